@@ -0,0 +1,548 @@
+/**
+ * @file
+ * @brief The `grey` command line tool: converts integers to Grey codes
+ * or back, one per line, from files or the standard input to the
+ * standard output.
+ *
+ * The input is read in large blocks of whole lines. With more than one
+ * thread, each block is split at line boundaries into one part per
+ * thread; every thread parses, converts and formats its part into its
+ * own buffer, then the buffers are written out in order.
+ *
+ * With `--raw` the files hold packed binary integers instead, converted
+ * in place or into another file by grey_packed_convert_file().
+ *
+ * Exit status: 0 on success, 1 on an invalid input line, 2 on wrong
+ * usage or I/O errors.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "grey_text.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(GREY_NO_THREADS) && defined(__GNUC__) \
+    && (defined(__unix__) || defined(__APPLE__))
+#define GREY_CLI_THREADS
+#include <pthread.h>
+#endif
+
+/** Bytes of input read at once, also the longest accepted line. */
+#define GREY_CLI_BLOCK (16U * 1024U * 1024U)
+/** Smallest block split among threads, smaller ones are not worth it. */
+#define GREY_CLI_PARALLEL_MIN (256U * 1024U)
+#define GREY_CLI_MAX_THREADS 64U
+
+#define GREY_CLI_EXIT_INVALID 1
+#define GREY_CLI_EXIT_ERROR 2
+
+/** Command line options. */
+typedef struct
+{
+    grey_text_config_t text;
+    size_t threads;
+    /** Packed binary files instead of text, see grey_cli_raw(). */
+    bool raw;
+    grey_packed_config_t packed;
+    /** Output file of the raw conversion, NULL for in place. */
+    const char* out;
+} grey_cli_options_t;
+
+/** State kept across files. */
+typedef struct
+{
+    const grey_cli_options_t* options;
+    char* buffer;
+    /** One part of each block per thread, with its output buffer. */
+    grey_text_block_t parts[GREY_CLI_MAX_THREADS];
+} grey_cli_t;
+
+/** Converts one part of a block, in its own thread. */
+typedef struct
+{
+    grey_text_block_t* part;
+    const grey_text_config_t* config;
+} grey_cli_task_t;
+
+static int grey_cli_usage(FILE* const out, const int status)
+{
+    fputs("Usage: grey [OPTION]... [FILE]...\n"
+          "Converts integers, one per line, to Grey codes or back.\n"
+          "Reads the standard input without FILE or when FILE is -.\n"
+          "\n"
+          "  -e, --encode         integers to Grey codes (default)\n"
+          "  -d, --decode         Grey codes to integers\n"
+          "  -i, --input FORMAT   dec, hex or bin (default dec)\n"
+          "  -o, --output FORMAT  dec, hex or bin (default as input)\n"
+          "  -w, --width BITS     8, 16, 32 or 64 (default 64)\n"
+          "  -p, --pad            zero-pad hex and bin output to the width\n"
+          "  -j, --threads N      convert with N threads (default 1)\n"
+          "  -r, --raw            FILEs are packed binary integers of the\n"
+          "                       width, converted in place\n"
+          "  -O, --out OUT        with --raw, convert the only FILE into OUT\n"
+          "      --order ORDER    with --raw, byte order of FILE: native,\n"
+          "                       little or big (default native)\n"
+          "      --out-order ORDER\n"
+          "                       byte order of OUT (default as FILE)\n"
+          "  -h, --help           show this help\n"
+          "      --version        show the library version\n"
+          "\n"
+          "Hexadecimal input may start with 0x. Exit status: 0 on success,\n"
+          "1 on an invalid line, 2 on other errors.\n", out);
+    return status;
+}
+
+static bool grey_cli_format(const char* const name,
+                            grey_text_format_t* const format)
+{
+    if (strcmp(name, "dec") == 0)
+    {
+        *format = GREY_TEXT_DEC;
+    }
+    else if (strcmp(name, "hex") == 0)
+    {
+        *format = GREY_TEXT_HEX;
+    }
+    else if (strcmp(name, "bin") == 0)
+    {
+        *format = GREY_TEXT_BIN;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+static bool grey_cli_order(const char* const name,
+                           grey_byte_order_t* const order)
+{
+    if (strcmp(name, "native") == 0)
+    {
+        *order = GREY_ORDER_NATIVE;
+    }
+    else if (strcmp(name, "little") == 0)
+    {
+        *order = GREY_ORDER_LITTLE;
+    }
+    else if (strcmp(name, "big") == 0)
+    {
+        *order = GREY_ORDER_BIG;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+static bool grey_cli_number(const char* const str, const size_t max,
+                            size_t* const number)
+{
+    char* end = NULL;
+    const unsigned long parsed = strtoul(str, &end, 10);
+    if (end == str || *end != '\0' || parsed == 0U || parsed > max)
+    {
+        return false;
+    }
+    *number = (size_t) parsed;
+    return true;
+}
+
+#if defined(GREY_CLI_THREADS)
+static void* grey_cli_worker(void* const arg)
+{
+    const grey_cli_task_t* const task = arg;
+    grey_text_convert(task->part, task->config);
+    return NULL;
+}
+#endif
+
+/**
+ * Converts \p length bytes of whole lines of the buffer, writes the
+ * output and reports the first invalid line.
+ *
+ * @param[in,out] cli state.
+ * @param[in] length bytes of the buffer to convert.
+ * @param[in] name of the input, for error messages.
+ * @param[in,out] line lines of the input before the buffer, updated.
+ * @return 0 on success, otherwise the exit status.
+ */
+static int grey_cli_convert(grey_cli_t* const cli, const size_t length,
+                            const char* const name, size_t* const line)
+{
+    const grey_text_config_t* const config = &cli->options->text;
+    size_t parts = 1U;
+    if (length >= GREY_CLI_PARALLEL_MIN)
+    {
+        parts = cli->options->threads;
+    }
+    /* Parts end after the first newline from their share of the bytes */
+    size_t start = 0;
+    for (size_t i = 0; i < parts; i++)
+    {
+        size_t end = length;
+        if (i + 1U < parts)
+        {
+            end = (length / parts) * (i + 1U);
+            if (end < start)
+            {
+                end = start;
+            }
+            const char* const newline = memchr(&cli->buffer[end], '\n',
+                                               length - end);
+            end = (newline != NULL)
+                  ? (size_t) (newline - cli->buffer) + 1U
+                  : length;
+        }
+        cli->parts[i].in = &cli->buffer[start];
+        cli->parts[i].in_len = end - start;
+        start = end;
+    }
+#if defined(GREY_CLI_THREADS)
+    grey_cli_task_t tasks[GREY_CLI_MAX_THREADS];
+    pthread_t threads[GREY_CLI_MAX_THREADS];
+    bool started[GREY_CLI_MAX_THREADS];
+    for (size_t i = 1; i < parts; i++)
+    {
+        tasks[i].part = &cli->parts[i];
+        tasks[i].config = config;
+        /* If a thread cannot start, its part is converted below */
+        started[i] = pthread_create(&threads[i], NULL, grey_cli_worker,
+                                    &tasks[i]) == 0;
+    }
+    grey_text_convert(&cli->parts[0], config);
+    for (size_t i = 1; i < parts; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+        else
+        {
+            grey_text_convert(&cli->parts[i], config);
+        }
+    }
+#else
+    for (size_t i = 0; i < parts; i++)
+    {
+        grey_text_convert(&cli->parts[i], config);
+    }
+#endif
+    for (size_t i = 0; i < parts; i++)
+    {
+        const grey_text_block_t* const part = &cli->parts[i];
+        if (fwrite(part->out, 1, part->out_len, stdout) != part->out_len)
+        {
+            fprintf(stderr, "grey: write error\n");
+            return GREY_CLI_EXIT_ERROR;
+        }
+        *line += part->lines;
+        if (part->error != GREY_OK)
+        {
+            /* The output of the lines before first */
+            fflush(stdout);
+        }
+        switch (part->error)
+        {
+            case GREY_OK:
+                break;
+            case GREY_ERR_NOMEM:
+                fprintf(stderr, "grey: out of memory\n");
+                return GREY_CLI_EXIT_ERROR;
+            case GREY_ERR_RANGE:
+                fprintf(stderr, "grey: %s:%zu: number out of range\n",
+                        name, *line + 1U);
+                return GREY_CLI_EXIT_INVALID;
+            case GREY_ERR_INVALID:
+            case GREY_ERR_UNSUPPORTED:
+            case GREY_ERR_IO:
+            default:
+                fprintf(stderr, "grey: %s:%zu: invalid number\n",
+                        name, *line + 1U);
+                return GREY_CLI_EXIT_INVALID;
+        }
+    }
+    return 0;
+}
+
+/** Converts a whole input file, block by block. */
+static int grey_cli_file(grey_cli_t* const cli, FILE* const in,
+                         const char* const name)
+{
+    size_t kept = 0;
+    size_t line = 0;
+    for (;;)
+    {
+        const size_t got = fread(&cli->buffer[kept], 1,
+                                  GREY_CLI_BLOCK - kept, in);
+        if (ferror(in))
+        {
+            fprintf(stderr, "grey: %s: read error\n", name);
+            return GREY_CLI_EXIT_ERROR;
+        }
+        const size_t length = kept + got;
+        const bool end = got < GREY_CLI_BLOCK - kept;
+        /* Without the end of the input, the last line may be partial */
+        size_t complete = length;
+        if (!end)
+        {
+            while (complete > 0U && cli->buffer[complete - 1U] != '\n')
+            {
+                complete--;
+            }
+            if (complete == 0U)
+            {
+                fprintf(stderr, "grey: %s:%zu: line too long\n",
+                        name, line + 1U);
+                return GREY_CLI_EXIT_INVALID;
+            }
+        }
+        if (complete > 0U)
+        {
+            const int status = grey_cli_convert(cli, complete, name, &line);
+            if (status != 0)
+            {
+                return status;
+            }
+        }
+        kept = length - complete;
+        memmove(cli->buffer, &cli->buffer[complete], kept);
+        if (end)
+        {
+            return 0;
+        }
+    }
+}
+
+/** Converts packed binary files with the memory-mapped conversion. */
+static int grey_cli_raw(const grey_cli_options_t* const options,
+                        const int files, char** const paths)
+{
+    if (files == 0 || (options->out != NULL && files != 1))
+    {
+        fprintf(stderr, "grey: --raw needs FILEs, only one with --out\n");
+        return GREY_CLI_EXIT_ERROR;
+    }
+    grey_parallel_config_t parallel;
+    grey_parallel_config_get(&parallel);
+    parallel.threads = options->threads;
+    if (grey_parallel_config_set(&parallel) != GREY_OK)
+    {
+        fprintf(stderr, "grey: threads not supported\n");
+        return GREY_CLI_EXIT_ERROR;
+    }
+    for (int i = 0; i < files; i++)
+    {
+        errno = 0;
+        switch (grey_packed_convert_file(paths[i], options->out,
+                                         &options->packed))
+        {
+            case GREY_OK:
+                break;
+            case GREY_ERR_INVALID:
+                fprintf(stderr, "grey: %s: size not a multiple of %u bits\n",
+                        paths[i], options->packed.bits);
+                return GREY_CLI_EXIT_INVALID;
+            case GREY_ERR_RANGE:
+                fprintf(stderr, "grey: %s: too large to map\n", paths[i]);
+                return GREY_CLI_EXIT_ERROR;
+            case GREY_ERR_UNSUPPORTED:
+                fprintf(stderr, "grey: --raw not supported\n");
+                return GREY_CLI_EXIT_ERROR;
+            case GREY_ERR_IO:
+            case GREY_ERR_NOMEM:
+            default:
+                fprintf(stderr, "grey: %s: %s\n", paths[i],
+                        strerror(errno));
+                return GREY_CLI_EXIT_ERROR;
+        }
+    }
+    return 0;
+}
+
+/** Parses the options, removing them from \p argv; -1 on success. */
+static int grey_cli_options(int* const argc, char** const argv,
+                            grey_cli_options_t* const options)
+{
+    bool output_set = false;
+    bool out_order_set = false;
+    int files = 1;
+    bool only_files = false;
+    for (int i = 1; i < *argc; i++)
+    {
+        const char* const arg = argv[i];
+        const char* const value = (i + 1 < *argc) ? argv[i + 1] : NULL;
+        size_t number = 0;
+        if (only_files || arg[0] != '-' || strcmp(arg, "-") == 0)
+        {
+            argv[files++] = argv[i];
+        }
+        else if (strcmp(arg, "--") == 0)
+        {
+            only_files = true;
+        }
+        else if (strcmp(arg, "-e") == 0 || strcmp(arg, "--encode") == 0)
+        {
+            options->text.direction = GREY_TEXT_ENCODE;
+        }
+        else if (strcmp(arg, "-d") == 0 || strcmp(arg, "--decode") == 0)
+        {
+            options->text.direction = GREY_TEXT_DECODE;
+        }
+        else if (strcmp(arg, "-p") == 0 || strcmp(arg, "--pad") == 0)
+        {
+            options->text.pad = true;
+        }
+        else if ((strcmp(arg, "-i") == 0 || strcmp(arg, "--input") == 0)
+                 && value != NULL
+                 && grey_cli_format(value, &options->text.input))
+        {
+            i++;
+        }
+        else if ((strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0)
+                 && value != NULL
+                 && grey_cli_format(value, &options->text.output))
+        {
+            output_set = true;
+            i++;
+        }
+        else if ((strcmp(arg, "-w") == 0 || strcmp(arg, "--width") == 0)
+                 && value != NULL && grey_cli_number(value, 64U, &number)
+                 && (number == 8U || number == 16U || number == 32U
+                     || number == 64U))
+        {
+            options->text.bits = (unsigned int) number;
+            i++;
+        }
+        else if ((strcmp(arg, "-j") == 0 || strcmp(arg, "--threads") == 0)
+                 && value != NULL
+                 && grey_cli_number(value, GREY_CLI_MAX_THREADS, &number))
+        {
+            options->threads = number;
+            i++;
+        }
+        else if (strcmp(arg, "-r") == 0 || strcmp(arg, "--raw") == 0)
+        {
+            options->raw = true;
+        }
+        else if ((strcmp(arg, "-O") == 0 || strcmp(arg, "--out") == 0)
+                 && value != NULL)
+        {
+            options->out = value;
+            i++;
+        }
+        else if (strcmp(arg, "--order") == 0 && value != NULL
+                 && grey_cli_order(value, &options->packed.input_order))
+        {
+            i++;
+        }
+        else if (strcmp(arg, "--out-order") == 0 && value != NULL
+                 && grey_cli_order(value, &options->packed.output_order))
+        {
+            out_order_set = true;
+            i++;
+        }
+        else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
+        {
+            return grey_cli_usage(stdout, 0);
+        }
+        else if (strcmp(arg, "--version") == 0)
+        {
+            printf("grey %s\n", GREY_VERSION);
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "grey: wrong option or value: %s\n", arg);
+            return grey_cli_usage(stderr, GREY_CLI_EXIT_ERROR);
+        }
+    }
+    if (!output_set)
+    {
+        options->text.output = options->text.input;
+    }
+    if (!out_order_set)
+    {
+        options->packed.output_order = options->packed.input_order;
+    }
+    options->packed.bits = options->text.bits;
+    options->packed.decode = options->text.direction == GREY_TEXT_DECODE;
+    *argc = files;
+    return -1;
+}
+
+int main(int argc, char** argv)
+{
+    grey_cli_options_t options = {
+            .text = {
+                    .input = GREY_TEXT_DEC,
+                    .output = GREY_TEXT_DEC,
+                    .direction = GREY_TEXT_ENCODE,
+                    .bits = 64U,
+                    .pad = false,
+            },
+            .threads = 1U,
+            .raw = false,
+            .packed = {
+                    .input_order = GREY_ORDER_NATIVE,
+            },
+            .out = NULL,
+    };
+    const int done = grey_cli_options(&argc, argv, &options);
+    if (done >= 0)
+    {
+        return done;
+    }
+    if (options.raw)
+    {
+        return grey_cli_raw(&options, argc - 1, &argv[1]);
+    }
+    static grey_cli_t cli;
+    cli.options = &options;
+    cli.buffer = malloc(GREY_CLI_BLOCK);
+    if (cli.buffer == NULL)
+    {
+        fprintf(stderr, "grey: out of memory\n");
+        return GREY_CLI_EXIT_ERROR;
+    }
+    int status = 0;
+    if (argc == 1)
+    {
+        status = grey_cli_file(&cli, stdin, "-");
+    }
+    for (int i = 1; i < argc && status == 0; i++)
+    {
+        if (strcmp(argv[i], "-") == 0)
+        {
+            status = grey_cli_file(&cli, stdin, "-");
+            continue;
+        }
+        FILE* const in = fopen(argv[i], "rb");
+        if (in == NULL)
+        {
+            fprintf(stderr, "grey: %s: cannot open\n", argv[i]);
+            status = GREY_CLI_EXIT_ERROR;
+            break;
+        }
+        status = grey_cli_file(&cli, in, argv[i]);
+        fclose(in);
+    }
+    if (fflush(stdout) != 0 && status == 0)
+    {
+        fprintf(stderr, "grey: write error\n");
+        status = GREY_CLI_EXIT_ERROR;
+    }
+    for (size_t i = 0; i < GREY_CLI_MAX_THREADS; i++)
+    {
+        free(cli.parts[i].out);
+    }
+    free(cli.buffer);
+    return status;
+}
@@ -0,0 +1,464 @@
+/**
+ * @file
+ * @brief Text conversion of the `grey` command line tool.
+ *
+ * Decimal and hexadecimal numbers are parsed and formatted 8 characters
+ * at a time inside a 64-bit integer (SWAR), as the binary strings of the
+ * library: one range test per 8 characters validates them, then a few
+ * shifts and multiplications merge or split the digits pairwise. Shorter
+ * leading parts are padded with '0' to a whole chunk, so there is no
+ * loop per character. Lines are converted in batches with the bulk
+ * kernels of the library.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_text.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Each byte of a word set to 0x01. */
+#define GREY_TEXT_ONES UINT64_C(0x0101010101010101)
+/** Each byte of a word set to '0'. */
+#define GREY_TEXT_ZEROS UINT64_C(0x3030303030303030)
+/** Top bit of each byte of a word. */
+#define GREY_TEXT_HIGH UINT64_C(0x8080808080808080)
+/** 10^8, the largest power of 10 fitting a chunk of 8 characters. */
+#define GREY_TEXT_DEC_CHUNK UINT64_C(100000000)
+/** Lines parsed before converting them all with one bulk call. */
+#define GREY_TEXT_BATCH 512U
+
+/**
+ * 8 characters as a word, the first one in the lowest byte regardless
+ * of the byte order of the CPU.
+ */
+static inline uint64_t grey_text_load(const char* const str)
+{
+    uint64_t word;
+    memcpy(&word, str, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/** Inverse of grey_text_load(). */
+static inline void grey_text_store(char* const str, uint64_t word)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    word = __builtin_bswap64(word);
+#endif
+    memcpy(str, &word, sizeof(word));
+}
+
+/**
+ * Top bit of each byte of \p word set if the byte is between \p low and
+ * \p high included. Only for bytes below 0x80, for which the additions
+ * never carry into the next byte.
+ */
+static inline uint64_t grey_text_in_range(const uint64_t word,
+                                          const uint64_t low,
+                                          const uint64_t high)
+{
+    const uint64_t at_least_low = word + (0x80U - low) * GREY_TEXT_ONES;
+    const uint64_t above_high = word + (0x7FU - high) * GREY_TEXT_ONES;
+    return at_least_low & ~above_high & GREY_TEXT_HIGH;
+}
+
+/**
+ * The first \p length characters of \p str, at most 8, as the last ones
+ * of a chunk starting with '0's.
+ */
+static inline uint64_t grey_text_load_head(const char* const str,
+                                           const size_t length)
+{
+    char chunk[8];
+    memset(chunk, '0', sizeof(chunk));
+    memcpy(&chunk[sizeof(chunk) - length], str, length);
+    return grey_text_load(chunk);
+}
+
+/**
+ * Value of 8 decimal digits, each byte of \p word set to the ASCII digit.
+ * Any other character sets some bits of \p invalid.
+ */
+static inline uint64_t grey_text_dec_chunk(const uint64_t word,
+                                           uint64_t* const invalid)
+{
+    *invalid |= (word & GREY_TEXT_HIGH)
+                | (grey_text_in_range(word, '0', '9') ^ GREY_TEXT_HIGH);
+    uint64_t digits = word & (0x0FU * GREY_TEXT_ONES);
+    /* Pairs of digits, pairs of pairs, then the two halves */
+    digits = (digits * 10U + (digits >> 8U))
+             & UINT64_C(0x00FF00FF00FF00FF);
+    digits = (digits * 100U + (digits >> 16U))
+             & UINT64_C(0x0000FFFF0000FFFF);
+    return (digits * 10000U + (digits >> 32U)) & UINT64_C(0xFFFFFFFF);
+}
+
+/**
+ * Value of 8 hexadecimal digits of either case, as grey_text_dec_chunk().
+ */
+static inline uint64_t grey_text_hex_chunk(const uint64_t word,
+                                           uint64_t* const invalid)
+{
+    /* Setting bit 5 lowers the case of letters only, not of digits */
+    const uint64_t letters = grey_text_in_range(
+            word | (0x20U * GREY_TEXT_ONES), 'a', 'f');
+    *invalid |= (word & GREY_TEXT_HIGH)
+                | ((grey_text_in_range(word, '0', '9') | letters)
+                   ^ GREY_TEXT_HIGH);
+    /* The lowest 4 bits of 'a' and 'A' are 1 */
+    uint64_t nibbles = (word & (0x0FU * GREY_TEXT_ONES))
+                       + (letters >> 7U) * 9U;
+    nibbles = ((nibbles << 4U) | (nibbles >> 8U))
+              & UINT64_C(0x00FF00FF00FF00FF);
+    nibbles = ((nibbles << 8U) | (nibbles >> 16U))
+              & UINT64_C(0x0000FFFF0000FFFF);
+    return ((nibbles << 16U) | (nibbles >> 32U)) & UINT64_C(0xFFFFFFFF);
+}
+
+static grey_err_t grey_text_parse_dec(const char* const str,
+                                      const size_t length,
+                                      uint64_t* const value)
+{
+    const size_t head = length % 8U;
+    uint64_t invalid = 0;
+    uint64_t overflow = 0;
+    uint64_t parsed = 0;
+    if (head != 0U)
+    {
+        parsed = grey_text_dec_chunk(grey_text_load_head(str, head),
+                                     &invalid);
+    }
+    for (size_t i = head; i < length; i += 8U)
+    {
+        const uint64_t chunk = grey_text_dec_chunk(grey_text_load(&str[i]),
+                                                   &invalid);
+        overflow |= (parsed > (UINT64_MAX - chunk) / GREY_TEXT_DEC_CHUNK);
+        parsed = parsed * GREY_TEXT_DEC_CHUNK + chunk;
+    }
+    if (invalid != 0U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    if (overflow != 0U)
+    {
+        return GREY_ERR_RANGE;
+    }
+    *value = parsed;
+    return GREY_OK;
+}
+
+static grey_err_t grey_text_parse_hex(const char* str, size_t length,
+                                      uint64_t* const value)
+{
+    if (length > 2U && str[0] == '0' && (str[1] | 0x20) == 'x')
+    {
+        str += 2;
+        length -= 2U;
+    }
+    const size_t head = length % 8U;
+    uint64_t invalid = 0;
+    uint64_t overflow = 0;
+    uint64_t parsed = 0;
+    if (head != 0U)
+    {
+        parsed = grey_text_hex_chunk(grey_text_load_head(str, head),
+                                     &invalid);
+    }
+    for (size_t i = head; i < length; i += 8U)
+    {
+        overflow |= parsed >> 32U;
+        parsed = (parsed << 32U)
+                 | grey_text_hex_chunk(grey_text_load(&str[i]), &invalid);
+    }
+    if (invalid != 0U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    if (overflow != 0U)
+    {
+        return GREY_ERR_RANGE;
+    }
+    *value = parsed;
+    return GREY_OK;
+}
+
+grey_err_t grey_text_parse(const char* const str, const size_t length,
+                           const grey_text_format_t format,
+                           const uint64_t max, uint64_t* const value)
+{
+    if (length == 0U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint64_t parsed = 0;
+    grey_err_t err;
+    switch (format)
+    {
+        case GREY_TEXT_HEX:
+            err = grey_text_parse_hex(str, length, &parsed);
+            break;
+        case GREY_TEXT_BIN:
+            err = grey_parse_binstr64(str, length, &parsed);
+            break;
+        case GREY_TEXT_DEC:
+        default:
+            err = grey_text_parse_dec(str, length, &parsed);
+            break;
+    }
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    if (parsed > max)
+    {
+        return GREY_ERR_RANGE;
+    }
+    *value = parsed;
+    return GREY_OK;
+}
+
+/**
+ * The 8 decimal digits of \p value, below 10^8, as ASCII. Splits it into
+ * halves, quarters and digits, dividing all parts at once with
+ * multiplications by the reciprocals, exact for these ranges.
+ */
+static inline uint64_t grey_text_dec_ascii(const uint64_t value)
+{
+    uint64_t parts = (value / 10000U) | ((value % 10000U) << 32U);
+    uint64_t tens = ((parts * 5243U) >> 19U) & UINT64_C(0x0000007F0000007F);
+    parts = tens | ((parts - tens * 100U) << 16U);
+    tens = ((parts * 103U) >> 10U) & UINT64_C(0x000F000F000F000F);
+    parts = tens | ((parts - tens * 10U) << 8U);
+    return parts + GREY_TEXT_ZEROS;
+}
+
+/** Bits up to the most significant 1 of \p value, not 0. */
+static inline unsigned int grey_text_bit_length(const uint64_t value)
+{
+#if defined(__GNUC__)
+    return 64U - (unsigned int) __builtin_clzll(value);
+#else
+    unsigned int length = 0;
+    while ((value >> length) != 0U && length < 64U)
+    {
+        length++;
+    }
+    return length;
+#endif
+}
+
+/** Index of the least significant non-zero byte, \p word not 0. */
+static inline unsigned int grey_text_first_byte(const uint64_t word)
+{
+#if defined(__GNUC__)
+    return (unsigned int) __builtin_ctzll(word) / 8U;
+#else
+    unsigned int index = 0;
+    while (((word >> (8U * index)) & 0xFFU) == 0U)
+    {
+        index++;
+    }
+    return index;
+#endif
+}
+
+static size_t grey_text_format_dec(char* const str, const uint64_t value)
+{
+    char digits[3U * 8U];
+    size_t chunks;
+    if (value < GREY_TEXT_DEC_CHUNK)
+    {
+        grey_text_store(digits, grey_text_dec_ascii(value));
+        chunks = 1U;
+    }
+    else if (value < GREY_TEXT_DEC_CHUNK * GREY_TEXT_DEC_CHUNK)
+    {
+        grey_text_store(digits,
+                        grey_text_dec_ascii(value / GREY_TEXT_DEC_CHUNK));
+        grey_text_store(&digits[8],
+                        grey_text_dec_ascii(value % GREY_TEXT_DEC_CHUNK));
+        chunks = 2U;
+    }
+    else
+    {
+        const uint64_t high = value / GREY_TEXT_DEC_CHUNK;
+        grey_text_store(digits,
+                        grey_text_dec_ascii(high / GREY_TEXT_DEC_CHUNK));
+        grey_text_store(&digits[8],
+                        grey_text_dec_ascii(high % GREY_TEXT_DEC_CHUNK));
+        grey_text_store(&digits[16],
+                        grey_text_dec_ascii(value % GREY_TEXT_DEC_CHUNK));
+        chunks = 3U;
+    }
+    /* Leading zeros of the first chunk, but not the only digit of 0 */
+    const uint64_t first = grey_text_load(digits) - GREY_TEXT_ZEROS;
+    const size_t zeros = (first == 0U) ? 7U : grey_text_first_byte(first);
+    const size_t length = chunks * 8U - zeros;
+    memcpy(str, &digits[zeros], length);
+    return length;
+}
+
+/**
+ * The 8 lowercase hexadecimal digits of \p value, below 2^32, as ASCII:
+ * splits it into halves, bytes and nibbles, then adds '0' or 'a' - 10.
+ */
+static inline uint64_t grey_text_hex_ascii(const uint64_t value)
+{
+    uint64_t nibbles = ((value << 32U) | (value >> 16U))
+                       & UINT64_C(0x0000FFFF0000FFFF);
+    nibbles = ((nibbles << 16U) | (nibbles >> 8U))
+              & UINT64_C(0x00FF00FF00FF00FF);
+    nibbles = ((nibbles << 8U) | (nibbles >> 4U))
+              & (0x0FU * GREY_TEXT_ONES);
+    /* 0x76 carries the nibbles from 10 up into the top bit */
+    const uint64_t letters = ((nibbles + 0x76U * GREY_TEXT_ONES) >> 7U)
+                             & GREY_TEXT_ONES;
+    return nibbles + GREY_TEXT_ZEROS + letters * ('a' - '0' - 10U);
+}
+
+static size_t grey_text_format_hex(char* const str, const uint64_t value,
+                                   const unsigned int pad_bits)
+{
+    char digits[2U * 8U];
+    grey_text_store(digits, grey_text_hex_ascii(value >> 32U));
+    grey_text_store(&digits[8], grey_text_hex_ascii(value & 0xFFFFFFFFU));
+    size_t length;
+    if (pad_bits != 0U)
+    {
+        length = pad_bits / 4U;
+    }
+    else
+    {
+        /* At least one digit, also for 0 */
+        length = (grey_text_bit_length(value | 1U) + 3U) / 4U;
+    }
+    memcpy(str, &digits[sizeof(digits) - length], length);
+    return length;
+}
+
+size_t grey_text_format(char* const str, const uint64_t value,
+                        const grey_text_format_t format,
+                        const unsigned int pad_bits)
+{
+    switch (format)
+    {
+        case GREY_TEXT_HEX:
+            return grey_text_format_hex(str, value, pad_bits);
+        case GREY_TEXT_BIN:
+            if (pad_bits != 0U)
+            {
+                char fixed[64U + 1U];
+                grey_binstr_fixed64(fixed, value);
+                memcpy(str, &fixed[64U - pad_bits], pad_bits);
+                return pad_bits;
+            }
+            if (value == 0U)
+            {
+                str[0] = '0';
+                return 1U;
+            }
+            else
+            {
+                char shortest[64U + 1U];
+                const size_t length = grey_binstr64(shortest, value);
+                memcpy(str, shortest, length);
+                return length;
+            }
+        case GREY_TEXT_DEC:
+        default:
+            return grey_text_format_dec(str, value);
+    }
+}
+
+/** Makes room for \p more characters after the output of \p block. */
+static grey_err_t grey_text_reserve(grey_text_block_t* const block,
+                                    const size_t more)
+{
+    const size_t needed = block->out_len + more;
+    if (needed <= block->out_capacity)
+    {
+        return GREY_OK;
+    }
+    size_t capacity = 2U * block->out_capacity;
+    if (capacity < needed)
+    {
+        capacity = needed;
+    }
+    char* const out = realloc(block->out, capacity);
+    if (out == NULL)
+    {
+        return GREY_ERR_NOMEM;
+    }
+    block->out = out;
+    block->out_capacity = capacity;
+    return GREY_OK;
+}
+
+grey_err_t grey_text_convert(grey_text_block_t* const block,
+                             const grey_text_config_t* const config)
+{
+    uint64_t values[GREY_TEXT_BATCH];
+    const uint64_t max = (config->bits >= 64U)
+                         ? UINT64_MAX
+                         : (UINT64_C(1) << config->bits) - 1U;
+    const unsigned int pad_bits = config->pad ? config->bits : 0U;
+    size_t position = 0;
+    block->out_len = 0;
+    block->lines = 0;
+    block->error = GREY_OK;
+    while (position < block->in_len && block->error == GREY_OK)
+    {
+        size_t amount = 0;
+        while (amount < GREY_TEXT_BATCH && position < block->in_len)
+        {
+            const char* const line = &block->in[position];
+            const char* const newline = memchr(
+                    line, '\n', block->in_len - position);
+            size_t length = (newline != NULL)
+                            ? (size_t) (newline - line)
+                            : block->in_len - position;
+            const size_t next = position + length + 1U;
+            if (length > 0U && line[length - 1U] == '\r')
+            {
+                length--;
+            }
+            block->error = grey_text_parse(line, length, config->input,
+                                           max, &values[amount]);
+            if (block->error != GREY_OK)
+            {
+                break;
+            }
+            amount++;
+            position = next;
+        }
+        if (config->direction == GREY_TEXT_DECODE)
+        {
+            grey_from_array_inplace64(values, amount);
+        }
+        else
+        {
+            grey_to_array_inplace64(values, amount);
+        }
+        if (grey_text_reserve(block, amount * (GREY_TEXT_MAX_LEN + 1U))
+            != GREY_OK)
+        {
+            block->error = GREY_ERR_NOMEM;
+            break;
+        }
+        char* out = &block->out[block->out_len];
+        for (size_t i = 0; i < amount; i++)
+        {
+            out += grey_text_format(out, values[i], config->output,
+                                    pad_bits);
+            *out++ = '\n';
+        }
+        block->out_len = (size_t) (out - block->out);
+        block->lines += amount;
+    }
+    return block->error;
+}
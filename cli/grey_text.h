@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief Text conversion of the `grey` command line tool: fast parsers
+ * and formatters of decimal, hexadecimal and binary integers, and the
+ * conversion of whole blocks of lines.
+ *
+ * Not part of the library API.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef GREY_TEXT_H
+#define GREY_TEXT_H
+
+#include "grey.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** Longest formatted integer: 64 binary digits. */
+#define GREY_TEXT_MAX_LEN 64U
+
+/** Notation of the integers, one per line. */
+typedef enum
+{
+    /** Decimal, such as `42`. */
+    GREY_TEXT_DEC = 0,
+    /** Hexadecimal, such as `2a`, optionally prefixed by `0x`. */
+    GREY_TEXT_HEX = 1,
+    /** Binary, such as `101010`, as grey_binstr(). */
+    GREY_TEXT_BIN = 2,
+} grey_text_format_t;
+
+/** What to do with each integer. */
+typedef enum
+{
+    /** Binary values to Grey codes. */
+    GREY_TEXT_ENCODE = 0,
+    /** Grey codes to binary values. */
+    GREY_TEXT_DECODE = 1,
+} grey_text_direction_t;
+
+/** Conversion settings, shared by all blocks. */
+typedef struct
+{
+    grey_text_format_t input;
+    grey_text_format_t output;
+    grey_text_direction_t direction;
+    /** Width of the integers: 8, 16, 32 or 64 bits. */
+    unsigned int bits;
+    /** Zero-pad the hexadecimal and binary output to #bits. */
+    bool pad;
+} grey_text_config_t;
+
+/**
+ * A block of complete lines to convert, and the result.
+ *
+ * The output buffer is grown with `realloc()` as needed and may be
+ * reused for the next block.
+ */
+typedef struct
+{
+    /** Lines to convert, each one terminated by `'\n'`. */
+    const char* in;
+    size_t in_len;
+    /** Converted lines. */
+    char* out;
+    size_t out_len;
+    size_t out_capacity;
+    /** Lines converted, so far. */
+    size_t lines;
+    /**
+     * #GREY_OK, or the error of the line after the converted ones, in
+     * which case #out holds the output of the lines before it.
+     */
+    grey_err_t error;
+} grey_text_block_t;
+
+/**
+ * Parses an unsigned integer of the given notation.
+ *
+ * @param[in] str text of the integer, without sign or spaces.
+ * @param[in] length characters of \p str.
+ * @param[in] format notation of \p str.
+ * @param[in] max largest accepted value.
+ * @param[out] value parsed integer, untouched on failure.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID on malformed text,
+ *         #GREY_ERR_RANGE if the integer is larger than \p max.
+ */
+grey_err_t grey_text_parse(const char* str, size_t length,
+                           grey_text_format_t format, uint64_t max,
+                           uint64_t* value);
+
+/**
+ * Formats an unsigned integer in the given notation, not null-terminated.
+ *
+ * @param[out] str at least #GREY_TEXT_MAX_LEN characters.
+ * @param[in] value integer to format.
+ * @param[in] format notation.
+ * @param[in] pad_bits 0 for no leading zeros, otherwise the width in bits
+ *            to zero-pad the hexadecimal and binary notations to.
+ * @return characters written.
+ */
+size_t grey_text_format(char* str, uint64_t value, grey_text_format_t format,
+                        unsigned int pad_bits);
+
+/**
+ * Converts each line of a block, stopping at the first invalid one.
+ *
+ * @param[in,out] block lines to convert and output buffer.
+ * @param[in] config conversion settings.
+ * @return #GREY_OK on success, #GREY_ERR_NOMEM if the output buffer
+ *         cannot grow, otherwise the error of the invalid line, as in
+ *         grey_text_block_t.error.
+ */
+grey_err_t grey_text_convert(grey_text_block_t* block,
+                             const grey_text_config_t* config);
+
+#endif  /* GREY_TEXT_H */
@@ -11,6 +11,11 @@
  * domain of the Grey codes and their values), redefine the macro
  * `GREY_UINTBITS` to 32, 16 or 8 instead of 64.
  *
+ * Fixed-width variants of the functions, such as grey_to16() or
+ * grey_from128(), are available regardless of `GREY_UINTBITS`, so a single
+ * build handles all widths. In C11, grey_to(), grey_from() and
+ * grey_binstr() select them automatically, see #GREY_NO_GENERIC.
+ *
  * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
  * <https://matjaz.it>. All rights reserved.
  * @license BSD 3-clause license.
@@ -31,6 +36,11 @@ extern "C"
 
 #include <stdint.h>
 #include <inttypes.h>
+#include <stddef.h>
+#include <stdbool.h>
+#if defined(GREY_FROM_CLMUL) && defined(__PCLMUL__) && defined(__x86_64__)
+#include <wmmintrin.h>
+#endif
 
 /**
  * @property GREY_UINTBITS
@@ -129,33 +139,249 @@ typedef uint8_t grey_code_t;
 typedef grey_code_t grey_int_t;
 
 /**
- * Utility wrapper adding/subtracting a delta to a Grey-encoded value.
+ * Outcome of the library functions that can fail.
+ */
+typedef enum
+{
+    /** Success. */
+    GREY_OK = 0,
+    /** The requested feature is not supported by this CPU or build. */
+    GREY_ERR_UNSUPPORTED = 1,
+    /** Memory allocation failed. */
+    GREY_ERR_NOMEM = 2,
+    /** The input is malformed, such as a non-binary character. */
+    GREY_ERR_INVALID = 3,
+    /** The input is well-formed, but its value does not fit the type. */
+    GREY_ERR_RANGE = 4,
+    /** A file could not be opened, resized or mapped, see `errno`. */
+    GREY_ERR_IO = 5,
+} grey_err_t;
+
+/**
+ * Instruction sets the bulk conversion kernels are implemented with.
  *
- * @warning No checks are performed for overflows/underflows/integer conversion
- * errors etc.!
- * @param grey value to increase/decrease.
- * @param delta value to add/remove from the grey code, signed.
- * @return increased/decreased Grey code.
+ * The ones up to #GREY_KERNEL_AVX512 are ordered from the slowest to the
+ * fastest one. The following ones are alternatives, never picked by
+ * #GREY_KERNEL_AUTO.
+ */
+typedef enum
+{
+    /** Let the library pick the fastest kernel supported by the CPU. */
+    GREY_KERNEL_AUTO = 0,
+    /** Plain C, one element at a time. Always available. */
+    GREY_KERNEL_SCALAR = 1,
+    /** x86 SSE2, 128-bit vectors. */
+    GREY_KERNEL_SSE2 = 2,
+    /** x86 AVX2, 256-bit vectors. */
+    GREY_KERNEL_AVX2 = 3,
+    /** x86 AVX-512 F and BW, 512-bit vectors. */
+    GREY_KERNEL_AVX512 = 4,
+    /**
+     * Like #GREY_KERNEL_SSE2, but decodes 64-bit Grey codes with a
+     * carry-less multiplication (PCLMULQDQ) instead of the shift-XOR
+     * cascade.
+     */
+    GREY_KERNEL_PCLMUL = 5,
+    /**
+     * Like #GREY_KERNEL_AVX512, but decodes 64-bit Grey codes with a
+     * carry-less multiplication (VPCLMULQDQ) instead of the shift-XOR
+     * cascade.
+     */
+    GREY_KERNEL_VPCLMUL = 6,
+    /**
+     * Plain C, converting with lookup tables: 256 entries for 8-bit codes
+     * and for each byte of the 32- and 64-bit ones, 65536 entries for
+     * 16-bit codes. The other functions are the ones of
+     * #GREY_KERNEL_SCALAR.
+     */
+    GREY_KERNEL_LUT = 7,
+} grey_kernel_t;
+
+/**
+ * @property GREY_HAS_UINT128
+ * Defined to 1 when the compiler provides a 128-bit unsigned integer, in
+ * which case #grey_uint128_t, #GREY_MAX128 and the 128-bit functions such
+ * as grey_to128() are available.
+ */
+/**
+ * @property grey_uint128_t
+ * 128-bit unsigned integer (`unsigned __int128`), for the 128-bit Grey
+ * codes and their values.
+ */
+/**
+ * @property GREY_MAX128
+ * Maximum value of #grey_uint128_t.
+ */
+#if defined(__SIZEOF_INT128__)
+#define GREY_HAS_UINT128 1
+__extension__ typedef unsigned __int128 grey_uint128_t;
+#define GREY_MAX128 (~(grey_uint128_t) 0U)
+#endif
+
+/*
+ * Always-inlined conversions of each width, regardless of #GREY_UINTBITS.
+ * Usable to avoid a library call in hot loops without the
+ * #GREY_HEADER_ONLY mode.
  */
-#define grey_add(grey, delta) grey_to(grey_from((grey)) + (delta))
+
+/** Always-inlined version of grey_to8(). */
+static inline uint8_t grey_inline_to8(const uint8_t value)
+{
+    return (uint8_t) (value ^ (value >> 1U));
+}
+
+/** Always-inlined version of grey_from8(). */
+static inline uint8_t grey_inline_from8(uint8_t grey)
+{
+    grey ^= (uint8_t) (grey >> 4U);
+    grey ^= (uint8_t) (grey >> 2U);
+    grey ^= (uint8_t) (grey >> 1U);
+    return grey;
+}
+
+/** Always-inlined version of grey_to16(). */
+static inline uint16_t grey_inline_to16(const uint16_t value)
+{
+    return (uint16_t) (value ^ (value >> 1U));
+}
+
+/** Always-inlined version of grey_from16(). */
+static inline uint16_t grey_inline_from16(uint16_t grey)
+{
+    grey ^= (uint16_t) (grey >> 8U);
+    grey ^= (uint16_t) (grey >> 4U);
+    grey ^= (uint16_t) (grey >> 2U);
+    grey ^= (uint16_t) (grey >> 1U);
+    return grey;
+}
+
+/** Always-inlined version of grey_to32(). */
+static inline uint32_t grey_inline_to32(const uint32_t value)
+{
+    return value ^ (value >> 1U);
+}
+
+/** Always-inlined version of grey_from32(). */
+static inline uint32_t grey_inline_from32(uint32_t grey)
+{
+    grey ^= grey >> 16U;
+    grey ^= grey >> 8U;
+    grey ^= grey >> 4U;
+    grey ^= grey >> 2U;
+    grey ^= grey >> 1U;
+    return grey;
+}
+
+/** Always-inlined version of grey_to64(). */
+static inline uint64_t grey_inline_to64(const uint64_t value)
+{
+    return value ^ (value >> 1U);
+}
+
+/** Always-inlined version of grey_from64(). */
+static inline uint64_t grey_inline_from64(uint64_t grey)
+{
+#if defined(GREY_FROM_CLMUL) && defined(__PCLMUL__) && defined(__x86_64__)
+    /* Bits 63..126 of the carry-less product by 64 ones are the
+     * prefix-XORs from the most significant bit down. */
+    const __m128i product = _mm_clmulepi64_si128(
+            _mm_cvtsi64_si128((long long) grey), _mm_set1_epi64x(-1), 0x00);
+    const uint64_t low = (uint64_t) _mm_cvtsi128_si64(product);
+    const uint64_t high = (uint64_t) _mm_cvtsi128_si64(
+            _mm_unpackhi_epi64(product, product));
+    return (high << 1U) | (low >> 63U);
+#else
+    grey ^= grey >> 32U;
+    grey ^= grey >> 16U;
+    grey ^= grey >> 8U;
+    grey ^= grey >> 4U;
+    grey ^= grey >> 2U;
+    grey ^= grey >> 1U;
+    return grey;
+#endif
+}
+
+#if defined(GREY_HAS_UINT128)
+/** Always-inlined version of grey_to128(). */
+static inline grey_uint128_t grey_inline_to128(const grey_uint128_t value)
+{
+    return value ^ (value >> 1U);
+}
 
 /**
- * Utility wrapper incrementing a Grey-encoded value by 1.
+ * Always-inlined version of grey_from128().
  *
- * @warning No checks are performed for overflows!
- * @param grey value to increment.
- * @return incremented Grey code = `grey+1`.
+ * Decodes the two 64-bit halves independently, then flips the whole lower
+ * half if the upper half of the code has odd parity, which is the lowest
+ * bit of its decoded value.
  */
-#define grey_incr(grey) grey_add((grey), 1)
+static inline grey_uint128_t grey_inline_from128(const grey_uint128_t grey)
+{
+    const uint64_t high = grey_inline_from64((uint64_t) (grey >> 64U));
+    const uint64_t low = grey_inline_from64((uint64_t) grey)
+                         ^ (0U - (high & 1U));
+    return ((grey_uint128_t) high << 64U) | low;
+}
+#endif
+
+#define GREY_WIDTH_NAME_(name, bits) name##bits
+/** Name of the \p bits -wide variant of the function \p name. */
+#define GREY_WIDTH_NAME(name, bits) GREY_WIDTH_NAME_(name, bits)
+
+/** Always-inlined version of grey_to(). */
+static inline grey_code_t grey_inline_to(const grey_int_t value)
+{
+    return GREY_WIDTH_NAME(grey_inline_to, GREY_UINTBITS)(value);
+}
+
+/** Always-inlined version of grey_from(). */
+static inline grey_int_t grey_inline_from(const grey_code_t grey)
+{
+    return GREY_WIDTH_NAME(grey_inline_from, GREY_UINTBITS)(grey);
+}
 
 /**
- * Utility wrapper decrementing a Grey-encoded value by 1.
+ * @property GREY_HEADER_ONLY
+ * Define it before including this header to get `static inline`
+ * definitions of grey_to() and grey_from() and their fixed-width variants
+ * instead of the declarations of the library functions, so they vanish
+ * into the callers and loops around them can be vectorised by the
+ * compiler.
  *
- * @warning No checks are performed for underflows!
- * @param grey value to decrement.
- * @return decremented Grey code = `grey-1`.
+ * The library keeps exporting the linkable symbols either way, so
+ * translation units with and without this mode can be mixed.
  */
-#define grey_decr(grey) grey_add((grey), -1)
+#if defined(GREY_HEADER_ONLY)
+
+#define GREY_HEADER_ONLY_DEFINE(bits, type) \
+    static inline type grey_to##bits(const type value) \
+    { \
+        return grey_inline_to##bits(value); \
+    } \
+    static inline type grey_from##bits(const type grey) \
+    { \
+        return grey_inline_from##bits(grey); \
+    }
+
+GREY_HEADER_ONLY_DEFINE(8, uint8_t)
+GREY_HEADER_ONLY_DEFINE(16, uint16_t)
+GREY_HEADER_ONLY_DEFINE(32, uint32_t)
+GREY_HEADER_ONLY_DEFINE(64, uint64_t)
+#if defined(GREY_HAS_UINT128)
+GREY_HEADER_ONLY_DEFINE(128, grey_uint128_t)
+#endif
+
+static inline grey_code_t grey_to(const grey_int_t value)
+{
+    return grey_inline_to(value);
+}
+
+static inline grey_int_t grey_from(const grey_code_t grey)
+{
+    return grey_inline_from(grey);
+}
+
+#else
 
 /**
  * Converts a regular binary unsigned integer to Grey code.
@@ -168,35 +394,2539 @@ grey_code_t grey_to(grey_int_t value);
 /**
  * Converts a Grey-encoded value into a regular binary unsigned integer.
  *
+ * Uses a cascade of log2(#GREY_UINTBITS) shift-XOR steps. On x86-64, when
+ * compiled with `GREY_FROM_CLMUL` defined and PCLMULQDQ enabled
+ * (`-mpclmul`, the `GREY_FROM_CLMUL` CMake option), 64-bit codes are
+ * decoded with a single carry-less multiplication instead.
+ *
  * @param grey value to convert
  * @return binary value (regular integer) of the Grey code
  */
 grey_int_t grey_from(grey_code_t grey);
 
+/*
+ * Fixed-width variants of grey_to() and grey_from(), all available in the
+ * same build regardless of #GREY_UINTBITS.
+ */
+/** grey_to() on 8-bit integers. */
+uint8_t grey_to8(uint8_t value);
+/** grey_from() on 8-bit integers. */
+uint8_t grey_from8(uint8_t grey);
+/** grey_to() on 16-bit integers. */
+uint16_t grey_to16(uint16_t value);
+/** grey_from() on 16-bit integers. */
+uint16_t grey_from16(uint16_t grey);
+/** grey_to() on 32-bit integers. */
+uint32_t grey_to32(uint32_t value);
+/** grey_from() on 32-bit integers. */
+uint32_t grey_from32(uint32_t grey);
+/** grey_to() on 64-bit integers. */
+uint64_t grey_to64(uint64_t value);
+/** grey_from() on 64-bit integers. */
+uint64_t grey_from64(uint64_t grey);
+#if defined(GREY_HAS_UINT128)
+/** grey_to() on 128-bit integers. */
+grey_uint128_t grey_to128(grey_uint128_t value);
+/** grey_from() on 128-bit integers. */
+grey_uint128_t grey_from128(grey_uint128_t grey);
+#endif
+
+#endif
+
+/** 1 if \p x has an odd number of set bits, 0 otherwise. */
+static inline unsigned int grey_inline_parity64(const uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned int) __builtin_parityll(x);
+#else
+    uint64_t folded = x ^ (x >> 32U);
+    folded ^= folded >> 16U;
+    folded ^= folded >> 8U;
+    folded ^= folded >> 4U;
+    /* Parities of the 16 nibble values, as a bit table */
+    return (unsigned int) ((0x6996U >> (folded & 0xFU)) & 1U);
+#endif
+}
+
+#if defined(GREY_HAS_UINT128)
+/** grey_inline_parity64() on 128 bits. */
+static inline unsigned int grey_inline_parity128(const grey_uint128_t x)
+{
+    return grey_inline_parity64((uint64_t) x ^ (uint64_t) (x >> 64U));
+}
+#endif
 
 /**
- * Fills a string with the Grey code in binary representation.
+ * Defines grey_incr<bits>() and grey_decr<bits>(), stepping a Grey code
+ * directly, without decoding it.
  *
- * The representation is:
- * - ASCII
- * - big endian (as humans would read and write the number)
- * - contains no spaces
- * - is **null-terminated**
- * - is at most #GREY_UINTBITS bytes in size (**excluding** the
- *   null-terminator).
+ * The parity of a Grey code is the parity of its value, i.e. its lowest
+ * bit. Going up from an even value flips bit 0, from an odd one flips the
+ * bit above the lowest set one, except for the maximum value, whose code is
+ * the top bit alone: that one is flipped, wrapping around to 0. Going down
+ * is the same with the two cases swapped, and 0 wraps around to the code of
+ * the maximum value, which is the top bit.
+ */
+#define GREY_INCR_DECR_DEFINE(bits, type, parity) \
+    static inline type grey_incr##bits(const type grey) \
+    { \
+        type flip = 1U; \
+        if (parity(grey)) \
+        { \
+            flip = (type) (grey & (type) (0U - grey)); \
+            if (flip != (type) 1U << ((bits) - 1U)) \
+            { \
+                flip = (type) (flip << 1U); \
+            } \
+        } \
+        return (type) (grey ^ flip); \
+    } \
+    static inline type grey_decr##bits(const type grey) \
+    { \
+        type flip = 1U; \
+        if (grey == 0U) \
+        { \
+            flip = (type) ((type) 1U << ((bits) - 1U)); \
+        } \
+        else if (!parity(grey)) \
+        { \
+            flip = (type) (grey & (type) (0U - grey)); \
+            flip = (type) (flip << 1U); \
+        } \
+        return (type) (grey ^ flip); \
+    }
+
+/*
+ * Fixed-width variants of grey_incr() and grey_decr(), all available
+ * regardless of #GREY_UINTBITS.
+ */
+GREY_INCR_DECR_DEFINE(8, uint8_t, grey_inline_parity64)
+GREY_INCR_DECR_DEFINE(16, uint16_t, grey_inline_parity64)
+GREY_INCR_DECR_DEFINE(32, uint32_t, grey_inline_parity64)
+GREY_INCR_DECR_DEFINE(64, uint64_t, grey_inline_parity64)
+#if defined(GREY_HAS_UINT128)
+GREY_INCR_DECR_DEFINE(128, grey_uint128_t, grey_inline_parity128)
+#endif
+
+/**
+ * Defines grey_cmp<bits>(), comparing two Grey codes by their binary
+ * values without decoding them.
  *
- * Example:
- *     `grey_binstr(str, 0x0E)` fills `str` with `"1110\0"` and returns `4`.
+ * The two values differ first in the highest bit where the codes differ,
+ * as they have the same bits above it. There, the value bit is the parity
+ * of the code bits from it up, so the code with odd parity there is the
+ * one of the larger value. \p top_bit gives the index of the highest set
+ * bit of a non-zero code.
+ */
+#define GREY_CMP_DEFINE(bits, type, parity, top_bit) \
+    static inline int grey_cmp##bits(const type a, const type b) \
+    { \
+        const type differing = (type) (a ^ b); \
+        if (differing == 0U) \
+        { \
+            return 0; \
+        } \
+        return parity((type) (a >> top_bit(differing))) ? 1 : -1; \
+    }
+
+/** Index of the highest set bit of \p x, which must not be 0. */
+static inline uint_fast8_t grey_inline_top_bit64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (uint_fast8_t) (63 - __builtin_clzll(x));
+#else
+    uint_fast8_t top = 0;
+    for (uint_fast8_t half = 32U; half > 0U; half >>= 1U)
+    {
+        if (x >> half)
+        {
+            x >>= half;
+            top = (uint_fast8_t) (top + half);
+        }
+    }
+    return top;
+#endif
+}
+
+/*
+ * Fixed-width variants of grey_cmp(), all available regardless of
+ * #GREY_UINTBITS.
+ */
+GREY_CMP_DEFINE(8, uint8_t, grey_inline_parity64, grey_inline_top_bit64)
+GREY_CMP_DEFINE(16, uint16_t, grey_inline_parity64, grey_inline_top_bit64)
+GREY_CMP_DEFINE(32, uint32_t, grey_inline_parity64, grey_inline_top_bit64)
+GREY_CMP_DEFINE(64, uint64_t, grey_inline_parity64, grey_inline_top_bit64)
+#if defined(GREY_HAS_UINT128)
+/** grey_inline_top_bit64() on 128 bits. */
+static inline uint_fast8_t grey_inline_top_bit128(const grey_uint128_t x)
+{
+    const uint64_t high = (uint64_t) (x >> 64U);
+    return (high != 0U)
+           ? (uint_fast8_t) (64U + grey_inline_top_bit64(high))
+           : grey_inline_top_bit64((uint64_t) x);
+}
+
+GREY_CMP_DEFINE(128, grey_uint128_t, grey_inline_parity128,
+                grey_inline_top_bit128)
+#endif
+
+/**
+ * Compares two Grey codes by their binary values, without decoding them.
  *
- * Note: this is just a utility function, is not meant to be super-efficient.
+ * Costs a XOR, a count of leading zeros and a parity, so sorting and
+ * searching Grey-coded keys needs no grey_from() in the comparator.
  *
- * @param[out] str buffer of #GREY_UINTBITS+1 bytes (the "+1" is the space
- *             for the null-terminator).
- * @param[in] grey value to encode.
- * @returns length of the binary string written into \p str **excluding** the
- *          null-terminator
+ * @param a first Grey code
+ * @param b second Grey code
+ * @return a negative number if the value of \p a is smaller than the one
+ *         of \p b, 0 if they are equal, a positive number if it is larger,
+ *         like `memcmp()`.
  */
-uint8_t grey_binstr(char str[GREY_UINTBITS+1], grey_code_t grey);
+static inline int grey_cmp(const grey_code_t a, const grey_code_t b)
+{
+    return GREY_WIDTH_NAME(grey_cmp, GREY_UINTBITS)(a, b);
+}
+
+/**
+ * Adds/subtracts a delta to a Grey-encoded value.
+ *
+ * Always inlined, without calls into the library. For steps of 1 use
+ * grey_incr() and grey_decr() instead, which do not decode the code.
+ *
+ * @warning No checks are performed for overflows/underflows: the result
+ * wraps around modulo #GREY_MAX + 1. See grey_add_overflow().
+ * @param grey value to increase/decrease.
+ * @param delta value to add/remove from the grey code, signed.
+ * @return increased/decreased Grey code.
+ */
+static inline grey_code_t grey_add(const grey_code_t grey,
+                                   const int64_t delta)
+{
+    return grey_inline_to(
+            (grey_int_t) (grey_inline_from(grey) + (grey_int_t) delta));
+}
+
+/**
+ * Adds/subtracts a delta to a Grey-encoded value, telling whether the
+ * result wrapped around, like `__builtin_add_overflow()`.
+ *
+ * Always inlined, without calls into the library.
+ *
+ * @param[in] grey value to increase/decrease.
+ * @param[in] delta value to add/remove from the grey code, signed.
+ * @param[out] result Grey code of the sum, wrapped around modulo
+ *             #GREY_MAX + 1 as grey_add() does.
+ * @return true if the sum overflowed above #GREY_MAX or underflowed below
+ *         0, false if \p result is exact.
+ */
+static inline bool grey_add_overflow(const grey_code_t grey,
+                                     const int64_t delta,
+                                     grey_code_t* const result)
+{
+    const grey_int_t value = grey_inline_from(grey);
+    *result = grey_inline_to((grey_int_t) (value + (grey_int_t) delta));
+    if (delta >= 0)
+    {
+        return (uint64_t) delta > (uint64_t) (GREY_MAX - value);
+    }
+    return (0U - (uint64_t) delta) > (uint64_t) value;
+}
+
+/**
+ * Increments a Grey-encoded value by 1.
+ *
+ * Works on the code directly in a few instructions, without decoding it:
+ * see #GREY_INCR_DECR_DEFINE.
+ *
+ * @warning No checks are performed for overflows: the code of #GREY_MAX
+ * wraps around to 0.
+ * @param grey value to increment.
+ * @return incremented Grey code = `grey+1`.
+ */
+static inline grey_code_t grey_incr(const grey_code_t grey)
+{
+    return GREY_WIDTH_NAME(grey_incr, GREY_UINTBITS)(grey);
+}
+
+/**
+ * Decrements a Grey-encoded value by 1.
+ *
+ * Works on the code directly in a few instructions, without decoding it:
+ * see #GREY_INCR_DECR_DEFINE.
+ *
+ * @warning No checks are performed for underflows: 0 wraps around to the
+ * code of #GREY_MAX.
+ * @param grey value to decrement.
+ * @return decremented Grey code = `grey-1`.
+ */
+static inline grey_code_t grey_decr(const grey_code_t grey)
+{
+    return GREY_WIDTH_NAME(grey_decr, GREY_UINTBITS)(grey);
+}
+
+/**
+ * Reads a Grey counter that other threads, processes or devices step by 1
+ * at a time, also when the read itself is not atomic: a 64-bit counter on
+ * a 32-bit CPU, or a register wider than its bus.
+ *
+ * A read overlapping a single step is either the code before or the one
+ * after it, whichever way it is torn, as they differ by one bit. The
+ * counter is read until two reads in a row are equal or one step apart,
+ * so none of them overlapped more than one step, and the last one is
+ * returned.
+ *
+ * @param[in] counter Grey code to read.
+ * @return a code the counter held during the call.
+ */
+static inline grey_code_t grey_snapshot(const volatile grey_code_t* counter)
+{
+    grey_code_t previous = *counter;
+    for (;;)
+    {
+        const grey_code_t current = *counter;
+        if (current == previous || current == grey_incr(previous)
+            || current == grey_decr(previous))
+        {
+            return current;
+        }
+        previous = current;
+    }
+}
+
+/**
+ * @property GREY_HAS_ATOMIC
+ * Defined to 1 when the compiler provides the atomic builtins of GCC and
+ * Clang, in which case #grey_atomic_t and its functions are available.
+ *
+ * They follow the C11 memory model, like `<stdatomic.h>`, but on a plain
+ * #grey_code_t, so the counters are the same in C99, C11 and C++ code
+ * sharing them.
+ */
+#if defined(__GNUC__) && defined(__ATOMIC_ACQ_REL)
+#define GREY_HAS_ATOMIC 1
+
+/** Size of a cache line, that counters updated by different CPUs avoid. */
+#define GREY_CACHE_LINE 64U
+
+/**
+ * Grey counter updated atomically by many threads or processes, e.g. the
+ * read or write pointer of a FIFO in shared memory.
+ *
+ * Readers see it change by one bit per step. Initialise it with
+ * grey_atomic_init() and access it only with the grey_atomic_...()
+ * functions or grey_snapshot() on #code.
+ */
+typedef struct
+{
+    /** Current Grey code. */
+    grey_code_t code;
+} grey_atomic_t;
+
+/**
+ * A #grey_atomic_t alone in its cache line, so that updating it does not
+ * slow down the CPUs using the data next to it (false sharing).
+ */
+typedef struct
+{
+    grey_atomic_t counter;
+    uint8_t padding[GREY_CACHE_LINE - sizeof(grey_atomic_t)];
+} __attribute__((aligned(GREY_CACHE_LINE))) grey_atomic_padded_t;
+
+/**
+ * Bytes of memory, e.g. shared among processes and mapped anywhere,
+ * holding \p amount counters in their own cache line with
+ * grey_atomic_at().
+ */
+#define GREY_ATOMIC_REGION_SIZE(amount) \
+    (((size_t) (amount) + 1U) * GREY_CACHE_LINE)
+
+/**
+ * The counter \p index of a region of #GREY_ATOMIC_REGION_SIZE() bytes,
+ * starting at the first cache line in it.
+ *
+ * @param[in] region memory for the counters, of any alignment.
+ * @param[in] index of the counter, from 0.
+ * @return the counter, alone in its cache line.
+ */
+static inline grey_atomic_t* grey_atomic_at(void* const region,
+                                            const size_t index)
+{
+    const uintptr_t first = ((uintptr_t) region + GREY_CACHE_LINE - 1U)
+                            & ~(uintptr_t) (GREY_CACHE_LINE - 1U);
+    return (grey_atomic_t*) (first + index * GREY_CACHE_LINE);
+}
+
+/**
+ * Sets the counter before sharing it, without ordering.
+ *
+ * @param[out] counter to initialise.
+ * @param[in] code its starting Grey code.
+ */
+static inline void grey_atomic_init(grey_atomic_t* const counter,
+                                    const grey_code_t code)
+{
+    __atomic_store_n(&counter->code, code, __ATOMIC_RELAXED);
+}
+
+/**
+ * Reads the counter, with acquire ordering: what was written before the
+ * grey_atomic_store() or update of the code is visible after this.
+ *
+ * @param[in] counter to read.
+ * @return its Grey code.
+ */
+static inline grey_code_t grey_atomic_load(const grey_atomic_t* const counter)
+{
+    return __atomic_load_n(&counter->code, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Sets the counter, with release ordering. Enough for the single writer
+ * of a FIFO pointer, without the compare-exchange of grey_atomic_incr().
+ *
+ * @param[in, out] counter to write.
+ * @param[in] code its new Grey code.
+ */
+static inline void grey_atomic_store(grey_atomic_t* const counter,
+                                     const grey_code_t code)
+{
+    __atomic_store_n(&counter->code, code, __ATOMIC_RELEASE);
+}
+
+/**
+ * Replaces the code of the counter with \p desired if it is still
+ * \p expected, with acquire-release ordering.
+ *
+ * @param[in, out] counter to update.
+ * @param[in, out] expected code the counter should have, overwritten with
+ *                 the actual one on failure.
+ * @param[in] desired new code of the counter.
+ * @return true if the counter was updated.
+ */
+static inline bool grey_atomic_cas(grey_atomic_t* const counter,
+                                   grey_code_t* const expected,
+                                   const grey_code_t desired)
+{
+    return __atomic_compare_exchange_n(&counter->code, expected, desired,
+                                       false, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Adds/subtracts a delta to the counter atomically, wrapping around as
+ * grey_add() does, with acquire-release ordering.
+ *
+ * @param[in, out] counter to update.
+ * @param[in] delta value to add/remove, signed.
+ * @return the new Grey code of the counter.
+ */
+static inline grey_code_t grey_atomic_add(grey_atomic_t* const counter,
+                                          const int64_t delta)
+{
+    grey_code_t code = __atomic_load_n(&counter->code, __ATOMIC_RELAXED);
+    grey_code_t next;
+    do
+    {
+        next = grey_add(code, delta);
+    }
+    while (!__atomic_compare_exchange_n(&counter->code, &code, next, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+    return next;
+}
+
+/**
+ * Increments the counter by 1 atomically, wrapping around as grey_incr()
+ * does, with acquire-release ordering.
+ *
+ * @param[in, out] counter to update.
+ * @return the new Grey code of the counter.
+ */
+static inline grey_code_t grey_atomic_incr(grey_atomic_t* const counter)
+{
+    grey_code_t code = __atomic_load_n(&counter->code, __ATOMIC_RELAXED);
+    grey_code_t next;
+    do
+    {
+        next = grey_incr(code);
+    }
+    while (!__atomic_compare_exchange_n(&counter->code, &code, next, true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+    return next;
+}
+
+/**
+ * Decoder of the readings of an absolute encoder in Grey code, e.g.
+ * sampled in an interrupt handler and decoded later by a thread.
+ *
+ * The readings go through a single-producer single-consumer ring buffer:
+ * one context pushes them with grey_stream_push(), which is wait-free and
+ * async-signal-safe, another decodes them in batches with
+ * grey_stream_decode(). Neither allocates nor locks.
+ *
+ * The decoder follows the encoder across turns: it moves by the shortest
+ * way round from one reading to the next, so going past #GREY_MAX to 0 is
+ * one step forward, and flags the readings that changed more than one bit
+ * since the previous one, which a Grey encoder moving one step cannot do.
+ *
+ * Initialise it with grey_stream_init(). The fields are for reading only,
+ * by the consumer.
+ */
+typedef struct
+{
+    /** Readings pushed so far, written by the producer. */
+    size_t head;
+    /** Readings dropped by grey_stream_push() as the buffer was full. */
+    size_t overruns;
+    /** Ring buffer of the readings, of a power of 2 length. */
+    grey_code_t* buffer;
+    /** Length of the buffer minus 1. */
+    size_t mask;
+    /** Readings decoded so far, in the cache line of the consumer. */
+    size_t tail __attribute__((aligned(GREY_CACHE_LINE)));
+    /**
+     * Position of the encoder after the last decoded reading: the turns
+     * completed times 2^#GREY_UINTBITS plus the decoded reading, wrapping
+     * around at 64 bits. Starts at the first reading.
+     */
+    int64_t position;
+    /** Readings flagged as glitches so far. */
+    uint64_t glitches;
+    /** Whether a reading was decoded, so #position is set. */
+    bool started;
+} grey_stream_t;
+
+/**
+ * Prepares an empty decoder, before sharing it between the producer and
+ * the consumer.
+ *
+ * @param[out] stream to initialise.
+ * @param[in] buffer where the pushed readings wait to be decoded, used
+ *            until the decoder is not needed anymore.
+ * @param[in] capacity readings the buffer holds, a power of 2.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p buffer is NULL or
+ *         \p capacity is not a power of 2.
+ */
+grey_err_t grey_stream_init(grey_stream_t* stream, grey_code_t* buffer,
+                            size_t capacity);
+
+/**
+ * Appends a reading to the decoder, from the single producer. Wait-free
+ * and async-signal-safe, it may be called from interrupt and signal
+ * handlers.
+ *
+ * @param[in, out] stream to push into.
+ * @param[in] reading the Grey code read from the encoder.
+ * @return false if the buffer was full, in which case the reading is
+ *         dropped and counted in grey_stream_overruns().
+ */
+static inline bool grey_stream_push(grey_stream_t* const stream,
+                                    const grey_code_t reading)
+{
+    const size_t head = stream->head;  /* Written only here */
+    const size_t tail = __atomic_load_n(&stream->tail, __ATOMIC_ACQUIRE);
+    if (head - tail > stream->mask)
+    {
+        __atomic_store_n(&stream->overruns, stream->overruns + 1U,
+                         __ATOMIC_RELAXED);
+        return false;
+    }
+    stream->buffer[head & stream->mask] = reading;
+    __atomic_store_n(&stream->head, head + 1U, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * Readings dropped so far because the buffer was full, from any context.
+ *
+ * @param[in] stream to check.
+ * @return the amount of lost readings.
+ */
+static inline size_t grey_stream_overruns(const grey_stream_t* const stream)
+{
+    return __atomic_load_n(&stream->overruns, __ATOMIC_RELAXED);
+}
+
+/**
+ * Decodes the readings pushed so far, up to \p max of them, from the
+ * single consumer, updating grey_stream_t.position and
+ * grey_stream_t.glitches.
+ *
+ * The readings are decoded in batches with the kernels of
+ * grey_from_array() straight from the ring buffer, then the buffer space
+ * is handed back to the producer at once.
+ *
+ * @param[in, out] stream to decode.
+ * @param[out] positions where to write the position after each reading,
+ *             see grey_stream_t.position, or NULL.
+ * @param[out] glitches where to write for each reading whether it changed
+ *             more than one bit from the previous one, or NULL. The
+ *             position follows such a reading anyway, by the shortest way.
+ * @param[in] max most readings to decode, the length of the outputs.
+ * @return the amount of decoded readings, 0 if none was waiting.
+ */
+size_t grey_stream_decode(grey_stream_t* stream, int64_t* positions,
+                          bool* glitches, size_t max);
+
+#endif
+
+/**
+ * Index of the lowest set bit of \p x, which must not be 0.
+ */
+static inline uint_fast8_t grey_inline_ctz64(const uint64_t x)
+{
+#if defined(__GNUC__)
+    return (uint_fast8_t) __builtin_ctzll(x);
+#else
+    /* De Bruijn sequence: the top 6 bits of its product by the isolated
+     * lowest bit are unique for each bit position. */
+    static const uint8_t positions[64] = {
+            0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+            62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+            63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+            46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6,
+    };
+    return positions[((x & (0U - x)) * UINT64_C(0x03F79D71B4CB0A89)) >> 58U];
+#endif
+}
+
+/**
+ * Iterator over the sequence of Grey codes, one code at a time.
+ *
+ * Keeps the binary value next to its code, so each step costs a count of
+ * trailing zeros and an XOR, and tells which bit changed: what drives a
+ * scan pattern or an exhaustive sweep toggling one input at a time. Use
+ * grey_fill_range() instead to generate many codes into an array.
+ */
+typedef struct
+{
+    /** Current Grey code. */
+    grey_code_t code;
+    /** Binary value of #code. */
+    grey_int_t value;
+    /**
+     * Index of the bit flipped by the last step, from 0 for the least
+     * significant one. #GREY_UINTBITS before the first step.
+     */
+    uint_fast8_t flipped;
+} grey_iter_t;
+
+/**
+ * Initialises an iterator to start from the Grey code of \p start.
+ *
+ * @param[out] iter iterator to initialise
+ * @param[in] start binary value of the starting code.
+ */
+static inline void grey_iter_init(grey_iter_t* const iter,
+                                  const grey_int_t start)
+{
+    iter->value = start;
+    iter->code = grey_inline_to(start);
+    iter->flipped = GREY_UINTBITS;
+}
+
+/**
+ * Steps the iterator to the code of the next value, wrapping around after
+ * #GREY_MAX, in O(1).
+ *
+ * Counting up from value `v` flips the bit in the position of the lowest
+ * set bit of `v + 1`, or the top bit when wrapping around to 0.
+ *
+ * @param[in,out] iter iterator to step, which also gets the index of the
+ *                flipped bit in its `flipped` field.
+ * @return the new Grey code.
+ */
+static inline grey_code_t grey_iter_next(grey_iter_t* const iter)
+{
+    iter->value++;
+    iter->flipped = (iter->value == 0U) ? (uint_fast8_t) (GREY_UINTBITS - 1U)
+                                        : grey_inline_ctz64(iter->value);
+    iter->code ^= (grey_code_t) ((grey_code_t) 1U << iter->flipped);
+    return iter->code;
+}
+
+/**
+ * Steps the iterator to the code of the previous value, wrapping around
+ * below 0, in O(1).
+ *
+ * Counting down from value `v` flips the bit in the position of the lowest
+ * set bit of `v`, or the top bit when wrapping around from 0.
+ *
+ * @param[in,out] iter iterator to step, which also gets the index of the
+ *                flipped bit in its `flipped` field.
+ * @return the new Grey code.
+ */
+static inline grey_code_t grey_iter_prev(grey_iter_t* const iter)
+{
+    iter->flipped = (iter->value == 0U) ? (uint_fast8_t) (GREY_UINTBITS - 1U)
+                                        : grey_inline_ctz64(iter->value);
+    iter->value--;
+    iter->code ^= (grey_code_t) ((grey_code_t) 1U << iter->flipped);
+    return iter->code;
+}
+
+/**
+ * Fills a string with the Grey code in binary representation.
+ *
+ * The representation is:
+ * - ASCII
+ * - big endian (as humans would read and write the number)
+ * - contains no spaces
+ * - is **null-terminated**
+ * - is at most #GREY_UINTBITS bytes in size (**excluding** the
+ *   null-terminator).
+ *
+ * Example:
+ *     `grey_binstr(str, 0x0E)` fills `str` with `"1110\0"` and returns `4`.
+ *
+ * The bits are formatted 8 at a time, without a branch per bit.
+ *
+ * @param[out] str buffer of #GREY_UINTBITS+1 bytes (the "+1" is the space
+ *             for the null-terminator).
+ * @param[in] grey value to encode.
+ * @returns length of the binary string written into \p str **excluding** the
+ *          null-terminator
+ */
+uint8_t grey_binstr(char str[GREY_UINTBITS+1], grey_code_t grey);
+
+/** grey_binstr() on an 8-bit Grey code. */
+uint8_t grey_binstr8(char str[8 + 1], uint8_t grey);
+/** grey_binstr() on a 16-bit Grey code. */
+uint8_t grey_binstr16(char str[16 + 1], uint16_t grey);
+/** grey_binstr() on a 32-bit Grey code. */
+uint8_t grey_binstr32(char str[32 + 1], uint32_t grey);
+/** grey_binstr() on a 64-bit Grey code. */
+uint8_t grey_binstr64(char str[64 + 1], uint64_t grey);
+#if defined(GREY_HAS_UINT128)
+/** grey_binstr() on a 128-bit Grey code. */
+uint8_t grey_binstr128(char str[128 + 1], grey_uint128_t grey);
+#endif
+
+/**
+ * Fills a string with the Grey code in binary representation, zero-padded
+ * to exactly #GREY_UINTBITS characters.
+ *
+ * Like grey_binstr(), but including the leading zeros, so every code
+ * takes the same space, e.g. `"00001110\0"` for `0x0E` with 8-bit codes.
+ *
+ * @param[out] str buffer of #GREY_UINTBITS+1 bytes, null-terminated.
+ * @param[in] grey value to encode.
+ */
+void grey_binstr_fixed(char str[GREY_UINTBITS + 1], grey_code_t grey);
+
+/** grey_binstr_fixed() on an 8-bit Grey code. */
+void grey_binstr_fixed8(char str[8 + 1], uint8_t grey);
+/** grey_binstr_fixed() on a 16-bit Grey code. */
+void grey_binstr_fixed16(char str[16 + 1], uint16_t grey);
+/** grey_binstr_fixed() on a 32-bit Grey code. */
+void grey_binstr_fixed32(char str[32 + 1], uint32_t grey);
+/** grey_binstr_fixed() on a 64-bit Grey code. */
+void grey_binstr_fixed64(char str[64 + 1], uint64_t grey);
+#if defined(GREY_HAS_UINT128)
+/** grey_binstr_fixed() on a 128-bit Grey code. */
+void grey_binstr_fixed128(char str[128 + 1], grey_uint128_t grey);
+#endif
+
+/**
+ * Size in bytes of the buffer needed by grey_binstr_array() for
+ * \p amount codes of \p bits bits, including the null-terminator.
+ */
+#define GREY_BINSTR_ARRAY_SIZE(bits, amount) \
+    (((amount) == 0U) ? 1U : (size_t) (amount) * ((size_t) (bits) + 1U))
+
+/**
+ * Formats a whole array of Grey codes into a single string.
+ *
+ * Each code is written as by grey_binstr_fixed(), followed by
+ * \p separator, except the last one, which is followed by the
+ * null-terminator instead. Being zero-padded, the i-th code always starts
+ * at `str[i * (GREY_UINTBITS + 1)]`.
+ *
+ * Example with 8-bit codes and `','` as separator:
+ *     `{0x0E, 0x01}` gives `"00001110,00000001\0"`.
+ *
+ * @param[out] str buffer of at least
+ *             `GREY_BINSTR_ARRAY_SIZE(GREY_UINTBITS, amount)` bytes.
+ * @param[in] codes Grey codes to format.
+ * @param[in] amount number of elements in \p codes.
+ * @param[in] separator character written between two codes, such as
+ *            `' '`, `','` or `'\n'`.
+ * @return length of the string written into \p str **excluding** the
+ *         null-terminator.
+ */
+size_t grey_binstr_array(char* str, const grey_code_t* codes, size_t amount,
+                         char separator);
+
+/** grey_binstr_array() on 8-bit Grey codes. */
+size_t grey_binstr_array8(char* str, const uint8_t* codes, size_t amount,
+                          char separator);
+/** grey_binstr_array() on 16-bit Grey codes. */
+size_t grey_binstr_array16(char* str, const uint16_t* codes, size_t amount,
+                           char separator);
+/** grey_binstr_array() on 32-bit Grey codes. */
+size_t grey_binstr_array32(char* str, const uint32_t* codes, size_t amount,
+                           char separator);
+/** grey_binstr_array() on 64-bit Grey codes. */
+size_t grey_binstr_array64(char* str, const uint64_t* codes, size_t amount,
+                           char separator);
+
+/**
+ * Parses a Grey code from its binary representation, the inverse of
+ * grey_binstr() and grey_binstr_fixed().
+ *
+ * The string must contain only `'0'` and `'1'` characters, most
+ * significant bit first, with no sign, prefix or spaces. Leading zeros
+ * are allowed in any amount, so both the zero-padded and the shortest
+ * representation are accepted. The characters are validated and
+ * converted 8 at a time.
+ *
+ * @param[in] str binary string, not necessarily null-terminated.
+ * @param[in] length number of characters of \p str to parse.
+ * @param[out] grey parsed Grey code, untouched on failure.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p length is 0 or
+ *         any character is not `'0'` or `'1'`, #GREY_ERR_RANGE if the
+ *         value has more than #GREY_UINTBITS significant bits but is
+ *         otherwise valid.
+ */
+grey_err_t grey_parse_binstr(const char* str, size_t length,
+                             grey_code_t* grey);
+
+/** grey_parse_binstr() of an 8-bit Grey code. */
+grey_err_t grey_parse_binstr8(const char* str, size_t length,
+                              uint8_t* grey);
+/** grey_parse_binstr() of a 16-bit Grey code. */
+grey_err_t grey_parse_binstr16(const char* str, size_t length,
+                               uint16_t* grey);
+/** grey_parse_binstr() of a 32-bit Grey code. */
+grey_err_t grey_parse_binstr32(const char* str, size_t length,
+                               uint32_t* grey);
+/** grey_parse_binstr() of a 64-bit Grey code. */
+grey_err_t grey_parse_binstr64(const char* str, size_t length,
+                               uint64_t* grey);
+#if defined(GREY_HAS_UINT128)
+/** grey_parse_binstr() of a 128-bit Grey code. */
+grey_err_t grey_parse_binstr128(const char* str, size_t length,
+                                grey_uint128_t* grey);
+#endif
+
+/**
+ * Converts an array of regular binary unsigned integers to Grey codes.
+ *
+ * Equivalent to calling grey_to() on each element, but processes whole
+ * SIMD vectors at a time (SSE2, AVX2 or AVX-512, see grey_kernel_force()),
+ * so it reaches memory bandwidth on large arrays.
+ *
+ * @param[in] values binary values (regular integers) to convert
+ * @param[out] codes where to write \p amount Grey codes. Must not overlap
+ *             with \p values, use grey_to_array_inplace() instead.
+ * @param[in] amount number of elements in \p values and \p codes.
+ *            May be 0, in which case the pointers are not accessed.
+ */
+void grey_to_array(const grey_int_t* values, grey_code_t* codes,
+                   size_t amount);
+
+/**
+ * Converts an array of Grey-encoded values to regular binary unsigned
+ * integers.
+ *
+ * Equivalent to calling grey_from() on each element, but applies the
+ * shift-XOR cascade to whole SIMD vectors at a time.
+ *
+ * @param[in] codes Grey codes to convert
+ * @param[out] values where to write \p amount binary values. Must not
+ *             overlap with \p codes, use grey_from_array_inplace() instead.
+ * @param[in] amount number of elements in \p codes and \p values.
+ *            May be 0, in which case the pointers are not accessed.
+ */
+void grey_from_array(const grey_code_t* codes, grey_int_t* values,
+                     size_t amount);
+
+/**
+ * Converts an array of binary values to Grey codes, overwriting them.
+ *
+ * @param[in,out] values binary values to convert, replaced by their Grey
+ *                codes.
+ * @param[in] amount number of elements in \p values.
+ */
+void grey_to_array_inplace(grey_int_t* values, size_t amount);
+
+/**
+ * Converts an array of Grey codes to binary values, overwriting them.
+ *
+ * @param[in,out] codes Grey codes to convert, replaced by their binary
+ *                values.
+ * @param[in] amount number of elements in \p codes.
+ */
+void grey_from_array_inplace(grey_code_t* codes, size_t amount);
+
+/*
+ * Fixed-width variants of the bulk conversions, all available in the same
+ * build regardless of #GREY_UINTBITS.
+ */
+/** grey_to_array() on 8-bit integers. */
+void grey_to_array8(const uint8_t* values, uint8_t* codes, size_t amount);
+/** grey_from_array() on 8-bit integers. */
+void grey_from_array8(const uint8_t* codes, uint8_t* values, size_t amount);
+/** grey_to_array_inplace() on 8-bit integers. */
+void grey_to_array_inplace8(uint8_t* values, size_t amount);
+/** grey_from_array_inplace() on 8-bit integers. */
+void grey_from_array_inplace8(uint8_t* codes, size_t amount);
+/** grey_to_array() on 16-bit integers. */
+void grey_to_array16(const uint16_t* values, uint16_t* codes, size_t amount);
+/** grey_from_array() on 16-bit integers. */
+void grey_from_array16(const uint16_t* codes, uint16_t* values,
+                       size_t amount);
+/** grey_to_array_inplace() on 16-bit integers. */
+void grey_to_array_inplace16(uint16_t* values, size_t amount);
+/** grey_from_array_inplace() on 16-bit integers. */
+void grey_from_array_inplace16(uint16_t* codes, size_t amount);
+/** grey_to_array() on 32-bit integers. */
+void grey_to_array32(const uint32_t* values, uint32_t* codes, size_t amount);
+/** grey_from_array() on 32-bit integers. */
+void grey_from_array32(const uint32_t* codes, uint32_t* values,
+                       size_t amount);
+/** grey_to_array_inplace() on 32-bit integers. */
+void grey_to_array_inplace32(uint32_t* values, size_t amount);
+/** grey_from_array_inplace() on 32-bit integers. */
+void grey_from_array_inplace32(uint32_t* codes, size_t amount);
+/** grey_to_array() on 64-bit integers. */
+void grey_to_array64(const uint64_t* values, uint64_t* codes, size_t amount);
+/** grey_from_array() on 64-bit integers. */
+void grey_from_array64(const uint64_t* codes, uint64_t* values,
+                       size_t amount);
+/** grey_to_array_inplace() on 64-bit integers. */
+void grey_to_array_inplace64(uint64_t* values, size_t amount);
+/** grey_from_array_inplace() on 64-bit integers. */
+void grey_from_array_inplace64(uint64_t* codes, size_t amount);
+
+/** Most threads a parallel conversion can use, including the caller. */
+#define GREY_PARALLEL_MAX_THREADS 256U
+
+/** Tuning of the parallel conversions, such as grey_to_array_parallel(). */
+typedef struct
+{
+    /**
+     * Threads converting an array, including the calling one. 0 for one
+     * per online CPU, 1 to always stay in the calling thread. Default 0.
+     */
+    size_t threads;
+    /**
+     * Arrays smaller than this many bytes are converted by the calling
+     * thread alone, as waking up the pool would cost more than it saves.
+     * Default 4 MiB.
+     */
+    size_t cutoff;
+    /**
+     * Bytes converted by a thread at a time. Small enough to fit in the
+     * cache, large enough to make the scheduling overhead negligible.
+     * Default 64 KiB.
+     */
+    size_t chunk;
+} grey_parallel_config_t;
+
+/**
+ * Sets the tuning of the parallel conversions.
+ *
+ * Waits for any running parallel conversion to end. If fewer threads
+ * than before are requested, the pool is stopped and restarted on the
+ * next large conversion.
+ *
+ * @param[in] config new tuning.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if the chunk is 0 or
+ *         more than #GREY_PARALLEL_MAX_THREADS threads are requested,
+ *         #GREY_ERR_UNSUPPORTED if threads are requested in a build
+ *         without thread support.
+ */
+grey_err_t grey_parallel_config_set(const grey_parallel_config_t* config);
+
+/**
+ * Reads the tuning of the parallel conversions.
+ *
+ * @param[out] config current tuning.
+ */
+void grey_parallel_config_get(grey_parallel_config_t* config);
+
+/**
+ * Stops and joins the threads of the parallel conversions, freeing their
+ * resources. They are started again by the next large conversion.
+ */
+void grey_parallel_shutdown(void);
+
+/**
+ * Zeroes a buffer with the same threads that will convert it.
+ *
+ * On NUMA systems a memory page is placed on the node of the thread that
+ * first writes it. Each thread of the parallel conversions always
+ * processes the same part of buffers of the same size in bytes, so
+ * zeroing a freshly allocated buffer with this function, instead of
+ * `memset()` or `calloc()`, keeps most of its accesses node-local later.
+ *
+ * On Linux the pool threads are pinned to the CPUs of the process, one
+ * each, and steal chunks from threads on their own node first. Elsewhere
+ * they are not pinned and the placement is best-effort, as is the one of
+ * the part of the calling thread, unless the application keeps it on one
+ * node. Chunks stolen from other nodes are still converted remotely.
+ *
+ * @param[out] buffer memory to zero.
+ * @param[in] bytes size of \p buffer in bytes.
+ */
+void grey_parallel_first_touch(void* buffer, size_t bytes);
+
+/**
+ * grey_to_array() splitting very large arrays across threads.
+ *
+ * The array is split into chunks, converted by a pool of threads started
+ * on the first call, plus the calling one, each with the same kernel as
+ * grey_to_array(). Threads done early take over the chunks left by the
+ * others. Arrays below the cutoff are converted by the calling thread
+ * alone, see grey_parallel_config_t; so is the whole array when another
+ * thread is running a parallel conversion at the same time.
+ *
+ * Unlike grey_to_array(), \p values and \p codes may be the same buffer,
+ * for an in-place conversion; they must not otherwise overlap.
+ *
+ * @param[in] values binary values (regular integers) to convert.
+ * @param[out] codes where to write \p amount Grey codes.
+ * @param[in] amount number of elements in \p values and \p codes.
+ */
+void grey_to_array_parallel(const grey_int_t* values, grey_code_t* codes,
+                            size_t amount);
+
+/**
+ * grey_from_array() splitting very large arrays across threads, see
+ * grey_to_array_parallel().
+ *
+ * @param[in] codes Grey codes to convert.
+ * @param[out] values where to write \p amount binary values, may be
+ *             the same buffer as \p codes.
+ * @param[in] amount number of elements in \p codes and \p values.
+ */
+void grey_from_array_parallel(const grey_code_t* codes, grey_int_t* values,
+                              size_t amount);
+
+/** grey_to_array_parallel() on 8-bit integers. */
+void grey_to_array_parallel8(const uint8_t* values, uint8_t* codes,
+                             size_t amount);
+/** grey_from_array_parallel() on 8-bit integers. */
+void grey_from_array_parallel8(const uint8_t* codes, uint8_t* values,
+                               size_t amount);
+/** grey_to_array_parallel() on 16-bit integers. */
+void grey_to_array_parallel16(const uint16_t* values, uint16_t* codes,
+                              size_t amount);
+/** grey_from_array_parallel() on 16-bit integers. */
+void grey_from_array_parallel16(const uint16_t* codes, uint16_t* values,
+                                size_t amount);
+/** grey_to_array_parallel() on 32-bit integers. */
+void grey_to_array_parallel32(const uint32_t* values, uint32_t* codes,
+                              size_t amount);
+/** grey_from_array_parallel() on 32-bit integers. */
+void grey_from_array_parallel32(const uint32_t* codes, uint32_t* values,
+                                size_t amount);
+/** grey_to_array_parallel() on 64-bit integers. */
+void grey_to_array_parallel64(const uint64_t* values, uint64_t* codes,
+                              size_t amount);
+/** grey_from_array_parallel() on 64-bit integers. */
+void grey_from_array_parallel64(const uint64_t* codes, uint64_t* values,
+                                size_t amount);
+
+/** Byte order of packed integers, see grey_packed_config_t. */
+typedef enum
+{
+    /** The one of the CPU running the library. */
+    GREY_ORDER_NATIVE = 0,
+    /** Least significant byte first. */
+    GREY_ORDER_LITTLE = 1,
+    /** Most significant byte first. */
+    GREY_ORDER_BIG = 2,
+} grey_byte_order_t;
+
+/** Layout and direction of the conversion of packed integers. */
+typedef struct
+{
+    /** Width of each integer: 8, 16, 32 or 64 bits. */
+    unsigned int bits;
+    /** false to convert values to Grey codes, true for the opposite. */
+    bool decode;
+    /** Byte order of the integers to convert. */
+    grey_byte_order_t input_order;
+    /** Byte order of the converted integers. */
+    grey_byte_order_t output_order;
+} grey_packed_config_t;
+
+/**
+ * Converts a buffer of packed integers of any byte order, such as the
+ * samples of a capture file.
+ *
+ * Integers not in the native byte order are swapped in small blocks,
+ * staying in the cache between the swap and the conversion, so the
+ * whole buffer is read and written only once. Large buffers are split
+ * across threads as grey_to_array_parallel().
+ *
+ * @param[in] input integers to convert, aligned to their size.
+ * @param[out] output where to write the converted integers, may be the
+ *             same buffer as \p input, but must not otherwise overlap.
+ * @param[in] bytes size of \p input and \p output in bytes.
+ * @param[in] config width, direction and byte orders.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p config is not
+ *         valid or \p bytes is not a multiple of the width.
+ */
+grey_err_t grey_packed_convert(const void* input, void* output,
+                               size_t bytes,
+                               const grey_packed_config_t* config);
+
+/**
+ * Converts a file of packed integers in place or into another file,
+ * without reading it into a buffer.
+ *
+ * The files are memory-mapped and converted with grey_packed_convert(),
+ * directly in the page cache, with a hint to the kernel that they are
+ * accessed sequentially. The output file is created or truncated. Only
+ * available on POSIX systems.
+ *
+ * @param[in] input path of the file to convert.
+ * @param[in] output path of the file to write, NULL or the same file as
+ *            \p input to convert it in place.
+ * @param[in] config width, direction and byte orders.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p config is not
+ *         valid or the size of \p input is not a multiple of the width,
+ *         #GREY_ERR_RANGE if it does not fit in the address space,
+ *         #GREY_ERR_IO if a file cannot be opened, resized or mapped,
+ *         such as a pipe,
+ *         #GREY_ERR_UNSUPPORTED on systems without memory mapping.
+ */
+grey_err_t grey_packed_convert_file(const char* input, const char* output,
+                                    const grey_packed_config_t* config);
+
+/**
+ * Grey code of the lowest \p bits bits of \p value, ignoring the others.
+ *
+ * @param[in] value binary value (regular integer) to convert.
+ * @param[in] bits width of the code, 1 to 64.
+ * @return the Grey code, with the bits above \p bits cleared.
+ */
+uint64_t grey_to_bits(uint64_t value, unsigned int bits);
+
+/**
+ * Value of the \p bits -wide Grey code in the lowest bits of \p code.
+ *
+ * The bits above \p bits, such as the neighbouring fields of a register,
+ * are ignored: grey_from64() would spread them into the result.
+ *
+ * @param[in] code Grey code to convert.
+ * @param[in] bits width of the code, 1 to 64.
+ * @return the binary value, with the bits above \p bits cleared.
+ */
+uint64_t grey_from_bits(uint64_t code, unsigned int bits);
+
+/** Order of the bits of the fields packed by grey_fields_to() etc. */
+typedef enum
+{
+    /**
+     * Most significant bit of each field first, starting from the most
+     * significant bit of the first byte, as serial encoders send them.
+     */
+    GREY_FIELDS_MSB_FIRST = 0,
+    /**
+     * Least significant bit of each field first, starting from the least
+     * significant bit of the first byte, as C bit-fields on little-endian
+     * CPUs.
+     */
+    GREY_FIELDS_LSB_FIRST = 1,
+} grey_field_order_t;
+
+/** Bytes holding \p amount fields of \p bits bits, packed. */
+#define GREY_FIELDS_BYTES(bits, amount) \
+    (((size_t) (bits) * (size_t) (amount) + 7U) / 8U)
+
+/**
+ * Converts \p bits -wide binary values packed back-to-back, without any
+ * padding, to Grey codes packed the same way.
+ *
+ * The fields are converted in place in the bitstream, 64 bits at a time,
+ * rather than unpacked one by one. The bits of the last byte after the
+ * last field are left untouched in \p codes.
+ *
+ * @param[in] values #GREY_FIELDS_BYTES() bytes of packed values.
+ * @param[out] codes where to write the packed Grey codes, may be the same
+ *             buffer as \p values, but must not otherwise overlap.
+ * @param[in] bits width of each field, 1 to 64.
+ * @param[in] amount number of fields.
+ * @param[in] order of the bits in the stream.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits or \p order
+ *         are out of range.
+ */
+grey_err_t grey_fields_to(const void* values, void* codes, unsigned int bits,
+                          size_t amount, grey_field_order_t order);
+
+/**
+ * Converts \p bits -wide Grey codes packed back-to-back to binary values
+ * packed the same way, see grey_fields_to().
+ *
+ * @param[in] codes #GREY_FIELDS_BYTES() bytes of packed Grey codes.
+ * @param[out] values where to write the packed values, may be the same
+ *             buffer as \p codes, but must not otherwise overlap.
+ * @param[in] bits width of each field, 1 to 64.
+ * @param[in] amount number of fields.
+ * @param[in] order of the bits in the stream.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits or \p order
+ *         are out of range.
+ */
+grey_err_t grey_fields_from(const void* codes, void* values,
+                            unsigned int bits, size_t amount,
+                            grey_field_order_t order);
+
+/**
+ * Unpacks \p bits -wide Grey codes packed back-to-back and converts them
+ * to one 64-bit binary value each.
+ *
+ * @param[in] codes #GREY_FIELDS_BYTES() bytes of packed Grey codes.
+ * @param[out] values where to write \p amount binary values.
+ * @param[in] bits width of each field, 1 to 64.
+ * @param[in] amount number of fields.
+ * @param[in] order of the bits in the stream.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits or \p order
+ *         are out of range.
+ */
+grey_err_t grey_fields_unpack_from(const void* codes, uint64_t* values,
+                                   unsigned int bits, size_t amount,
+                                   grey_field_order_t order);
+
+/**
+ * Converts 64-bit binary values to \p bits -wide Grey codes and packs
+ * them back-to-back. The bits of the values above \p bits are ignored;
+ * the bits of the last byte after the last field are left untouched.
+ *
+ * @param[in] values \p amount binary values to convert.
+ * @param[out] codes where to write #GREY_FIELDS_BYTES() bytes of packed
+ *             Grey codes.
+ * @param[in] bits width of each field, 1 to 64.
+ * @param[in] amount number of fields.
+ * @param[in] order of the bits in the stream.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits or \p order
+ *         are out of range.
+ */
+grey_err_t grey_fields_pack_to(const uint64_t* values, void* codes,
+                               unsigned int bits, size_t amount,
+                               grey_field_order_t order);
+
+/**
+ * Order of the 64-bit words of a multiword value, for grey_to_words() and
+ * grey_from_words(). Each word is in the native byte order.
+ */
+typedef enum
+{
+    /** Least significant word first, at index 0. */
+    GREY_WORDS_LE = 0,
+    /** Most significant word first, at index 0. */
+    GREY_WORDS_BE = 1,
+} grey_word_order_t;
+
+/** Number of 64-bit words holding a multiword value of \p bits bits. */
+#define GREY_WORDS(bits) (((bits) + 63U) / 64U)
+
+/**
+ * Converts a binary unsigned integer of any width, stored as an array of
+ * 64-bit words, to its Grey code.
+ *
+ * Every word is encoded with the lowest bit of its more significant
+ * neighbour shifted in from the top, using the same SIMD kernels as
+ * grey_to_array().
+ *
+ * @param[in] values #GREY_WORDS(\p bits) words of the binary value. The
+ *            bits of the most significant word above \p bits are ignored.
+ * @param[out] codes where to write the #GREY_WORDS(\p bits) words of the
+ *             Grey code, with the bits above \p bits cleared. May be the
+ *             same buffer as \p values, but must not otherwise overlap.
+ * @param[in] bits width of the value in bits. May be 0, in which case the
+ *            pointers are not accessed.
+ * @param[in] order order of the words in both \p values and \p codes.
+ */
+void grey_to_words(const uint64_t* values, uint64_t* codes, size_t bits,
+                   grey_word_order_t order);
+
+/**
+ * Converts a Grey code of any width, stored as an array of 64-bit words,
+ * to its binary unsigned integer.
+ *
+ * Each word is decoded as by the 64-bit kernel of grey_from_array() and
+ * inverted if the parity of all the more significant words is odd, in a
+ * single SIMD pass from the most significant word down.
+ *
+ * @param[in] codes #GREY_WORDS(\p bits) words of the Grey code. The bits
+ *            of the most significant word above \p bits are ignored.
+ * @param[out] values where to write the #GREY_WORDS(\p bits) words of the
+ *             binary value, with the bits above \p bits cleared. May be the
+ *             same buffer as \p codes, but must not otherwise overlap.
+ * @param[in] bits width of the code in bits. May be 0, in which case the
+ *            pointers are not accessed.
+ * @param[in] order order of the words in both \p codes and \p values.
+ */
+void grey_from_words(const uint64_t* codes, uint64_t* values, size_t bits,
+                     grey_word_order_t order);
+
+/** Most bits of each coordinate of the 2-D Hilbert indices. */
+#define GREY_HILBERT_MAX_BITS2 32U
+/** Most bits of each coordinate of the 3-D Hilbert indices. */
+#define GREY_HILBERT_MAX_BITS3 21U
+
+/**
+ * Position along the 2-D Hilbert curve of a point, which keeps close
+ * points close on the curve, e.g. as the key of a spatial index.
+ *
+ * The curve is the one of the algorithm of Skilling, built on Grey codes:
+ * it starts at the origin and ends at `x` = 2^\p bits - 1, `y` = 0. The
+ * index holds at each level, from the most significant one, the bit of
+ * `x` then the bit of `y`. Converts all the levels at once, without a
+ * loop over them.
+ *
+ * @param[in] x first coordinate. The bits above \p bits are ignored.
+ * @param[in] y second coordinate. The bits above \p bits are ignored.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS2.
+ * @return the Hilbert index, of 2 * \p bits bits.
+ */
+uint64_t grey_hilbert_index2(uint32_t x, uint32_t y, unsigned int bits);
+
+/**
+ * Point at a position along the 2-D Hilbert curve, the inverse of
+ * grey_hilbert_index2().
+ *
+ * @param[in] index Hilbert index. The bits above 2 * \p bits are ignored.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS2.
+ * @param[out] x first coordinate.
+ * @param[out] y second coordinate.
+ */
+void grey_hilbert_coords2(uint64_t index, unsigned int bits,
+                          uint32_t* x, uint32_t* y);
+
+/**
+ * Position along the 3-D Hilbert curve of a point, see
+ * grey_hilbert_index2(). Converts 2 levels at a time with a table.
+ *
+ * @param[in] x first coordinate. The bits above \p bits are ignored.
+ * @param[in] y second coordinate. The bits above \p bits are ignored.
+ * @param[in] z third coordinate. The bits above \p bits are ignored.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS3.
+ * @return the Hilbert index, of 3 * \p bits bits.
+ */
+uint64_t grey_hilbert_index3(uint32_t x, uint32_t y, uint32_t z,
+                             unsigned int bits);
+
+/**
+ * Point at a position along the 3-D Hilbert curve, the inverse of
+ * grey_hilbert_index3().
+ *
+ * @param[in] index Hilbert index. The bits above 3 * \p bits are ignored.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS3.
+ * @param[out] x first coordinate.
+ * @param[out] y second coordinate.
+ * @param[out] z third coordinate.
+ */
+void grey_hilbert_coords3(uint64_t index, unsigned int bits,
+                          uint32_t* x, uint32_t* y, uint32_t* z);
+
+/**
+ * Position along the Hilbert curve of a point in any number of
+ * dimensions, the same as grey_hilbert_index2() and grey_hilbert_index3()
+ * in 2 and 3 dimensions.
+ *
+ * @param[in] coords \p dims coordinates of the point. The bits above
+ *            \p bits are ignored.
+ * @param[in] dims number of dimensions, at least 1.
+ * @param[in] bits bits of each coordinate, 1 to 32.
+ * @param[out] index where to write the #GREY_WORDS(\p dims * \p bits)
+ *             words of the index, least significant first, with the bits
+ *             above \p dims * \p bits cleared.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p dims or \p bits
+ *         are out of range, #GREY_ERR_NOMEM if there is no memory for the
+ *         copy of the coordinates of more than 64 dimensions.
+ */
+grey_err_t grey_hilbert_index(const uint32_t* coords, size_t dims,
+                              unsigned int bits, uint64_t* index);
+
+/**
+ * Point at a position along the Hilbert curve in any number of
+ * dimensions, the inverse of grey_hilbert_index().
+ *
+ * @param[in] index #GREY_WORDS(\p dims * \p bits) words of the index,
+ *            least significant first. The bits above \p dims * \p bits
+ *            are ignored.
+ * @param[in] dims number of dimensions, at least 1.
+ * @param[in] bits bits of each coordinate, 1 to 32.
+ * @param[out] coords where to write the \p dims coordinates.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p dims or \p bits
+ *         are out of range.
+ */
+grey_err_t grey_hilbert_coords(const uint64_t* index, size_t dims,
+                               unsigned int bits, uint32_t* coords);
+
+/**
+ * grey_hilbert_index2() of many points, vectorized with the widest
+ * instruction set the CPU supports, see grey_kernel_force().
+ *
+ * @param[in] x first coordinates of the points.
+ * @param[in] y second coordinates of the points.
+ * @param[out] indices where to write the \p amount Hilbert indices.
+ * @param[in] amount number of points.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS2.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits is out of
+ *         range.
+ */
+grey_err_t grey_hilbert_index2_array(const uint32_t* x, const uint32_t* y,
+                                     uint64_t* indices, size_t amount,
+                                     unsigned int bits);
+
+/**
+ * grey_hilbert_coords2() of many indices, see
+ * grey_hilbert_index2_array().
+ *
+ * @param[in] indices Hilbert indices to convert.
+ * @param[out] x where to write the first coordinates of the points.
+ * @param[out] y where to write the second coordinates of the points.
+ * @param[in] amount number of indices.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS2.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits is out of
+ *         range.
+ */
+grey_err_t grey_hilbert_coords2_array(const uint64_t* indices, uint32_t* x,
+                                      uint32_t* y, size_t amount,
+                                      unsigned int bits);
+
+/**
+ * grey_hilbert_index3() of many points, see grey_hilbert_index2_array().
+ *
+ * @param[in] x first coordinates of the points.
+ * @param[in] y second coordinates of the points.
+ * @param[in] z third coordinates of the points.
+ * @param[out] indices where to write the \p amount Hilbert indices.
+ * @param[in] amount number of points.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS3.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits is out of
+ *         range.
+ */
+grey_err_t grey_hilbert_index3_array(const uint32_t* x, const uint32_t* y,
+                                     const uint32_t* z, uint64_t* indices,
+                                     size_t amount, unsigned int bits);
+
+/**
+ * grey_hilbert_coords3() of many indices, see
+ * grey_hilbert_index2_array().
+ *
+ * @param[in] indices Hilbert indices to convert.
+ * @param[out] x where to write the first coordinates of the points.
+ * @param[out] y where to write the second coordinates of the points.
+ * @param[out] z where to write the third coordinates of the points.
+ * @param[in] amount number of indices.
+ * @param[in] bits bits of each coordinate, 1 to #GREY_HILBERT_MAX_BITS3.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p bits is out of
+ *         range.
+ */
+grey_err_t grey_hilbert_coords3_array(const uint64_t* indices, uint32_t* x,
+                                      uint32_t* y, uint32_t* z,
+                                      size_t amount, unsigned int bits);
+
+/**
+ * Converts a number written with digits of different radices, like the
+ * dials of an odometer, to its reflected mixed-radix Grey code: counting
+ * up, one digit at a time changes, by +1 or -1.
+ *
+ * Each digit of the code is the one of the number, or its reflection
+ * `radix - 1 - digit` when the number made by the digits above it is odd.
+ * With all radices 2 it is the binary code of grey_to().
+ *
+ * @param[in] radices radix of each digit, at least 2, least significant
+ *            digit first.
+ * @param[in] digits of the number, each below its radix.
+ * @param[out] codes where to write the digits of the Grey code, may be
+ *             \p digits itself.
+ * @param[in] length number of digits.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if a radix is below 2 or
+ *         a digit is not below its radix.
+ */
+grey_err_t grey_radix_to(const uint32_t* radices, const uint32_t* digits,
+                         uint32_t* codes, size_t length);
+
+/**
+ * Converts a reflected mixed-radix Grey code back to the digits of its
+ * number, the inverse of grey_radix_to().
+ *
+ * @param[in] radices radix of each digit, least significant digit first.
+ * @param[in] codes digits of the Grey code, each below its radix.
+ * @param[out] digits where to write the digits of the number, may be
+ *             \p codes itself.
+ * @param[in] length number of digits.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID as grey_radix_to().
+ */
+grey_err_t grey_radix_from(const uint32_t* radices, const uint32_t* codes,
+                           uint32_t* digits, size_t length);
+
+/**
+ * grey_radix_to() of the number \p value.
+ *
+ * @param[in] value to convert.
+ * @param[in] radices radix of each digit, least significant digit first.
+ * @param[in] length number of digits.
+ * @param[out] codes where to write the \p length digits of the code.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID as grey_radix_to(),
+ *         #GREY_ERR_RANGE if \p value has more digits than \p length.
+ */
+grey_err_t grey_radix_to_u64(uint64_t value, const uint32_t* radices,
+                             size_t length, uint32_t* codes);
+
+/**
+ * grey_radix_from() returning the number as an integer.
+ *
+ * @param[in] radices radix of each digit, least significant digit first.
+ * @param[in] codes digits of the Grey code.
+ * @param[in] length number of digits.
+ * @param[out] value where to write the number.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID as grey_radix_to(),
+ *         #GREY_ERR_RANGE if the number does not fit in 64 bits.
+ */
+grey_err_t grey_radix_from_u64(const uint32_t* radices, const uint32_t* codes,
+                               size_t length, uint64_t* value);
+
+/**
+ * Reflected k-ary Grey code of \p value, the digits of grey_radix_to()
+ * with all radices \p radix packed back into an integer in base \p radix.
+ *
+ * Radices that are powers of 2 convert all the digits at once with shifts
+ * and XORs, as grey_to() does for radix 2. The others digit by digit.
+ *
+ * For radices that are not powers of 2, the values must be below the
+ * largest multiple of the largest power of \p radix that fits in 64 bits,
+ * so that their codes do too (e.g. about 2^63.4 for radix 3); powers of 2
+ * accept any value.
+ *
+ * @param[in] value to convert.
+ * @param[in] radix of the digits, at least 2.
+ * @param[out] code where to write the Grey code.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p radix is below 2,
+ *         #GREY_ERR_RANGE if \p value is too large.
+ */
+grey_err_t grey_kary_to(uint64_t value, uint32_t radix, uint64_t* code);
+
+/**
+ * Value of a reflected k-ary Grey code, the inverse of grey_kary_to().
+ *
+ * @param[in] code to convert.
+ * @param[in] radix of the digits, at least 2.
+ * @param[out] value where to write the value.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p radix is below 2,
+ *         #GREY_ERR_RANGE if \p code is too large, as in grey_kary_to().
+ */
+grey_err_t grey_kary_from(uint64_t code, uint32_t radix, uint64_t* value);
+
+/**
+ * grey_kary_to() of many values. Radix 2 runs the kernels of
+ * grey_to_array64(), the other powers of 2 a loop the compiler
+ * vectorizes.
+ *
+ * @param[in] values to convert.
+ * @param[out] codes where to write the Grey codes, may be \p values.
+ * @param[in] amount of values.
+ * @param[in] radix of the digits, at least 2.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p radix is below 2,
+ *         #GREY_ERR_RANGE if a value is too large, in which case only the
+ *         values before it are converted.
+ */
+grey_err_t grey_kary_to_array(const uint64_t* values, uint64_t* codes,
+                              size_t amount, uint32_t radix);
+
+/**
+ * grey_kary_from() of many codes, see grey_kary_to_array().
+ *
+ * @param[in] codes to convert.
+ * @param[out] values where to write the values, may be \p codes.
+ * @param[in] amount of codes.
+ * @param[in] radix of the digits, at least 2.
+ * @return as grey_kary_to_array().
+ */
+grey_err_t grey_kary_from_array(const uint64_t* codes, uint64_t* values,
+                                size_t amount, uint32_t radix);
+
+/** Most digits of a #grey_radix_iter_t. */
+#define GREY_RADIX_MAX_DIGITS 64U
+
+/**
+ * Iterator over all the reflected mixed-radix Grey codes of some digits,
+ * from all digits 0, one code at a time in O(1) each.
+ *
+ * Follows the loopless algorithm H of Knuth (TAOCP 7.2.1.1): each digit
+ * moves back and forth between 0 and its radix - 1, and the focus
+ * pointers skip at once the digits that have just reached an end, which
+ * wait for a higher digit to step before moving back.
+ */
+typedef struct
+{
+    /** Current digits of the Grey code, least significant first. */
+    uint32_t digits[GREY_RADIX_MAX_DIGITS];
+    /** Radix of each digit. */
+    uint32_t radices[GREY_RADIX_MAX_DIGITS];
+    /** Whether each digit moves down. */
+    bool down[GREY_RADIX_MAX_DIGITS];
+    /** Next digit to step from each one, the focus pointers. */
+    uint8_t focus[GREY_RADIX_MAX_DIGITS + 1U];
+    /** Number of digits. */
+    uint8_t length;
+    /** Index of the digit changed by the last step, #length before. */
+    uint8_t changed;
+    /** Whether the last step decreased the digit, else increased it. */
+    bool decreased;
+} grey_radix_iter_t;
+
+/**
+ * Initialises an iterator to the code with all digits 0.
+ *
+ * @param[out] iter iterator to initialise.
+ * @param[in] radices radix of each digit, at least 2, least significant
+ *            digit first.
+ * @param[in] length number of digits, up to #GREY_RADIX_MAX_DIGITS.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if a radix is below 2 or
+ *         \p length is too large.
+ */
+grey_err_t grey_radix_iter_init(grey_radix_iter_t* iter,
+                                const uint32_t* radices, size_t length);
+
+/**
+ * Moves an initialised iterator to the code of a number, as
+ * grey_radix_to_u64(), from which it steps on as if it had got there one
+ * step at a time.
+ *
+ * @param[in,out] iter iterator to move, whose `changed` field becomes its
+ *                number of digits.
+ * @param[in] value number of the code.
+ * @return #GREY_OK on success, #GREY_ERR_RANGE if \p value does not fit
+ *         in the digits, in which case the iterator does not change.
+ */
+grey_err_t grey_radix_iter_seek(grey_radix_iter_t* iter, uint64_t value);
+
+/**
+ * Steps the iterator to the next code, changing one digit by 1, in O(1).
+ *
+ * @param[in,out] iter iterator to step, which also gets the index of the
+ *                changed digit in its `changed` field.
+ * @return false without changing the digits if the current code was the
+ *         last one, else true.
+ */
+static inline bool grey_radix_iter_next(grey_radix_iter_t* const iter)
+{
+    const uint8_t index = iter->focus[0];
+    if (index == iter->length)
+    {
+        return false;
+    }
+    iter->focus[0] = 0;
+    iter->changed = index;
+    iter->decreased = iter->down[index];
+    if (iter->down[index])
+    {
+        iter->digits[index]--;
+    }
+    else
+    {
+        iter->digits[index]++;
+    }
+    if (iter->digits[index] == 0U
+        || iter->digits[index] == iter->radices[index] - 1U)
+    {
+        /* At an end: turns around, but waits for a higher digit to step */
+        iter->down[index] = !iter->down[index];
+        iter->focus[index] = iter->focus[index + 1U];
+        iter->focus[index + 1U] = (uint8_t) (index + 1U);
+    }
+    return true;
+}
+
+/**
+ * Number of k-subsets of an n-set, the binomial coefficient (n k).
+ *
+ * @param[in] n size of the set.
+ * @param[in] k size of the subsets.
+ * @param[out] count where to write the number of subsets.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p k is larger than
+ *         \p n, #GREY_ERR_RANGE if the count does not fit in 64 bits,
+ *         which never happens for \p n up to 64.
+ */
+grey_err_t grey_subset_count(uint32_t n, uint32_t k, uint64_t* count);
+
+/**
+ * Rank of a k-subset of an n-set in the revolving-door order of
+ * #grey_subset_iter_t, from 0 for the subset {0, 1, ..., k - 1}.
+ *
+ * The order is the combinatorial Grey code in which the subsets without
+ * the element n - 1 come first, in the same order for the (n - 1)-set,
+ * followed by the ones with it, in reverse order. So the rank takes a step
+ * per element, in O(n).
+ *
+ * @param[in] elements of the subset, increasing, each below \p n.
+ * @param[in] n size of the set.
+ * @param[in] k size of the subset.
+ * @param[out] rank where to write the rank.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p k is larger than
+ *         \p n or the elements are not increasing and below \p n,
+ *         #GREY_ERR_RANGE if the number of subsets does not fit in 64 bits.
+ */
+grey_err_t grey_subset_rank(const uint32_t* elements, uint32_t n, uint32_t k,
+                            uint64_t* rank);
+
+/**
+ * k-subset of an n-set with a rank, the inverse of grey_subset_rank().
+ *
+ * @param[in] rank of the subset, below grey_subset_count().
+ * @param[in] n size of the set.
+ * @param[in] k size of the subset.
+ * @param[out] elements where to write the \p k elements, increasing.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p k is larger than
+ *         \p n, #GREY_ERR_RANGE if \p rank is too large or the number of
+ *         subsets does not fit in 64 bits.
+ */
+grey_err_t grey_subset_unrank(uint64_t rank, uint32_t n, uint32_t k,
+                              uint32_t* elements);
+
+/**
+ * grey_subset_rank() of a subset of a set of up to 64 elements, given as
+ * the bitmask of its elements, with k its number of bits.
+ *
+ * @param[in] mask of the elements of the subset, below bit \p n.
+ * @param[in] n size of the set, up to 64.
+ * @param[out] rank where to write the rank.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p n is larger than 64
+ *         or \p mask has bits from \p n up.
+ */
+grey_err_t grey_subset_rank_mask(uint64_t mask, uint32_t n, uint64_t* rank);
+
+/**
+ * grey_subset_unrank() writing the subset as the bitmask of its elements.
+ *
+ * @param[in] rank of the subset, below grey_subset_count().
+ * @param[in] n size of the set, up to 64.
+ * @param[in] k size of the subset.
+ * @param[out] mask where to write the bitmask of the subset.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p n is larger than 64
+ *         or \p k is larger than \p n, #GREY_ERR_RANGE if \p rank is too
+ *         large.
+ */
+grey_err_t grey_subset_unrank_mask(uint64_t rank, uint32_t n, uint32_t k,
+                                   uint64_t* mask);
+
+/**
+ * Iterator over the k-subsets of an n-set in revolving-door order, where
+ * each subset differs from the previous one by one element leaving and
+ * another one joining.
+ *
+ * Follows the algorithm R of Knuth (TAOCP 7.2.1.3), which moves the lowest
+ * element able to: up by 1 when k minus its index is odd, else down by 1,
+ * and the element below it to the other end of its range. Only the
+ * moved elements and the one below them can change whether they are
+ * able to move, and the next element able to is never more than 2 above
+ * the moved one, so the iterator keeps its index and finds the next one
+ * among 5 candidates, loopless, in O(1) each step. The subsets are kept
+ * as arrays of elements of any n, and also as bitmasks for n up to 64.
+ *
+ * To split the subsets across threads, position an iterator per thread
+ * with grey_subset_iter_seek() at the ranks starting their shares.
+ */
+typedef struct
+{
+    /**
+     * Elements of the current subset, increasing, followed by n: the
+     * k + 1 entries given to grey_subset_iter_init().
+     */
+    uint32_t* elements;
+    /** Bitmask of the elements of the current subset, if n is up to 64. */
+    uint64_t mask;
+    /** Size of the set. */
+    uint32_t n;
+    /** Size of the subsets. */
+    uint32_t k;
+    /** Element which left the subset at the last step, n before. */
+    uint32_t left;
+    /** Element which joined the subset at the last step, n before. */
+    uint32_t joined;
+    /** Index in #elements of the one to move at the next step, k if none. */
+    uint32_t focus;
+} grey_subset_iter_t;
+
+/**
+ * Initialises an iterator to the first subset, {0, 1, ..., k - 1}.
+ *
+ * @param[out] iter iterator to initialise.
+ * @param[in] n size of the set, below `UINT32_MAX`.
+ * @param[in] k size of the subsets.
+ * @param[in] elements where to keep the current subset, of \p k + 1
+ *            entries, valid as long as the iterator is used.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p k is larger than
+ *         \p n, \p n is `UINT32_MAX` or \p elements is NULL.
+ */
+grey_err_t grey_subset_iter_init(grey_subset_iter_t* iter, uint32_t n,
+                                 uint32_t k, uint32_t* elements);
+
+/**
+ * Moves an iterator to the subset with a rank, as grey_subset_unrank().
+ *
+ * @param[in,out] iter iterator to move, whose `left` and `joined` fields
+ *                become n.
+ * @param[in] rank of the subset.
+ * @return #GREY_OK on success, #GREY_ERR_RANGE if \p rank is too large or
+ *         the number of subsets does not fit in 64 bits.
+ */
+grey_err_t grey_subset_iter_seek(grey_subset_iter_t* iter, uint64_t rank);
+
+/**
+ * Whether the element at \p index of the current subset of an iterator is
+ * able to move, when all the ones below it are not.
+ */
+static inline bool grey_subset_iter_movable(
+        const grey_subset_iter_t* const iter, const uint32_t index)
+{
+    const uint32_t* const c = iter->elements;
+    if (((iter->k - index) & 1U) != 0U)
+    {
+        return c[index] + 1U < c[index + 1U];
+    }
+    return c[index] > index;
+}
+
+/**
+ * Steps the iterator to the next subset, in O(1).
+ *
+ * @param[in,out] iter iterator to step, which also gets the element which
+ *                left the subset and the one which joined it in its
+ *                `left` and `joined` fields.
+ * @return false without changing the subset if it was the last one, else
+ *         true.
+ */
+static inline bool grey_subset_iter_next(grey_subset_iter_t* const iter)
+{
+    uint32_t* const c = iter->elements;
+    const uint32_t k = iter->k;
+    const uint32_t j = iter->focus;
+    if (j >= k)
+    {
+        return false;
+    }
+    if (((k - j) & 1U) != 0U)
+    {
+        /* Up: c[j - 1] is j - 1, it leaves, c[j] + 1 joins above */
+        iter->left = (j == 0U) ? c[0] : c[j - 1U];
+        if (j > 0U)
+        {
+            c[j - 1U] = c[j];
+        }
+        c[j]++;
+        iter->joined = c[j];
+    }
+    else
+    {
+        /* Down: c[j - 1] is c[j] - 1, c[j] leaves, j - 1 joins below */
+        iter->left = c[j];
+        if (j == 0U)
+        {
+            c[0]--;
+        }
+        else
+        {
+            c[j] = c[j - 1U];
+            c[j - 1U] = j - 1U;
+        }
+        iter->joined = (j == 0U) ? c[0] : j - 1U;
+    }
+    if (iter->n <= 64U)
+    {
+        iter->mask ^= (UINT64_C(1) << iter->left)
+                      | (UINT64_C(1) << iter->joined);
+    }
+    /* The ones below j - 2 still cannot move, the next is up to j + 2 */
+    const uint32_t last = (k - j > 3U) ? j + 3U : k;
+    uint32_t next = (j > 2U) ? j - 2U : 0U;
+    while (next < last && !grey_subset_iter_movable(iter, next))
+    {
+        next++;
+    }
+    iter->focus = (next == last) ? k : next;
+    return true;
+}
+
+/** Most elements of a #grey_perm_iter_t. */
+#define GREY_PERM_MAX_LENGTH 64U
+
+/**
+ * Iterator over all the permutations of n elements in the plain changes
+ * order of Steinhaus, Johnson and Trotter, where each permutation differs
+ * from the previous one by two adjacent elements swapped.
+ *
+ * The largest element sweeps across the others, one swap per step, and
+ * at each end of its sweep the next smaller element able to move steps
+ * by one. So the moves made by each element in its current sweep are the
+ * digits of a reflected mixed-radix Grey code, with the element i having
+ * radix i + 1: the iterator steps them with a #grey_radix_iter_t, whose
+ * focus pointers find the element to move in O(1) at every step, without
+ * loops, as in Even's speedup.
+ *
+ * To split the permutations across threads, position an iterator per
+ * thread with grey_perm_iter_seek() at the ranks starting their shares.
+ */
+typedef struct
+{
+    /**
+     * Moves of each element in its current sweep, also the number of
+     * smaller elements after it: digit i is the one of the element
+     * n - 1 - i.
+     */
+    grey_radix_iter_t moves;
+    /** Current permutation of the elements 0 to n - 1. */
+    uint8_t elements[GREY_PERM_MAX_LENGTH];
+    /** Position of each element in #elements. */
+    uint8_t positions[GREY_PERM_MAX_LENGTH];
+    /** Number of elements, n. */
+    uint8_t length;
+    /**
+     * Lower position of the two swapped by the last step, so the swapped
+     * elements are now at `swapped` and `swapped + 1`; #length before.
+     */
+    uint8_t swapped;
+} grey_perm_iter_t;
+
+/**
+ * Initialises an iterator to the identity permutation, 0, 1, ..., n - 1.
+ *
+ * @param[out] iter iterator to initialise.
+ * @param[in] length number of elements, up to #GREY_PERM_MAX_LENGTH.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p length is too
+ *         large.
+ */
+grey_err_t grey_perm_iter_init(grey_perm_iter_t* iter, size_t length);
+
+/**
+ * Moves an iterator to the permutation with a rank, as grey_perm_unrank().
+ *
+ * @param[in,out] iter iterator to move, whose `swapped` field becomes its
+ *                number of elements.
+ * @param[in] rank of the permutation.
+ * @return #GREY_OK on success, #GREY_ERR_RANGE if \p rank is not below n!,
+ *         in which case the iterator does not change.
+ */
+grey_err_t grey_perm_iter_seek(grey_perm_iter_t* iter, uint64_t rank);
+
+/**
+ * Steps the iterator to the next permutation, swapping two adjacent
+ * elements, in O(1).
+ *
+ * @param[in,out] iter iterator to step, which also gets the lower position
+ *                of the swapped elements in its `swapped` field.
+ * @return false without changing the permutation if it was the last one,
+ *         else true.
+ */
+static inline bool grey_perm_iter_next(grey_perm_iter_t* const iter)
+{
+    if (!grey_radix_iter_next(&iter->moves))
+    {
+        return false;
+    }
+    /* An element moves towards the start while its digit increases */
+    const uint8_t element = (uint8_t) (iter->length - 1U
+                                       - iter->moves.changed);
+    const uint8_t from = iter->positions[element];
+    const uint8_t to = iter->moves.decreased ? (uint8_t) (from + 1U)
+                                             : (uint8_t) (from - 1U);
+    const uint8_t other = iter->elements[to];
+    iter->elements[to] = element;
+    iter->elements[from] = other;
+    iter->positions[element] = to;
+    iter->positions[other] = from;
+    iter->swapped = iter->moves.decreased ? from : to;
+    return true;
+}
+
+/**
+ * Rank of a permutation of n elements in the plain changes order of
+ * #grey_perm_iter_t, from 0 for the identity.
+ *
+ * It is the number whose reflected mixed-radix Grey code, see
+ * grey_radix_from_u64(), has as digits the counts of smaller elements
+ * after each element, the largest one first, in O(n^2).
+ *
+ * @param[in] elements permutation of the integers 0 to \p length - 1.
+ * @param[in] length number of elements, up to #GREY_PERM_MAX_LENGTH.
+ * @param[out] rank where to write the rank.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p elements is not a
+ *         permutation or \p length is too large, #GREY_ERR_RANGE if the
+ *         rank does not fit in 64 bits, which happens from 21 elements.
+ */
+grey_err_t grey_perm_rank(const uint8_t* elements, size_t length,
+                          uint64_t* rank);
+
+/**
+ * Permutation of n elements with a rank, the inverse of grey_perm_rank().
+ *
+ * @param[in] rank of the permutation, below \p length!.
+ * @param[in] length number of elements, up to #GREY_PERM_MAX_LENGTH.
+ * @param[out] elements where to write the permutation of the integers 0
+ *             to \p length - 1.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p length is too
+ *         large, #GREY_ERR_RANGE if \p rank is too large.
+ */
+grey_err_t grey_perm_unrank(uint64_t rank, size_t length, uint8_t* elements);
+
+/**
+ * Number of set bits of \p x.
+ *
+ * On x86 without the `POPCNT` instruction the builtin is a library call,
+ * so the bits are counted in parallel in the register instead, which the
+ * compiler can also vectorize.
+ */
+static inline uint_fast8_t grey_inline_popcount64(const uint64_t x)
+{
+#if defined(__GNUC__) \
+    && (defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__)))
+    return (uint_fast8_t) __builtin_popcountll(x);
+#else
+    uint64_t counts = x - ((x >> 1U) & UINT64_C(0x5555555555555555));
+    counts = (counts & UINT64_C(0x3333333333333333))
+             + ((counts >> 2U) & UINT64_C(0x3333333333333333));
+    counts = (counts + (counts >> 4U)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    /* Sum of the byte counts, in the top byte */
+    return (uint_fast8_t) ((counts * UINT64_C(0x0101010101010101)) >> 56U);
+#endif
+}
+
+/**
+ * Hamming distance of two Grey codes: the number of bits they differ in.
+ *
+ * Adjacent values have codes at distance 1, so codes close in Hamming
+ * distance are what a noisy reading of a Grey-coded sensor or a
+ * similarity lookup on Grey-coded features is likely to hit.
+ *
+ * @param[in] a Grey code
+ * @param[in] b Grey code
+ * @return the distance, from 0 to #GREY_UINTBITS.
+ */
+static inline uint_fast8_t grey_distance(const grey_code_t a,
+                                         const grey_code_t b)
+{
+    return grey_inline_popcount64((uint64_t) (a ^ b));
+}
+
+/**
+ * Hamming distances of one Grey code to many, as grey_distance().
+ *
+ * Runs the kernel of the instruction set selected with
+ * grey_kernel_force(), counting the bits of whole vectors at once:
+ * a bit-slice count in SSE2, a table of nibble counts looked up with a
+ * byte shuffle in AVX2 and AVX-512, or the `VPOPCNT` instructions of
+ * AVX-512 when the CPU has them.
+ *
+ * @param[in] query Grey code to measure from.
+ * @param[in] codes Grey codes to measure to.
+ * @param[out] distances where to write the \p amount distances.
+ * @param[in] amount number of codes.
+ */
+void grey_distances(grey_code_t query, const grey_code_t* codes,
+                    uint8_t* distances, size_t amount);
+
+/**
+ * Hamming distances of many Grey codes to many, as grey_distances() of
+ * each query.
+ *
+ * The \p codes are scanned in tiles that stay in the L1 cache while all
+ * the queries are measured against them.
+ *
+ * @param[in] queries Grey codes to measure from.
+ * @param[in] queries_amount number of queries.
+ * @param[in] codes Grey codes to measure to.
+ * @param[in] amount number of codes.
+ * @param[out] distances where to write the `queries_amount * amount`
+ *             distances, row by row: the one of `queries[q]` to
+ *             `codes[i]` at `distances[q * amount + i]`.
+ */
+void grey_distances_many(const grey_code_t* queries, size_t queries_amount,
+                         const grey_code_t* codes, size_t amount,
+                         uint8_t* distances);
+
+/*
+ * Fixed-width variants of the distance functions, all available in the
+ * same build regardless of #GREY_UINTBITS.
+ */
+/** grey_distances() of 8-bit codes. */
+void grey_distances8(uint8_t query, const uint8_t* codes,
+                     uint8_t* distances, size_t amount);
+/** grey_distances() of 16-bit codes. */
+void grey_distances16(uint16_t query, const uint16_t* codes,
+                      uint8_t* distances, size_t amount);
+/** grey_distances() of 32-bit codes. */
+void grey_distances32(uint32_t query, const uint32_t* codes,
+                      uint8_t* distances, size_t amount);
+/** grey_distances() of 64-bit codes. */
+void grey_distances64(uint64_t query, const uint64_t* codes,
+                      uint8_t* distances, size_t amount);
+/** grey_distances_many() of 8-bit codes. */
+void grey_distances_many8(const uint8_t* queries, size_t queries_amount,
+                          const uint8_t* codes, size_t amount,
+                          uint8_t* distances);
+/** grey_distances_many() of 16-bit codes. */
+void grey_distances_many16(const uint16_t* queries, size_t queries_amount,
+                           const uint16_t* codes, size_t amount,
+                           uint8_t* distances);
+/** grey_distances_many() of 32-bit codes. */
+void grey_distances_many32(const uint32_t* queries, size_t queries_amount,
+                           const uint32_t* codes, size_t amount,
+                           uint8_t* distances);
+/** grey_distances_many() of 64-bit codes. */
+void grey_distances_many64(const uint64_t* queries, size_t queries_amount,
+                           const uint64_t* codes, size_t amount,
+                           uint8_t* distances);
+
+/**
+ * Iterator over the Hamming ball around a Grey code: all the codes at
+ * distance up to a radius from it, without allocating.
+ *
+ * The codes come by increasing distance, the center first, and at each
+ * distance by increasing mask of flipped bits, each mask generated from
+ * the previous one in O(1) with Gosper's hack. A ball of radius `r` holds
+ * the sum of the binomial coefficients `C(GREY_UINTBITS, d)` for `d` from
+ * 0 to `r` codes.
+ */
+typedef struct
+{
+    /** Center of the ball. */
+    grey_code_t center;
+    /** Bits flipped in the next code. */
+    grey_code_t flips;
+    /** Distance of the next code, above #radius when all were returned. */
+    uint8_t distance;
+    /** Largest distance of the codes. */
+    uint8_t radius;
+} grey_ball_iter_t;
+
+/**
+ * Initialises an iterator over the codes at distance up to \p radius from
+ * \p center, to return \p center first.
+ *
+ * @param[out] iter iterator to initialise.
+ * @param[in] center Grey code at the center of the ball.
+ * @param[in] radius largest distance, up to #GREY_UINTBITS.
+ * @return #GREY_OK on success, #GREY_ERR_INVALID if \p radius is too
+ *         large.
+ */
+grey_err_t grey_ball_iter_init(grey_ball_iter_t* iter, grey_code_t center,
+                               unsigned int radius);
+
+/**
+ * Gets the next code of the ball, in O(1).
+ *
+ * @param[in,out] iter iterator to step.
+ * @param[out] code where to write the code.
+ * @return false without writing \p code if all the codes were returned,
+ *         else true.
+ */
+static inline bool grey_ball_iter_next(grey_ball_iter_t* const iter,
+                                       grey_code_t* const code)
+{
+    if (iter->distance > iter->radius)
+    {
+        return false;
+    }
+    *code = (grey_code_t) (iter->center ^ iter->flips);
+    /* Next mask with as many bits: moves the lowest block of ones */
+    const grey_code_t flips = iter->flips;
+    const grey_code_t moved = (grey_code_t) (flips + (flips & (0U - flips)));
+    if (moved != 0U)
+    {
+        const grey_code_t rest = (grey_code_t) ((flips ^ moved) >> 2U);
+        iter->flips = (grey_code_t) (
+                moved | (rest >> grey_inline_ctz64(flips)));
+    }
+    else
+    {
+        /* The ones are all at the top, or there are none: one bit more */
+        iter->distance++;
+        iter->flips = 0;
+        if (iter->distance <= GREY_UINTBITS)
+        {
+            iter->flips = (grey_code_t) (
+                    GREY_MAX >> (GREY_UINTBITS - iter->distance));
+        }
+    }
+    return true;
+}
+
+/**
+ * Writes the next codes of the ball, as many calls of
+ * grey_ball_iter_next().
+ *
+ * @param[in,out] iter iterator to step.
+ * @param[out] codes where to write the codes.
+ * @param[in] max largest number of codes to write.
+ * @return the number of codes written, less than \p max only when all the
+ *         codes were returned.
+ */
+size_t grey_ball_iter_fill(grey_ball_iter_t* iter, grey_code_t* codes,
+                           size_t max);
+
+/**
+ * Writes the Grey codes of consecutive values, counting up.
+ *
+ * Equivalent to `out[i] = grey_to(start + i)`, wrapping around after
+ * #GREY_MAX, but the values are generated and encoded in SIMD registers.
+ * Use grey_iter_next() instead to walk the sequence one code at a time.
+ *
+ * @param[in] start value of the first code
+ * @param[in] count number of codes to write. May be 0, in which case
+ *            \p out is not accessed.
+ * @param[out] out where to write \p count Grey codes.
+ */
+void grey_fill_range(grey_int_t start, size_t count, grey_code_t* out);
+
+/**
+ * Writes the Grey codes of consecutive values, counting down.
+ *
+ * Equivalent to `out[i] = grey_to(start - i)`, wrapping around below 0,
+ * see grey_fill_range().
+ *
+ * @param[in] start value of the first code
+ * @param[in] count number of codes to write. May be 0, in which case
+ *            \p out is not accessed.
+ * @param[out] out where to write \p count Grey codes.
+ */
+void grey_fill_range_down(grey_int_t start, size_t count, grey_code_t* out);
+
+/*
+ * Fixed-width variants of the sequence generators, all available in the
+ * same build regardless of #GREY_UINTBITS.
+ */
+/** grey_fill_range() of 8-bit codes. */
+void grey_fill_range8(uint8_t start, size_t count, uint8_t* out);
+/** grey_fill_range_down() of 8-bit codes. */
+void grey_fill_range_down8(uint8_t start, size_t count, uint8_t* out);
+/** grey_fill_range() of 16-bit codes. */
+void grey_fill_range16(uint16_t start, size_t count, uint16_t* out);
+/** grey_fill_range_down() of 16-bit codes. */
+void grey_fill_range_down16(uint16_t start, size_t count, uint16_t* out);
+/** grey_fill_range() of 32-bit codes. */
+void grey_fill_range32(uint32_t start, size_t count, uint32_t* out);
+/** grey_fill_range_down() of 32-bit codes. */
+void grey_fill_range_down32(uint32_t start, size_t count, uint32_t* out);
+/** grey_fill_range() of 64-bit codes. */
+void grey_fill_range64(uint64_t start, size_t count, uint64_t* out);
+/** grey_fill_range_down() of 64-bit codes. */
+void grey_fill_range_down64(uint64_t start, size_t count, uint64_t* out);
+
+/**
+ * Sorts an array of Grey codes by their binary values, ascending.
+ *
+ * The codes are decoded once with the bulk kernel of grey_from_array(),
+ * sorted with a stable LSD radix sort on 8-bit digits, skipping the digits
+ * all values have in common, then encoded back once with the one of
+ * grey_to_array(). Use grey_cmp() instead for comparison-based algorithms.
+ *
+ * @param[in,out] codes Grey codes to sort
+ * @param[in] amount number of elements in \p codes (and \p payload).
+ * @param[in,out] payload optional array of \p amount elements of
+ *                \p payload_size bytes each, permuted like \p codes, so
+ *                that element `i` still belongs to `codes[i]`. NULL to
+ *                sort only the codes.
+ * @param[in] payload_size size in bytes of each element of \p payload.
+ * @return #GREY_OK on success, #GREY_ERR_NOMEM if the scratch buffers
+ *         could not be allocated, in which case the arrays are unchanged.
+ */
+grey_err_t grey_sort(grey_code_t* codes, size_t amount,
+                     void* payload, size_t payload_size);
+
+/*
+ * Fixed-width variants of grey_sort(), all available in the same build
+ * regardless of #GREY_UINTBITS.
+ */
+/** grey_sort() of 8-bit codes. */
+grey_err_t grey_sort8(uint8_t* codes, size_t amount,
+                      void* payload, size_t payload_size);
+/** grey_sort() of 16-bit codes. */
+grey_err_t grey_sort16(uint16_t* codes, size_t amount,
+                       void* payload, size_t payload_size);
+/** grey_sort() of 32-bit codes. */
+grey_err_t grey_sort32(uint32_t* codes, size_t amount,
+                       void* payload, size_t payload_size);
+/** grey_sort() of 64-bit codes. */
+grey_err_t grey_sort64(uint64_t* codes, size_t amount,
+                       void* payload, size_t payload_size);
+
+/**
+ * Selects which kernel the bulk conversion functions use.
+ *
+ * By default, when the library is loaded it checks the CPU features once
+ * and picks the fastest supported kernel, so a single binary runs on any
+ * CPU of the architecture and still uses its widest vectors. The
+ * `GREY_KERNEL` environment variable (`scalar`, `sse2`, `avx2`, `avx512`),
+ * read at the same time, forces a specific one instead, e.g. for testing
+ * or to use the carry-less multiplication ones (`pclmul`, `vpclmul`) or
+ * the lookup table ones (`lut`). Set it to `tune` to run
+ * grey_kernel_tune() instead.
+ *
+ * @warning Not thread-safe: call it before other threads start converting.
+ * @param[in] kernel kernel to use from now on, #GREY_KERNEL_AUTO to go back
+ *            to the fastest one.
+ * @return #GREY_OK on success, #GREY_ERR_UNSUPPORTED if the CPU or the
+ *         build does not support \p kernel, in which case the kernel in
+ *         use does not change.
+ */
+grey_err_t grey_kernel_force(grey_kernel_t kernel);
+
+/**
+ * Tells which kernel the bulk conversion functions are currently using.
+ *
+ * @return the kernel in use, never #GREY_KERNEL_AUTO.
+ */
+grey_kernel_t grey_kernel_active(void);
+
+/**
+ * Times the conversion kernels on this CPU and makes the fastest one of
+ * each width and direction the one grey_to_array(), grey_from_array() and
+ * their variants use.
+ *
+ * The tuning starts from the fastest kernel, as with #GREY_KERNEL_AUTO,
+ * which keeps all the other functions and is what grey_kernel_active()
+ * tells. Then each kernel the CPU supports converts a buffer of a few
+ * KiB, in both directions at every width, for a fraction of a
+ * millisecond: it takes a few tens of milliseconds in total. Calling
+ * grey_kernel_force() undoes it.
+ *
+ * @warning Not thread-safe: call it before other threads start converting.
+ * @return #GREY_OK on success, #GREY_ERR_NOMEM if the buffer could not be
+ *         allocated, #GREY_ERR_UNSUPPORTED if the processor time of
+ *         `clock()` is not available, in which case the kernels in use do
+ *         not change.
+ */
+grey_err_t grey_kernel_tune(void);
+
+/**
+ * Tells which kernel converts the codes of a width, which after
+ * grey_kernel_tune() may differ from grey_kernel_active().
+ *
+ * @param[in] bits width of the codes: 8, 16, 32 or 64.
+ * @param[in] decode true for the decoding kernel of grey_from_array(),
+ *            false for the encoding one of grey_to_array().
+ * @return the kernel in use, #GREY_KERNEL_AUTO for other widths.
+ */
+grey_kernel_t grey_kernel_active_width(unsigned int bits, bool decode);
+
+/**
+ * Human-readable lowercase name of a kernel, as accepted by the
+ * `GREY_KERNEL` environment variable, e.g. `"avx2"`.
+ *
+ * @param[in] kernel kernel to name
+ * @return null-terminated static string, `"unknown"` for invalid values.
+ */
+const char* grey_kernel_name(grey_kernel_t kernel);
+
+/**
+ * Groups of bulk functions counted separately by the runtime counters of
+ * the `GREY_STATS` builds, see grey_stats_snapshot().
+ */
+typedef enum
+{
+    /** grey_to_array() and all its single-threaded variants. */
+    GREY_STATS_TO_ARRAY = 0,
+    /** grey_from_array() and all its single-threaded variants. */
+    GREY_STATS_FROM_ARRAY = 1,
+    /** grey_fill_range() and grey_fill_range_down() at all widths. */
+    GREY_STATS_FILL_RANGE = 2,
+    /** grey_to_words(). */
+    GREY_STATS_WORDS_TO = 3,
+    /** grey_from_words(). */
+    GREY_STATS_WORDS_FROM = 4,
+    /** grey_hilbert_index2_array() and the other 3 Hilbert array ones. */
+    GREY_STATS_HILBERT = 5,
+    /** grey_distances() and grey_distances_many() at all widths. */
+    GREY_STATS_DISTANCES = 6,
+    /**
+     * grey_to_array_parallel() at all widths, once per call with the
+     * kernel of its threads, however many chunks they split it into.
+     */
+    GREY_STATS_PARALLEL_TO = 7,
+    /** grey_from_array_parallel() at all widths, as #GREY_STATS_PARALLEL_TO. */
+    GREY_STATS_PARALLEL_FROM = 8,
+    /**
+     * grey_packed_convert() and grey_packed_convert_file() encoding, as
+     * #GREY_STATS_PARALLEL_TO.
+     */
+    GREY_STATS_PACKED_TO = 9,
+    /** grey_packed_convert() and its file variant decoding. */
+    GREY_STATS_PACKED_FROM = 10,
+} grey_stats_api_t;
+
+/** Amount of #grey_stats_api_t groups. */
+#define GREY_STATS_APIS 11U
+/** Amount of #grey_kernel_t kernels, #GREY_KERNEL_AUTO included. */
+#define GREY_STATS_KERNELS 8U
+/**
+ * Amount of buckets of the call size histogram: bucket 0 counts the calls
+ * with no elements, bucket `b` the ones with `[2^(b-1), 2^b)` elements.
+ */
+#define GREY_STATS_BUCKETS 65U
+
+/**
+ * Runtime counters of the bulk functions, summed over all threads.
+ *
+ * The elements are the ones of the function arguments, e.g. the codes of
+ * grey_to_array() or the distances of grey_distances_many(), the bytes
+ * the ones the kernels read and write. The cycles are the ones of the
+ * time stamp counter, of the calls sampled as set with
+ * grey_stats_sample_cycles().
+ */
+typedef struct
+{
+    /** Calls of each group made with each kernel. */
+    uint64_t calls[GREY_STATS_APIS][GREY_STATS_KERNELS];
+    /** Elements processed by each group with each kernel. */
+    uint64_t elements[GREY_STATS_APIS][GREY_STATS_KERNELS];
+    /** Bytes read and written by each group with each kernel. */
+    uint64_t bytes[GREY_STATS_APIS][GREY_STATS_KERNELS];
+    /** Calls of each group by their amount of elements. */
+    uint64_t sizes[GREY_STATS_APIS][GREY_STATS_BUCKETS];
+    /** Calls of each group whose cycles were counted. */
+    uint64_t sampled_calls[GREY_STATS_APIS];
+    /** Elements processed by the sampled calls of each group. */
+    uint64_t sampled_elements[GREY_STATS_APIS];
+    /** Cycles taken by the sampled calls of each group. */
+    uint64_t cycles[GREY_STATS_APIS];
+} grey_stats_t;
+
+/**
+ * Reads the runtime counters of the bulk functions, counted since the
+ * start or the last grey_stats_reset().
+ *
+ * Only the library built with `GREY_STATS` defined (the CMake option of
+ * the same name) has them: each thread counts its calls in its own
+ * counters, without locks nor atomic read-modify-write operations, which
+ * this function sums up. Without it the bulk functions compile exactly
+ * as they would without counters.
+ *
+ * @warning Safe while other threads convert, whose calls ending meanwhile
+ *          may or may not be counted, but not with another
+ *          grey_stats_snapshot() or grey_stats_reset() at the same time.
+ * @param[out] stats where to write the counters
+ * @return #GREY_OK on success, #GREY_ERR_UNSUPPORTED if the library was
+ *         built without `GREY_STATS`.
+ */
+grey_err_t grey_stats_snapshot(grey_stats_t* stats);
+
+/**
+ * Restarts all the runtime counters of grey_stats_snapshot() from 0.
+ *
+ * @warning Same thread-safety as grey_stats_snapshot().
+ * @return #GREY_OK on success, #GREY_ERR_UNSUPPORTED if the library was
+ *         built without `GREY_STATS`.
+ */
+grey_err_t grey_stats_reset(void);
+
+/**
+ * Makes every thread count the cycles of one of every \p period calls of
+ * the bulk functions, reading the time stamp counter before and after.
+ *
+ * @param[in] period calls per sampled call, 1 to sample them all, 0 to
+ *            stop sampling, which is the default.
+ * @return #GREY_OK on success, #GREY_ERR_UNSUPPORTED if the library was
+ *         built without `GREY_STATS` or, for a non-zero \p period, the
+ *         processor has no time stamp counter (only x86 has one).
+ */
+grey_err_t grey_stats_sample_cycles(uint32_t period);
+
+/**
+ * Human-readable lowercase name of a group of bulk functions, as used in
+ * grey_stats_json(), e.g. `"to_array"`.
+ *
+ * @param[in] api group to name
+ * @return null-terminated static string, `"unknown"` for invalid values.
+ */
+const char* grey_stats_api_name(grey_stats_api_t api);
+
+/**
+ * Writes the runtime counters as a JSON object, with the groups and
+ * kernels which were called only.
+ *
+ * Each group has its totals, its counters per kernel, named like
+ * grey_kernel_name(), and its call size histogram, each bucket named by
+ * its smallest size, plus its sampled cycles if any:
+ *
+ * ```json
+ * {"to_array": {"calls": 2, "elements": 3000, "bytes": 48000,
+ *   "kernels": {"avx2": {"calls": 2, "elements": 3000, "bytes": 48000}},
+ *   "sizes": {"512": 1, "2048": 1},
+ *   "cycles": {"calls": 1, "elements": 1000, "cycles": 812}}}
+ * ```
+ *
+ * Like `snprintf()`, it writes at most \p size characters, the
+ * null-terminator included, and returns the length of the whole JSON, so
+ * a return value not smaller than \p size means it was truncated.
+ *
+ * @param[in] stats counters, e.g. from grey_stats_snapshot()
+ * @param[out] buffer where to write the JSON, may be NULL if \p size is 0
+ * @param[in] size capacity of \p buffer in characters
+ * @return the length of the JSON, without null-terminator.
+ */
+size_t grey_stats_json(const grey_stats_t* stats, char* buffer, size_t size);
+
+/**
+ * @property GREY_NO_GENERIC
+ * Define it before including this header to disable the C11 `_Generic`
+ * front-end.
+ *
+ * In C11 and later, grey_to(), grey_from(), grey_binstr(),
+ * grey_binstr_fixed(), grey_incr(), grey_decr() and grey_cmp() are also
+ * macros picking the fixed-width variant matching the type of the Grey
+ * code or value argument, e.g. grey_from16() for a `uint16_t`.
+ * Arguments of any other type, such as signed integers or integer
+ * literals, use the #GREY_UINTBITS-wide function as before. Wrap the name
+ * in parentheses, like `(grey_to)(x)`, to call the function directly.
+ */
+#if !defined(GREY_NO_GENERIC) && !defined(__cplusplus) \
+    && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#include <limits.h>
+
+#if (USHRT_MAX == 0xFFFFU)
+#define GREY_GENERIC_USHORT_(name) unsigned short: name##16,
+#else
+#define GREY_GENERIC_USHORT_(name)
+#endif
+#if (UINT_MAX == 0xFFFFFFFFU)
+#define GREY_GENERIC_UINT_(name) unsigned int: name##32,
+#else
+#define GREY_GENERIC_UINT_(name)
+#endif
+#if (ULONG_MAX == 0xFFFFFFFFFFFFFFFFU)
+#define GREY_GENERIC_ULONG_(name) unsigned long: name##64,
+#elif (ULONG_MAX == 0xFFFFFFFFU)
+#define GREY_GENERIC_ULONG_(name) unsigned long: name##32,
+#else
+#define GREY_GENERIC_ULONG_(name)
+#endif
+#if defined(GREY_HAS_UINT128)
+#define GREY_GENERIC_UINT128_(name) grey_uint128_t: name##128,
+#else
+#define GREY_GENERIC_UINT128_(name)
+#endif
+/**
+ * Selects the fixed-width variant of \p name by the type of \p x,
+ * by the standard unsigned types so it works whichever of them the
+ * `uintN_t` types are defined as.
+ */
+#define GREY_GENERIC(name, x) _Generic((x), \
+    unsigned char: name##8, \
+    GREY_GENERIC_USHORT_(name) \
+    GREY_GENERIC_UINT_(name) \
+    GREY_GENERIC_ULONG_(name) \
+    unsigned long long: name##64, \
+    GREY_GENERIC_UINT128_(name) \
+    default: name)
+
+#define grey_to(value) GREY_GENERIC(grey_to, (value))(value)
+#define grey_from(grey) GREY_GENERIC(grey_from, (grey))(grey)
+#define grey_binstr(str, grey) GREY_GENERIC(grey_binstr, (grey))((str), (grey))
+#define grey_binstr_fixed(str, grey) \
+    GREY_GENERIC(grey_binstr_fixed, (grey))((str), (grey))
+#define grey_incr(grey) GREY_GENERIC(grey_incr, (grey))(grey)
+#define grey_decr(grey) GREY_GENERIC(grey_decr, (grey))(grey)
+#define grey_cmp(a, b) GREY_GENERIC(grey_cmp, (a))((a), (b))
+
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,466 @@
+/**
+ * @file
+ *
+ * C++14 front-end of grey.h: Grey codes of any unsigned integer type.
+ *
+ * grey::to() and grey::from() are `constexpr` templates on the type of
+ * their argument, so each width gets exactly the shift cascade it needs
+ * and constant arguments fold into constants, e.g. the tables of
+ * grey::table(). They take any unsigned integer type, including
+ * `unsigned __int128` and `std::bitset`, and any other type with the `^`
+ * and `>>` operators of the integers once grey::width is specialised for
+ * it.
+ *
+ * On top of them, grey::code is a Grey code which cannot be confused with
+ * its value, grey::sequence_view a lazy range of consecutive codes and, in
+ * C++20, the `std::span` overloads of grey::to(), grey::from() and
+ * grey::fill() run the SIMD kernels of the C library, which must be linked
+ * as usual.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef GREY_HPP
+#define GREY_HPP
+
+#if (__cplusplus < 201402L) \
+    && !(defined(_MSVC_LANG) && (_MSVC_LANG >= 201402L))
+#error "grey.hpp requires C++14 or later"
+#endif
+
+#include "grey.h"
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+/**
+ * @property GREY_HAS_SPAN
+ * Defined to 1 when the standard library provides `std::span`, in which
+ * case the bulk overloads of grey::to(), grey::from() and grey::fill()
+ * are available.
+ */
+#if defined(__cpp_lib_span)
+#include <algorithm>
+#include <span>
+
+#define GREY_HAS_SPAN 1
+#endif
+
+/**
+ * @property GREY_HAS_RANGES
+ * Defined to 1 when the standard library provides `<ranges>`, in which
+ * case grey::sequence_view is a `std::ranges::view`.
+ */
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+
+#define GREY_HAS_RANGES 1
+#endif
+
+namespace grey
+{
+    /**
+     * Amount of bits of the codes of type \p T, 0 if \p T is not a type of
+     * Grey codes.
+     *
+     * Specialise it for other wide unsigned types with the `^` and `>>`
+     * operators of the integers to use them with grey::to() and
+     * grey::from().
+     */
+    template<typename T, typename = void>
+    struct width : std::integral_constant<unsigned int, 0U>
+    {
+    };
+
+    /** Unsigned integer types, `bool` excluded. */
+    template<typename T>
+    struct width<T, typename std::enable_if<
+            std::is_integral<T>::value && std::is_unsigned<T>::value
+            && !std::is_same<T, bool>::value>::type>
+            : std::integral_constant<unsigned int,
+                                     static_cast<unsigned int>(
+                                             std::numeric_limits<T>::digits)>
+    {
+    };
+
+#if defined(GREY_HAS_UINT128)
+    /** `unsigned __int128`, not an integral type in strict ISO C++. */
+    template<>
+    struct width<grey_uint128_t, void>
+            : std::integral_constant<unsigned int, 128U>
+    {
+    };
+#endif
+
+    /** `std::bitset`, whose operators are `constexpr` since C++23. */
+    template<std::size_t N>
+    struct width<std::bitset<N>, void>
+            : std::integral_constant<unsigned int,
+                                     static_cast<unsigned int>(N)>
+    {
+    };
+
+    /** Whether \p T is a type of Grey codes, see grey::width. */
+    template<typename T>
+    struct is_code_type
+            : std::integral_constant<bool, (width<T>::value > 0U)>
+    {
+    };
+
+    /**
+     * Converts an unsigned integer to its Grey code, as grey_to() does.
+     *
+     * @param[in] value integer to convert
+     * @return Grey code of \p value.
+     */
+    template<typename T>
+    constexpr typename std::enable_if<is_code_type<T>::value, T>::type
+    to(const T value) noexcept
+    {
+        return static_cast<T>(value ^ (value >> 1U));
+    }
+
+    /**
+     * Converts a Grey code to its unsigned integer, as grey_from() does,
+     * with the log2(#grey::width) shifts of its type.
+     *
+     * @param[in] code Grey code to convert
+     * @return value of \p code.
+     */
+    template<typename T>
+    constexpr typename std::enable_if<is_code_type<T>::value, T>::type
+    from(T code) noexcept
+    {
+        for (unsigned int shift = 1U; shift < width<T>::value; shift <<= 1U)
+        {
+            code = static_cast<T>(code ^ (code >> shift));
+        }
+        return code;
+    }
+
+    namespace detail
+    {
+        template<typename T, bool Decode, std::size_t... I>
+        constexpr std::array<T, sizeof...(I)>
+        table(std::index_sequence<I...>) noexcept
+        {
+            return {{(Decode ? from(static_cast<T>(I))
+                             : to(static_cast<T>(I)))...}};
+        }
+    }
+
+    /**
+     * Table of the Grey codes of the values from 0 to \p N - 1, built at
+     * compile time, e.g.
+     * `constexpr auto codes = grey::table<std::uint8_t, 256U>();`.
+     *
+     * @return the table, the code of `i` at index `i`.
+     */
+    template<typename T, std::size_t N>
+    constexpr std::array<T, N> table() noexcept
+    {
+        return detail::table<T, false>(std::make_index_sequence<N>());
+    }
+
+    /**
+     * Table of the values of the Grey codes from 0 to \p N - 1, built at
+     * compile time, the inverse of grey::table().
+     *
+     * @return the table, the value of the code `i` at index `i`.
+     */
+    template<typename T, std::size_t N>
+    constexpr std::array<T, N> inverse_table() noexcept
+    {
+        return detail::table<T, true>(std::make_index_sequence<N>());
+    }
+
+    /**
+     * Grey code of type \p T, a distinct type from its value.
+     *
+     * It is ordered like its value, not like its bits, and incrementing
+     * or decrementing it moves to the next or previous code of the
+     * sequence, wrapping around. These need arithmetic, so only integer
+     * codes have them.
+     */
+    template<typename T>
+    class code
+    {
+        static_assert(is_code_type<T>::value,
+                      "grey::code requires a type of Grey codes");
+
+    public:
+        /** Type of the bits and of the value of the code. */
+        using value_type = T;
+
+        /** Code of the value 0. */
+        constexpr code() noexcept: bits_()
+        {
+        }
+
+        /** Code made of the given \p bits, which are not converted. */
+        constexpr explicit code(const T bits) noexcept: bits_(bits)
+        {
+        }
+
+        /** Code of the given \p value. */
+        static constexpr code of(const T value) noexcept
+        {
+            return code(grey::to(value));
+        }
+
+        /** Bits of the code. */
+        constexpr T bits() const noexcept
+        {
+            return bits_;
+        }
+
+        /** Value of the code. */
+        constexpr T value() const noexcept
+        {
+            return grey::from(bits_);
+        }
+
+        /** Moves to the code of the next value. */
+        constexpr code& operator++() noexcept
+        {
+            bits_ = grey::to(static_cast<T>(value() + 1U));
+            return *this;
+        }
+
+        /** Moves to the code of the previous value. */
+        constexpr code& operator--() noexcept
+        {
+            bits_ = grey::to(static_cast<T>(value() - 1U));
+            return *this;
+        }
+
+        constexpr code operator++(int) noexcept
+        {
+            const code previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr code operator--(int) noexcept
+        {
+            const code previous = *this;
+            --*this;
+            return previous;
+        }
+
+        friend constexpr bool operator==(const code a, const code b) noexcept
+        {
+            return a.bits_ == b.bits_;
+        }
+
+        friend constexpr bool operator!=(const code a, const code b) noexcept
+        {
+            return !(a == b);
+        }
+
+        friend constexpr bool operator<(const code a, const code b) noexcept
+        {
+            return a.value() < b.value();
+        }
+
+        friend constexpr bool operator>(const code a, const code b) noexcept
+        {
+            return b < a;
+        }
+
+        friend constexpr bool operator<=(const code a, const code b) noexcept
+        {
+            return !(b < a);
+        }
+
+        friend constexpr bool operator>=(const code a, const code b) noexcept
+        {
+            return !(a < b);
+        }
+
+    private:
+        T bits_;
+    };
+
+    /**
+     * Lazy range of the Grey codes of \p count consecutive values from
+     * \p start, wrapping around, like the ones grey_fill_range() writes.
+     *
+     * Each code is computed when its iterator is dereferenced, so the
+     * range takes no memory, e.g.
+     * `for (std::uint16_t c : grey::sequence_view<std::uint16_t>(0, 10))`.
+     * In C++20 it is a `std::ranges::view` and composes with the range
+     * adaptors.
+     */
+    template<typename T>
+    class sequence_view
+#if defined(GREY_HAS_RANGES)
+            : public std::ranges::view_interface<sequence_view<T>>
+#endif
+    {
+        static_assert(is_code_type<T>::value,
+                      "grey::sequence_view requires a type of Grey codes");
+
+    public:
+        /** Iterator of the codes, computing each when dereferenced. */
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = T;
+
+            constexpr iterator() noexcept: value_(), index_(0U)
+            {
+            }
+
+            constexpr iterator(const T value, const std::size_t index)
+            noexcept: value_(value), index_(index)
+            {
+            }
+
+            constexpr T operator*() const noexcept
+            {
+                return grey::to(value_);
+            }
+
+            constexpr iterator& operator++() noexcept
+            {
+                value_ = static_cast<T>(value_ + 1U);
+                index_++;
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept
+            {
+                const iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            friend constexpr bool operator==(const iterator& a,
+                                             const iterator& b) noexcept
+            {
+                return a.index_ == b.index_;
+            }
+
+            friend constexpr bool operator!=(const iterator& a,
+                                             const iterator& b) noexcept
+            {
+                return !(a == b);
+            }
+
+        private:
+            T value_;
+            std::size_t index_;
+        };
+
+        /** Empty sequence. */
+        constexpr sequence_view() noexcept: start_(), count_(0U)
+        {
+        }
+
+        /** Sequence of \p count codes from the one of \p start. */
+        constexpr sequence_view(const T start, const std::size_t count)
+        noexcept: start_(start), count_(count)
+        {
+        }
+
+        constexpr iterator begin() const noexcept
+        {
+            return iterator(start_, 0U);
+        }
+
+        constexpr iterator end() const noexcept
+        {
+            return iterator(static_cast<T>(start_ + count_), count_);
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return count_;
+        }
+
+    private:
+        T start_;
+        std::size_t count_;
+    };
+
+#if defined(GREY_HAS_SPAN)
+
+/**
+ * Defines the `std::span` overloads of grey::to(), grey::from() and
+ * grey::fill() on \p bits -wide integers, running the kernels of the C
+ * library.
+ *
+ * The two-span conversions convert as many elements as fit in the output
+ * with grey_to_array<bits>() or grey_from_array<bits>() and return how
+ * many, the one-span ones convert in place. grey::fill() writes the codes
+ * of consecutive values with grey_fill_range<bits>().
+ */
+#define GREY_HPP_SPAN_DEFINE(bits) \
+    inline std::size_t to(const std::span<const std::uint##bits##_t> values, \
+                          const std::span<std::uint##bits##_t> codes) \
+    noexcept \
+    { \
+        const std::size_t amount = std::min(values.size(), codes.size()); \
+        grey_to_array##bits(values.data(), codes.data(), amount); \
+        return amount; \
+    } \
+    inline void to(const std::span<std::uint##bits##_t> values) noexcept \
+    { \
+        grey_to_array_inplace##bits(values.data(), values.size()); \
+    } \
+    inline std::size_t from(const std::span<const std::uint##bits##_t> \
+                            codes, \
+                            const std::span<std::uint##bits##_t> values) \
+    noexcept \
+    { \
+        const std::size_t amount = std::min(codes.size(), values.size()); \
+        grey_from_array##bits(codes.data(), values.data(), amount); \
+        return amount; \
+    } \
+    inline void from(const std::span<std::uint##bits##_t> codes) noexcept \
+    { \
+        grey_from_array_inplace##bits(codes.data(), codes.size()); \
+    } \
+    inline void fill(const std::uint##bits##_t start, \
+                     const std::span<std::uint##bits##_t> codes) noexcept \
+    { \
+        grey_fill_range##bits(start, codes.size(), codes.data()); \
+    }
+
+    GREY_HPP_SPAN_DEFINE(8)
+    GREY_HPP_SPAN_DEFINE(16)
+    GREY_HPP_SPAN_DEFINE(32)
+    GREY_HPP_SPAN_DEFINE(64)
+
+#undef GREY_HPP_SPAN_DEFINE
+
+#endif  /* GREY_HAS_SPAN */
+}
+
+#if defined(GREY_HAS_RANGES)
+/** The iterators of a grey::sequence_view do not point into it. */
+template<typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<
+        grey::sequence_view<T>> = true;
+#endif
+
+#endif  /* GREY_HPP */
@@ -6,47 +6,204 @@
  * @license BSD 3-clause license.
  */
 
+/* The library always provides the linkable definitions, as functions. */
+#undef GREY_HEADER_ONLY
+#define GREY_NO_GENERIC
+
 #include "grey.h"
+#include "grey_kernels.h"
+#include "grey_hilbert_kernels.h"
+#include "grey_stats.h"
+
+#define GREY_WIDTH_DEFINE(bits, type) \
+    type grey_to##bits(const type value) \
+    { \
+        return grey_inline_to##bits(value); \
+    } \
+    type grey_from##bits(const type grey) \
+    { \
+        return grey_inline_from##bits(grey); \
+    }
 
-grey_code_t inline grey_to(const grey_int_t binary)
+GREY_WIDTH_DEFINE(8, uint8_t)
+GREY_WIDTH_DEFINE(16, uint16_t)
+GREY_WIDTH_DEFINE(32, uint32_t)
+GREY_WIDTH_DEFINE(64, uint64_t)
+#if defined(GREY_HAS_UINT128)
+GREY_WIDTH_DEFINE(128, grey_uint128_t)
+#endif
+
+grey_code_t grey_to(const grey_int_t value)
 {
-    return binary ^ (binary >> 1U);
+    return grey_inline_to(value);
 }
 
-grey_int_t grey_from(grey_code_t grey)
+grey_int_t grey_from(const grey_code_t grey)
 {
-#if (GREY_UINTBITS > 32)
-    grey ^= grey >> 32U;
-#endif
-#if (GREY_UINTBITS > 16)
-    grey ^= grey >> 16U;
-#endif
-#if (GREY_UINTBITS > 8)
-    grey ^= grey >> 8U;
-#endif
-    grey ^= grey >> 4U;
-    grey ^= grey >> 2U;
-    grey ^= grey >> 1U;
-    return grey;
-}
-
-uint8_t grey_binstr(char* str, const grey_code_t grey)
-{
-    uint8_t len = 0;
-    uint_fast8_t found_a_1 = 0;
-    for (int_fast8_t i = GREY_UINTBITS - 1; i >= 0; i--)
-    {
-        const uint_fast8_t bit = (grey >> (unsigned int) i) & 1U;
-        if (bit)
-        {
-            found_a_1 = i;
-            str[len++] = '1';
-        }
-        else if (found_a_1)
-        {
-            str[len++] = '0';
-        }
+    return grey_inline_from(grey);
+}
+
+/**
+ * Defines a scalar kernel, converting one element at a time. Used as-is
+ * when no SIMD instruction set is available.
+ */
+#define GREY_SCALAR_KERNEL_DEFINE(name, type, scalar_op) \
+    void name(const type* const in, type* const out, const size_t amount) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            out[i] = scalar_op(in[i]); \
+        } \
+    }
+
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_to8, uint8_t, grey_inline_to8)
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_from8, uint8_t, grey_inline_from8)
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_to16, uint16_t, grey_inline_to16)
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_from16, uint16_t, grey_inline_from16)
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_to32, uint32_t, grey_inline_to32)
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_from32, uint32_t, grey_inline_from32)
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_to64, uint64_t, grey_inline_to64)
+GREY_SCALAR_KERNEL_DEFINE(grey_scalar_from64, uint64_t, grey_inline_from64)
+
+#define GREY_SCALAR_FILL_DEFINE(name, type, scalar_op) \
+    void name(const type start, const type step, type* const out, \
+              const size_t amount) \
+    { \
+        type value = start; \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            out[i] = scalar_op(value); \
+            value = (type) (value + step); \
+        } \
+    }
+
+GREY_SCALAR_FILL_DEFINE(grey_scalar_fill8, uint8_t, grey_inline_to8)
+GREY_SCALAR_FILL_DEFINE(grey_scalar_fill16, uint16_t, grey_inline_to16)
+GREY_SCALAR_FILL_DEFINE(grey_scalar_fill32, uint32_t, grey_inline_to32)
+GREY_SCALAR_FILL_DEFINE(grey_scalar_fill64, uint64_t, grey_inline_to64)
+
+/* A "vector" of a single word for the multiword skeleton. */
+#define GREY_SCALAR_LOAD(word) (*(word))
+#define GREY_SCALAR_STORE(word, value) (*(word) = (value))
+#define GREY_SCALAR_WORDS_PARITIES(word) ((unsigned int) ((word) & 1U))
+#define GREY_SCALAR_WORDS_FLIP(word, mask) ((word) ^ ((uint64_t) 0 - (mask)))
+GREY_WORDS_KERNELS_DEFINE(scalar, uint64_t, 1U,
+                          GREY_SCALAR_LOAD, GREY_SCALAR_STORE,
+                          grey_inline_word_to, grey_inline_from64,
+                          GREY_SCALAR_WORDS_PARITIES, GREY_SCALAR_WORDS_FLIP)
+
+GREY_HILBERT_KERNELS_DEFINE(scalar, points)
+
+#define GREY_SCALAR_DISTANCES_DEFINE(bits, type) \
+    void grey_scalar_distances##bits(const type query, \
+                                     const type* const codes, \
+                                     uint8_t* const distances, \
+                                     const size_t amount) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            distances[i] = (uint8_t) grey_inline_popcount64( \
+                    (uint64_t) (codes[i] ^ query)); \
+        } \
+    }
+
+GREY_SCALAR_DISTANCES_DEFINE(8, uint8_t)
+GREY_SCALAR_DISTANCES_DEFINE(16, uint16_t)
+GREY_SCALAR_DISTANCES_DEFINE(32, uint32_t)
+GREY_SCALAR_DISTANCES_DEFINE(64, uint64_t)
+
+void grey_to_array(const grey_int_t* const values, grey_code_t* const codes,
+                   const size_t amount)
+{
+    GREY_STATS_CONVERT(to, GREY_UINTBITS, amount,
+                       GREY_KERNEL(to)(values, codes, amount));
+}
+
+void grey_from_array(const grey_code_t* const codes, grey_int_t* const values,
+                     const size_t amount)
+{
+    GREY_STATS_CONVERT(from, GREY_UINTBITS, amount,
+                       GREY_KERNEL(from)(codes, values, amount));
+}
+
+void grey_to_array_inplace(grey_int_t* const values, const size_t amount)
+{
+    GREY_STATS_CONVERT(to, GREY_UINTBITS, amount,
+                       GREY_KERNEL(to)(values, values, amount));
+}
+
+void grey_from_array_inplace(grey_code_t* const codes, const size_t amount)
+{
+    GREY_STATS_CONVERT(from, GREY_UINTBITS, amount,
+                       GREY_KERNEL(from)(codes, codes, amount));
+}
+
+#define GREY_ARRAY_WIDTH_DEFINE(bits, type) \
+    void grey_to_array##bits(const type* const values, type* const codes, \
+                             const size_t amount) \
+    { \
+        GREY_STATS_CONVERT(to, bits, amount, \
+                           grey_kernels.to##bits(values, codes, amount)); \
+    } \
+    void grey_from_array##bits(const type* const codes, type* const values, \
+                               const size_t amount) \
+    { \
+        GREY_STATS_CONVERT(from, bits, amount, \
+                           grey_kernels.from##bits(codes, values, amount)); \
+    } \
+    void grey_to_array_inplace##bits(type* const values, \
+                                     const size_t amount) \
+    { \
+        GREY_STATS_CONVERT(to, bits, amount, \
+                           grey_kernels.to##bits(values, values, amount)); \
+    } \
+    void grey_from_array_inplace##bits(type* const codes, \
+                                       const size_t amount) \
+    { \
+        GREY_STATS_CONVERT(from, bits, amount, \
+                           grey_kernels.from##bits(codes, codes, amount)); \
     }
-    str[len] = '\0';
-    return len;
+
+GREY_ARRAY_WIDTH_DEFINE(8, uint8_t)
+GREY_ARRAY_WIDTH_DEFINE(16, uint16_t)
+GREY_ARRAY_WIDTH_DEFINE(32, uint32_t)
+GREY_ARRAY_WIDTH_DEFINE(64, uint64_t)
+
+void grey_fill_range(const grey_int_t start, const size_t count,
+                     grey_code_t* const out)
+{
+    GREY_STATS_RECORD(GREY_STATS_FILL_RANGE,
+                      grey_kernels.id, count, count * sizeof(grey_code_t),
+                      GREY_KERNEL(fill)(start, 1U, out, count));
 }
+
+/* A step of the maximum value is a step of -1, wrapping around. */
+void grey_fill_range_down(const grey_int_t start, const size_t count,
+                          grey_code_t* const out)
+{
+    GREY_STATS_RECORD(GREY_STATS_FILL_RANGE,
+                      grey_kernels.id, count, count * sizeof(grey_code_t),
+                      GREY_KERNEL(fill)(start, GREY_MAX, out, count));
+}
+
+#define GREY_FILL_WIDTH_DEFINE(bits, type) \
+    void grey_fill_range##bits(const type start, const size_t count, \
+                               type* const out) \
+    { \
+        GREY_STATS_RECORD(GREY_STATS_FILL_RANGE, grey_kernels.id, count, \
+                          count * sizeof(type), \
+                          grey_kernels.fill##bits(start, 1U, out, count)); \
+    } \
+    void grey_fill_range_down##bits(const type start, const size_t count, \
+                                    type* const out) \
+    { \
+        GREY_STATS_RECORD(GREY_STATS_FILL_RANGE, grey_kernels.id, count, \
+                          count * sizeof(type), \
+                          grey_kernels.fill##bits(start, UINT##bits##_MAX, \
+                                                  out, count)); \
+    }
+
+GREY_FILL_WIDTH_DEFINE(8, uint8_t)
+GREY_FILL_WIDTH_DEFINE(16, uint16_t)
+GREY_FILL_WIDTH_DEFINE(32, uint32_t)
+GREY_FILL_WIDTH_DEFINE(64, uint64_t)
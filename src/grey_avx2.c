@@ -0,0 +1,261 @@
+/**
+ * @file
+ * @brief AVX2 bulk conversion kernels, 256 bits per iteration.
+ *
+ * Same structure as the SSE2 kernels on twice as wide vectors, including
+ * the masked 16-bit shifts emulating the missing 8-bit ones.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+#include "grey_hilbert_kernels.h"
+
+#if defined(GREY_KERNELS_AVX2)
+
+#include <immintrin.h>
+#include <string.h>
+
+#define GREY_AVX2_SHR8(v, n) \
+    _mm256_and_si256(_mm256_srli_epi16((v), (n)), \
+                     _mm256_set1_epi8((char) (0xFFU >> (n))))
+
+static inline __m256i avx2_to8(const __m256i v)
+{
+    return _mm256_xor_si256(v, GREY_AVX2_SHR8(v, 1));
+}
+
+static inline __m256i avx2_from8(__m256i v)
+{
+    v = _mm256_xor_si256(v, GREY_AVX2_SHR8(v, 4));
+    v = _mm256_xor_si256(v, GREY_AVX2_SHR8(v, 2));
+    v = _mm256_xor_si256(v, GREY_AVX2_SHR8(v, 1));
+    return v;
+}
+
+static inline __m256i avx2_to16(const __m256i v)
+{
+    return _mm256_xor_si256(v, _mm256_srli_epi16(v, 1));
+}
+
+static inline __m256i avx2_from16(__m256i v)
+{
+    v = _mm256_xor_si256(v, _mm256_srli_epi16(v, 8));
+    v = _mm256_xor_si256(v, _mm256_srli_epi16(v, 4));
+    v = _mm256_xor_si256(v, _mm256_srli_epi16(v, 2));
+    v = _mm256_xor_si256(v, _mm256_srli_epi16(v, 1));
+    return v;
+}
+
+static inline __m256i avx2_to32(const __m256i v)
+{
+    return _mm256_xor_si256(v, _mm256_srli_epi32(v, 1));
+}
+
+static inline __m256i avx2_from32(__m256i v)
+{
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 16));
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 8));
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 4));
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 2));
+    v = _mm256_xor_si256(v, _mm256_srli_epi32(v, 1));
+    return v;
+}
+
+static inline __m256i avx2_to64(const __m256i v)
+{
+    return _mm256_xor_si256(v, _mm256_srli_epi64(v, 1));
+}
+
+static inline __m256i avx2_from64(__m256i v)
+{
+    v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 32));
+    v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 16));
+    v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 8));
+    v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 4));
+    v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 2));
+    v = _mm256_xor_si256(v, _mm256_srli_epi64(v, 1));
+    return v;
+}
+
+/** Encodes four words of a multiword value, see grey_inline_word_to(). */
+static inline __m256i avx2_words_to(const __m256i v, const __m256i above)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(v, _mm256_srli_epi64(v, 1)),
+                            _mm256_slli_epi64(above, 63));
+}
+
+/** Lowest bit of each of the four words, as a 4-bit integer. */
+static inline unsigned int avx2_words_parities(const __m256i v)
+{
+    return (unsigned int) _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_slli_epi64(v, 63)));
+}
+
+/** Inverts the words whose bit is set in \p mask. */
+static inline __m256i avx2_words_flip(const __m256i v, const unsigned int mask)
+{
+    const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+    const __m256i selected = _mm256_and_si256(
+            _mm256_set1_epi64x((long long) mask), lane_bits);
+    return _mm256_xor_si256(v, _mm256_cmpeq_epi64(selected, lane_bits));
+}
+
+GREY_KERNEL_DEFINE(grey_avx2_to8, uint8_t, __m256i, 32,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_to8, grey_inline_to8)
+GREY_KERNEL_DEFINE(grey_avx2_from8, uint8_t, __m256i, 32,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_from8, grey_inline_from8)
+GREY_KERNEL_DEFINE(grey_avx2_to16, uint16_t, __m256i, 16,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_to16, grey_inline_to16)
+GREY_KERNEL_DEFINE(grey_avx2_from16, uint16_t, __m256i, 16,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_from16, grey_inline_from16)
+GREY_KERNEL_DEFINE(grey_avx2_to32, uint32_t, __m256i, 8,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_to32, grey_inline_to32)
+GREY_KERNEL_DEFINE(grey_avx2_from32, uint32_t, __m256i, 8,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_from32, grey_inline_from32)
+GREY_KERNEL_DEFINE(grey_avx2_to64, uint64_t, __m256i, 4,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_to64, grey_inline_to64)
+GREY_KERNEL_DEFINE(grey_avx2_from64, uint64_t, __m256i, 4,
+                   _mm256_loadu_si256, _mm256_storeu_si256,
+                   avx2_from64, grey_inline_from64)
+GREY_WORDS_KERNELS_DEFINE(avx2, __m256i, 4,
+                          _mm256_loadu_si256, _mm256_storeu_si256,
+                          avx2_words_to, avx2_from64,
+                          avx2_words_parities, avx2_words_flip)
+
+GREY_FILL_KERNEL_DEFINE(grey_avx2_fill8, uint8_t, __m256i, 32,
+                        _mm256_loadu_si256, _mm256_storeu_si256,
+                        _mm256_add_epi8, avx2_to8, grey_inline_to8)
+GREY_FILL_KERNEL_DEFINE(grey_avx2_fill16, uint16_t, __m256i, 16,
+                        _mm256_loadu_si256, _mm256_storeu_si256,
+                        _mm256_add_epi16, avx2_to16, grey_inline_to16)
+GREY_FILL_KERNEL_DEFINE(grey_avx2_fill32, uint32_t, __m256i, 8,
+                        _mm256_loadu_si256, _mm256_storeu_si256,
+                        _mm256_add_epi32, avx2_to32, grey_inline_to32)
+GREY_FILL_KERNEL_DEFINE(grey_avx2_fill64, uint64_t, __m256i, 4,
+                        _mm256_loadu_si256, _mm256_storeu_si256,
+                        _mm256_add_epi64, avx2_to64, grey_inline_to64)
+
+/* Portable code, vectorized by the compiler for this instruction set. */
+GREY_HILBERT_KERNELS_DEFINE(avx2, block)
+
+/** Bit counts of the bytes of \p v, looking up the ones of each nibble. */
+static inline __m256i avx2_count8(const __m256i v)
+{
+    const __m256i table = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+    const __m256i high = _mm256_shuffle_epi8(
+            table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    return _mm256_add_epi8(low, high);
+}
+
+static inline __m256i avx2_count16(const __m256i v)
+{
+    return _mm256_maddubs_epi16(avx2_count8(v), _mm256_set1_epi8(1));
+}
+
+static inline __m256i avx2_count32(const __m256i v)
+{
+    return _mm256_madd_epi16(avx2_count16(v), _mm256_set1_epi16(1));
+}
+
+static inline __m256i avx2_count64(const __m256i v)
+{
+    return _mm256_sad_epu8(avx2_count8(v), _mm256_setzero_si256());
+}
+
+static inline __m256i avx2_broadcast8(const uint8_t query)
+{
+    return _mm256_set1_epi8((char) query);
+}
+
+static inline __m256i avx2_broadcast16(const uint16_t query)
+{
+    return _mm256_set1_epi16((short) query);
+}
+
+static inline __m256i avx2_broadcast32(const uint32_t query)
+{
+    return _mm256_set1_epi32((int) query);
+}
+
+static inline __m256i avx2_broadcast64(const uint64_t query)
+{
+    return _mm256_set1_epi64x((long long) query);
+}
+
+static inline void avx2_store_distances8(uint8_t* const out,
+                                         const __m256i counts)
+{
+    _mm256_storeu_si256((__m256i*) out, counts);
+}
+
+/* The packs work within each 128-bit half, then a permutation joins them. */
+static inline void avx2_store_distances16(uint8_t* const out,
+                                          const __m256i counts)
+{
+    const __m256i bytes = _mm256_permute4x64_epi64(
+            _mm256_packus_epi16(counts, counts), 0x08);
+    _mm_storeu_si128((__m128i*) out, _mm256_castsi256_si128(bytes));
+}
+
+static inline void avx2_store_distances32(uint8_t* const out,
+                                          const __m256i counts)
+{
+    const __m256i lowest = _mm256_setr_epi8(
+            0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i bytes = _mm256_permutevar8x32_epi32(
+            _mm256_shuffle_epi8(counts, lowest),
+            _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+    _mm_storel_epi64((__m128i*) out, _mm256_castsi256_si128(bytes));
+}
+
+static inline void avx2_store_distances64(uint8_t* const out,
+                                          const __m256i counts)
+{
+    const __m256i lowest = _mm256_setr_epi8(
+            0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, 0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i bytes = _mm256_shuffle_epi8(counts, lowest);
+    const int joined = _mm_cvtsi128_si32(
+            _mm_or_si128(_mm256_castsi256_si128(bytes),
+                         _mm256_extracti128_si256(bytes, 1)));
+    memcpy(out, &joined, 4U);
+}
+
+GREY_DISTANCES_KERNEL_DEFINE(grey_avx2_distances8, uint8_t, __m256i, 32,
+                             _mm256_loadu_si256, avx2_broadcast8,
+                             _mm256_xor_si256, avx2_count8,
+                             avx2_store_distances8)
+GREY_DISTANCES_KERNEL_DEFINE(grey_avx2_distances16, uint16_t, __m256i, 16,
+                             _mm256_loadu_si256, avx2_broadcast16,
+                             _mm256_xor_si256, avx2_count16,
+                             avx2_store_distances16)
+GREY_DISTANCES_KERNEL_DEFINE(grey_avx2_distances32, uint32_t, __m256i, 8,
+                             _mm256_loadu_si256, avx2_broadcast32,
+                             _mm256_xor_si256, avx2_count32,
+                             avx2_store_distances32)
+GREY_DISTANCES_KERNEL_DEFINE(grey_avx2_distances64, uint64_t, __m256i, 4,
+                             _mm256_loadu_si256, avx2_broadcast64,
+                             _mm256_xor_si256, avx2_count64,
+                             avx2_store_distances64)
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int grey_avx2_unavailable_t;
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @file
+ * @brief AVX-512 (F + BW) bulk conversion kernels, 512 bits per iteration.
+ *
+ * Each shift-XOR step with a mask is a single `vpternlog`, and the
+ * leftover elements are handled with one masked load/store instead of a
+ * scalar loop.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+#include "grey_hilbert_kernels.h"
+
+#if defined(GREY_KERNELS_AVX512)
+
+#include <immintrin.h>
+
+/** Truth table of `a ^ (b & c)` for `vpternlog`. */
+#define GREY_TERNLOG_XOR_AND 0x78
+/** Truth table of `a ^ b ^ c` for `vpternlog`. */
+#define GREY_TERNLOG_XOR3 0x96
+
+#define GREY_AVX512_SHR8_XOR(v, n) \
+    _mm512_ternarylogic_epi64((v), _mm512_srli_epi16((v), (n)), \
+                              _mm512_set1_epi8((char) (0xFFU >> (n))), \
+                              GREY_TERNLOG_XOR_AND)
+
+static inline __m512i avx512_to8(const __m512i v)
+{
+    return GREY_AVX512_SHR8_XOR(v, 1);
+}
+
+static inline __m512i avx512_from8(__m512i v)
+{
+    v = GREY_AVX512_SHR8_XOR(v, 4);
+    v = GREY_AVX512_SHR8_XOR(v, 2);
+    v = GREY_AVX512_SHR8_XOR(v, 1);
+    return v;
+}
+
+static inline __m512i avx512_to16(const __m512i v)
+{
+    return _mm512_xor_si512(v, _mm512_srli_epi16(v, 1));
+}
+
+static inline __m512i avx512_from16(__m512i v)
+{
+    v = _mm512_xor_si512(v, _mm512_srli_epi16(v, 8));
+    v = _mm512_xor_si512(v, _mm512_srli_epi16(v, 4));
+    v = _mm512_xor_si512(v, _mm512_srli_epi16(v, 2));
+    v = _mm512_xor_si512(v, _mm512_srli_epi16(v, 1));
+    return v;
+}
+
+static inline __m512i avx512_to32(const __m512i v)
+{
+    return _mm512_xor_si512(v, _mm512_srli_epi32(v, 1));
+}
+
+static inline __m512i avx512_from32(__m512i v)
+{
+    v = _mm512_xor_si512(v, _mm512_srli_epi32(v, 16));
+    v = _mm512_xor_si512(v, _mm512_srli_epi32(v, 8));
+    v = _mm512_xor_si512(v, _mm512_srli_epi32(v, 4));
+    v = _mm512_xor_si512(v, _mm512_srli_epi32(v, 2));
+    v = _mm512_xor_si512(v, _mm512_srli_epi32(v, 1));
+    return v;
+}
+
+static inline __m512i avx512_to64(const __m512i v)
+{
+    return _mm512_xor_si512(v, _mm512_srli_epi64(v, 1));
+}
+
+static inline __m512i avx512_from64(__m512i v)
+{
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 32));
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 16));
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 8));
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 4));
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 2));
+    v = _mm512_xor_si512(v, _mm512_srli_epi64(v, 1));
+    return v;
+}
+
+/** Encodes eight words of a multiword value, see grey_inline_word_to(). */
+static inline __m512i avx512_words_to(const __m512i v, const __m512i above)
+{
+    return _mm512_ternarylogic_epi64(v, _mm512_srli_epi64(v, 1),
+                                     _mm512_slli_epi64(above, 63),
+                                     GREY_TERNLOG_XOR3);
+}
+
+/** Lowest bit of each of the eight words, as an 8-bit integer. */
+static inline unsigned int avx512_words_parities(const __m512i v)
+{
+    return _mm512_test_epi64_mask(v, _mm512_set1_epi64(1));
+}
+
+/** Inverts the words whose bit is set in \p mask. */
+static inline __m512i avx512_words_flip(const __m512i v,
+                                        const unsigned int mask)
+{
+    return _mm512_mask_xor_epi64(v, (__mmask8) mask, v,
+                                 _mm512_set1_epi64(-1));
+}
+
+/**
+ * Like #GREY_KERNEL_DEFINE, but the leftovers are processed with a
+ * masked load and store of the \p width -bit lanes.
+ */
+#define GREY_AVX512_KERNEL_DEFINE(name, type, width, mask_t, vector_op) \
+    void name(const type* const in, type* const out, const size_t amount) \
+    { \
+        const size_t lanes = 512U / (width); \
+        size_t i = 0; \
+        for (; i + lanes <= amount; i += lanes) \
+        { \
+            const __m512i v = _mm512_loadu_si512(&in[i]); \
+            _mm512_storeu_si512(&out[i], vector_op(v)); \
+        } \
+        if (i < amount) \
+        { \
+            const mask_t mask = (mask_t) ((1ULL << (amount - i)) - 1U); \
+            const __m512i v = _mm512_maskz_loadu_epi##width(mask, &in[i]); \
+            _mm512_mask_storeu_epi##width(&out[i], mask, vector_op(v)); \
+        } \
+    }
+
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_to8, uint8_t, 8, __mmask64,
+                          avx512_to8)
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_from8, uint8_t, 8, __mmask64,
+                          avx512_from8)
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_to16, uint16_t, 16, __mmask32,
+                          avx512_to16)
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_from16, uint16_t, 16, __mmask32,
+                          avx512_from16)
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_to32, uint32_t, 32, __mmask16,
+                          avx512_to32)
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_from32, uint32_t, 32, __mmask16,
+                          avx512_from32)
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_to64, uint64_t, 64, __mmask8,
+                          avx512_to64)
+GREY_AVX512_KERNEL_DEFINE(grey_avx512_from64, uint64_t, 64, __mmask8,
+                          avx512_from64)
+GREY_WORDS_KERNELS_DEFINE(avx512, __m512i, 8,
+                          _mm512_loadu_si512, _mm512_storeu_si512,
+                          avx512_words_to, avx512_from64,
+                          avx512_words_parities, avx512_words_flip)
+
+GREY_FILL_KERNEL_DEFINE(grey_avx512_fill8, uint8_t, __m512i, 64,
+                        _mm512_loadu_si512, _mm512_storeu_si512,
+                        _mm512_add_epi8, avx512_to8, grey_inline_to8)
+GREY_FILL_KERNEL_DEFINE(grey_avx512_fill16, uint16_t, __m512i, 32,
+                        _mm512_loadu_si512, _mm512_storeu_si512,
+                        _mm512_add_epi16, avx512_to16, grey_inline_to16)
+GREY_FILL_KERNEL_DEFINE(grey_avx512_fill32, uint32_t, __m512i, 16,
+                        _mm512_loadu_si512, _mm512_storeu_si512,
+                        _mm512_add_epi32, avx512_to32, grey_inline_to32)
+GREY_FILL_KERNEL_DEFINE(grey_avx512_fill64, uint64_t, __m512i, 8,
+                        _mm512_loadu_si512, _mm512_storeu_si512,
+                        _mm512_add_epi64, avx512_to64, grey_inline_to64)
+
+/* Portable code, vectorized by the compiler for this instruction set. */
+GREY_HILBERT_KERNELS_DEFINE(avx512, block)
+
+/** Bit counts of the bytes of \p v, looking up the ones of each nibble. */
+static inline __m512i avx512_count8(const __m512i v)
+{
+    const __m512i table = _mm512_broadcast_i32x4(_mm_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    const __m512i low = _mm512_shuffle_epi8(table, _mm512_and_si512(v, nibble));
+    const __m512i high = _mm512_shuffle_epi8(
+            table, _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble));
+    return _mm512_add_epi8(low, high);
+}
+
+static inline __m512i avx512_count16(const __m512i v)
+{
+    return _mm512_maddubs_epi16(avx512_count8(v), _mm512_set1_epi8(1));
+}
+
+static inline __m512i avx512_count32(const __m512i v)
+{
+    return _mm512_madd_epi16(avx512_count16(v), _mm512_set1_epi16(1));
+}
+
+static inline __m512i avx512_count64(const __m512i v)
+{
+    return _mm512_sad_epu8(avx512_count8(v), _mm512_setzero_si512());
+}
+
+GREY_AVX512_DISTANCES_DEFINE(avx512, avx512_count8, avx512_count16,
+                             avx512_count32, avx512_count64)
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int grey_avx512_unavailable_t;
+
+#endif
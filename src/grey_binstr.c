@@ -0,0 +1,292 @@
+/**
+ * @file
+ * @brief Binary string formatting and parsing of Grey codes.
+ *
+ * Both directions work on 8 characters at a time inside a 64-bit integer
+ * (SWAR), with no table and no branch per bit. Formatting spreads the 8
+ * bits of a byte over the 8 bytes of a word with a multiplication and
+ * turns each byte into '0' or '1'. Parsing validates 8 characters with a
+ * single mask test, then gathers their lowest bits into a byte with
+ * another multiplication. Whole 64-bit words are formatted with SSE2
+ * instead where available, part of the x86-64 baseline.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#define GREY_NO_GENERIC
+
+#include "grey.h"
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/** Each byte of a word set to 0x01. */
+#define GREY_BINSTR_ONES UINT64_C(0x0101010101010101)
+/** Each byte of a word set to '0'. */
+#define GREY_BINSTR_ZEROS UINT64_C(0x3030303030303030)
+
+/*
+ * Bit of the formatted byte ending up in each character, and multiplier
+ * gathering the digits of 8 characters into a byte, most significant bit
+ * first. Depend on which byte of a word is stored first in memory.
+ */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define GREY_BINSTR_CHAR_BITS UINT64_C(0x8040201008040201)
+#define GREY_BINSTR_GATHER UINT64_C(0x0102040810204080)
+#else
+#define GREY_BINSTR_CHAR_BITS UINT64_C(0x0102040810204080)
+#define GREY_BINSTR_GATHER UINT64_C(0x8040201008040201)
+#endif
+
+/** Reverses the byte order of \p x. */
+static inline uint64_t grey_binstr_bswap64(const uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap64(x);
+#else
+    uint64_t swapped = 0;
+    for (unsigned int i = 0; i < 64U; i += 8U)
+    {
+        swapped = (swapped << 8U) | ((x >> i) & 0xFFU);
+    }
+    return swapped;
+#endif
+}
+
+/** The 8 ASCII characters of \p byte, as stored in memory. */
+static inline uint64_t grey_binstr_spread(const uint64_t byte)
+{
+    /* One bit per byte: adding 0x7F carries it into the top bit, never
+     * into the next byte. */
+    const uint64_t bits = (byte * GREY_BINSTR_ONES) & GREY_BINSTR_CHAR_BITS;
+    return (((bits + 0x7FU * GREY_BINSTR_ONES) >> 7U) & GREY_BINSTR_ONES)
+           | GREY_BINSTR_ZEROS;
+}
+
+#if defined(__SSE2__)
+/**
+ * Writes the 64 bits of \p word as ASCII, 16 characters per vector: each
+ * byte is replicated 8 times by unpacking it with itself, then each copy
+ * tests a different bit.
+ */
+static inline void grey_binstr_sse2_word64(char* const str,
+                                           const uint64_t word)
+{
+    /* Most significant byte first in memory */
+    const __m128i be = _mm_cvtsi64_si128((long long) grey_binstr_bswap64(word));
+    const __m128i bytes2 = _mm_unpacklo_epi8(be, be);
+    const __m128i bytes4_low = _mm_unpacklo_epi16(bytes2, bytes2);
+    const __m128i bytes4_high = _mm_unpackhi_epi16(bytes2, bytes2);
+    const __m128i bytes8[4] = {
+            _mm_unpacklo_epi32(bytes4_low, bytes4_low),
+            _mm_unpackhi_epi32(bytes4_low, bytes4_low),
+            _mm_unpacklo_epi32(bytes4_high, bytes4_high),
+            _mm_unpackhi_epi32(bytes4_high, bytes4_high),
+    };
+    const __m128i char_bits = _mm_set1_epi64x(
+            (long long) UINT64_C(0x0102040810204080));
+    const __m128i zeros = _mm_set1_epi8('0');
+    for (unsigned int i = 0; i < 4U; i++)
+    {
+        const __m128i set = _mm_cmpeq_epi8(
+                _mm_and_si128(bytes8[i], char_bits), char_bits);
+        /* '0' - (-1) is '1' */
+        _mm_storeu_si128((__m128i*) &str[16U * i],
+                         _mm_sub_epi8(zeros, set));
+    }
+}
+#endif
+
+/**
+ * Writes the lowest \p chars bits of \p word, at most 64, as ASCII
+ * without null-terminator, most significant bit first.
+ */
+static inline void grey_binstr_word(char* const str, const uint64_t word,
+                                    const unsigned int chars)
+{
+#if defined(__SSE2__)
+    if (chars == 64U)
+    {
+        grey_binstr_sse2_word64(str, word);
+        return;
+    }
+#endif
+    const unsigned int head = chars % 8U;
+    if (head != 0U)
+    {
+        char byte[8];
+        const uint64_t ascii = grey_binstr_spread(
+                (word >> (chars - head)) & 0xFFU);
+        memcpy(byte, &ascii, sizeof(ascii));
+        memcpy(str, &byte[8U - head], head);
+    }
+    for (unsigned int i = head; i < chars; i += 8U)
+    {
+        const uint64_t ascii = grey_binstr_spread(
+                (word >> (chars - i - 8U)) & 0xFFU);
+        memcpy(&str[i], &ascii, sizeof(ascii));
+    }
+}
+
+/**
+ * Parses 8 ASCII characters into a byte, most significant bit first.
+ * Any character other than '0' or '1' sets some bits of \p invalid.
+ */
+static inline uint64_t grey_binstr_gather(const char* const str,
+                                          uint64_t* const invalid)
+{
+    uint64_t ascii;
+    memcpy(&ascii, str, sizeof(ascii));
+    ascii ^= GREY_BINSTR_ZEROS;
+    *invalid |= ascii & ~GREY_BINSTR_ONES;
+    /* Distinct bit positions in each byte of the product: no carries. */
+    return ((ascii & GREY_BINSTR_ONES) * GREY_BINSTR_GATHER) >> 56U;
+}
+
+/**
+ * Defines the formatters and the parser of \p bits -wide Grey codes.
+ */
+#define GREY_BINSTR_DEFINE(bits, type) \
+    uint8_t grey_binstr##bits(char str[(bits) + 1], const type grey) \
+    { \
+        /* Fixed-width into a scratch buffer, then only the significant \
+         * part is copied: faster than a variable amount of bytes. */ \
+        char fixed[(bits)]; \
+        const unsigned int len = (grey == 0U) \
+                                 ? 0U \
+                                 : grey_inline_top_bit64(grey) + 1U; \
+        grey_binstr_word(fixed, grey, (bits)); \
+        memcpy(str, &fixed[(bits) - len], len); \
+        str[len] = '\0'; \
+        return (uint8_t) len; \
+    } \
+    void grey_binstr_fixed##bits(char str[(bits) + 1], const type grey) \
+    { \
+        grey_binstr_word(str, grey, (bits)); \
+        str[(bits)] = '\0'; \
+    } \
+    size_t grey_binstr_array##bits(char* const str, \
+                                   const type* const codes, \
+                                   const size_t amount, \
+                                   const char separator) \
+    { \
+        if (amount == 0U) \
+        { \
+            str[0] = '\0'; \
+            return 0; \
+        } \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            char* const code_str = &str[i * ((bits) + 1U)]; \
+            grey_binstr_word(code_str, codes[i], (bits)); \
+            code_str[(bits)] = separator; \
+        } \
+        str[amount * ((bits) + 1U) - 1U] = '\0'; \
+        return amount * ((bits) + 1U) - 1U; \
+    } \
+    GREY_PARSE_BINSTR_DEFINE(bits, type)
+
+/**
+ * Defines grey_parse_binstr() for \p bits -wide Grey codes.
+ *
+ * The first `length % 8` characters are parsed one by one, so the rest is
+ * a whole number of 8-character chunks. Invalid characters and the bits
+ * shifted out of the value are collected without branching and checked
+ * once at the end.
+ */
+#define GREY_PARSE_BINSTR_DEFINE(bits, type) \
+    grey_err_t grey_parse_binstr##bits(const char* const str, \
+                                       const size_t length, \
+                                       type* const grey) \
+    { \
+        if (length == 0U) \
+        { \
+            return GREY_ERR_INVALID; \
+        } \
+        type value = 0; \
+        type overflow = 0; \
+        uint64_t invalid = 0; \
+        size_t i = 0; \
+        for (; i < length % 8U; i++) \
+        { \
+            const unsigned int digit = (unsigned int) \
+                    ((unsigned char) str[i] - '0'); \
+            invalid |= digit & ~1U; \
+            overflow |= (type) (value >> ((bits) - 1U)); \
+            value = (type) ((type) (value << 1U) | (digit & 1U)); \
+        } \
+        for (; i < length; i += 8U) \
+        { \
+            const uint64_t byte = grey_binstr_gather(&str[i], &invalid); \
+            overflow |= (type) (value >> ((bits) - 8U)); \
+            value = (type) ((type) (value << 8U) | byte); \
+        } \
+        if (invalid) \
+        { \
+            return GREY_ERR_INVALID; \
+        } \
+        if (overflow) \
+        { \
+            return GREY_ERR_RANGE; \
+        } \
+        *grey = value; \
+        return GREY_OK; \
+    }
+
+GREY_BINSTR_DEFINE(8, uint8_t)
+GREY_BINSTR_DEFINE(16, uint16_t)
+GREY_BINSTR_DEFINE(32, uint32_t)
+GREY_BINSTR_DEFINE(64, uint64_t)
+
+#if defined(GREY_HAS_UINT128)
+uint8_t grey_binstr128(char str[128 + 1], const grey_uint128_t grey)
+{
+    const uint64_t high = (uint64_t) (grey >> 64U);
+    const uint64_t low = (uint64_t) grey;
+    if (high == 0U)
+    {
+        return grey_binstr64(str, low);
+    }
+    const unsigned int high_len = grey_inline_top_bit64(high) + 1U;
+    grey_binstr_word(str, high, high_len);
+    grey_binstr_word(&str[high_len], low, 64U);
+    str[high_len + 64U] = '\0';
+    return (uint8_t) (high_len + 64U);
+}
+
+void grey_binstr_fixed128(char str[128 + 1], const grey_uint128_t grey)
+{
+    grey_binstr_word(str, (uint64_t) (grey >> 64U), 64U);
+    grey_binstr_word(&str[64], (uint64_t) grey, 64U);
+    str[128] = '\0';
+}
+
+GREY_PARSE_BINSTR_DEFINE(128, grey_uint128_t)
+#endif
+
+uint8_t grey_binstr(char str[GREY_UINTBITS + 1], const grey_code_t grey)
+{
+    return GREY_WIDTH_NAME(grey_binstr, GREY_UINTBITS)(str, grey);
+}
+
+void grey_binstr_fixed(char str[GREY_UINTBITS + 1], const grey_code_t grey)
+{
+    GREY_WIDTH_NAME(grey_binstr_fixed, GREY_UINTBITS)(str, grey);
+}
+
+size_t grey_binstr_array(char* const str, const grey_code_t* const codes,
+                         const size_t amount, const char separator)
+{
+    return GREY_WIDTH_NAME(grey_binstr_array, GREY_UINTBITS)(
+            str, codes, amount, separator);
+}
+
+grey_err_t grey_parse_binstr(const char* const str, const size_t length,
+                             grey_code_t* const grey)
+{
+    return GREY_WIDTH_NAME(grey_parse_binstr, GREY_UINTBITS)(str, length,
+                                                             grey);
+}
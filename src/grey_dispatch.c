@@ -0,0 +1,462 @@
+/**
+ * @file
+ * @brief Runtime selection of the bulk conversion kernels.
+ *
+ * The CPU features are probed once when the library is loaded and the
+ * kernels of the widest supported instruction set are copied into
+ * #grey_kernels, which the public bulk functions call through.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** Elements converted by each timing of grey_kernel_tune(). */
+#define GREY_TUNE_LENGTH 2048U
+/** Shortest timing of grey_kernel_tune(), in clock() ticks: 100 us. */
+#define GREY_TUNE_TICKS ((clock_t) (CLOCKS_PER_SEC / 10000))
+/** Timings of each kernel by grey_kernel_tune(), the fastest one counts. */
+#define GREY_TUNE_RUNS 3U
+
+#define GREY_KERNEL_TABLE(isa, kernel_id) \
+    { \
+        .to8 = grey_##isa##_to8, \
+        .from8 = grey_##isa##_from8, \
+        .to16 = grey_##isa##_to16, \
+        .from16 = grey_##isa##_from16, \
+        .to32 = grey_##isa##_to32, \
+        .from32 = grey_##isa##_from32, \
+        .to64 = grey_##isa##_to64, \
+        .from64 = grey_##isa##_from64, \
+        .words_to_le = grey_##isa##_words_to_le, \
+        .words_to_be = grey_##isa##_words_to_be, \
+        .words_from_le = grey_##isa##_words_from_le, \
+        .words_from_be = grey_##isa##_words_from_be, \
+        .fill8 = grey_##isa##_fill8, \
+        .fill16 = grey_##isa##_fill16, \
+        .fill32 = grey_##isa##_fill32, \
+        .fill64 = grey_##isa##_fill64, \
+        .hilbert_index2 = grey_##isa##_hilbert_index2, \
+        .hilbert_coords2 = grey_##isa##_hilbert_coords2, \
+        .hilbert_index3 = grey_##isa##_hilbert_index3, \
+        .hilbert_coords3 = grey_##isa##_hilbert_coords3, \
+        .distances8 = grey_##isa##_distances8, \
+        .distances16 = grey_##isa##_distances16, \
+        .distances32 = grey_##isa##_distances32, \
+        .distances64 = grey_##isa##_distances64, \
+        .id = (kernel_id), \
+    }
+
+static const grey_kernel_table_t grey_kernels_scalar =
+        GREY_KERNEL_TABLE(scalar, GREY_KERNEL_SCALAR);
+#if defined(GREY_KERNELS_SSE2)
+static const grey_kernel_table_t grey_kernels_sse2 =
+        GREY_KERNEL_TABLE(sse2, GREY_KERNEL_SSE2);
+#endif
+#if defined(GREY_KERNELS_AVX2)
+static const grey_kernel_table_t grey_kernels_avx2 =
+        GREY_KERNEL_TABLE(avx2, GREY_KERNEL_AVX2);
+#endif
+#if defined(GREY_KERNELS_AVX512)
+static const grey_kernel_table_t grey_kernels_avx512 =
+        GREY_KERNEL_TABLE(avx512, GREY_KERNEL_AVX512);
+#endif
+
+/**
+ * Like #GREY_KERNEL_TABLE, but with the 64-bit and multiword decoders of
+ * the \p from64_isa instruction set.
+ */
+#define GREY_KERNEL_TABLE_FROM64(isa, from64_isa, kernel_id) \
+    { \
+        .to8 = grey_##isa##_to8, \
+        .from8 = grey_##isa##_from8, \
+        .to16 = grey_##isa##_to16, \
+        .from16 = grey_##isa##_from16, \
+        .to32 = grey_##isa##_to32, \
+        .from32 = grey_##isa##_from32, \
+        .to64 = grey_##isa##_to64, \
+        .from64 = grey_##from64_isa##_from64, \
+        .words_to_le = grey_##isa##_words_to_le, \
+        .words_to_be = grey_##isa##_words_to_be, \
+        .words_from_le = grey_##from64_isa##_words_from_le, \
+        .words_from_be = grey_##from64_isa##_words_from_be, \
+        .fill8 = grey_##isa##_fill8, \
+        .fill16 = grey_##isa##_fill16, \
+        .fill32 = grey_##isa##_fill32, \
+        .fill64 = grey_##isa##_fill64, \
+        .hilbert_index2 = grey_##isa##_hilbert_index2, \
+        .hilbert_coords2 = grey_##isa##_hilbert_coords2, \
+        .hilbert_index3 = grey_##isa##_hilbert_index3, \
+        .hilbert_coords3 = grey_##isa##_hilbert_coords3, \
+        .distances8 = grey_##isa##_distances8, \
+        .distances16 = grey_##isa##_distances16, \
+        .distances32 = grey_##isa##_distances32, \
+        .distances64 = grey_##isa##_distances64, \
+        .id = (kernel_id), \
+    }
+
+#if defined(GREY_KERNELS_PCLMUL) && defined(GREY_KERNELS_SSE2)
+static const grey_kernel_table_t grey_kernels_pclmul =
+        GREY_KERNEL_TABLE_FROM64(sse2, pclmul,
+                                 GREY_KERNEL_PCLMUL);
+#endif
+#if defined(GREY_KERNELS_VPCLMUL) && defined(GREY_KERNELS_AVX512)
+static const grey_kernel_table_t grey_kernels_vpclmul =
+        GREY_KERNEL_TABLE_FROM64(avx512, vpclmul,
+                                 GREY_KERNEL_VPCLMUL);
+#endif
+
+/**
+ * Like #GREY_KERNEL_TABLE, but with the conversion kernels of the
+ * \p convert_isa instruction set.
+ */
+#define GREY_KERNEL_TABLE_CONVERT(isa, convert_isa, kernel_id) \
+    { \
+        .to8 = grey_##convert_isa##_to8, \
+        .from8 = grey_##convert_isa##_from8, \
+        .to16 = grey_##convert_isa##_to16, \
+        .from16 = grey_##convert_isa##_from16, \
+        .to32 = grey_##convert_isa##_to32, \
+        .from32 = grey_##convert_isa##_from32, \
+        .to64 = grey_##convert_isa##_to64, \
+        .from64 = grey_##convert_isa##_from64, \
+        .words_to_le = grey_##isa##_words_to_le, \
+        .words_to_be = grey_##isa##_words_to_be, \
+        .words_from_le = grey_##isa##_words_from_le, \
+        .words_from_be = grey_##isa##_words_from_be, \
+        .fill8 = grey_##isa##_fill8, \
+        .fill16 = grey_##isa##_fill16, \
+        .fill32 = grey_##isa##_fill32, \
+        .fill64 = grey_##isa##_fill64, \
+        .hilbert_index2 = grey_##isa##_hilbert_index2, \
+        .hilbert_coords2 = grey_##isa##_hilbert_coords2, \
+        .hilbert_index3 = grey_##isa##_hilbert_index3, \
+        .hilbert_coords3 = grey_##isa##_hilbert_coords3, \
+        .distances8 = grey_##isa##_distances8, \
+        .distances16 = grey_##isa##_distances16, \
+        .distances32 = grey_##isa##_distances32, \
+        .distances64 = grey_##isa##_distances64, \
+        .id = (kernel_id), \
+    }
+
+static const grey_kernel_table_t grey_kernels_lut =
+        GREY_KERNEL_TABLE_CONVERT(scalar, lut, GREY_KERNEL_LUT);
+
+/* Valid even before the load-time selection runs. */
+grey_kernel_table_t grey_kernels = GREY_KERNEL_TABLE(scalar,
+                                                     GREY_KERNEL_SCALAR);
+
+static const char* const grey_kernel_names[] = {
+        [GREY_KERNEL_AUTO] = "auto",
+        [GREY_KERNEL_SCALAR] = "scalar",
+        [GREY_KERNEL_SSE2] = "sse2",
+        [GREY_KERNEL_AVX2] = "avx2",
+        [GREY_KERNEL_AVX512] = "avx512",
+        [GREY_KERNEL_PCLMUL] = "pclmul",
+        [GREY_KERNEL_VPCLMUL] = "vpclmul",
+        [GREY_KERNEL_LUT] = "lut",
+};
+#define GREY_KERNEL_AMOUNT \
+    (sizeof(grey_kernel_names) / sizeof(grey_kernel_names[0]))
+
+/**
+ * Kernel of each conversion in #grey_kernels, encoding then decoding,
+ * for the widths of 8, 16, 32 and 64 bits.
+ */
+static grey_kernel_t grey_kernel_widths[2][4] = {
+        {GREY_KERNEL_SCALAR, GREY_KERNEL_SCALAR,
+         GREY_KERNEL_SCALAR, GREY_KERNEL_SCALAR},
+        {GREY_KERNEL_SCALAR, GREY_KERNEL_SCALAR,
+         GREY_KERNEL_SCALAR, GREY_KERNEL_SCALAR},
+};
+
+/**
+ * Kernels of the given instruction set, if both compiled in and supported
+ * by the running CPU (and operating system, for the wider registers).
+ */
+static const grey_kernel_table_t* grey_kernel_table(const grey_kernel_t kernel)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+#endif
+    switch (kernel)
+    {
+        case GREY_KERNEL_SCALAR:
+            return &grey_kernels_scalar;
+#if defined(GREY_KERNELS_SSE2)
+        case GREY_KERNEL_SSE2:
+            return __builtin_cpu_supports("sse2")
+                   ? &grey_kernels_sse2 : NULL;
+#else
+        case GREY_KERNEL_SSE2:
+            return NULL;
+#endif
+#if defined(GREY_KERNELS_AVX2)
+        case GREY_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2")
+                   ? &grey_kernels_avx2 : NULL;
+#else
+        case GREY_KERNEL_AVX2:
+            return NULL;
+#endif
+#if defined(GREY_KERNELS_AVX512)
+        case GREY_KERNEL_AVX512:
+            return (__builtin_cpu_supports("avx512f")
+                    && __builtin_cpu_supports("avx512bw"))
+                   ? &grey_kernels_avx512 : NULL;
+#else
+        case GREY_KERNEL_AVX512:
+            return NULL;
+#endif
+#if defined(GREY_KERNELS_PCLMUL) && defined(GREY_KERNELS_SSE2)
+        case GREY_KERNEL_PCLMUL:
+            return (__builtin_cpu_supports("sse2")
+                    && __builtin_cpu_supports("pclmul"))
+                   ? &grey_kernels_pclmul : NULL;
+#else
+        case GREY_KERNEL_PCLMUL:
+            return NULL;
+#endif
+#if defined(GREY_KERNELS_VPCLMUL) && defined(GREY_KERNELS_AVX512)
+        case GREY_KERNEL_VPCLMUL:
+            return (__builtin_cpu_supports("avx512f")
+                    && __builtin_cpu_supports("avx512bw")
+                    && __builtin_cpu_supports("vpclmulqdq"))
+                   ? &grey_kernels_vpclmul : NULL;
+#else
+        case GREY_KERNEL_VPCLMUL:
+            return NULL;
+#endif
+        case GREY_KERNEL_LUT:
+            grey_lut_init();
+            return &grey_kernels_lut;
+        case GREY_KERNEL_AUTO:
+        default:
+            return NULL;
+    }
+}
+
+#if defined(GREY_KERNELS_VPOPCNT)
+/**
+ * Switches the AVX-512 kernels in \p table to the distance kernels
+ * counting bits with `VPOPCNT` when the CPU has it, which is not part of
+ * what selects an AVX-512 kernel.
+ */
+static void grey_kernel_vpopcnt(grey_kernel_table_t* const table)
+{
+    if ((table->id == GREY_KERNEL_AVX512 || table->id == GREY_KERNEL_VPCLMUL)
+        && __builtin_cpu_supports("avx512vpopcntdq")
+        && __builtin_cpu_supports("avx512bitalg"))
+    {
+        table->distances8 = grey_vpopcnt_distances8;
+        table->distances16 = grey_vpopcnt_distances16;
+        table->distances32 = grey_vpopcnt_distances32;
+        table->distances64 = grey_vpopcnt_distances64;
+    }
+}
+#endif
+
+grey_err_t grey_kernel_force(grey_kernel_t kernel)
+{
+    const grey_kernel_table_t* table = NULL;
+    if (kernel == GREY_KERNEL_AUTO)
+    {
+        /* Try from the fastest down, the scalar one always succeeds. */
+        for (kernel = GREY_KERNEL_AVX512; table == NULL; kernel--)
+        {
+            table = grey_kernel_table(kernel);
+        }
+    }
+    else
+    {
+        table = grey_kernel_table(kernel);
+    }
+    if (table == NULL)
+    {
+        return GREY_ERR_UNSUPPORTED;
+    }
+    grey_kernels = *table;
+#if defined(GREY_KERNELS_VPOPCNT)
+    grey_kernel_vpopcnt(&grey_kernels);
+#endif
+    for (size_t width = 0; width < 4U; width++)
+    {
+        grey_kernel_widths[0][width] = table->id;
+        grey_kernel_widths[1][width] = table->id;
+    }
+    return GREY_OK;
+}
+
+grey_kernel_t grey_kernel_active(void)
+{
+    return grey_kernels.id;
+}
+
+grey_kernel_t grey_kernel_active_width(const unsigned int bits,
+                                       const bool decode)
+{
+    switch (bits)
+    {
+        case 8:
+            return grey_kernel_widths[decode][0];
+        case 16:
+            return grey_kernel_widths[decode][1];
+        case 32:
+            return grey_kernel_widths[decode][2];
+        case 64:
+            return grey_kernel_widths[decode][3];
+        default:
+            return GREY_KERNEL_AUTO;
+    }
+}
+
+/**
+ * Defines the timing of the \p bits -wide kernels by grey_kernel_tune(),
+ * and the tuning of the two conversions of \p tuned at that width, whose
+ * index is \p width in #grey_kernel_widths.
+ *
+ * The timing doubles the repetitions of the in-place conversion of the
+ * buffer until they take #GREY_TUNE_TICKS, then returns the fastest of
+ * #GREY_TUNE_RUNS timings, in ticks per conversion. The tuning replaces
+ * a kernel of \p tuned only with a strictly faster one.
+ */
+#define GREY_TUNE_WIDTH_DEFINE(bits, type, width) \
+    static double grey_tune_time##bits(const grey_kernel##bits##_fn kernel, \
+                                       type* const buffer) \
+    { \
+        size_t reps = 1; \
+        clock_t elapsed; \
+        do \
+        { \
+            reps *= 2U; \
+            const clock_t start = clock(); \
+            for (size_t i = 0; i < reps; i++) \
+            { \
+                kernel(buffer, buffer, GREY_TUNE_LENGTH); \
+            } \
+            elapsed = clock() - start; \
+        } while (elapsed < GREY_TUNE_TICKS); \
+        double fastest = (double) elapsed; \
+        for (size_t run = 0; run < GREY_TUNE_RUNS; run++) \
+        { \
+            const clock_t start = clock(); \
+            for (size_t i = 0; i < reps; i++) \
+            { \
+                kernel(buffer, buffer, GREY_TUNE_LENGTH); \
+            } \
+            elapsed = clock() - start; \
+            fastest = ((double) elapsed < fastest) ? (double) elapsed \
+                                                   : fastest; \
+        } \
+        return fastest / (double) reps; \
+    } \
+    static void grey_tune##bits(grey_kernel_table_t* const tuned, \
+                                type* const buffer) \
+    { \
+        double to_fastest = grey_tune_time##bits(tuned->to##bits, buffer); \
+        double from_fastest = grey_tune_time##bits(tuned->from##bits, \
+                                                   buffer); \
+        for (size_t i = GREY_KERNEL_SCALAR; i < GREY_KERNEL_AMOUNT; i++) \
+        { \
+            const grey_kernel_t kernel = (grey_kernel_t) i; \
+            const grey_kernel_table_t* const table = \
+                    grey_kernel_table(kernel); \
+            if (table == NULL || kernel == tuned->id) \
+            { \
+                continue; \
+            } \
+            const double to = grey_tune_time##bits(table->to##bits, buffer); \
+            if (to < to_fastest) \
+            { \
+                to_fastest = to; \
+                tuned->to##bits = table->to##bits; \
+                grey_kernel_widths[0][width] = kernel; \
+            } \
+            const double from = grey_tune_time##bits(table->from##bits, \
+                                                     buffer); \
+            if (from < from_fastest) \
+            { \
+                from_fastest = from; \
+                tuned->from##bits = table->from##bits; \
+                grey_kernel_widths[1][width] = kernel; \
+            } \
+        } \
+    }
+
+GREY_TUNE_WIDTH_DEFINE(8, uint8_t, 0)
+GREY_TUNE_WIDTH_DEFINE(16, uint16_t, 1)
+GREY_TUNE_WIDTH_DEFINE(32, uint32_t, 2)
+GREY_TUNE_WIDTH_DEFINE(64, uint64_t, 3)
+
+grey_err_t grey_kernel_tune(void)
+{
+    if (clock() == (clock_t) -1)
+    {
+        return GREY_ERR_UNSUPPORTED;
+    }
+    uint64_t* const buffer = malloc(GREY_TUNE_LENGTH * sizeof(uint64_t));
+    if (buffer == NULL)
+    {
+        return GREY_ERR_NOMEM;
+    }
+    for (size_t i = 0; i < GREY_TUNE_LENGTH; i++)
+    {
+        buffer[i] = i * UINT64_C(0x9E3779B97F4A7C15);
+    }
+    (void) grey_kernel_force(GREY_KERNEL_AUTO);
+    grey_kernel_table_t tuned = grey_kernels;
+    grey_tune8(&tuned, (uint8_t*) buffer);
+    grey_tune16(&tuned, (uint16_t*) buffer);
+    grey_tune32(&tuned, (uint32_t*) buffer);
+    grey_tune64(&tuned, buffer);
+    grey_kernels = tuned;
+    free(buffer);
+    return GREY_OK;
+}
+
+const char* grey_kernel_name(const grey_kernel_t kernel)
+{
+    if ((size_t) kernel >= GREY_KERNEL_AMOUNT)
+    {
+        return "unknown";
+    }
+    return grey_kernel_names[kernel];
+}
+
+/**
+ * Picks the kernel when the library is loaded: the one named by the
+ * `GREY_KERNEL` environment variable if valid and supported, the fastest
+ * one of each conversion if it is `tune`, otherwise the fastest one.
+ *
+ * Compilers without constructor support keep the scalar kernels until
+ * grey_kernel_force() is called.
+ */
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void grey_kernel_init(void)
+{
+    const char* const requested = getenv("GREY_KERNEL");
+    if (requested != NULL && strcmp(requested, "tune") == 0
+        && grey_kernel_tune() == GREY_OK)
+    {
+        return;
+    }
+    if (requested != NULL)
+    {
+        for (size_t i = 0; i < GREY_KERNEL_AMOUNT; i++)
+        {
+            if (strcmp(requested, grey_kernel_names[i]) == 0
+                && grey_kernel_force((grey_kernel_t) i) == GREY_OK)
+            {
+                return;
+            }
+        }
+    }
+    (void) grey_kernel_force(GREY_KERNEL_AUTO);
+}
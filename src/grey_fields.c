@@ -0,0 +1,368 @@
+/**
+ * @file
+ * @brief Conversion of Grey codes of any width from 1 to 64 bits, packed
+ * back-to-back in a bitstream, as read from absolute encoders.
+ *
+ * The packed fields are converted without unpacking them: the stream is
+ * loaded 64 bits at a time into words where, in both bit orders, a higher
+ * bit is a more significant bit of its field. Each field then converts as
+ * a 64-bit integer would, except that the bits must not cross the top bit
+ * of their field, which a mask of the top bits of the fields in the word
+ * stops. The mask repeats every \p bits words, so it is computed once per
+ * call. Fields split across two words take the missing bit from the more
+ * significant word, converted just before.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include <string.h>
+
+/** Bits that are the top bit of a field, for each word of the period. */
+typedef struct
+{
+    uint64_t tops[64];
+    /** Bits of the word above its highest top bit. */
+    uint64_t leads[64];
+} grey_fields_masks_t;
+
+/** Mask of the lowest \p bits bits, 1 to 64. */
+static inline uint64_t grey_fields_mask(const unsigned int bits)
+{
+    return UINT64_MAX >> (64U - bits);
+}
+
+static bool grey_fields_valid(const unsigned int bits,
+                              const grey_field_order_t order)
+{
+    return bits >= 1U && bits <= 64U
+           && (order == GREY_FIELDS_MSB_FIRST
+               || order == GREY_FIELDS_LSB_FIRST);
+}
+
+/** Byte order of a word loaded from the stream as the fields need it. */
+static inline uint64_t grey_fields_order(const uint64_t word, const bool msb)
+{
+    const uint16_t one = 1U;
+    const bool little = *(const uint8_t*) &one == 1U;
+    if (msb != little)
+    {
+        return word;
+    }
+#if defined(__GNUC__)
+    return __builtin_bswap64(word);
+#else
+    uint64_t swapped = 0;
+    for (unsigned int i = 0; i < 8U; i++)
+    {
+        swapped = (swapped << 8U) | ((word >> (8U * i)) & 0xFFU);
+    }
+    return swapped;
+#endif
+}
+
+/**
+ * Loads the word \p index of the stream of \p size bytes, with zeros
+ * past its end.
+ */
+static inline uint64_t grey_fields_load(const uint8_t* const stream,
+                                        const size_t size, const size_t index,
+                                        const bool msb)
+{
+    uint64_t word = 0;
+    const size_t left = size - index * 8U;
+    if (left >= 8U)
+    {
+        memcpy(&word, &stream[index * 8U], 8U);
+        return grey_fields_order(word, msb);
+    }
+    uint8_t bytes[8] = {0};
+    memcpy(bytes, &stream[index * 8U], left);
+    memcpy(&word, bytes, 8U);
+    return grey_fields_order(word, msb);
+}
+
+/**
+ * Stores the word \p index of the stream of \p size bytes, keeping the
+ * bits of the stream outside of \p valid.
+ */
+static inline void grey_fields_store(uint8_t* const stream, const size_t size,
+                                     const size_t index, uint64_t word,
+                                     const uint64_t valid, const bool msb)
+{
+    if (valid != UINT64_MAX)
+    {
+        word = (word & valid)
+               | (grey_fields_load(stream, size, index, msb) & ~valid);
+    }
+    word = grey_fields_order(word, msb);
+    const size_t left = size - index * 8U;
+    memcpy(&stream[index * 8U], &word, (left < 8U) ? left : 8U);
+}
+
+/** Bits of the last word of the stream of \p total bits that are in it. */
+static uint64_t grey_fields_tail(const size_t total, const bool msb)
+{
+    const unsigned int used = (unsigned int) ((total - 1U) % 64U) + 1U;
+    return msb ? UINT64_MAX << (64U - used) : grey_fields_mask(used);
+}
+
+/** The masks of the first min(\p bits, \p words) words of the stream. */
+static void grey_fields_masks(grey_fields_masks_t* const masks,
+                              const unsigned int bits, const size_t words,
+                              const bool msb)
+{
+    const size_t period = (words < bits) ? words : bits;
+    for (size_t index = 0; index < period; index++)
+    {
+        /* Offset in the word of the first bit of the stream that is the
+         * top bit of a field: the first of it, or the last if LSB first */
+        const unsigned int shift = (unsigned int) (index * 64U % bits);
+        unsigned int offset = msb ? (bits - shift) % bits
+                                  : (2U * bits - 1U - shift) % bits;
+        /* The first top bit is the highest one if MSB first, else last */
+        const unsigned int highest = msb ? 63U - offset
+                                         : offset + (63U - offset) / bits
+                                                    * bits;
+        uint64_t tops = 0;
+        for (; offset < 64U; offset += bits)
+        {
+            tops |= 1ULL << (msb ? 63U - offset : offset);
+        }
+        masks->tops[index] = tops;
+        masks->leads[index] = (highest == 63U) ? 0U
+                                               : UINT64_MAX << (highest + 1U);
+    }
+}
+
+/**
+ * Converts the \p words words of the stream of \p size bytes, from the
+ * most significant one. Inlined with constant \p msb and \p decode, so
+ * the loop has no other branches than for the last word.
+ */
+static inline void grey_fields_words(const uint8_t* const input,
+                                     uint8_t* const output,
+                                     const size_t size, const size_t words,
+                                     const uint64_t tail,
+                                     const unsigned int bits,
+                                     const grey_fields_masks_t* const masks,
+                                     const bool msb, const bool decode)
+{
+    size_t index = msb ? 0U : words - 1U;
+    size_t period = msb ? 0U : (size_t) ((words - 1U) % bits);
+    /* Bit 0 of the more significant word, before or after decoding */
+    uint64_t carry = 0;
+    for (size_t done = 0; done < words; done++)
+    {
+        uint64_t word = grey_fields_load(input, size, index, msb);
+        const uint64_t tops = masks->tops[period];
+        if (decode)
+        {
+            uint64_t stops = tops;
+            for (unsigned int shift = 1U; shift < 64U; shift *= 2U)
+            {
+                word ^= (word >> shift) & ~stops;
+                stops |= stops >> shift;
+            }
+            word ^= masks->leads[period] & (0U - carry);
+            carry = word & 1U;
+        }
+        else
+        {
+            const uint64_t next_carry = word & 1U;
+            word ^= ((word >> 1U) | (carry << 63U)) & ~tops;
+            carry = next_carry;
+        }
+        grey_fields_store(output, size, index, word,
+                          (index == words - 1U) ? tail : UINT64_MAX, msb);
+        if (msb)
+        {
+            index++;
+            period = (period + 1U == bits) ? 0U : period + 1U;
+        }
+        else
+        {
+            index--;
+            period = (period == 0U) ? bits - 1U : period - 1U;
+        }
+    }
+}
+
+/** Shared by grey_fields_to() and grey_fields_from(). */
+static grey_err_t grey_fields_convert(const void* const input,
+                                      void* const output,
+                                      const unsigned int bits,
+                                      const size_t amount,
+                                      const grey_field_order_t order,
+                                      const bool decode)
+{
+    if (!grey_fields_valid(bits, order))
+    {
+        return GREY_ERR_INVALID;
+    }
+    if (amount == 0U)
+    {
+        return GREY_OK;
+    }
+    const bool msb = order == GREY_FIELDS_MSB_FIRST;
+    const size_t total = (size_t) bits * amount;
+    const size_t size = (total + 7U) / 8U;
+    const size_t words = (total + 63U) / 64U;
+    const uint64_t tail = grey_fields_tail(total, msb);
+    grey_fields_masks_t masks;
+    grey_fields_masks(&masks, bits, words, msb);
+    if (msb && decode)
+    {
+        grey_fields_words(input, output, size, words, tail, bits, &masks,
+                          true, true);
+    }
+    else if (msb)
+    {
+        grey_fields_words(input, output, size, words, tail, bits, &masks,
+                          true, false);
+    }
+    else if (decode)
+    {
+        grey_fields_words(input, output, size, words, tail, bits, &masks,
+                          false, true);
+    }
+    else
+    {
+        grey_fields_words(input, output, size, words, tail, bits, &masks,
+                          false, false);
+    }
+    return GREY_OK;
+}
+
+uint64_t grey_to_bits(const uint64_t value, const unsigned int bits)
+{
+    return grey_inline_to64(value & grey_fields_mask(bits));
+}
+
+uint64_t grey_from_bits(const uint64_t code, const unsigned int bits)
+{
+    return grey_inline_from64(code & grey_fields_mask(bits));
+}
+
+grey_err_t grey_fields_to(const void* const values, void* const codes,
+                          const unsigned int bits, const size_t amount,
+                          const grey_field_order_t order)
+{
+    return grey_fields_convert(values, codes, bits, amount, order, false);
+}
+
+grey_err_t grey_fields_from(const void* const codes, void* const values,
+                            const unsigned int bits, const size_t amount,
+                            const grey_field_order_t order)
+{
+    return grey_fields_convert(codes, values, bits, amount, order, true);
+}
+
+grey_err_t grey_fields_unpack_from(const void* const codes,
+                                   uint64_t* const values,
+                                   const unsigned int bits,
+                                   const size_t amount,
+                                   const grey_field_order_t order)
+{
+    if (!grey_fields_valid(bits, order))
+    {
+        return GREY_ERR_INVALID;
+    }
+    const bool msb = order == GREY_FIELDS_MSB_FIRST;
+    const size_t size = GREY_FIELDS_BYTES(bits, amount);
+    const uint64_t mask = grey_fields_mask(bits);
+    size_t index = 0;
+    unsigned int offset = 0;  /* Of the field in the stream order */
+    uint64_t word = (amount > 0U) ? grey_fields_load(codes, size, 0, msb) : 0U;
+    for (size_t i = 0; i < amount; i++)
+    {
+        uint64_t code;
+        const unsigned int end = offset + bits;
+        if (end <= 64U)
+        {
+            code = msb ? word >> (64U - end) : word >> offset;
+        }
+        else
+        {
+            /* Split across words: the first part is the top one if MSB */
+            const unsigned int rest = end - 64U;
+            const uint64_t next = grey_fields_load(codes, size, index + 1U,
+                                                   msb);
+            code = msb ? (word << rest) | (next >> (64U - rest))
+                       : (word >> offset) | (next << (64U - offset));
+        }
+        values[i] = code & mask;
+        offset = end;
+        if (offset >= 64U)
+        {
+            offset -= 64U;
+            index++;
+            if (i + 1U < amount)
+            {
+                word = grey_fields_load(codes, size, index, msb);
+            }
+        }
+    }
+    grey_from_array_inplace64(values, amount);
+    return GREY_OK;
+}
+
+grey_err_t grey_fields_pack_to(const uint64_t* const values,
+                               void* const codes, const unsigned int bits,
+                               const size_t amount,
+                               const grey_field_order_t order)
+{
+    if (!grey_fields_valid(bits, order))
+    {
+        return GREY_ERR_INVALID;
+    }
+    if (amount == 0U)
+    {
+        return GREY_OK;
+    }
+    const bool msb = order == GREY_FIELDS_MSB_FIRST;
+    const size_t total = (size_t) bits * amount;
+    const size_t size = (total + 7U) / 8U;
+    const size_t words = (total + 63U) / 64U;
+    const uint64_t tail = grey_fields_tail(total, msb);
+    size_t index = 0;
+    unsigned int offset = 0;
+    uint64_t word = 0;
+    for (size_t i = 0; i < amount; i++)
+    {
+        const uint64_t code = grey_to_bits(values[i], bits);
+        const unsigned int end = offset + bits;
+        if (end <= 64U)
+        {
+            word |= msb ? code << (64U - end) : code << offset;
+        }
+        else
+        {
+            const unsigned int rest = end - 64U;
+            word |= msb ? code >> rest : code << offset;
+        }
+        if (end >= 64U)
+        {
+            grey_fields_store(codes, size, index, word,
+                              (index == words - 1U) ? tail : UINT64_MAX,
+                              msb);
+            index++;
+            offset = end - 64U;
+            /* The bits of the code that did not fit, if any */
+            word = (offset == 0U) ? 0U
+                                  : msb ? code << (64U - offset)
+                                        : code >> (bits - offset);
+        }
+        else
+        {
+            offset = end;
+        }
+    }
+    if (offset > 0U)
+    {
+        grey_fields_store(codes, size, index, word, tail, msb);
+    }
+    return GREY_OK;
+}
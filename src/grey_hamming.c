@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @brief Hamming distances between Grey codes and the Hamming ball around
+ * a code.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "grey_kernels.h"
+#include "grey_stats.h"
+
+/**
+ * Bytes of codes measured against all the queries at once by
+ * grey_distances_many(), half of a typical L1 data cache.
+ */
+#define GREY_HAMMING_TILE_BYTES 16384U
+
+#define GREY_DISTANCES_WIDTH_DEFINE(bits, type) \
+    void grey_distances##bits(const type query, const type* const codes, \
+                              uint8_t* const distances, const size_t amount) \
+    { \
+        GREY_STATS_RECORD(GREY_STATS_DISTANCES, grey_kernels.id, amount, \
+                          amount * (sizeof(type) + 1U), \
+                          grey_kernels.distances##bits(query, codes, \
+                                                       distances, amount)); \
+    } \
+    static inline void grey_distances_tiled##bits( \
+            const type* const queries, const size_t queries_amount, \
+            const type* const codes, const size_t amount, \
+            uint8_t* const distances) \
+    { \
+        const size_t tile = GREY_HAMMING_TILE_BYTES / sizeof(type); \
+        for (size_t start = 0; start < amount; start += tile) \
+        { \
+            const size_t length = (amount - start < tile) \
+                                  ? amount - start : tile; \
+            for (size_t q = 0; q < queries_amount; q++) \
+            { \
+                grey_kernels.distances##bits( \
+                        queries[q], &codes[start], \
+                        &distances[q * amount + start], length); \
+            } \
+        } \
+    } \
+    void grey_distances_many##bits(const type* const queries, \
+                                   const size_t queries_amount, \
+                                   const type* const codes, \
+                                   const size_t amount, \
+                                   uint8_t* const distances) \
+    { \
+        GREY_STATS_RECORD(GREY_STATS_DISTANCES, grey_kernels.id, \
+                          queries_amount * amount, \
+                          queries_amount * amount * (sizeof(type) + 1U), \
+                          grey_distances_tiled##bits(queries, queries_amount, \
+                                                     codes, amount, \
+                                                     distances)); \
+    }
+
+GREY_DISTANCES_WIDTH_DEFINE(8, uint8_t)
+GREY_DISTANCES_WIDTH_DEFINE(16, uint16_t)
+GREY_DISTANCES_WIDTH_DEFINE(32, uint32_t)
+GREY_DISTANCES_WIDTH_DEFINE(64, uint64_t)
+
+void grey_distances(const grey_code_t query, const grey_code_t* const codes,
+                    uint8_t* const distances, const size_t amount)
+{
+    GREY_STATS_RECORD(GREY_STATS_DISTANCES, grey_kernels.id, amount,
+                      amount * (sizeof(grey_code_t) + 1U),
+                      GREY_KERNEL(distances)(query, codes, distances,
+                                             amount));
+}
+
+/** grey_distances_many<bits>() at the #GREY_UINTBITS width. */
+#define GREY_DISTANCES_MANY_(bits) grey_distances_many##bits
+#define GREY_DISTANCES_MANY(bits) GREY_DISTANCES_MANY_(bits)
+
+void grey_distances_many(const grey_code_t* const queries,
+                         const size_t queries_amount,
+                         const grey_code_t* const codes, const size_t amount,
+                         uint8_t* const distances)
+{
+    GREY_DISTANCES_MANY(GREY_UINTBITS)(queries, queries_amount, codes, amount,
+                                       distances);
+}
+
+grey_err_t grey_ball_iter_init(grey_ball_iter_t* const iter,
+                               const grey_code_t center,
+                               const unsigned int radius)
+{
+    if (radius > GREY_UINTBITS)
+    {
+        return GREY_ERR_INVALID;
+    }
+    iter->center = center;
+    iter->flips = 0;
+    iter->distance = 0;
+    iter->radius = (uint8_t) radius;
+    return GREY_OK;
+}
+
+size_t grey_ball_iter_fill(grey_ball_iter_t* const iter,
+                           grey_code_t* const codes, const size_t max)
+{
+    size_t written = 0;
+    while (written < max && grey_ball_iter_next(iter, &codes[written]))
+    {
+        written++;
+    }
+    return written;
+}
@@ -0,0 +1,292 @@
+/**
+ * @file
+ * @brief Hilbert curve indices in 2, 3 and any number of dimensions.
+ *
+ * All of them follow the algorithm of Skilling ("Programming the Hilbert
+ * curve", 2004), working on the coordinates in place: from the most
+ * significant level, the lower bits of the coordinates are exchanged or
+ * inverted according to the bits of the level, then the coordinates are
+ * Grey-encoded across the dimensions and along the levels, and the index
+ * is made of their bits interleaved.
+ *
+ * - Any number of dimensions: the algorithm as is, one level and one
+ *   dimension at a time.
+ * - 3-D points: the exchanges and inversions so far are one of 48
+ *   states, so a table converts two levels at a time, see
+ *   grey_hilbert_tables.h.
+ * - 2-D points and arrays, 3-D arrays: without loops over the levels in
+ *   2-D, without branches in 3-D, see grey_hilbert_kernels.h.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_hilbert_kernels.h"
+#include "grey_hilbert_tables.h"
+#include "grey_kernels.h"
+#include "grey_stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Dimensions of grey_hilbert_index() copied on the stack, not the heap. */
+#define GREY_HILBERT_STACK_DIMS 64U
+
+uint64_t grey_hilbert_index2(const uint32_t x, const uint32_t y,
+                             const unsigned int bits)
+{
+    return grey_hilbert_bitwise_index2(x, y, bits);
+}
+
+void grey_hilbert_coords2(const uint64_t index, const unsigned int bits,
+                          uint32_t* const x, uint32_t* const y)
+{
+    grey_hilbert_bitwise_coords2(index, bits, x, y);
+}
+
+uint64_t grey_hilbert_index3(const uint32_t x, const uint32_t y,
+                             const uint32_t z, const unsigned int bits)
+{
+    uint64_t index = 0;
+    unsigned int state = 0;
+    unsigned int take;
+    for (unsigned int level = bits; level > 0U; level -= take)
+    {
+        take = (level < 2U) ? level : 2U;
+        const unsigned int pad = 2U - take;
+        const unsigned int shift = level - take;
+        const unsigned int key = ((((x >> shift) << pad) & 3U) << 4U)
+                                 | ((((y >> shift) << pad) & 3U) << 2U)
+                                 | (((z >> shift) << pad) & 3U);
+        const unsigned int entry = grey_hilbert_encode3[(state << 6U)
+                                                        | key];
+        index = (index << (3U * take)) | ((entry & 0x3FU) >> (3U * pad));
+        state = entry >> 6U;
+    }
+    return index;
+}
+
+void grey_hilbert_coords3(const uint64_t index, const unsigned int bits,
+                          uint32_t* const x, uint32_t* const y,
+                          uint32_t* const z)
+{
+    uint32_t x_value = 0;
+    uint32_t y_value = 0;
+    uint32_t z_value = 0;
+    unsigned int state = 0;
+    unsigned int take;
+    for (unsigned int level = bits; level > 0U; level -= take)
+    {
+        take = (level < 2U) ? level : 2U;
+        const unsigned int pad = 2U - take;
+        const unsigned int digits = (unsigned int) (
+                ((index >> (3U * (level - take))) << (3U * pad)) & 0x3FU);
+        const unsigned int entry = grey_hilbert_decode3[(state << 6U)
+                                                        | digits];
+        x_value = (x_value << take) | (((entry >> 4U) & 3U) >> pad);
+        y_value = (y_value << take) | (((entry >> 2U) & 3U) >> pad);
+        z_value = (z_value << take) | ((entry & 3U) >> pad);
+        state = entry >> 6U;
+    }
+    *x = x_value;
+    *y = y_value;
+    *z = z_value;
+}
+
+/**
+ * Skilling's algorithm: replaces the coordinates with the "transposed"
+ * Hilbert index, whose bits interleaved are the index.
+ */
+static void grey_hilbert_transpose(uint32_t* const coords, const size_t dims,
+                                   const unsigned int bits)
+{
+    for (unsigned int level = bits - 1U; level > 0U; level--)
+    {
+        const uint32_t lower = grey_hilbert_mask(level);
+        for (size_t i = 0; i < dims; i++)
+        {
+            if ((coords[i] >> level) & 1U)
+            {
+                coords[0] ^= lower;
+            }
+            else
+            {
+                const uint32_t exchanged = (coords[0] ^ coords[i]) & lower;
+                coords[0] ^= exchanged;
+                coords[i] ^= exchanged;
+            }
+        }
+    }
+    for (size_t i = 1; i < dims; i++)
+    {
+        coords[i] ^= coords[i - 1U];
+    }
+    /* Each level inverted by the parity of the last coordinate above it */
+    const uint32_t parity = grey_inline_from32(coords[dims - 1U]) >> 1U;
+    for (size_t i = 0; i < dims; i++)
+    {
+        coords[i] ^= parity;
+    }
+}
+
+/** The inverse of grey_hilbert_transpose(). */
+static void grey_hilbert_untranspose(uint32_t* const coords,
+                                     const size_t dims,
+                                     const unsigned int bits)
+{
+    const uint32_t parity = coords[dims - 1U] >> 1U;
+    for (size_t i = dims - 1U; i > 0U; i--)
+    {
+        coords[i] ^= coords[i - 1U];
+    }
+    coords[0] ^= parity;
+    for (unsigned int level = 1U; level < bits; level++)
+    {
+        const uint32_t lower = grey_hilbert_mask(level);
+        for (size_t i = dims; i-- > 0U;)
+        {
+            if ((coords[i] >> level) & 1U)
+            {
+                coords[0] ^= lower;
+            }
+            else
+            {
+                const uint32_t exchanged = (coords[0] ^ coords[i]) & lower;
+                coords[0] ^= exchanged;
+                coords[i] ^= exchanged;
+            }
+        }
+    }
+}
+
+grey_err_t grey_hilbert_index(const uint32_t* const coords, const size_t dims,
+                              const unsigned int bits, uint64_t* const index)
+{
+    if (dims == 0U || bits == 0U || bits > 32U || dims > SIZE_MAX / 32U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint32_t stack[GREY_HILBERT_STACK_DIMS];
+    uint32_t* transposed = stack;
+    if (dims > GREY_HILBERT_STACK_DIMS)
+    {
+        transposed = malloc(dims * sizeof(uint32_t));
+        if (transposed == NULL)
+        {
+            return GREY_ERR_NOMEM;
+        }
+    }
+    const uint32_t mask = grey_hilbert_mask(bits);
+    for (size_t i = 0; i < dims; i++)
+    {
+        transposed[i] = coords[i] & mask;
+    }
+    grey_hilbert_transpose(transposed, dims, bits);
+    memset(index, 0, GREY_WORDS(dims * bits) * sizeof(uint64_t));
+    /* The bit of the first coordinate is the highest of each level */
+    size_t position = dims * bits;
+    for (unsigned int level = bits; level-- > 0U;)
+    {
+        for (size_t i = 0; i < dims; i++)
+        {
+            position--;
+            index[position / 64U] |= (uint64_t) ((transposed[i] >> level)
+                                                 & 1U) << (position % 64U);
+        }
+    }
+    if (transposed != stack)
+    {
+        free(transposed);
+    }
+    return GREY_OK;
+}
+
+grey_err_t grey_hilbert_coords(const uint64_t* const index, const size_t dims,
+                               const unsigned int bits,
+                               uint32_t* const coords)
+{
+    if (dims == 0U || bits == 0U || bits > 32U || dims > SIZE_MAX / 32U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    memset(coords, 0, dims * sizeof(uint32_t));
+    size_t position = dims * bits;
+    for (unsigned int level = bits; level-- > 0U;)
+    {
+        for (size_t i = 0; i < dims; i++)
+        {
+            position--;
+            coords[i] |= (uint32_t) ((index[position / 64U]
+                                      >> (position % 64U)) & 1U) << level;
+        }
+    }
+    grey_hilbert_untranspose(coords, dims, bits);
+    return GREY_OK;
+}
+
+grey_err_t grey_hilbert_index2_array(const uint32_t* const x,
+                                     const uint32_t* const y,
+                                     uint64_t* const indices,
+                                     const size_t amount,
+                                     const unsigned int bits)
+{
+    if (bits == 0U || bits > GREY_HILBERT_MAX_BITS2)
+    {
+        return GREY_ERR_INVALID;
+    }
+    GREY_STATS_RECORD(GREY_STATS_HILBERT, grey_kernels.id, amount,
+                      amount * 16U,
+                      grey_kernels.hilbert_index2(x, y, indices, amount,
+                                                  bits));
+    return GREY_OK;
+}
+
+grey_err_t grey_hilbert_coords2_array(const uint64_t* const indices,
+                                      uint32_t* const x, uint32_t* const y,
+                                      const size_t amount,
+                                      const unsigned int bits)
+{
+    if (bits == 0U || bits > GREY_HILBERT_MAX_BITS2)
+    {
+        return GREY_ERR_INVALID;
+    }
+    GREY_STATS_RECORD(GREY_STATS_HILBERT, grey_kernels.id, amount,
+                      amount * 16U,
+                      grey_kernels.hilbert_coords2(indices, x, y, amount,
+                                                   bits));
+    return GREY_OK;
+}
+
+grey_err_t grey_hilbert_index3_array(const uint32_t* const x,
+                                     const uint32_t* const y,
+                                     const uint32_t* const z,
+                                     uint64_t* const indices,
+                                     const size_t amount,
+                                     const unsigned int bits)
+{
+    if (bits == 0U || bits > GREY_HILBERT_MAX_BITS3)
+    {
+        return GREY_ERR_INVALID;
+    }
+    GREY_STATS_RECORD(GREY_STATS_HILBERT, grey_kernels.id, amount,
+                      amount * 20U,
+                      grey_kernels.hilbert_index3(x, y, z, indices, amount,
+                                                  bits));
+    return GREY_OK;
+}
+
+grey_err_t grey_hilbert_coords3_array(const uint64_t* const indices,
+                                      uint32_t* const x, uint32_t* const y,
+                                      uint32_t* const z, const size_t amount,
+                                      const unsigned int bits)
+{
+    if (bits == 0U || bits > GREY_HILBERT_MAX_BITS3)
+    {
+        return GREY_ERR_INVALID;
+    }
+    GREY_STATS_RECORD(GREY_STATS_HILBERT, grey_kernels.id, amount,
+                      amount * 20U,
+                      grey_kernels.hilbert_coords3(indices, x, y, z, amount,
+                                                   bits));
+    return GREY_OK;
+}
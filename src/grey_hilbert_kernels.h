@@ -0,0 +1,357 @@
+/**
+ * @file
+ * @brief Internal bulk kernels of the Hilbert curve array functions.
+ *
+ * Not part of the public API: defined by #GREY_HILBERT_KERNELS_DEFINE in
+ * the file of each instruction set, so the same portable code is
+ * vectorized by the compiler for each of them, and selected at runtime
+ * with the other kernels, see grey_kernels.h.
+ *
+ * - 2-D: the bits of the index are computed all at once with prefix
+ *   operations over the levels, from the formulation of the curve as a
+ *   finite-state machine of 4 states, as they compose like 2x2 matrices
+ *   over GF(2). The index is then decoded with two grey_inline_from32().
+ * - 3-D: the algorithm of Skilling, with the branches replaced by masks,
+ *   over blocks of #GREY_HILBERT_BLOCK points, or with narrower vectors
+ *   the table of grey_hilbert_index3(), faster there.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef GREY_HILBERT_KERNELS_H
+#define GREY_HILBERT_KERNELS_H
+
+#include "grey.h"
+#include <string.h>
+
+/** Points converted together by the 3-D kernels. */
+#define GREY_HILBERT_BLOCK 16U
+
+/** Mask of the lowest \p bits bits, 1 to 32. */
+static inline uint32_t grey_hilbert_mask(const unsigned int bits)
+{
+    return UINT32_MAX >> (32U - bits);
+}
+
+/** Spreads the 32 bits of \p x to the even bits of the result. */
+static inline uint64_t grey_hilbert_spread2(const uint32_t x)
+{
+    uint64_t v = x;
+    v = (v | (v << 16U)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8U)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v << 4U)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v << 2U)) & 0x3333333333333333ULL;
+    v = (v | (v << 1U)) & 0x5555555555555555ULL;
+    return v;
+}
+
+/** Gathers the even bits of \p v, the inverse of grey_hilbert_spread2(). */
+static inline uint32_t grey_hilbert_gather2(uint64_t v)
+{
+    v &= 0x5555555555555555ULL;
+    v = (v | (v >> 1U)) & 0x3333333333333333ULL;
+    v = (v | (v >> 2U)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v >> 4U)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v >> 8U)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v >> 16U)) & 0x00000000FFFFFFFFULL;
+    return (uint32_t) v;
+}
+
+/** Spreads the lowest 21 bits of \p x to every third bit of the result. */
+static inline uint64_t grey_hilbert_spread3(const uint32_t x)
+{
+    uint64_t v = x & 0x1FFFFFU;
+    v = (v | (v << 32U)) & 0x001F00000000FFFFULL;
+    v = (v | (v << 16U)) & 0x001F0000FF0000FFULL;
+    v = (v | (v << 8U)) & 0x100F00F00F00F00FULL;
+    v = (v | (v << 4U)) & 0x10C30C30C30C30C3ULL;
+    v = (v | (v << 2U)) & 0x1249249249249249ULL;
+    return v;
+}
+
+/** Gathers every third bit of \p v, the inverse of grey_hilbert_spread3(). */
+static inline uint32_t grey_hilbert_gather3(uint64_t v)
+{
+    v &= 0x1249249249249249ULL;
+    v = (v | (v >> 2U)) & 0x10C30C30C30C30C3ULL;
+    v = (v | (v >> 4U)) & 0x100F00F00F00F00FULL;
+    v = (v | (v >> 8U)) & 0x001F0000FF0000FFULL;
+    v = (v | (v >> 16U)) & 0x001F00000000FFFFULL;
+    v = (v | (v >> 32U)) & 0x00000000001FFFFFULL;
+    return (uint32_t) v;
+}
+
+/**
+ * 2-D index of the point, without loops nor tables.
+ *
+ * The coordinates are aligned to the top, so that the most significant
+ * level is bit 31. At each level, the state of the curve so far is an
+ * exchange and an inversion of the quadrants: (a, b, c, d) encode the
+ * transformation of each level and the prefix scan composes them from the
+ * top one down, in log2(32) steps. Bits above \p bits are ignored.
+ */
+static inline uint64_t grey_hilbert_bitwise_index2(uint32_t x, uint32_t y,
+                                                   const unsigned int bits)
+{
+    const uint32_t ones = UINT32_MAX;
+    x <<= 32U - bits;
+    y <<= 32U - bits;
+    uint32_t a = x ^ y;
+    uint32_t b = ones ^ a;
+    uint32_t c = ones ^ (x | y);
+    uint32_t d = x & (y ^ ones);
+    uint32_t scan_a = a | (b >> 1U);
+    uint32_t scan_b = (a >> 1U) ^ a;
+    uint32_t scan_c = ((c >> 1U) ^ (b & (d >> 1U))) ^ c;
+    uint32_t scan_d = ((a & (c >> 1U)) ^ (d >> 1U)) ^ d;
+    for (unsigned int shift = 2U; shift < 32U; shift *= 2U)
+    {
+        a = scan_a;
+        b = scan_b;
+        c = scan_c;
+        d = scan_d;
+        scan_a = (a & (a >> shift)) ^ (b & (b >> shift));
+        scan_b = (a & (b >> shift)) ^ (b & ((a ^ b) >> shift));
+        scan_c ^= (a & (c >> shift)) ^ (b & (d >> shift));
+        scan_d ^= (b & (c >> shift)) ^ ((a ^ b) & (d >> shift));
+    }
+    a = scan_c ^ (scan_c >> 1U);
+    b = scan_d ^ (scan_d >> 1U);
+    const uint32_t low = x ^ y;
+    const uint32_t high = b | (ones ^ (low | a));
+    return ((grey_hilbert_spread2(high) << 1U) | grey_hilbert_spread2(low))
+            >> (64U - 2U * bits);
+}
+
+/**
+ * The inverse of grey_hilbert_bitwise_index2(): the exchanges and
+ * inversions are the parity of the levels above, so two Grey decodings.
+ */
+static inline void grey_hilbert_bitwise_coords2(uint64_t index,
+                                                const unsigned int bits,
+                                                uint32_t* const x,
+                                                uint32_t* const y)
+{
+    const uint32_t ones = UINT32_MAX;
+    index <<= 64U - 2U * bits;
+    const uint32_t low = grey_hilbert_gather2(index);
+    const uint32_t high = grey_hilbert_gather2(index >> 1U);
+    const uint32_t inverted = grey_inline_from32((low | high) ^ ones);
+    const uint32_t exchanged = grey_inline_from32(low & high);
+    const uint32_t swap = ((low ^ ones) & exchanged) | (low & inverted);
+    *x = (swap ^ high) >> (32U - bits);
+    *y = (swap ^ low ^ high) >> (32U - bits);
+}
+
+/**
+ * Skilling's transpose of #GREY_HILBERT_BLOCK points in 3-D, with the
+ * branches replaced by masks.
+ */
+static inline void grey_hilbert_block_transpose3(uint32_t* const x,
+                                                 uint32_t* const y,
+                                                 uint32_t* const z,
+                                                 const unsigned int bits)
+{
+    for (unsigned int level = bits - 1U; level > 0U; level--)
+    {
+        const uint32_t lower = grey_hilbert_mask(level);
+        for (size_t i = 0; i < GREY_HILBERT_BLOCK; i++)
+        {
+            const uint32_t x_set = 0U - ((x[i] >> level) & 1U);
+            const uint32_t y_set = 0U - ((y[i] >> level) & 1U);
+            const uint32_t z_set = 0U - ((z[i] >> level) & 1U);
+            x[i] ^= lower & x_set;
+            uint32_t exchanged = (x[i] ^ y[i]) & lower & ~y_set;
+            x[i] ^= (lower & y_set) | exchanged;
+            y[i] ^= exchanged;
+            exchanged = (x[i] ^ z[i]) & lower & ~z_set;
+            x[i] ^= (lower & z_set) | exchanged;
+            z[i] ^= exchanged;
+        }
+    }
+    for (size_t i = 0; i < GREY_HILBERT_BLOCK; i++)
+    {
+        y[i] ^= x[i];
+        z[i] ^= y[i];
+        const uint32_t parity = grey_inline_from32(z[i]) >> 1U;
+        x[i] ^= parity;
+        y[i] ^= parity;
+        z[i] ^= parity;
+    }
+}
+
+/** The inverse of grey_hilbert_block_transpose3(). */
+static inline void grey_hilbert_block_untranspose3(uint32_t* const x,
+                                                   uint32_t* const y,
+                                                   uint32_t* const z,
+                                                   const unsigned int bits)
+{
+    for (size_t i = 0; i < GREY_HILBERT_BLOCK; i++)
+    {
+        const uint32_t parity = z[i] >> 1U;
+        z[i] ^= y[i];
+        y[i] ^= x[i];
+        x[i] ^= parity;
+    }
+    for (unsigned int level = 1U; level < bits; level++)
+    {
+        const uint32_t lower = grey_hilbert_mask(level);
+        for (size_t i = 0; i < GREY_HILBERT_BLOCK; i++)
+        {
+            const uint32_t y_set = 0U - ((y[i] >> level) & 1U);
+            const uint32_t z_set = 0U - ((z[i] >> level) & 1U);
+            uint32_t exchanged = (x[i] ^ z[i]) & lower & ~z_set;
+            x[i] ^= (lower & z_set) | exchanged;
+            z[i] ^= exchanged;
+            exchanged = (x[i] ^ y[i]) & lower & ~y_set;
+            x[i] ^= (lower & y_set) | exchanged;
+            y[i] ^= exchanged;
+            x[i] ^= lower & (0U - ((x[i] >> level) & 1U));
+        }
+    }
+}
+
+/** The 3-D index of each point, #GREY_HILBERT_BLOCK points at a time. */
+static inline void grey_hilbert_block_index3(const uint32_t* const x,
+                                             const uint32_t* const y,
+                                             const uint32_t* const z,
+                                             uint64_t* const indices,
+                                             const size_t amount,
+                                             const unsigned int bits)
+{
+    const uint32_t mask = grey_hilbert_mask(bits);
+    uint32_t block_x[GREY_HILBERT_BLOCK];
+    uint32_t block_y[GREY_HILBERT_BLOCK];
+    uint32_t block_z[GREY_HILBERT_BLOCK];
+    for (size_t done = 0; done < amount; done += GREY_HILBERT_BLOCK)
+    {
+        const size_t length = (amount - done < GREY_HILBERT_BLOCK)
+                              ? amount - done : GREY_HILBERT_BLOCK;
+        for (size_t i = 0; i < GREY_HILBERT_BLOCK; i++)
+        {
+            /* The last block is padded with copies of its first point */
+            const size_t point = done + ((i < length) ? i : 0U);
+            block_x[i] = x[point] & mask;
+            block_y[i] = y[point] & mask;
+            block_z[i] = z[point] & mask;
+        }
+        grey_hilbert_block_transpose3(block_x, block_y, block_z, bits);
+        for (size_t i = 0; i < length; i++)
+        {
+            indices[done + i] = (grey_hilbert_spread3(block_x[i]) << 2U)
+                                | (grey_hilbert_spread3(block_y[i]) << 1U)
+                                | grey_hilbert_spread3(block_z[i]);
+        }
+    }
+}
+
+/** The inverse of grey_hilbert_block_index3(). */
+static inline void grey_hilbert_block_coords3(const uint64_t* const indices,
+                                              uint32_t* const x,
+                                              uint32_t* const y,
+                                              uint32_t* const z,
+                                              const size_t amount,
+                                              const unsigned int bits)
+{
+    const uint32_t mask = grey_hilbert_mask(bits);
+    uint32_t block_x[GREY_HILBERT_BLOCK];
+    uint32_t block_y[GREY_HILBERT_BLOCK];
+    uint32_t block_z[GREY_HILBERT_BLOCK];
+    for (size_t done = 0; done < amount; done += GREY_HILBERT_BLOCK)
+    {
+        const size_t length = (amount - done < GREY_HILBERT_BLOCK)
+                              ? amount - done : GREY_HILBERT_BLOCK;
+        for (size_t i = 0; i < GREY_HILBERT_BLOCK; i++)
+        {
+            const uint64_t index = indices[done + ((i < length) ? i : 0U)];
+            block_x[i] = grey_hilbert_gather3(index >> 2U) & mask;
+            block_y[i] = grey_hilbert_gather3(index >> 1U) & mask;
+            block_z[i] = grey_hilbert_gather3(index) & mask;
+        }
+        grey_hilbert_block_untranspose3(block_x, block_y, block_z, bits);
+        memcpy(&x[done], block_x, length * sizeof(uint32_t));
+        memcpy(&y[done], block_y, length * sizeof(uint32_t));
+        memcpy(&z[done], block_z, length * sizeof(uint32_t));
+    }
+}
+
+/** grey_hilbert_index3() of each point, for the scalar instruction sets. */
+static inline void grey_hilbert_points_index3(const uint32_t* const x,
+                                              const uint32_t* const y,
+                                              const uint32_t* const z,
+                                              uint64_t* const indices,
+                                              const size_t amount,
+                                              const unsigned int bits)
+{
+    for (size_t i = 0; i < amount; i++)
+    {
+        indices[i] = grey_hilbert_index3(x[i], y[i], z[i], bits);
+    }
+}
+
+/** grey_hilbert_coords3() of each index, see grey_hilbert_points_index3(). */
+static inline void grey_hilbert_points_coords3(const uint64_t* const indices,
+                                               uint32_t* const x,
+                                               uint32_t* const y,
+                                               uint32_t* const z,
+                                               const size_t amount,
+                                               const unsigned int bits)
+{
+    for (size_t i = 0; i < amount; i++)
+    {
+        grey_hilbert_coords3(indices[i], bits, &x[i], &y[i], &z[i]);
+    }
+}
+
+/**
+ * Defines the 4 Hilbert curve kernels of one instruction set, named
+ * `grey_<isa>_hilbert_<index|coords><2|3>`, with the arguments of the
+ * array functions in grey.h, already validated.
+ *
+ * In 3-D, \p kind is `block` for the kernels converting blocks of points
+ * without branches, which pay off only with vectors of 8 lanes or more,
+ * or `points` for the ones converting each point with the table.
+ */
+#define GREY_HILBERT_KERNELS_DEFINE(isa, kind) \
+    void grey_##isa##_hilbert_index2(const uint32_t* const x, \
+                                     const uint32_t* const y, \
+                                     uint64_t* const indices, \
+                                     const size_t amount, \
+                                     const unsigned int bits) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            indices[i] = grey_hilbert_bitwise_index2(x[i], y[i], bits); \
+        } \
+    } \
+    void grey_##isa##_hilbert_coords2(const uint64_t* const indices, \
+                                      uint32_t* const x, uint32_t* const y, \
+                                      const size_t amount, \
+                                      const unsigned int bits) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            grey_hilbert_bitwise_coords2(indices[i], bits, &x[i], &y[i]); \
+        } \
+    } \
+    void grey_##isa##_hilbert_index3(const uint32_t* const x, \
+                                     const uint32_t* const y, \
+                                     const uint32_t* const z, \
+                                     uint64_t* const indices, \
+                                     const size_t amount, \
+                                     const unsigned int bits) \
+    { \
+        grey_hilbert_##kind##_index3(x, y, z, indices, amount, bits); \
+    } \
+    void grey_##isa##_hilbert_coords3(const uint64_t* const indices, \
+                                      uint32_t* const x, uint32_t* const y, \
+                                      uint32_t* const z, \
+                                      const size_t amount, \
+                                      const unsigned int bits) \
+    { \
+        grey_hilbert_##kind##_coords3(indices, x, y, z, amount, bits); \
+    }
+
+#endif  /* GREY_HILBERT_KERNELS_H */
@@ -0,0 +1,553 @@
+/**
+ * @file
+ * @brief Internal state tables of the 3-D Hilbert indices.
+ *
+ * Not part of the public API. Generated from the algorithm of Skilling in
+ * `grey_hilbert.c`, do not edit by hand.
+ *
+ * At each level of the coordinates, from the most significant bit, the
+ * algorithm exchanges and inverts the lower bits of the coordinates
+ * according to the bits of the level, and XORs the Grey code of the
+ * level with the parity of the levels above. The exchanges and inversions
+ * done so far and that parity are the state, one of 48 starting from 0.
+ * Each entry converts two levels of all the coordinates at once, the bits
+ * of each coordinate from the highest level, and gives the state of the
+ * levels after them.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef GREY_HILBERT_TABLES_H
+#define GREY_HILBERT_TABLES_H
+
+#include <stdint.h>
+
+/**
+ * 3-D, 2 levels: `state << 6 | x << 4 | y << 2 | z` to
+ * `next << 6 | index`.
+ */
+static const uint16_t grey_hilbert_encode3[3072] = {
+     512,  583,  392,  457,  641,  710,  975, 1038, 1182, 1241,   80,  145,
+     221, 1306,  211,   18,  771,  836, 1099,  842,   66,  901,   76,  141,
+     671,  728,  279,  342, 1372,  475,  404,  469, 1468, 1531, 1908, 1525,
+     317, 1594,  307,  370, 1760, 1831,  104,  169, 2083,   36,  235,   42,
+    1663, 1720,  247,   54, 1790, 1849, 1968, 2033, 2145, 2214,  303,  366,
+     418, 2277,  428,  493,    0, 2307, 2492, 2111, 1991, 1732, 1851, 2552,
+     840, 1611, 1716,  823,  905, 1738, 1845,  118, 2241,  514,  637,  446,
+    2374, 2117, 2234, 1017, 1487,  524,  627, 1456, 1550,  653,  754,  305,
+    1374, 2271,  416,  481, 2585, 2392,  999, 1062,  528,  599,  552,  623,
+     657,  726,  681,  750,  797, 2652, 1123,  866, 2714,  923,  100,  165,
+     787,  852,  811,  876,   82,  917,  106,  941, 1728, 1799,   72,  137,
+    2051,    4,  203,   10, 2556, 2043, 1972, 2037, 2367, 2488, 1143,  886,
+    2113, 2182,  271,  334,  386, 2245,  396,  461, 1021, 2426, 1011, 1074,
+     574,  633, 1904, 1521, 2782, 2841,  400,  465, 2143, 2200,  983, 1046,
+     544,  615,  424,  489,  673,  742, 1007, 1070, 1117, 2650, 1107,  850,
+    2716,  155,   84,  149,  803,  868, 1131,  874,   98,  933,  108,  173,
+    1334, 1653, 1674,  201, 2929, 1202, 1229, 1934, 1198, 1257, 1174, 1233,
+     237, 1322,  213, 1298,  503, 2804, 2827, 1352, 1072,  691,  716, 2575,
+     687,  744,  663,  720, 1388,  491, 1364,  467,  888, 1659, 1668,  775,
+     953, 1786, 1797,   70, 2726,  935,   88,  153, 2085, 1316,  219,   26,
+    1535,  572,  579, 1408, 1598,  701,  706,  257, 2977, 1568,  287,  350,
+    1378, 2275,  412,  477, 1442, 3043, 1884, 1501, 2981, 1572,  283,  346,
+    1452, 1515, 1428, 1491,  301, 1578,  277, 1554, 2081, 1312,  223,   30,
+    2534, 2919, 1944, 2009, 1647, 1704, 1623, 1680, 1774, 1833, 1750, 1809,
+    1342, 1661, 1666,  193, 2937, 1210, 1221, 1926,  880, 1651, 1676,  783,
+     945, 1778, 1805,   78,  511, 2812, 2819, 1344, 1080,  699,  708, 2567,
+    1527,  564,  587, 1416, 1590,  693,  714,  265, 1890, 3045, 1900, 1517,
+    2979,  356,  299,  362, 1436, 1499, 1876, 1493,  285, 1562,  275,  338,
+    2337, 2470,  239,   46, 1184, 1255, 1960, 2025, 1631, 1688,  215,   22,
+    1758, 1817, 1936, 2001, 1214, 1273,  112,  177,  253, 1338,  243,   50,
+    1922, 2885, 1932, 1997, 1601, 1670, 1103,  846,  703,  760,  311,  374,
+    1404,  507,  436,  501, 2563, 1028,  971, 1034, 2752, 2823, 1864, 1481,
+     832, 1603, 1724,  831,  897, 1730, 1853,  126, 2718,  927,   96,  161,
+    2077, 1308,  227,   34, 1479,  516,  635, 1464, 1542,  645,  762,  313,
+    2969, 1560,  295,  358, 1370, 2267,  420,  485,    8, 2315, 2484, 2103,
+    1999, 1740, 1843, 2544, 1744, 1815, 1768, 1839, 2067,   20, 2091,   44,
+    2249,  522,  629,  438, 2382, 2125, 2226, 1009, 2129, 2198, 2153, 2222,
+     402, 2261,  426, 2285,  512,  583,  392,  457,  641,  710,  975, 1038,
+    1182, 1241,   80,  145,  221, 1306,  211,   18,  771,  836, 1099,  842,
+      66,  901,   76,  141,  671,  728,  279,  342, 1372,  475,  404,  469,
+    1468, 1531, 1908, 1525,  317, 1594,  307,  370, 1760, 1831,  104,  169,
+    2083,   36,  235,   42, 1663, 1720,  247,   54, 1790, 1849, 1968, 2033,
+    2145, 2214,  303,  366,  418, 2277,  428,  493,   64,  129, 2654, 2333,
+     195,    2,  159, 1180, 1980, 2045,  864, 1635, 1151,  894,  929, 1762,
+     263,  326, 3033, 2778,  388,  453,  344, 2139, 1019, 1082, 1511,  548,
+    1912, 1529, 1574,  677, 1736, 1807,   16, 2323, 2059,   12, 2007, 1748,
+    2548, 2035,   40, 2347, 2359, 2480, 2031, 1772, 2121, 2190, 2257,  530,
+     394, 2253, 2390, 2133, 1013, 2418, 2281,  554,  566,  625, 2414, 2157,
+    2466, 1121, 2750,  959, 1251, 2720, 2109, 1340, 1692,  799, 2498, 2883,
+    1821,   94,  769, 2624, 2853, 1894, 3001, 1592, 2212, 2983, 1402, 2299,
+     603, 1432, 2565, 2372,  730,  281, 1414, 3015, 2476, 2095, 1776, 1847,
+    1835, 2536, 2099,   52, 2452, 2071, 2508, 1995, 1811, 2512, 2319, 2440,
+     621,  430, 2161, 2230, 2218, 1001,  434, 2293,  597,  406,  973, 2378,
+    2194,  977,  526,  585,  384,  449, 1310, 1629,  967, 1030, 2905, 1178,
+     520,  591,  848, 1619,  649,  718,  913, 1746, 1091,  834,  479, 2780,
+      68,  133, 1048,  667,  779,  844, 1495,  532,   74,  909, 1558,  661,
+    1916, 1533,   32, 2339,  315,  378, 2023, 1764, 1460, 1523,  872, 1643,
+     309, 1586,  937, 1770,  255,   62, 2273,  546, 1976, 2041, 2406, 2149,
+    1655, 1712, 1519,  556, 1782, 1841, 1582,  685, 1698,  225, 1406, 2303,
+    1253, 1958, 2617, 2424, 1708,  815,  560,  631, 1837,  110,  689,  758,
+    2851, 1376,  829, 2684,  740, 2599, 2746,  955,  619, 1448,  819,  884,
+     746,  297,  114,  949, 2460, 2079, 1410, 3011, 1819, 2520, 2949, 1540,
+    1684,  791, 1420, 1483, 1813,   86,  269, 1546,  605,  414, 2049, 1280,
+    2202,  985, 2502, 2887,  595, 1424, 1615, 1672,  722,  273, 1742, 1801,
+    2742,  951, 1784, 1855, 2101, 1332, 2107,   60, 2506, 2891, 2500, 1987,
+     777, 2632, 2311, 2432, 2993, 1584, 2169, 2238, 1394, 2291,  442, 2301,
+    2573, 2380,  965, 2370, 1422, 3023,  518,  577, 1390, 2287, 2790, 2849,
+    2601, 2408, 2151, 2208, 1366, 2263,  536,  607, 2577, 2384,  665,  734,
+     813, 2668, 1125, 2658, 2730,  939, 2724,  163,  789, 2644,  795,  860,
+    2706,  915,   90,  925, 1728, 1799,   72,  137, 2051,    4,  203,   10,
+    2556, 2043, 1972, 2037, 2367, 2488, 1143,  886, 2113, 2182,  271,  334,
+     386, 2245,  396,  461, 1021, 2426, 1011, 1074,  574,  633, 1904, 1521,
+    2782, 2841,  400,  465, 2143, 2200,  983, 1046,  544,  615,  424,  489,
+     673,  742, 1007, 1070, 1117, 2650, 1107,  850, 2716,  155,   84,  149,
+     803,  868, 1131,  874,   98,  933,  108,  173,    0, 2307, 2492, 2111,
+    1991, 1732, 1851, 2552,  840, 1611, 1716,  823,  905, 1738, 1845,  118,
+    2241,  514,  637,  446, 2374, 2117, 2234, 1017, 1487,  524,  627, 1456,
+    1550,  653,  754,  305, 1374, 2271,  416,  481, 2585, 2392,  999, 1062,
+     528,  599,  552,  623,  657,  726,  681,  750,  797, 2652, 1123,  866,
+    2714,  923,  100,  165,  787,  852,  811,  876,   82,  917,  106,  941,
+    2530, 2915, 1948, 2013,  801, 2656, 1119,  862, 2686, 2365, 2434, 1089,
+     191, 1212, 1219, 2688, 2597, 2404,  987, 1050, 1446, 3047, 1880, 1497,
+    3065, 2810, 2821, 1862,  376, 2171, 2180, 2951, 2540, 2027, 2516, 2003,
+    2351, 2472, 2327, 2448,   48, 2355, 2444, 2063, 2039, 1780, 1803, 2504,
+    1005, 2410,  981, 2386,  558,  617,  534,  593, 2289,  562,  589,  398,
+    2422, 2165, 2186,  969, 1954, 2917, 1964, 2029, 1633, 1702, 1135,  878,
+    2814, 2873,  432,  497, 2175, 2232, 1015, 1078, 2595, 1060, 1003, 1066,
+    2784, 2855, 1896, 1513, 1149, 2682, 1139,  882, 2748,  187,  116,  181,
+    2524, 2011, 1940, 2005, 2335, 2456, 1111,  854, 1858, 3013, 1868, 1485,
+    2947,  324,  267,  330,  989, 2394,  979, 1042,  542,  601, 1872, 1489,
+    2305, 2438,  207,   14, 1152, 1223, 1928, 1993, 2678, 2357, 2442, 1097,
+     183, 1204, 1227, 2696,   56, 2363, 2436, 2055, 2047, 1788, 1795, 2496,
+    3057, 2802, 2829, 1870,  368, 2163, 2188, 2959, 2297,  570,  581,  390,
+    2430, 2173, 2178,  961, 2798, 2857, 2774, 2833, 2159, 2216, 2135, 2192,
+    1382, 2279,  408,  473, 2593, 2400,  991, 1054, 1133, 2666, 1109, 2642,
+    2732,  171, 2708,  147,  805, 2660, 1115,  858, 2722,  931,   92,  157,
+    1206, 1265, 1326, 1645,  245, 1330, 2921, 1194, 1930, 2893, 1302, 1621,
+    1609, 1678, 2897, 1170,  695,  752,  495, 2796, 1396,  499, 1064,  683,
+    2571, 1036,  471, 2772, 2760, 2831, 1040,  659,  120,  185, 2662, 2341,
+     251,   58,  167, 1188, 1924, 1989,  856, 1627, 1095,  838,  921, 1754,
+     319,  382, 3041, 2786,  444,  509,  352, 2147,  963, 1026, 1503,  540,
+    1856, 1473, 1566,  669, 1682,  209, 1166, 1225, 1237, 1942,  205, 1290,
+    1706,  233, 1970, 2933, 1261, 1966, 1649, 1718, 2835, 1360,  655,  712,
+     724, 2583, 1356,  459, 2859, 1384, 2611, 1076,  748, 2607, 2800, 2871,
+    2458, 1113, 2694,  903, 1243, 2712, 2053, 1284, 1700,  807, 2554, 2939,
+    1829,  102,  825, 2680, 2845, 1886, 2945, 1536, 2204, 2975, 1346, 2243,
+     611, 1440, 2621, 2428,  738,  289, 1470, 3071, 1334, 1653, 1674,  201,
+    2929, 1202, 1229, 1934, 1198, 1257, 1174, 1233,  237, 1322,  213, 1298,
+     503, 2804, 2827, 1352, 1072,  691,  716, 2575,  687,  744,  663,  720,
+    1388,  491, 1364,  467,  888, 1659, 1668,  775,  953, 1786, 1797,   70,
+    2726,  935,   88,  153, 2085, 1316,  219,   26, 1535,  572,  579, 1408,
+    1598,  701,  706,  257, 2977, 1568,  287,  350, 1378, 2275,  412,  477,
+    1398, 2295,  568,  639, 2609, 2416,  697,  766, 2734,  943, 1190, 1249,
+    2093, 1324,  229, 1314,  821, 2676,  827,  892, 2738,  947,  122,  957,
+    2985, 1576,  679,  736, 1386, 2283, 1380,  483, 1418, 3019, 1412, 1475,
+    2957, 1548,  261, 1538, 2710,  919, 1752, 1823, 2069, 1300, 2075,   28,
+    2057, 1288, 1607, 1664, 2510, 2895, 1734, 1793, 2961, 1552, 2137, 2206,
+    1362, 2259,  410, 2269, 1426, 3027, 1882, 3037, 2965, 1556, 2971,  348,
+    1450, 3051, 1444, 1507, 2989, 1580,  293, 1570, 2065, 1296, 2329, 2462,
+    2518, 2903, 1176, 1247, 2089, 1320, 1639, 1696, 2542, 2927, 1766, 1825,
+    2702,  911, 1158, 1217, 2061, 1292,  197, 1282, 2546, 2931, 1978, 2941,
+     817, 2672, 1657, 1726, 2953, 1544,  647,  704, 1354, 2251, 1348,  451,
+    2613, 2420, 2619, 1084, 1462, 3063, 2808, 2879, 1890, 3045, 1900, 1517,
+    2979,  356,  299,  362, 1436, 1499, 1876, 1493,  285, 1562,  275,  338,
+    2337, 2470,  239,   46, 1184, 1255, 1960, 2025, 1631, 1688,  215,   22,
+    1758, 1817, 1936, 2001, 1214, 1273,  112,  177,  253, 1338,  243,   50,
+    1922, 2885, 1932, 1997, 1601, 1670, 1103,  846,  703,  760,  311,  374,
+    1404,  507,  436,  501, 2563, 1028,  971, 1034, 2752, 2823, 1864, 1481,
+    1442, 3043, 1884, 1501, 2981, 1572,  283,  346, 1452, 1515, 1428, 1491,
+     301, 1578,  277, 1554, 2081, 1312,  223,   30, 2534, 2919, 1944, 2009,
+    1647, 1704, 1623, 1680, 1774, 1833, 1750, 1809, 1342, 1661, 1666,  193,
+    2937, 1210, 1221, 1926,  880, 1651, 1676,  783,  945, 1778, 1805,   78,
+     511, 2812, 2819, 1344, 1080,  699,  708, 2567, 1527,  564,  587, 1416,
+    1590,  693,  714,  265, 1206, 1265, 1326, 1645,  245, 1330, 2921, 1194,
+    1930, 2893, 1302, 1621, 1609, 1678, 2897, 1170,  695,  752,  495, 2796,
+    1396,  499, 1064,  683, 2571, 1036,  471, 2772, 2760, 2831, 1040,  659,
+     120,  185, 2662, 2341,  251,   58,  167, 1188, 1924, 1989,  856, 1627,
+    1095,  838,  921, 1754,  319,  382, 3041, 2786,  444,  509,  352, 2147,
+     963, 1026, 1503,  540, 1856, 1473, 1566,  669, 1682,  209, 1166, 1225,
+    1237, 1942,  205, 1290, 1706,  233, 1970, 2933, 1261, 1966, 1649, 1718,
+    2835, 1360,  655,  712,  724, 2583, 1356,  459, 2859, 1384, 2611, 1076,
+     748, 2607, 2800, 2871, 2458, 1113, 2694,  903, 1243, 2712, 2053, 1284,
+    1700,  807, 2554, 2939, 1829,  102,  825, 2680, 2845, 1886, 2945, 1536,
+    2204, 2975, 1346, 2243,  611, 1440, 2621, 2428,  738,  289, 1470, 3071,
+     384,  449, 1310, 1629,  967, 1030, 2905, 1178,  520,  591,  848, 1619,
+     649,  718,  913, 1746, 1091,  834,  479, 2780,   68,  133, 1048,  667,
+     779,  844, 1495,  532,   74,  909, 1558,  661, 1916, 1533,   32, 2339,
+     315,  378, 2023, 1764, 1460, 1523,  872, 1643,  309, 1586,  937, 1770,
+     255,   62, 2273,  546, 1976, 2041, 2406, 2149, 1655, 1712, 1519,  556,
+    1782, 1841, 1582,  685, 1698,  225, 1406, 2303, 1253, 1958, 2617, 2424,
+    1708,  815,  560,  631, 1837,  110,  689,  758, 2851, 1376,  829, 2684,
+     740, 2599, 2746,  955,  619, 1448,  819,  884,  746,  297,  114,  949,
+    2460, 2079, 1410, 3011, 1819, 2520, 2949, 1540, 1684,  791, 1420, 1483,
+    1813,   86,  269, 1546,  605,  414, 2049, 1280, 2202,  985, 2502, 2887,
+     595, 1424, 1615, 1672,  722,  273, 1742, 1801, 1874, 3029, 1898, 3053,
+    2963,  340, 2987,  364, 1434, 3035, 1892, 1509, 2973, 1564,  291,  354,
+    2321, 2454, 2345, 2478, 1168, 1239, 1192, 1263, 2073, 1304,  231,   38,
+    2526, 2911, 1952, 2017, 2638, 2317, 2482, 1137,  143, 1164, 1267, 2736,
+    1286, 1605, 1722,  249, 2881, 1154, 1277, 1982, 3017, 2762, 2869, 1910,
+     328, 2123, 2228, 2999,  455, 2756, 2875, 1400, 1024,  643,  764, 2623,
+    1938, 2901, 1962, 2925, 1617, 1686, 1641, 1710, 1294, 1613, 1714,  241,
+    2889, 1162, 1269, 1974, 2579, 1044, 2603, 1068, 2768, 2839, 2792, 2863,
+     463, 2764, 2867, 1392, 1032,  651,  756, 2615, 2522, 2907, 1956, 2021,
+     793, 2648, 1127,  870, 2630, 2309, 2490, 1145,  135, 1156, 1275, 2744,
+    2589, 2396,  995, 1058, 1438, 3039, 1888, 1505, 3009, 2754, 2877, 1918,
+     320, 2115, 2236, 3007, 1954, 2917, 1964, 2029, 1633, 1702, 1135,  878,
+    2814, 2873,  432,  497, 2175, 2232, 1015, 1078, 2595, 1060, 1003, 1066,
+    2784, 2855, 1896, 1513, 1149, 2682, 1139,  882, 2748,  187,  116,  181,
+    2524, 2011, 1940, 2005, 2335, 2456, 1111,  854, 1858, 3013, 1868, 1485,
+    2947,  324,  267,  330,  989, 2394,  979, 1042,  542,  601, 1872, 1489,
+    2305, 2438,  207,   14, 1152, 1223, 1928, 1993, 1398, 2295,  568,  639,
+    2609, 2416,  697,  766, 2734,  943, 1190, 1249, 2093, 1324,  229, 1314,
+     821, 2676,  827,  892, 2738,  947,  122,  957, 2985, 1576,  679,  736,
+    1386, 2283, 1380,  483, 1418, 3019, 1412, 1475, 2957, 1548,  261, 1538,
+    2710,  919, 1752, 1823, 2069, 1300, 2075,   28, 2057, 1288, 1607, 1664,
+    2510, 2895, 1734, 1793, 2961, 1552, 2137, 2206, 1362, 2259,  410, 2269,
+      64,  129, 2654, 2333,  195,    2,  159, 1180, 1980, 2045,  864, 1635,
+    1151,  894,  929, 1762,  263,  326, 3033, 2778,  388,  453,  344, 2139,
+    1019, 1082, 1511,  548, 1912, 1529, 1574,  677, 1736, 1807,   16, 2323,
+    2059,   12, 2007, 1748, 2548, 2035,   40, 2347, 2359, 2480, 2031, 1772,
+    2121, 2190, 2257,  530,  394, 2253, 2390, 2133, 1013, 2418, 2281,  554,
+     566,  625, 2414, 2157, 2466, 1121, 2750,  959, 1251, 2720, 2109, 1340,
+    1692,  799, 2498, 2883, 1821,   94,  769, 2624, 2853, 1894, 3001, 1592,
+    2212, 2983, 1402, 2299,  603, 1432, 2565, 2372,  730,  281, 1414, 3015,
+    2476, 2095, 1776, 1847, 1835, 2536, 2099,   52, 2452, 2071, 2508, 1995,
+    1811, 2512, 2319, 2440,  621,  430, 2161, 2230, 2218, 1001,  434, 2293,
+     597,  406,  973, 2378, 2194,  977,  526,  585,  832, 1603, 1724,  831,
+     897, 1730, 1853,  126, 2718,  927,   96,  161, 2077, 1308,  227,   34,
+    1479,  516,  635, 1464, 1542,  645,  762,  313, 2969, 1560,  295,  358,
+    1370, 2267,  420,  485,    8, 2315, 2484, 2103, 1999, 1740, 1843, 2544,
+    1744, 1815, 1768, 1839, 2067,   20, 2091,   44, 2249,  522,  629,  438,
+    2382, 2125, 2226, 1009, 2129, 2198, 2153, 2222,  402, 2261,  426, 2285,
+    2806, 2865, 2670, 2349, 2167, 2224,  175, 1196,  440,  505, 1318, 1637,
+    1023, 1086, 2913, 1186, 1141, 2674, 3049, 2794, 2740,  179,  360, 2155,
+    1147,  890,  487, 2788,  124,  189, 1056,  675, 1866, 3021, 2646, 2325,
+    2955,  332,  151, 1172, 1860, 1477,   24, 2331,  259,  322, 2015, 1756,
+    2313, 2446, 3025, 2770, 1160, 1231,  336, 2131,  199,    6, 2265,  538,
+    1920, 1985, 2398, 2141, 2530, 2915, 1948, 2013,  801, 2656, 1119,  862,
+    2686, 2365, 2434, 1089,  191, 1212, 1219, 2688, 2597, 2404,  987, 1050,
+    1446, 3047, 1880, 1497, 3065, 2810, 2821, 1862,  376, 2171, 2180, 2951,
+    2540, 2027, 2516, 2003, 2351, 2472, 2327, 2448,   48, 2355, 2444, 2063,
+    2039, 1780, 1803, 2504, 1005, 2410,  981, 2386,  558,  617,  534,  593,
+    2289,  562,  589,  398, 2422, 2165, 2186,  969, 2450, 1105, 2766, 2825,
+    1235, 2704, 2127, 2184, 1690,  217, 1350, 2247, 1245, 1950, 2561, 2368,
+    2837, 1878, 1101, 2634, 2196, 2967, 2700,  139, 2843, 1368,  773, 2628,
+     732, 2591, 2690,  899, 2474, 1129, 1906, 3061, 1259, 2728, 2995,  372,
+    2468, 2087, 1466, 3067, 1827, 2528, 3005, 1596, 2861, 1902, 2353, 2486,
+    2220, 2991, 1200, 1271,  613,  422, 2105, 1336, 2210,  993, 2558, 2943,
+    2514, 2899, 1946, 2909,  785, 2640, 1625, 1694, 1358, 2255, 2758, 2817,
+    2569, 2376, 2119, 2176, 2581, 2388, 2587, 1052, 1430, 3031, 2776, 2847,
+     781, 2636, 1093, 2626, 2698,  907, 2692,  131, 2538, 2923, 2532, 2019,
+     809, 2664, 2343, 2464, 1458, 3059, 1914, 3069, 2997, 1588, 3003,  380,
+    2605, 2412,  997, 2402, 1454, 3055,  550,  609, 2097, 1328, 2361, 2494,
+    2550, 2935, 1208, 1279, 2514, 2899, 1946, 2909,  785, 2640, 1625, 1694,
+    1358, 2255, 2758, 2817, 2569, 2376, 2119, 2176, 2581, 2388, 2587, 1052,
+    1430, 3031, 2776, 2847,  781, 2636, 1093, 2626, 2698,  907, 2692,  131,
+    2538, 2923, 2532, 2019,  809, 2664, 2343, 2464, 1458, 3059, 1914, 3069,
+    2997, 1588, 3003,  380, 2605, 2412,  997, 2402, 1454, 3055,  550,  609,
+    2097, 1328, 2361, 2494, 2550, 2935, 1208, 1279, 2678, 2357, 2442, 1097,
+     183, 1204, 1227, 2696,   56, 2363, 2436, 2055, 2047, 1788, 1795, 2496,
+    3057, 2802, 2829, 1870,  368, 2163, 2188, 2959, 2297,  570,  581,  390,
+    2430, 2173, 2178,  961, 2798, 2857, 2774, 2833, 2159, 2216, 2135, 2192,
+    1382, 2279,  408,  473, 2593, 2400,  991, 1054, 1133, 2666, 1109, 2642,
+    2732,  171, 2708,  147,  805, 2660, 1115,  858, 2722,  931,   92,  157,
+    2742,  951, 1784, 1855, 2101, 1332, 2107,   60, 2506, 2891, 2500, 1987,
+     777, 2632, 2311, 2432, 2993, 1584, 2169, 2238, 1394, 2291,  442, 2301,
+    2573, 2380,  965, 2370, 1422, 3023,  518,  577, 1390, 2287, 2790, 2849,
+    2601, 2408, 2151, 2208, 1366, 2263,  536,  607, 2577, 2384,  665,  734,
+     813, 2668, 1125, 2658, 2730,  939, 2724,  163,  789, 2644,  795,  860,
+    2706,  915,   90,  925, 2806, 2865, 2670, 2349, 2167, 2224,  175, 1196,
+     440,  505, 1318, 1637, 1023, 1086, 2913, 1186, 1141, 2674, 3049, 2794,
+    2740,  179,  360, 2155, 1147,  890,  487, 2788,  124,  189, 1056,  675,
+    1866, 3021, 2646, 2325, 2955,  332,  151, 1172, 1860, 1477,   24, 2331,
+     259,  322, 2015, 1756, 2313, 2446, 3025, 2770, 1160, 1231,  336, 2131,
+     199,    6, 2265,  538, 1920, 1985, 2398, 2141, 2450, 1105, 2766, 2825,
+    1235, 2704, 2127, 2184, 1690,  217, 1350, 2247, 1245, 1950, 2561, 2368,
+    2837, 1878, 1101, 2634, 2196, 2967, 2700,  139, 2843, 1368,  773, 2628,
+     732, 2591, 2690,  899, 2474, 1129, 1906, 3061, 1259, 2728, 2995,  372,
+    2468, 2087, 1466, 3067, 1827, 2528, 3005, 1596, 2861, 1902, 2353, 2486,
+    2220, 2991, 1200, 1271,  613,  422, 2105, 1336, 2210,  993, 2558, 2943,
+    1938, 2901, 1962, 2925, 1617, 1686, 1641, 1710, 1294, 1613, 1714,  241,
+    2889, 1162, 1269, 1974, 2579, 1044, 2603, 1068, 2768, 2839, 2792, 2863,
+     463, 2764, 2867, 1392, 1032,  651,  756, 2615, 2522, 2907, 1956, 2021,
+     793, 2648, 1127,  870, 2630, 2309, 2490, 1145,  135, 1156, 1275, 2744,
+    2589, 2396,  995, 1058, 1438, 3039, 1888, 1505, 3009, 2754, 2877, 1918,
+     320, 2115, 2236, 3007, 1426, 3027, 1882, 3037, 2965, 1556, 2971,  348,
+    1450, 3051, 1444, 1507, 2989, 1580,  293, 1570, 2065, 1296, 2329, 2462,
+    2518, 2903, 1176, 1247, 2089, 1320, 1639, 1696, 2542, 2927, 1766, 1825,
+    2702,  911, 1158, 1217, 2061, 1292,  197, 1282, 2546, 2931, 1978, 2941,
+     817, 2672, 1657, 1726, 2953, 1544,  647,  704, 1354, 2251, 1348,  451,
+    2613, 2420, 2619, 1084, 1462, 3063, 2808, 2879, 1874, 3029, 1898, 3053,
+    2963,  340, 2987,  364, 1434, 3035, 1892, 1509, 2973, 1564,  291,  354,
+    2321, 2454, 2345, 2478, 1168, 1239, 1192, 1263, 2073, 1304,  231,   38,
+    2526, 2911, 1952, 2017, 2638, 2317, 2482, 1137,  143, 1164, 1267, 2736,
+    1286, 1605, 1722,  249, 2881, 1154, 1277, 1982, 3017, 2762, 2869, 1910,
+     328, 2123, 2228, 2999,  455, 2756, 2875, 1400, 1024,  643,  764, 2623,
+};
+
+/**
+ * 3-D, 2 levels: `state << 6 | index` to
+ * `next << 6 | x << 4 | y << 2 | z`.
+ */
+static const uint16_t grey_hilbert_decode3[3072] = {
+     512,  644,   84,  784,  849,  917,  709,  577,  386,  451,  851, 1106,
+      86,  151, 1031,  966,   74,  139,   15,  206,  414,  479,  347,  282,
+     729, 1225, 1293,  477, 1372,  204, 1160,  664, 1768, 2168,  444, 2092,
+      45, 2301, 2233, 1833,  106,  171,   47,  238,  446,  511,  379,  314,
+    1974, 2039,  359,  294, 1890, 1507,   51,  242, 1713, 1845, 1573, 1505,
+    1440,  292, 1780, 1648,    0, 2256,  529, 2305, 1733, 2133, 2388, 1988,
+     840,  908, 1741, 1609,  537,  669, 1564, 1496,  552,  684,  124,  824,
+     889,  957,  749,  617, 2405, 2596, 2740,  949, 2673,  816, 1376, 2273,
+     418,  483,  883, 1138,  118,  183, 1063,  998,  554,  686,  126,  826,
+     891,  959,  751,  619, 1435,  287,  734,  602, 1674, 1806,   79,  779,
+    2503,  983, 2198, 1798, 2434,  594,  403, 2051, 1728, 2128,  404, 2052,
+       5, 2261, 2193, 1793,   66,  131,    7,  198,  406,  471,  339,  274,
+     418,  483,  883, 1138,  118,  183, 1063,  998, 2213, 2849, 2673,  181,
+    2740, 1136, 2784, 2148,  552,  684,  124,  824,  889,  957,  749,  617,
+     426,  491,  891, 1146,  126,  191, 1071, 1006, 1886, 1503, 1051,  986,
+    1930, 1995,  847, 1102, 2445,  605, 2393, 1993, 2504,  984,  540, 2316,
+    1459,  311,  758,  626, 1698, 1830,  103,  803, 1363,  195, 1666, 2834,
+     726, 1222, 1927, 2583,  731, 1227, 1295,  479, 1374,  206, 1162,  666,
+     106,  171,   47,  238,  446,  511,  379,  314, 1593, 3000, 1404, 2301,
+    1325, 2092, 2728,  937,  729, 1225, 1293,  477, 1372,  204, 1160,  664,
+    1044, 2884, 1157,  661, 2769, 1601, 1280,  464,  864,  932, 1765, 1633,
+     561,  693, 1588, 1520, 1395,  227, 1698, 2866,  758, 1254, 1959, 2615,
+    1467,  319,  766,  634, 1706, 1838,  111,  811, 1691, 1823, 1551, 1483,
+    1418,  270, 1758, 1626, 1942, 2007,  327,  262, 1858, 1475,   19,  210,
+    1297, 2064, 1408, 3009, 1541, 2948, 2516, 2901, 1689, 1821, 1549, 1481,
+    1416,  268, 1756, 1624,  872,  940, 1773, 1641,  569,  701, 1596, 1528,
+    1076, 2916, 1189,  693, 2801, 1633, 1312,  496, 2812, 1644, 1960, 2616,
+    1081, 2921, 1709, 2877, 1918, 1535, 1083, 1018, 1962, 2027,  879, 1134,
+    1950, 2015,  335,  270, 1866, 1483,   27,  218, 1689, 1821, 1549, 1481,
+    1416,  268, 1756, 1624, 1172, 2320, 1856, 2948,  325, 3009, 2449, 1237,
+    1942, 2007,  327,  262, 1858, 1475,   19,  210,   98,  163,   39,  230,
+     438,  503,  371,  306,  753, 1249, 1317,  501, 1396,  228, 1184,  688,
+     832,  900, 1733, 1601,  529,  661, 1556, 1488,   32, 2288,  561, 2337,
+    1765, 2165, 2420, 2020, 1768, 2168,  444, 2092,   45, 2301, 2233, 1833,
+    1561, 2968, 1372, 2269, 1293, 2060, 2696,  905,   74,  139,   15,  206,
+     414,  479,  347,  282, 1770, 2170,  446, 2094,   47, 2303, 2235, 1835,
+    2535, 1015, 2230, 1830, 2466,  626,  435, 2083, 1427,  279,  726,  594,
+    1666, 1798,   71,  771,  512,  644,   84,  784,  849,  917,  709,  577,
+     386,  451,  851, 1106,   86,  151, 1031,  966,   74,  139,   15,  206,
+     414,  479,  347,  282,  729, 1225, 1293,  477, 1372,  204, 1160,  664,
+    1768, 2168,  444, 2092,   45, 2301, 2233, 1833,  106,  171,   47,  238,
+     446,  511,  379,  314, 1974, 2039,  359,  294, 1890, 1507,   51,  242,
+    1713, 1845, 1573, 1505, 1440,  292, 1780, 1648,   64,  129,    5,  196,
+     404,  469,  337,  272, 1760, 2160,  436, 2084,   37, 2293, 2225, 1825,
+      34, 2290,  563, 2339, 1767, 2167, 2422, 2022,  342, 3026, 2771, 2135,
+    1159, 2307, 2626,  134,  842,  910, 1743, 1611,  539,  671, 1566, 1498,
+      42, 2298,  571, 2347, 1775, 2175, 2430, 2030, 2477,  637, 2425, 2025,
+    2536, 1016,  572, 2348, 1884, 1501, 1049,  984, 1928, 1993,  845, 1100,
+    2639,  782, 2506, 2891, 2395, 2586, 1438, 3039, 2479,  639, 2427, 2027,
+    2538, 1018,  574, 2350, 2541, 1021, 2236, 1836, 2472,  632,  441, 2089,
+    1433,  285,  732,  600, 1672, 1804,   77,  777, 2693, 1089, 2432, 1220,
+    2196, 2832, 1873, 2965, 2533, 1013, 2228, 1828, 2464,  624,  433, 2081,
+    1762, 2162,  438, 2086,   39, 2295, 2227, 1827, 1555, 2962, 1366, 2263,
+    1287, 2054, 2690,  899,  384,  449,  849, 1104,   84,  149, 1029,  964,
+     520,  652,   92,  792,  857,  925,  717,  585,  842,  910, 1743, 1611,
+     539,  671, 1566, 1498, 1046, 2886, 1159,  663, 2771, 1603, 1282,  466,
+      34, 2290,  563, 2339, 1767, 2167, 2422, 2022,  874,  942, 1775, 1643,
+     571,  703, 1598, 1530, 1721, 1853, 1581, 1513, 1448,  300, 1788, 1656,
+    1972, 2037,  357,  292, 1888, 1505,   49,  240, 1331, 2098, 1442, 3043,
+    1575, 2982, 2550, 2935, 1723, 1855, 1583, 1515, 1450,  302, 1790, 1658,
+    1465,  317,  764,  632, 1704, 1836,  109,  809, 2533, 1013, 2228, 1828,
+    2464,  624,  433, 2081, 1361,  193, 1664, 2832,  724, 1220, 1925, 2581,
+    1433,  285,  732,  600, 1672, 1804,   77,  777,  522,  654,   94,  794,
+     859,  927,  719,  587, 2375, 2566, 2710,  919, 2643,  786, 1346, 2243,
+    2447,  607, 2395, 1995, 2506,  986,  542, 2318, 2637,  780, 2504, 2889,
+    2393, 2584, 1436, 3037, 2413, 2604, 2748,  957, 2681,  824, 1384, 2281,
+     554,  686,  126,  826,  891,  959,  751,  619, 2215, 2851, 2675,  183,
+    2742, 1138, 2786, 2150, 2405, 2596, 2740,  949, 2673,  816, 1376, 2273,
+    1553, 2960, 1364, 2261, 1285, 2052, 2688,  897, 1730, 2130,  406, 2054,
+       7, 2263, 2195, 1795, 1728, 2128,  404, 2052,    5, 2261, 2193, 1793,
+      66,  131,    7,  198,  406,  471,  339,  274,  418,  483,  883, 1138,
+     118,  183, 1063,  998, 2213, 2849, 2673,  181, 2740, 1136, 2784, 2148,
+     552,  684,  124,  824,  889,  957,  749,  617,  426,  491,  891, 1146,
+     126,  191, 1071, 1006, 1886, 1503, 1051,  986, 1930, 1995,  847, 1102,
+    2445,  605, 2393, 1993, 2504,  984,  540, 2316,    0, 2256,  529, 2305,
+    1733, 2133, 2388, 1988,  840,  908, 1741, 1609,  537,  669, 1564, 1496,
+     552,  684,  124,  824,  889,  957,  749,  617, 2405, 2596, 2740,  949,
+    2673,  816, 1376, 2273,  418,  483,  883, 1138,  118,  183, 1063,  998,
+     554,  686,  126,  826,  891,  959,  751,  619, 1435,  287,  734,  602,
+    1674, 1806,   79,  779, 2503,  983, 2198, 1798, 2434,  594,  403, 2051,
+    2703, 1099, 2442, 1230, 2206, 2842, 1883, 2975, 2543, 1023, 2238, 1838,
+    2474,  634,  443, 2091, 2471,  631, 2419, 2019, 2530, 1010,  566, 2342,
+    1878, 1495, 1043,  978, 1922, 1987,  839, 1094, 2629,  772, 2496, 2881,
+    2385, 2576, 1428, 3029, 2469,  629, 2417, 2017, 2528, 1008,  564, 2340,
+      40, 2296,  569, 2345, 1773, 2173, 2428, 2028,  348, 3032, 2777, 2141,
+    1165, 2313, 2632,  140, 1212, 2360, 1896, 2988,  365, 3049, 2489, 1277,
+    1982, 2047,  367,  302, 1898, 1515,   59,  250, 1910, 1527, 1075, 1010,
+    1954, 2019,  871, 1126, 2469,  629, 2417, 2017, 2528, 1008,  564, 2340,
+    2772, 1604, 1920, 2576, 1041, 2881, 1669, 2837, 1878, 1495, 1043,  978,
+    1922, 1987,  839, 1094,  394,  459,  859, 1114,   94,  159, 1039,  974,
+    2189, 2825, 2649,  157, 2716, 1112, 2760, 2124, 2511,  991, 2206, 1806,
+    2442,  602,  411, 2059, 2695, 1091, 2434, 1222, 2198, 2834, 1875, 2967,
+    2215, 2851, 2675,  183, 2742, 1138, 2786, 2150,  426,  491,  891, 1146,
+     126,  191, 1071, 1006, 2413, 2604, 2748,  957, 2681,  824, 1384, 2281,
+    2213, 2849, 2673,  181, 2740, 1136, 2784, 2148,  340, 3024, 2769, 2133,
+    1157, 2305, 2624,  132,    8, 2264,  537, 2313, 1741, 2141, 2396, 1996,
+    1916, 1533, 1081, 1016, 1960, 2025,  877, 1132, 2780, 1612, 1928, 2584,
+    1049, 2889, 1677, 2845, 1054, 2894, 1167,  671, 2779, 1611, 1290,  474,
+     874,  942, 1775, 1643,  571,  703, 1598, 1530,  374, 3058, 2803, 2167,
+    1191, 2339, 2658,  166, 1046, 2886, 1159,  663, 2771, 1603, 1282,  466,
+     721, 1217, 1285,  469, 1364,  196, 1152,  656,   96,  161,   37,  228,
+     436,  501,  369,  304, 1587, 2994, 1398, 2295, 1319, 2086, 2722,  931,
+     723, 1219, 1287,  471, 1366,  198, 1154,  658, 1361,  193, 1664, 2832,
+     724, 1220, 1925, 2581, 2725, 1121, 2464, 1252, 2228, 2864, 1905, 2997,
+    1465,  317,  764,  632, 1704, 1836,  109,  809, 1369,  201, 1672, 2840,
+     732, 1228, 1933, 2589, 2782, 1614, 1930, 2586, 1051, 2891, 1679, 2847,
+    2671,  814, 2538, 2923, 2427, 2618, 1470, 3071, 1459,  311,  758,  626,
+    1698, 1830,  103,  803, 1363,  195, 1666, 2834,  726, 1222, 1927, 2583,
+     731, 1227, 1295,  479, 1374,  206, 1162,  666,  106,  171,   47,  238,
+     446,  511,  379,  314, 1593, 3000, 1404, 2301, 1325, 2092, 2728,  937,
+     729, 1225, 1293,  477, 1372,  204, 1160,  664, 1044, 2884, 1157,  661,
+    2769, 1601, 1280,  464,  864,  932, 1765, 1633,  561,  693, 1588, 1520,
+    1715, 1847, 1575, 1507, 1442,  294, 1782, 1650, 1329, 2096, 1440, 3041,
+    1573, 2980, 2548, 2933, 1593, 3000, 1404, 2301, 1325, 2092, 2728,  937,
+    1770, 2170,  446, 2094,   47, 2303, 2235, 1835,  731, 1227, 1295,  479,
+    1374,  206, 1162,  666, 1561, 2968, 1372, 2269, 1293, 2060, 2696,  905,
+    2373, 2564, 2708,  917, 2641,  784, 1344, 2241,  514,  646,   86,  786,
+     851,  919,  711,  579,  755, 1251, 1319,  503, 1398,  230, 1186,  690,
+    1585, 2992, 1396, 2293, 1317, 2084, 2720,  929, 1297, 2064, 1408, 3009,
+    1541, 2948, 2516, 2901, 1174, 2322, 1858, 2950,  327, 3011, 2451, 1239,
+    1691, 1823, 1551, 1483, 1418,  270, 1758, 1626, 1305, 2072, 1416, 3017,
+    1549, 2956, 2524, 2909, 2669,  812, 2536, 2921, 2425, 2616, 1468, 3069,
+    2814, 1646, 1962, 2618, 1083, 2923, 1711, 2879, 2812, 1644, 1960, 2616,
+    1081, 2921, 1709, 2877, 1918, 1535, 1083, 1018, 1962, 2027,  879, 1134,
+    1950, 2015,  335,  270, 1866, 1483,   27,  218, 1689, 1821, 1549, 1481,
+    1416,  268, 1756, 1624, 1172, 2320, 1856, 2948,  325, 3009, 2449, 1237,
+    1942, 2007,  327,  262, 1858, 1475,   19,  210,   98,  163,   39,  230,
+     438,  503,  371,  306,  753, 1249, 1317,  501, 1396,  228, 1184,  688,
+    1395,  227, 1698, 2866,  758, 1254, 1959, 2615, 1467,  319,  766,  634,
+    1706, 1838,  111,  811, 1691, 1823, 1551, 1483, 1418,  270, 1758, 1626,
+    1942, 2007,  327,  262, 1858, 1475,   19,  210, 1297, 2064, 1408, 3009,
+    1541, 2948, 2516, 2901, 1689, 1821, 1549, 1481, 1416,  268, 1756, 1624,
+     872,  940, 1773, 1641,  569,  701, 1596, 1528, 1076, 2916, 1189,  693,
+    2801, 1633, 1312,  496, 1916, 1533, 1081, 1016, 1960, 2025,  877, 1132,
+    2780, 1612, 1928, 2584, 1049, 2889, 1677, 2845, 1054, 2894, 1167,  671,
+    2779, 1611, 1290,  474,  874,  942, 1775, 1643,  571,  703, 1598, 1530,
+     374, 3058, 2803, 2167, 1191, 2339, 2658,  166, 1046, 2886, 1159,  663,
+    2771, 1603, 1282,  466,  721, 1217, 1285,  469, 1364,  196, 1152,  656,
+      96,  161,   37,  228,  436,  501,  369,  304, 1587, 2994, 1398, 2295,
+    1319, 2086, 2722,  931,  723, 1219, 1287,  471, 1366,  198, 1154,  658,
+    1361,  193, 1664, 2832,  724, 1220, 1925, 2581, 2725, 1121, 2464, 1252,
+    2228, 2864, 1905, 2997, 1465,  317,  764,  632, 1704, 1836,  109,  809,
+    1369,  201, 1672, 2840,  732, 1228, 1933, 2589, 2782, 1614, 1930, 2586,
+    1051, 2891, 1679, 2847, 2671,  814, 2538, 2923, 2427, 2618, 1470, 3071,
+     384,  449,  849, 1104,   84,  149, 1029,  964,  520,  652,   92,  792,
+     857,  925,  717,  585,  842,  910, 1743, 1611,  539,  671, 1566, 1498,
+    1046, 2886, 1159,  663, 2771, 1603, 1282,  466,   34, 2290,  563, 2339,
+    1767, 2167, 2422, 2022,  874,  942, 1775, 1643,  571,  703, 1598, 1530,
+    1721, 1853, 1581, 1513, 1448,  300, 1788, 1656, 1972, 2037,  357,  292,
+    1888, 1505,   49,  240, 1331, 2098, 1442, 3043, 1575, 2982, 2550, 2935,
+    1723, 1855, 1583, 1515, 1450,  302, 1790, 1658, 1465,  317,  764,  632,
+    1704, 1836,  109,  809, 2533, 1013, 2228, 1828, 2464,  624,  433, 2081,
+    1361,  193, 1664, 2832,  724, 1220, 1925, 2581, 1433,  285,  732,  600,
+    1672, 1804,   77,  777,  522,  654,   94,  794,  859,  927,  719,  587,
+    2375, 2566, 2710,  919, 2643,  786, 1346, 2243, 1084, 2924, 1197,  701,
+    2809, 1641, 1320,  504,  372, 3056, 2801, 2165, 1189, 2337, 2656,  164,
+    1172, 2320, 1856, 2948,  325, 3009, 2449, 1237, 1305, 2072, 1416, 3017,
+    1549, 2956, 2524, 2909, 1950, 2015,  335,  270, 1866, 1483,   27,  218,
+    1174, 2322, 1858, 2950,  327, 3011, 2451, 1239, 2727, 1123, 2466, 1254,
+    2230, 2866, 1907, 2999, 1403,  235, 1706, 2874,  766, 1262, 1967, 2623,
+     380, 3064, 2809, 2173, 1197, 2345, 2664,  172, 1052, 2892, 1165,  669,
+    2777, 1609, 1288,  472, 2772, 1604, 1920, 2576, 1041, 2881, 1669, 2837,
+    2661,  804, 2528, 2913, 2417, 2608, 1460, 3061, 1910, 1527, 1075, 1010,
+    1954, 2019,  871, 1126, 2774, 1606, 1922, 2578, 1043, 2883, 1671, 2839,
+    1371,  203, 1674, 2842,  734, 1230, 1935, 2591, 2735, 1131, 2474, 1262,
+    2238, 2874, 1915, 3007, 1212, 2360, 1896, 2988,  365, 3049, 2489, 1277,
+    1982, 2047,  367,  302, 1898, 1515,   59,  250, 1910, 1527, 1075, 1010,
+    1954, 2019,  871, 1126, 2469,  629, 2417, 2017, 2528, 1008,  564, 2340,
+    2772, 1604, 1920, 2576, 1041, 2881, 1669, 2837, 1878, 1495, 1043,  978,
+    1922, 1987,  839, 1094,  394,  459,  859, 1114,   94,  159, 1039,  974,
+    2189, 2825, 2649,  157, 2716, 1112, 2760, 2124, 1715, 1847, 1575, 1507,
+    1442,  294, 1782, 1650, 1329, 2096, 1440, 3041, 1573, 2980, 2548, 2933,
+    1593, 3000, 1404, 2301, 1325, 2092, 2728,  937, 1770, 2170,  446, 2094,
+      47, 2303, 2235, 1835,  731, 1227, 1295,  479, 1374,  206, 1162,  666,
+    1561, 2968, 1372, 2269, 1293, 2060, 2696,  905, 2373, 2564, 2708,  917,
+    2641,  784, 1344, 2241,  514,  646,   86,  786,  851,  919,  711,  579,
+      64,  129,    5,  196,  404,  469,  337,  272, 1760, 2160,  436, 2084,
+      37, 2293, 2225, 1825,   34, 2290,  563, 2339, 1767, 2167, 2422, 2022,
+     342, 3026, 2771, 2135, 1159, 2307, 2626,  134,  842,  910, 1743, 1611,
+     539,  671, 1566, 1498,   42, 2298,  571, 2347, 1775, 2175, 2430, 2030,
+    2477,  637, 2425, 2025, 2536, 1016,  572, 2348, 1884, 1501, 1049,  984,
+    1928, 1993,  845, 1100, 2639,  782, 2506, 2891, 2395, 2586, 1438, 3039,
+    2479,  639, 2427, 2027, 2538, 1018,  574, 2350, 2541, 1021, 2236, 1836,
+    2472,  632,  441, 2089, 1433,  285,  732,  600, 1672, 1804,   77,  777,
+    2693, 1089, 2432, 1220, 2196, 2832, 1873, 2965, 2533, 1013, 2228, 1828,
+    2464,  624,  433, 2081, 1762, 2162,  438, 2086,   39, 2295, 2227, 1827,
+    1555, 2962, 1366, 2263, 1287, 2054, 2690,  899,  832,  900, 1733, 1601,
+     529,  661, 1556, 1488,   32, 2288,  561, 2337, 1765, 2165, 2420, 2020,
+    1768, 2168,  444, 2092,   45, 2301, 2233, 1833, 1561, 2968, 1372, 2269,
+    1293, 2060, 2696,  905,   74,  139,   15,  206,  414,  479,  347,  282,
+    1770, 2170,  446, 2094,   47, 2303, 2235, 1835, 2535, 1015, 2230, 1830,
+    2466,  626,  435, 2083, 1427,  279,  726,  594, 1666, 1798,   71,  771,
+    1980, 2045,  365,  300, 1896, 1513,   57,  248, 1204, 2352, 1888, 2980,
+     357, 3041, 2481, 1269,  374, 3058, 2803, 2167, 1191, 2339, 2658,  166,
+      42, 2298,  571, 2347, 1775, 2175, 2430, 2030, 1054, 2894, 1167,  671,
+    2779, 1611, 1290,  474,  342, 3026, 2771, 2135, 1159, 2307, 2626,  134,
+    2181, 2817, 2641,  149, 2708, 1104, 2752, 2116,  392,  457,  857, 1112,
+      92,  157, 1037,  972, 2703, 1099, 2442, 1230, 2206, 2842, 1883, 2975,
+    2543, 1023, 2238, 1838, 2474,  634,  443, 2091, 2471,  631, 2419, 2019,
+    2530, 1010,  566, 2342, 1878, 1495, 1043,  978, 1922, 1987,  839, 1094,
+    2629,  772, 2496, 2881, 2385, 2576, 1428, 3029, 2469,  629, 2417, 2017,
+    2528, 1008,  564, 2340,   40, 2296,  569, 2345, 1773, 2173, 2428, 2028,
+     348, 3032, 2777, 2141, 1165, 2313, 2632,  140, 2383, 2574, 2718,  927,
+    2651,  794, 1354, 2251, 2183, 2819, 2643,  151, 2710, 1106, 2754, 2118,
+    2693, 1089, 2432, 1220, 2196, 2832, 1873, 2965, 1369,  201, 1672, 2840,
+     732, 1228, 1933, 2589, 2541, 1021, 2236, 1836, 2472,  632,  441, 2089,
+    2725, 1121, 2464, 1252, 2228, 2864, 1905, 2997, 1206, 2354, 1890, 2982,
+     359, 3043, 2483, 1271, 1339, 2106, 1450, 3051, 1583, 2990, 2558, 2943,
+    2191, 2827, 2651,  159, 2718, 1114, 2762, 2126, 2381, 2572, 2716,  925,
+    2649,  792, 1352, 2249, 2629,  772, 2496, 2881, 2385, 2576, 1428, 3029,
+    2774, 1606, 1922, 2578, 1043, 2883, 1671, 2839, 2471,  631, 2419, 2019,
+    2530, 1010,  566, 2342, 2661,  804, 2528, 2913, 2417, 2608, 1460, 3061,
+    1337, 2104, 1448, 3049, 1581, 2988, 2556, 2941, 1214, 2362, 1898, 2990,
+     367, 3051, 2491, 1279, 2191, 2827, 2651,  159, 2718, 1114, 2762, 2126,
+    2381, 2572, 2716,  925, 2649,  792, 1352, 2249, 2629,  772, 2496, 2881,
+    2385, 2576, 1428, 3029, 2774, 1606, 1922, 2578, 1043, 2883, 1671, 2839,
+    2471,  631, 2419, 2019, 2530, 1010,  566, 2342, 2661,  804, 2528, 2913,
+    2417, 2608, 1460, 3061, 1337, 2104, 1448, 3049, 1581, 2988, 2556, 2941,
+    1214, 2362, 1898, 2990,  367, 3051, 2491, 1279, 2511,  991, 2206, 1806,
+    2442,  602,  411, 2059, 2695, 1091, 2434, 1222, 2198, 2834, 1875, 2967,
+    2215, 2851, 2675,  183, 2742, 1138, 2786, 2150,  426,  491,  891, 1146,
+     126,  191, 1071, 1006, 2413, 2604, 2748,  957, 2681,  824, 1384, 2281,
+    2213, 2849, 2673,  181, 2740, 1136, 2784, 2148,  340, 3024, 2769, 2133,
+    1157, 2305, 2624,  132,    8, 2264,  537, 2313, 1741, 2141, 2396, 1996,
+    2447,  607, 2395, 1995, 2506,  986,  542, 2318, 2637,  780, 2504, 2889,
+    2393, 2584, 1436, 3037, 2413, 2604, 2748,  957, 2681,  824, 1384, 2281,
+     554,  686,  126,  826,  891,  959,  751,  619, 2215, 2851, 2675,  183,
+    2742, 1138, 2786, 2150, 2405, 2596, 2740,  949, 2673,  816, 1376, 2273,
+    1553, 2960, 1364, 2261, 1285, 2052, 2688,  897, 1730, 2130,  406, 2054,
+       7, 2263, 2195, 1795, 1980, 2045,  365,  300, 1896, 1513,   57,  248,
+    1204, 2352, 1888, 2980,  357, 3041, 2481, 1269,  374, 3058, 2803, 2167,
+    1191, 2339, 2658,  166,   42, 2298,  571, 2347, 1775, 2175, 2430, 2030,
+    1054, 2894, 1167,  671, 2779, 1611, 1290,  474,  342, 3026, 2771, 2135,
+    1159, 2307, 2626,  134, 2181, 2817, 2641,  149, 2708, 1104, 2752, 2116,
+     392,  457,  857, 1112,   92,  157, 1037,  972, 2383, 2574, 2718,  927,
+    2651,  794, 1354, 2251, 2183, 2819, 2643,  151, 2710, 1106, 2754, 2118,
+    2693, 1089, 2432, 1220, 2196, 2832, 1873, 2965, 1369,  201, 1672, 2840,
+     732, 1228, 1933, 2589, 2541, 1021, 2236, 1836, 2472,  632,  441, 2089,
+    2725, 1121, 2464, 1252, 2228, 2864, 1905, 2997, 1206, 2354, 1890, 2982,
+     359, 3043, 2483, 1271, 1339, 2106, 1450, 3051, 1583, 2990, 2558, 2943,
+     380, 3064, 2809, 2173, 1197, 2345, 2664,  172, 1052, 2892, 1165,  669,
+    2777, 1609, 1288,  472, 2772, 1604, 1920, 2576, 1041, 2881, 1669, 2837,
+    2661,  804, 2528, 2913, 2417, 2608, 1460, 3061, 1910, 1527, 1075, 1010,
+    1954, 2019,  871, 1126, 2774, 1606, 1922, 2578, 1043, 2883, 1671, 2839,
+    1371,  203, 1674, 2842,  734, 1230, 1935, 2591, 2735, 1131, 2474, 1262,
+    2238, 2874, 1915, 3007,  755, 1251, 1319,  503, 1398,  230, 1186,  690,
+    1585, 2992, 1396, 2293, 1317, 2084, 2720,  929, 1297, 2064, 1408, 3009,
+    1541, 2948, 2516, 2901, 1174, 2322, 1858, 2950,  327, 3011, 2451, 1239,
+    1691, 1823, 1551, 1483, 1418,  270, 1758, 1626, 1305, 2072, 1416, 3017,
+    1549, 2956, 2524, 2909, 2669,  812, 2536, 2921, 2425, 2616, 1468, 3069,
+    2814, 1646, 1962, 2618, 1083, 2923, 1711, 2879, 1084, 2924, 1197,  701,
+    2809, 1641, 1320,  504,  372, 3056, 2801, 2165, 1189, 2337, 2656,  164,
+    1172, 2320, 1856, 2948,  325, 3009, 2449, 1237, 1305, 2072, 1416, 3017,
+    1549, 2956, 2524, 2909, 1950, 2015,  335,  270, 1866, 1483,   27,  218,
+    1174, 2322, 1858, 2950,  327, 3011, 2451, 1239, 2727, 1123, 2466, 1254,
+    2230, 2866, 1907, 2999, 1403,  235, 1706, 2874,  766, 1262, 1967, 2623,
+};
+
+#endif  /* GREY_HILBERT_TABLES_H */
@@ -0,0 +1,532 @@
+/**
+ * @file
+ * @brief Internal declarations of the bulk conversion kernels.
+ *
+ * Not part of the public API: these are the building blocks used by
+ * grey_to_array() and grey_from_array(). Every kernel exists for each
+ * supported integer width, so the library can pick the one matching
+ * #GREY_UINTBITS. All kernels process \p amount elements from \p in to
+ * \p out, which may be the same buffer (in-place conversion) but must not
+ * otherwise overlap.
+ *
+ * When `GREY_DISPATCH_X86` is defined (the CMake build does so on x86),
+ * every SIMD kernel is compiled, each file with its own instruction set
+ * flags, and the one to use is chosen at runtime by checking the CPU.
+ * Otherwise only the kernels of the instruction sets enabled for the whole
+ * build are available.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef GREY_KERNELS_H
+#define GREY_KERNELS_H
+
+#include "grey.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Declares the 8 kernels (2 directions for 4 widths) of one instruction
+ * set, named `grey_<isa>_<to|from><bits>`, plus its 4 multiword ones
+ * `grey_<isa>_words_<to|from>_<le|be>`, see #GREY_WORDS_KERNELS_DEFINE,
+ * its 4 sequence generators `grey_<isa>_fill<bits>`, see
+ * #GREY_FILL_KERNEL_DEFINE, its 4 Hilbert curve kernels, see
+ * grey_hilbert_kernels.h, and its 4 Hamming distance kernels, see
+ * #GREY_DISTANCES_KERNEL_DEFINE.
+ */
+#define GREY_KERNELS_DECLARE(isa) \
+    GREY_CONVERT_KERNELS_DECLARE(isa); \
+    void grey_##isa##_words_to_le(const uint64_t* in, uint64_t* out, \
+                                  size_t amount); \
+    void grey_##isa##_words_to_be(const uint64_t* in, uint64_t* out, \
+                                  size_t amount); \
+    GREY_WORDS_FROM_KERNELS_DECLARE(isa); \
+    void grey_##isa##_fill8(uint8_t start, uint8_t step, uint8_t* out, \
+                            size_t amount); \
+    void grey_##isa##_fill16(uint16_t start, uint16_t step, uint16_t* out, \
+                             size_t amount); \
+    void grey_##isa##_fill32(uint32_t start, uint32_t step, uint32_t* out, \
+                             size_t amount); \
+    void grey_##isa##_fill64(uint64_t start, uint64_t step, uint64_t* out, \
+                             size_t amount); \
+    GREY_HILBERT_KERNELS_DECLARE(isa); \
+    GREY_DISTANCES_KERNELS_DECLARE(isa)
+
+/** Declares the 8 conversion kernels of one instruction set. */
+#define GREY_CONVERT_KERNELS_DECLARE(isa) \
+    void grey_##isa##_to8(const uint8_t* in, uint8_t* out, size_t amount); \
+    void grey_##isa##_from8(const uint8_t* in, uint8_t* out, size_t amount); \
+    void grey_##isa##_to16(const uint16_t* in, uint16_t* out, \
+                           size_t amount); \
+    void grey_##isa##_from16(const uint16_t* in, uint16_t* out, \
+                             size_t amount); \
+    void grey_##isa##_to32(const uint32_t* in, uint32_t* out, \
+                           size_t amount); \
+    void grey_##isa##_from32(const uint32_t* in, uint32_t* out, \
+                             size_t amount); \
+    void grey_##isa##_to64(const uint64_t* in, uint64_t* out, \
+                           size_t amount); \
+    void grey_##isa##_from64(const uint64_t* in, uint64_t* out, \
+                             size_t amount)
+
+/** Declares the 4 Hilbert curve kernels of one instruction set. */
+#define GREY_HILBERT_KERNELS_DECLARE(isa) \
+    void grey_##isa##_hilbert_index2(const uint32_t* x, const uint32_t* y, \
+                                     uint64_t* indices, size_t amount, \
+                                     unsigned int bits); \
+    void grey_##isa##_hilbert_coords2(const uint64_t* indices, uint32_t* x, \
+                                      uint32_t* y, size_t amount, \
+                                      unsigned int bits); \
+    void grey_##isa##_hilbert_index3(const uint32_t* x, const uint32_t* y, \
+                                     const uint32_t* z, uint64_t* indices, \
+                                     size_t amount, unsigned int bits); \
+    void grey_##isa##_hilbert_coords3(const uint64_t* indices, uint32_t* x, \
+                                      uint32_t* y, uint32_t* z, \
+                                      size_t amount, unsigned int bits)
+
+/** Declares the 4 Hamming distance kernels of one instruction set. */
+#define GREY_DISTANCES_KERNELS_DECLARE(isa) \
+    void grey_##isa##_distances8(uint8_t query, const uint8_t* codes, \
+                                 uint8_t* distances, size_t amount); \
+    void grey_##isa##_distances16(uint16_t query, const uint16_t* codes, \
+                                  uint8_t* distances, size_t amount); \
+    void grey_##isa##_distances32(uint32_t query, const uint32_t* codes, \
+                                  uint8_t* distances, size_t amount); \
+    void grey_##isa##_distances64(uint64_t query, const uint64_t* codes, \
+                                  uint8_t* distances, size_t amount)
+
+/** Declares the 2 multiword decoders of one instruction set. */
+#define GREY_WORDS_FROM_KERNELS_DECLARE(isa) \
+    uint64_t grey_##isa##_words_from_le(const uint64_t* in, uint64_t* out, \
+                                        size_t amount, uint64_t flip); \
+    uint64_t grey_##isa##_words_from_be(const uint64_t* in, uint64_t* out, \
+                                        size_t amount, uint64_t flip)
+
+/**
+ * Defines a kernel processing one vector of \p lanes elements per iteration
+ * with \p vector_op and the leftovers with \p scalar_op.
+ *
+ * The vector type, the unaligned load and store intrinsics are passed in
+ * so the same skeleton serves every instruction set.
+ */
+#define GREY_KERNEL_DEFINE(name, type, vec_t, lanes, load, store, \
+                           vector_op, scalar_op) \
+    void name(const type* const in, type* const out, const size_t amount) \
+    { \
+        size_t i = 0; \
+        for (; i + (lanes) <= amount; i += (lanes)) \
+        { \
+            const vec_t v = load((const vec_t*) &in[i]); \
+            store((vec_t*) &out[i], vector_op(v)); \
+        } \
+        for (; i < amount; i++) \
+        { \
+            out[i] = scalar_op(in[i]); \
+        } \
+    }
+
+/**
+ * Defines a kernel writing the Grey codes of the \p amount values
+ * `start`, `start + step`, `start + 2 * step`... wrapping around, as used
+ * with a \p step of 1 or -1 by grey_fill_range() and
+ * grey_fill_range_down().
+ *
+ * The values of \p lanes consecutive elements are kept in a vector,
+ * encoded with \p vector_op and advanced with the \p add intrinsic, so
+ * nothing is loaded from memory in the loop.
+ */
+#define GREY_FILL_KERNEL_DEFINE(name, type, vec_t, lanes, load, store, add, \
+                                vector_op, scalar_op) \
+    void name(const type start, const type step, type* const out, \
+              const size_t amount) \
+    { \
+        size_t i = 0; \
+        if (amount >= (lanes)) \
+        { \
+            type first[(lanes)]; \
+            type increment[(lanes)]; \
+            for (size_t k = 0; k < (lanes); k++) \
+            { \
+                first[k] = (type) (start + k * step); \
+                increment[k] = (type) ((lanes) * step); \
+            } \
+            vec_t values = load((const vec_t*) first); \
+            const vec_t vector_step = load((const vec_t*) increment); \
+            for (; i + (lanes) <= amount; i += (lanes)) \
+            { \
+                store((vec_t*) &out[i], vector_op(values)); \
+                values = add(values, vector_step); \
+            } \
+        } \
+        for (; i < amount; i++) \
+        { \
+            out[i] = scalar_op((type) (start + i * step)); \
+        } \
+    }
+
+/**
+ * Defines a kernel writing the Hamming distances of \p query to the
+ * \p amount codes, see grey_distances().
+ *
+ * \p query is broadcast to all \p lanes of a vector by `broadcast(query)`,
+ * then each vector of codes is XORed with it and `count_op(v)` counts the
+ * bits of each of its lanes, still one per lane. `store_op(distances, v)`
+ * narrows the counts to bytes and stores them.
+ */
+#define GREY_DISTANCES_KERNEL_DEFINE(name, type, vec_t, lanes, load, \
+                                     broadcast, xor, count_op, store_op) \
+    void name(const type query, const type* const codes, \
+              uint8_t* const distances, const size_t amount) \
+    { \
+        const vec_t queries = broadcast(query); \
+        size_t i = 0; \
+        for (; i + (lanes) <= amount; i += (lanes)) \
+        { \
+            const vec_t v = xor(load((const vec_t*) &codes[i]), queries); \
+            store_op(&distances[i], count_op(v)); \
+        } \
+        for (; i < amount; i++) \
+        { \
+            distances[i] = (uint8_t) grey_inline_popcount64( \
+                    (uint64_t) (codes[i] ^ query)); \
+        } \
+    }
+
+/**
+ * Defines the 4 Hamming distance kernels of an AVX-512 instruction set,
+ * which needs F and BW, with `count<bits>(v)` counting the bits of each
+ * lane of \p bits. The narrowing stores of AVX-512 write only the bytes
+ * of the distances, and the leftover codes take a masked load/store.
+ */
+#define GREY_AVX512_DISTANCES_DEFINE(isa, count8, count16, count32, \
+                                     count64) \
+    GREY_AVX512_DISTANCES_KERNEL_DEFINE(grey_##isa##_distances8, uint8_t, \
+                                        8, __mmask64, _mm512_set1_epi8, \
+                                        count8, _mm512_mask_storeu_epi8) \
+    GREY_AVX512_DISTANCES_KERNEL_DEFINE(grey_##isa##_distances16, \
+                                        uint16_t, 16, __mmask32, \
+                                        _mm512_set1_epi16, count16, \
+                                        _mm512_mask_cvtepi16_storeu_epi8) \
+    GREY_AVX512_DISTANCES_KERNEL_DEFINE(grey_##isa##_distances32, \
+                                        uint32_t, 32, __mmask16, \
+                                        _mm512_set1_epi32, count32, \
+                                        _mm512_mask_cvtepi32_storeu_epi8) \
+    GREY_AVX512_DISTANCES_KERNEL_DEFINE(grey_##isa##_distances64, \
+                                        uint64_t, 64, __mmask8, \
+                                        _mm512_set1_epi64, count64, \
+                                        _mm512_mask_cvtepi64_storeu_epi8)
+
+/** One kernel of #GREY_AVX512_DISTANCES_DEFINE. */
+#define GREY_AVX512_DISTANCES_KERNEL_DEFINE(name, type, width, mask_t, \
+                                            broadcast, count_op, \
+                                            mask_store) \
+    void name(const type query, const type* const codes, \
+              uint8_t* const distances, const size_t amount) \
+    { \
+        const size_t lanes = 512U / (width); \
+        const __m512i queries = broadcast((int##width##_t) query); \
+        size_t i = 0; \
+        for (; i + lanes <= amount; i += lanes) \
+        { \
+            const __m512i v = _mm512_loadu_si512(&codes[i]); \
+            mask_store(&distances[i], (mask_t) -1, \
+                       count_op(_mm512_xor_si512(v, queries))); \
+        } \
+        if (i < amount) \
+        { \
+            const mask_t mask = (mask_t) ((1ULL << (amount - i)) - 1U); \
+            const __m512i v = _mm512_maskz_loadu_epi##width(mask, \
+                                                            &codes[i]); \
+            mask_store(&distances[i], mask, \
+                       count_op(_mm512_xor_si512(v, queries))); \
+        } \
+    }
+
+/**
+ * Grey encoding of one word of a multiword value, given the next more
+ * significant word \p above, whose lowest bit is shifted in from the top.
+ */
+static inline uint64_t grey_inline_word_to(const uint64_t word,
+                                           const uint64_t above)
+{
+    return word ^ (word >> 1U) ^ (above << 63U);
+}
+
+/**
+ * Decodes one word of a multiword value and inverts it if \p flip is all
+ * ones, that is if the parity of all the more significant code words is
+ * odd. Returns the flip of the next less significant word.
+ *
+ * The lowest bit of a decoded word is the parity of its code word, so the
+ * returned flip does not depend on the inversion: the dependency between
+ * consecutive words is a single XOR.
+ */
+static inline uint64_t grey_inline_word_from(const uint64_t code,
+                                             uint64_t* const value,
+                                             const uint64_t flip)
+{
+    const uint64_t decoded = grey_inline_from64(code);
+    *value = decoded ^ flip;
+    return flip ^ ((uint64_t) 0 - (decoded & 1U));
+}
+
+/** Bit `i` of the result is the XOR of the bits `0..i` of \p x. */
+static inline uint8_t grey_inline_prefix_xor_up8(uint8_t x)
+{
+    x ^= (uint8_t) (x << 1U);
+    x ^= (uint8_t) (x << 2U);
+    x ^= (uint8_t) (x << 4U);
+    return x;
+}
+
+/**
+ * Defines the two multiword encoders and the two multiword decoders of one
+ * instruction set, processing \p lanes words per iteration.
+ *
+ * `encode_op(words, above)` encodes a vector of words, see
+ * grey_inline_word_to(). The decoding operations are described in
+ * #GREY_WORDS_FROM_KERNELS_DEFINE.
+ *
+ * Both encoders encode \p amount words, each one XORed with itself shifted
+ * right and the lowest bit of its more significant neighbour, which is the
+ * next word for `words_to_le` and the previous one for `words_to_be`:
+ * - `words_to_le` encodes `in[0 .. amount-1]` reading also `in[amount]`,
+ *   going forward;
+ * - `words_to_be` encodes `in[1 .. amount]` reading also `in[0]`, going
+ *   backward.
+ *
+ * Both walk from the least significant word up, so every neighbour is read
+ * before it is overwritten and \p in may be the same buffer as \p out.
+ * The most significant word has no neighbour and is left to the caller.
+ */
+#define GREY_WORDS_KERNELS_DEFINE(isa, vec_t, lanes, load, store, \
+                                  encode_op, decode_op, parities_op, \
+                                  flip_op) \
+    void grey_##isa##_words_to_le(const uint64_t* const in, \
+                                  uint64_t* const out, const size_t amount) \
+    { \
+        size_t i = 0; \
+        for (; i + (lanes) <= amount; i += (lanes)) \
+        { \
+            const vec_t v = load((const vec_t*) &in[i]); \
+            const vec_t above = load((const vec_t*) &in[i + 1U]); \
+            store((vec_t*) &out[i], encode_op(v, above)); \
+        } \
+        for (; i < amount; i++) \
+        { \
+            out[i] = grey_inline_word_to(in[i], in[i + 1U]); \
+        } \
+    } \
+    void grey_##isa##_words_to_be(const uint64_t* const in, \
+                                  uint64_t* const out, const size_t amount) \
+    { \
+        size_t i = amount; \
+        for (; i >= (lanes); i -= (lanes)) \
+        { \
+            const vec_t v = load((const vec_t*) &in[i - (lanes) + 1U]); \
+            const vec_t above = load((const vec_t*) &in[i - (lanes)]); \
+            store((vec_t*) &out[i - (lanes) + 1U], encode_op(v, above)); \
+        } \
+        for (; i > 0; i--) \
+        { \
+            out[i] = grey_inline_word_to(in[i], in[i - 1U]); \
+        } \
+    } \
+    GREY_WORDS_FROM_KERNELS_DEFINE(isa, vec_t, lanes, load, store, \
+                                   decode_op, parities_op, flip_op)
+
+/**
+ * Defines the two multiword decoders of one instruction set.
+ *
+ * Both decode the \p amount words of \p in from the most significant one
+ * down, starting with \p flip (0 or all ones) as the parity of the code
+ * words above them, and return the parity to continue with below them:
+ * `words_from_le` from `in[amount-1]` backward, `words_from_be` from
+ * `in[0]` forward.
+ *
+ * Each vector is decoded with `decode_op(words)`, then the lowest bits of
+ * its lanes are gathered by `parities_op(words)` into an integer, bit `k`
+ * for lane `k`. Lane `k` must be inverted when the parities of the lanes
+ * more significant than it, plus \p flip, XOR to 1: that is a prefix-XOR
+ * of this small integer, and `flip_op(words, mask)` inverts the lanes with
+ * a bit set in the mask. With a single lane that is all overhead, so the
+ * vector loop is skipped and the per-word loop does all the work.
+ */
+#define GREY_WORDS_FROM_KERNELS_DEFINE(isa, vec_t, lanes, load, store, \
+                                       decode_op, parities_op, flip_op) \
+    uint64_t grey_##isa##_words_from_le(const uint64_t* const in, \
+                                        uint64_t* const out, \
+                                        const size_t amount, uint64_t flip) \
+    { \
+        const unsigned int lanes_mask = (1U << (lanes)) - 1U; \
+        size_t i = amount; \
+        for (; (lanes) > 1U && i >= (lanes); i -= (lanes)) \
+        { \
+            const vec_t v = decode_op(load((const vec_t*) &in[i - (lanes)])); \
+            const uint8_t parities = (uint8_t) parities_op(v); \
+            /* Inclusive suffix XOR: bit k is the XOR of the bits k..7 */ \
+            const uint8_t suffix = grey_inline_from8(parities); \
+            const unsigned int mask = (unsigned int) (suffix ^ parities) \
+                                      ^ ((unsigned int) flip & lanes_mask); \
+            store((vec_t*) &out[i - (lanes)], flip_op(v, mask)); \
+            flip ^= (uint64_t) 0 - (suffix & 1U); \
+        } \
+        for (; i > 0; i--) \
+        { \
+            flip = grey_inline_word_from(in[i - 1U], &out[i - 1U], flip); \
+        } \
+        return flip; \
+    } \
+    uint64_t grey_##isa##_words_from_be(const uint64_t* const in, \
+                                        uint64_t* const out, \
+                                        const size_t amount, uint64_t flip) \
+    { \
+        const unsigned int lanes_mask = (1U << (lanes)) - 1U; \
+        size_t i = 0; \
+        for (; (lanes) > 1U && i + (lanes) <= amount; i += (lanes)) \
+        { \
+            const vec_t v = decode_op(load((const vec_t*) &in[i])); \
+            const uint8_t parities = (uint8_t) parities_op(v); \
+            /* Inclusive prefix XOR: bit k is the XOR of the bits 0..k */ \
+            const uint8_t prefix = grey_inline_prefix_xor_up8(parities); \
+            const unsigned int mask = (((unsigned int) prefix << 1U) \
+                                       ^ (unsigned int) flip) & lanes_mask; \
+            store((vec_t*) &out[i], flip_op(v, mask)); \
+            flip ^= (uint64_t) 0 - ((prefix >> ((lanes) - 1U)) & 1U); \
+        } \
+        for (; i < amount; i++) \
+        { \
+            flip = grey_inline_word_from(in[i], &out[i], flip); \
+        } \
+        return flip; \
+    }
+
+GREY_KERNELS_DECLARE(scalar);
+#if defined(GREY_DISPATCH_X86) || defined(__SSE2__)
+#define GREY_KERNELS_SSE2 1
+GREY_KERNELS_DECLARE(sse2);
+#endif
+#if defined(GREY_DISPATCH_X86) || defined(__AVX2__)
+#define GREY_KERNELS_AVX2 1
+GREY_KERNELS_DECLARE(avx2);
+#endif
+#if defined(GREY_DISPATCH_X86) \
+    || (defined(__AVX512F__) && defined(__AVX512BW__))
+#define GREY_KERNELS_AVX512 1
+GREY_KERNELS_DECLARE(avx512);
+#endif
+/* Carry-less multiplication kernels exist only for 64-bit decoding. */
+#if defined(GREY_DISPATCH_X86) || defined(__PCLMUL__)
+#define GREY_KERNELS_PCLMUL 1
+void grey_pclmul_from64(const uint64_t* in, uint64_t* out, size_t amount);
+GREY_WORDS_FROM_KERNELS_DECLARE(pclmul);
+#endif
+#if defined(GREY_DISPATCH_X86) \
+    || (defined(__VPCLMULQDQ__) && defined(__AVX512F__) \
+        && defined(__AVX512BW__))
+#define GREY_KERNELS_VPCLMUL 1
+void grey_vpclmul_from64(const uint64_t* in, uint64_t* out, size_t amount);
+GREY_WORDS_FROM_KERNELS_DECLARE(vpclmul);
+#endif
+/*
+ * Bit counting instructions of AVX-512, replacing the distance kernels of
+ * the AVX-512 instruction sets on the CPUs that have them.
+ */
+#if defined(GREY_DISPATCH_X86) \
+    || (defined(__AVX512VPOPCNTDQ__) && defined(__AVX512BITALG__) \
+        && defined(__AVX512F__) && defined(__AVX512BW__))
+#define GREY_KERNELS_VPOPCNT 1
+GREY_DISTANCES_KERNELS_DECLARE(vpopcnt);
+#endif
+/*
+ * Lookup table kernels, portable, exist only for the conversions. Their
+ * tables are filled by grey_lut_init() before they are first selected.
+ */
+GREY_CONVERT_KERNELS_DECLARE(lut);
+void grey_lut_init(void);
+
+typedef void (* grey_kernel8_fn)(const uint8_t* in, uint8_t* out,
+                                 size_t amount);
+typedef void (* grey_kernel16_fn)(const uint16_t* in, uint16_t* out,
+                                  size_t amount);
+typedef void (* grey_kernel32_fn)(const uint32_t* in, uint32_t* out,
+                                  size_t amount);
+typedef void (* grey_kernel64_fn)(const uint64_t* in, uint64_t* out,
+                                  size_t amount);
+typedef void (* grey_fill8_fn)(uint8_t start, uint8_t step, uint8_t* out,
+                               size_t amount);
+typedef void (* grey_fill16_fn)(uint16_t start, uint16_t step, uint16_t* out,
+                                size_t amount);
+typedef void (* grey_fill32_fn)(uint32_t start, uint32_t step, uint32_t* out,
+                                size_t amount);
+typedef void (* grey_fill64_fn)(uint64_t start, uint64_t step, uint64_t* out,
+                                size_t amount);
+typedef grey_kernel64_fn grey_words_to_fn;
+typedef uint64_t (* grey_words_from_fn)(const uint64_t* in, uint64_t* out,
+                                        size_t amount, uint64_t flip);
+typedef void (* grey_hilbert_index2_fn)(const uint32_t* x, const uint32_t* y,
+                                        uint64_t* indices, size_t amount,
+                                        unsigned int bits);
+typedef void (* grey_hilbert_coords2_fn)(const uint64_t* indices, uint32_t* x,
+                                         uint32_t* y, size_t amount,
+                                         unsigned int bits);
+typedef void (* grey_hilbert_index3_fn)(const uint32_t* x, const uint32_t* y,
+                                        const uint32_t* z, uint64_t* indices,
+                                        size_t amount, unsigned int bits);
+typedef void (* grey_hilbert_coords3_fn)(const uint64_t* indices, uint32_t* x,
+                                         uint32_t* y, uint32_t* z,
+                                         size_t amount, unsigned int bits);
+typedef void (* grey_distances8_fn)(uint8_t query, const uint8_t* codes,
+                                    uint8_t* distances, size_t amount);
+typedef void (* grey_distances16_fn)(uint16_t query, const uint16_t* codes,
+                                     uint8_t* distances, size_t amount);
+typedef void (* grey_distances32_fn)(uint32_t query, const uint32_t* codes,
+                                     uint8_t* distances, size_t amount);
+typedef void (* grey_distances64_fn)(uint64_t query, const uint64_t* codes,
+                                     uint8_t* distances, size_t amount);
+
+/** Set of kernels of one instruction set, for every width. */
+typedef struct
+{
+    grey_kernel8_fn to8;
+    grey_kernel8_fn from8;
+    grey_kernel16_fn to16;
+    grey_kernel16_fn from16;
+    grey_kernel32_fn to32;
+    grey_kernel32_fn from32;
+    grey_kernel64_fn to64;
+    grey_kernel64_fn from64;
+    grey_words_to_fn words_to_le;
+    grey_words_to_fn words_to_be;
+    grey_words_from_fn words_from_le;
+    grey_words_from_fn words_from_be;
+    grey_fill8_fn fill8;
+    grey_fill16_fn fill16;
+    grey_fill32_fn fill32;
+    grey_fill64_fn fill64;
+    grey_hilbert_index2_fn hilbert_index2;
+    grey_hilbert_coords2_fn hilbert_coords2;
+    grey_hilbert_index3_fn hilbert_index3;
+    grey_hilbert_coords3_fn hilbert_coords3;
+    grey_distances8_fn distances8;
+    grey_distances16_fn distances16;
+    grey_distances32_fn distances32;
+    grey_distances64_fn distances64;
+    grey_kernel_t id;
+} grey_kernel_table_t;
+
+/**
+ * Kernels currently in use. Initially the scalar ones, replaced at load
+ * time by the best ones the CPU supports, see grey_kernel_force().
+ */
+extern grey_kernel_table_t grey_kernels;
+
+/** Field of #grey_kernels for \p direction at the #GREY_UINTBITS width. */
+#define GREY_KERNEL_FIELD_(direction, bits) direction##bits
+#define GREY_KERNEL_FIELD(direction, bits) GREY_KERNEL_FIELD_(direction, bits)
+#define GREY_KERNEL(direction) \
+    grey_kernels.GREY_KERNEL_FIELD(direction, GREY_UINTBITS)
+
+#endif  /* GREY_KERNELS_H */
@@ -0,0 +1,109 @@
+/**
+ * @file
+ * @brief Lookup table conversion kernels.
+ *
+ * 8-bit codes convert with a table of 256 entries and 16-bit ones with a
+ * table of 65536 entries. Wider codes convert byte by byte with the
+ * 256-entry tables: encoding, each byte only takes the lowest bit of the
+ * byte above it into its top bit; decoding, each byte is inverted if the
+ * bytes above it have odd parity, which is the XOR of the lowest bits of
+ * the decoded bytes above it.
+ *
+ * Whether a table lookup beats the shift-XOR cascade depends on the CPU,
+ * see grey_kernel_tune().
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+
+static uint8_t grey_lut_to8_table[1U << 8U];
+static uint8_t grey_lut_from8_table[1U << 8U];
+static uint16_t grey_lut_to16_table[1U << 16U];
+static uint16_t grey_lut_from16_table[1U << 16U];
+static bool grey_lut_ready = false;
+
+void grey_lut_init(void)
+{
+    if (grey_lut_ready)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < (1U << 8U); i++)
+    {
+        grey_lut_to8_table[i] = grey_inline_to8((uint8_t) i);
+        grey_lut_from8_table[i] = grey_inline_from8((uint8_t) i);
+    }
+    for (uint32_t i = 0; i < (1U << 16U); i++)
+    {
+        grey_lut_to16_table[i] = grey_inline_to16((uint16_t) i);
+        grey_lut_from16_table[i] = grey_inline_from16((uint16_t) i);
+    }
+    grey_lut_ready = true;
+}
+
+#define GREY_LUT_KERNEL_DEFINE(name, type, table) \
+    void name(const type* const in, type* const out, const size_t amount) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            out[i] = table[in[i]]; \
+        } \
+    }
+
+GREY_LUT_KERNEL_DEFINE(grey_lut_to8, uint8_t, grey_lut_to8_table)
+GREY_LUT_KERNEL_DEFINE(grey_lut_from8, uint8_t, grey_lut_from8_table)
+GREY_LUT_KERNEL_DEFINE(grey_lut_to16, uint16_t, grey_lut_to16_table)
+GREY_LUT_KERNEL_DEFINE(grey_lut_from16, uint16_t, grey_lut_from16_table)
+
+/** Lowest bit of each byte, moved to its top bit by the encoding. */
+#define GREY_LUT_LOWS UINT64_C(0x0101010101010101)
+
+/**
+ * Defines the byte by byte kernels of \p bits -wide codes. All the bytes
+ * are looked up independently, then the decoded ones are inverted by the
+ * parity of the bytes above them, which is a suffix XOR of the lowest
+ * bits of the decoded bytes.
+ */
+#define GREY_LUT_WIDE_DEFINE(bits, type) \
+    void grey_lut_to##bits(const type* const in, type* const out, \
+                           const size_t amount) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            const type value = in[i]; \
+            type code = (type) ((value >> 1U) & (type) (GREY_LUT_LOWS << 7U)); \
+            for (unsigned int shift = 0; shift < (bits); shift += 8U) \
+            { \
+                code ^= (type) ((type) grey_lut_to8_table[ \
+                        (uint8_t) (value >> shift)] << shift); \
+            } \
+            out[i] = code; \
+        } \
+    } \
+    void grey_lut_from##bits(const type* const in, type* const out, \
+                             const size_t amount) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            const type code = in[i]; \
+            type value = 0; \
+            for (unsigned int shift = 0; shift < (bits); shift += 8U) \
+            { \
+                value |= (type) ((type) grey_lut_from8_table[ \
+                        (uint8_t) (code >> shift)] << shift); \
+            } \
+            /* Parity of the bytes above each one, in its lowest bit */ \
+            type odd = (type) ((value & (type) GREY_LUT_LOWS) >> 8U); \
+            for (unsigned int shift = 8U; shift < (bits); shift *= 2U) \
+            { \
+                odd ^= (type) (odd >> shift); \
+            } \
+            out[i] = (type) (value ^ (type) (odd * 0xFFU)); \
+        } \
+    }
+
+GREY_LUT_WIDE_DEFINE(32, uint32_t)
+GREY_LUT_WIDE_DEFINE(64, uint64_t)
@@ -0,0 +1,336 @@
+/**
+ * @file
+ * @brief Conversion of packed integers of any byte order, in buffers and
+ * in memory-mapped files.
+ *
+ * Integers in the foreign byte order are swapped, converted with the
+ * bulk kernels in use and swapped back as needed one small block at a
+ * time, so each block is still in the L1 cache for the following steps
+ * and memory is crossed only once. The blocks are processed by the pool
+ * of the parallel conversions, each thread on its own range of chunks.
+ *
+ * Files are converted through `mmap()`: the kernels read and write the
+ * page cache directly, with no copy into user buffers.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GREY_PACKED_MMAP
+/* mmap(), posix_madvise(), ftruncate() */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "grey.h"
+#include "grey_kernels.h"
+#include "grey_parallel.h"
+#include "grey_stats.h"
+
+#if defined(GREY_PACKED_MMAP)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/** Bytes swapped and converted at a time, fitting in any L1 cache. */
+#define GREY_PACKED_BLOCK 4096U
+
+static inline uint8_t grey_packed_bswap8(const uint8_t x)
+{
+    return x;
+}
+
+static inline uint16_t grey_packed_bswap16(const uint16_t x)
+{
+    return (uint16_t) ((x << 8U) | (x >> 8U));
+}
+
+static inline uint32_t grey_packed_bswap32(const uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap32(x);
+#else
+    return (x << 24U) | ((x << 8U) & 0x00FF0000U)
+           | ((x >> 8U) & 0x0000FF00U) | (x >> 24U);
+#endif
+}
+
+static inline uint64_t grey_packed_bswap64(const uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_bswap64(x);
+#else
+    return ((uint64_t) grey_packed_bswap32((uint32_t) x) << 32U)
+           | grey_packed_bswap32((uint32_t) (x >> 32U));
+#endif
+}
+
+/**
+ * Defines the converters of \p bits -wide packed integers for the pool,
+ * one for each direction and combination of swapping the input and the
+ * output, and their table indexed as
+ * `[decode][swap input][swap output]`.
+ */
+#define GREY_PACKED_DEFINE(bits, type) \
+    static void grey_packed_swap##bits(const type* const in, \
+                                       type* const out, \
+                                       const size_t amount) \
+    { \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            out[i] = grey_packed_bswap##bits(in[i]); \
+        } \
+    } \
+    static inline void grey_packed_fused##bits( \
+            const type* const in, type* const out, const size_t amount, \
+            void (* const kernel)(const type*, type*, size_t), \
+            const bool swap_in, const bool swap_out) \
+    { \
+        if (!swap_in && !swap_out) \
+        { \
+            kernel(in, out, amount); \
+            return; \
+        } \
+        const size_t block = GREY_PACKED_BLOCK / sizeof(type); \
+        for (size_t done = 0; done < amount; done += block) \
+        { \
+            const size_t length = (amount - done < block) \
+                                  ? amount - done : block; \
+            const type* source = &in[done]; \
+            type* const destination = &out[done]; \
+            if (swap_in) \
+            { \
+                grey_packed_swap##bits(source, destination, length); \
+                source = destination; \
+            } \
+            kernel(source, destination, length); \
+            if (swap_out) \
+            { \
+                grey_packed_swap##bits(destination, destination, length); \
+            } \
+        } \
+    } \
+    GREY_PACKED_FN_DEFINE(bits, type, to, false, false) \
+    GREY_PACKED_FN_DEFINE(bits, type, to, false, true) \
+    GREY_PACKED_FN_DEFINE(bits, type, to, true, false) \
+    GREY_PACKED_FN_DEFINE(bits, type, to, true, true) \
+    GREY_PACKED_FN_DEFINE(bits, type, from, false, false) \
+    GREY_PACKED_FN_DEFINE(bits, type, from, false, true) \
+    GREY_PACKED_FN_DEFINE(bits, type, from, true, false) \
+    GREY_PACKED_FN_DEFINE(bits, type, from, true, true) \
+    static const grey_parallel_fn_t grey_packed_fns##bits[2][2][2] = { \
+            { \
+                    {grey_packed_to##bits##_false_false, \
+                     grey_packed_to##bits##_false_true}, \
+                    {grey_packed_to##bits##_true_false, \
+                     grey_packed_to##bits##_true_true}, \
+            }, \
+            { \
+                    {grey_packed_from##bits##_false_false, \
+                     grey_packed_from##bits##_false_true}, \
+                    {grey_packed_from##bits##_true_false, \
+                     grey_packed_from##bits##_true_true}, \
+            }, \
+    };
+
+/** One converter of GREY_PACKED_DEFINE(). */
+#define GREY_PACKED_FN_DEFINE(bits, type, direction, swap_in, swap_out) \
+    static void grey_packed_##direction##bits##_##swap_in##_##swap_out( \
+            const void* const in, void* const out, const size_t amount) \
+    { \
+        grey_packed_fused##bits(in, out, amount, \
+                                grey_kernels.direction##bits, \
+                                swap_in, swap_out); \
+    }
+
+GREY_PACKED_DEFINE(8, uint8_t)
+GREY_PACKED_DEFINE(16, uint16_t)
+GREY_PACKED_DEFINE(32, uint32_t)
+GREY_PACKED_DEFINE(64, uint64_t)
+
+/** Whether integers in \p order must be swapped to the native one. */
+static bool grey_packed_foreign(const grey_byte_order_t order)
+{
+    const uint16_t one = 1U;
+    const bool little = *(const uint8_t*) &one == 1U;
+    return (order == GREY_ORDER_LITTLE && !little)
+           || (order == GREY_ORDER_BIG && little);
+}
+
+static bool grey_packed_valid(const grey_packed_config_t* const config)
+{
+    return (config->bits == 8U || config->bits == 16U
+            || config->bits == 32U || config->bits == 64U)
+           && config->input_order <= GREY_ORDER_BIG
+           && config->output_order <= GREY_ORDER_BIG;
+}
+
+grey_err_t grey_packed_convert(const void* const input, void* const output,
+                               const size_t bytes,
+                               const grey_packed_config_t* const config)
+{
+    if (!grey_packed_valid(config) || bytes % (config->bits / 8U) != 0U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    const size_t size = config->bits / 8U;
+    const bool swap_in = grey_packed_foreign(config->input_order);
+    const bool swap_out = grey_packed_foreign(config->output_order);
+    grey_parallel_fn_t fn;
+    switch (config->bits)
+    {
+        case 8U:
+            fn = grey_packed_fns8[config->decode][0][0];
+            break;
+        case 16U:
+            fn = grey_packed_fns16[config->decode][swap_in][swap_out];
+            break;
+        case 32U:
+            fn = grey_packed_fns32[config->decode][swap_in][swap_out];
+            break;
+        default:
+            fn = grey_packed_fns64[config->decode][swap_in][swap_out];
+            break;
+    }
+    /* Counted once for the whole call, not per chunk of the pool */
+    GREY_STATS_RECORD(config->decode ? GREY_STATS_PACKED_FROM
+                                     : GREY_STATS_PACKED_TO,
+                      grey_kernel_active_width(config->bits, config->decode),
+                      bytes / size, 2U * bytes,
+                      grey_parallel_run(fn, input, output, bytes / size,
+                                        size));
+    return GREY_OK;
+}
+
+#if defined(GREY_PACKED_MMAP)
+
+/** Maps the whole of \p fd, NULL on failure. */
+static void* grey_packed_map(const int fd, const size_t bytes,
+                             const bool writable)
+{
+    void* const map = mmap(NULL, bytes,
+                           writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                           MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        return NULL;
+    }
+    /* Only a hint: more read-ahead, pages dropped sooner after use */
+    posix_madvise(map, bytes, POSIX_MADV_SEQUENTIAL);
+    return map;
+}
+
+/**
+ * Converts the \p bytes of \p in_fd, all mapped, into \p out_fd, already
+ * of the same size, or in place if it is -1.
+ */
+static grey_err_t grey_packed_convert_fd(const int in_fd, const int out_fd,
+                                         const size_t bytes,
+                                         const grey_packed_config_t* config)
+{
+    void* const input = grey_packed_map(in_fd, bytes, out_fd < 0);
+    if (input == NULL)
+    {
+        return GREY_ERR_IO;
+    }
+    void* output = input;
+    if (out_fd >= 0)
+    {
+        output = grey_packed_map(out_fd, bytes, true);
+        if (output == NULL)
+        {
+            munmap(input, bytes);
+            return GREY_ERR_IO;
+        }
+    }
+    const grey_err_t err = grey_packed_convert(input, output, bytes, config);
+    if (output != input)
+    {
+        munmap(output, bytes);
+    }
+    munmap(input, bytes);
+    return err;
+}
+
+grey_err_t grey_packed_convert_file(const char* const input,
+                                    const char* const output,
+                                    const grey_packed_config_t* const config)
+{
+    if (!grey_packed_valid(config))
+    {
+        return GREY_ERR_INVALID;
+    }
+    struct stat in_stat;
+    struct stat out_stat;
+    if (stat(input, &in_stat) != 0)
+    {
+        return GREY_ERR_IO;
+    }
+    /* Truncating the input as the output would lose it */
+    const bool in_place = output == NULL
+                          || (stat(output, &out_stat) == 0
+                              && out_stat.st_dev == in_stat.st_dev
+                              && out_stat.st_ino == in_stat.st_ino);
+    const int in_fd = open(input, in_place ? O_RDWR : O_RDONLY);
+    if (in_fd < 0)
+    {
+        return GREY_ERR_IO;
+    }
+    grey_err_t err = GREY_OK;
+    int out_fd = -1;
+    if (fstat(in_fd, &in_stat) != 0)
+    {
+        err = GREY_ERR_IO;
+    }
+    else if (!S_ISREG(in_stat.st_mode))
+    {
+        /* Pipes and devices cannot be mapped, as mmap() would report */
+        errno = ENODEV;
+        err = GREY_ERR_IO;
+    }
+    else if ((uintmax_t) in_stat.st_size > SIZE_MAX)
+    {
+        err = GREY_ERR_RANGE;
+    }
+    else if ((size_t) in_stat.st_size % (config->bits / 8U) != 0U)
+    {
+        err = GREY_ERR_INVALID;
+    }
+    else if (!in_place)
+    {
+        out_fd = open(output, O_RDWR | O_CREAT | O_TRUNC, 0666);
+        if (out_fd < 0 || ftruncate(out_fd, in_stat.st_size) != 0)
+        {
+            err = GREY_ERR_IO;
+        }
+    }
+    if (err == GREY_OK && in_stat.st_size > 0)
+    {
+        err = grey_packed_convert_fd(in_fd, out_fd,
+                                     (size_t) in_stat.st_size, config);
+    }
+    if (out_fd >= 0 && close(out_fd) != 0 && err == GREY_OK)
+    {
+        err = GREY_ERR_IO;
+    }
+    close(in_fd);
+    return err;
+}
+
+#else
+
+grey_err_t grey_packed_convert_file(const char* const input,
+                                    const char* const output,
+                                    const grey_packed_config_t* const config)
+{
+    (void) input;
+    (void) output;
+    (void) config;
+    return GREY_ERR_UNSUPPORTED;
+}
+
+#endif
@@ -0,0 +1,561 @@
+/**
+ * @file
+ * @brief Multi-threaded bulk conversions of very large arrays.
+ *
+ * The array is split into chunks of grey_parallel_config_t.chunk bytes,
+ * each converted by the regular single-threaded kernels. The calling
+ * thread and the threads of a pool, started on the first large call, each
+ * own a contiguous range of chunks, always the same for arrays of the
+ * same size in bytes. A thread done with its own range steals the
+ * remaining chunks of the others, so a slow or descheduled thread does
+ * not hold back the whole call.
+ *
+ * Chunks are claimed with an atomic increment of the next chunk index of
+ * a range, by its owner and by thieves alike, so each one is converted
+ * exactly once without any lock. The pool itself sleeps on a condition
+ * variable between calls.
+ *
+ * On Linux each pool thread is pinned to a CPU of the process when it is
+ * created, so its range stays on the same NUMA node from the first touch
+ * to the conversions, and thieves empty the ranges of their own node
+ * before the ones of the others. The calling thread is left as it is:
+ * its range is local only if the application keeps it on one node.
+ *
+ * Without POSIX threads, or with `GREY_NO_THREADS` defined, everything
+ * runs in the calling thread.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#if !defined(GREY_NO_THREADS) && defined(__GNUC__) \
+    && (defined(__unix__) || defined(__APPLE__))
+#define GREY_PARALLEL_THREADS
+#if defined(__linux__)
+#define GREY_PARALLEL_AFFINITY
+/* pthread_attr_setaffinity_np(), CPU_SET() and the getcpu system call */
+#define _GNU_SOURCE
+#else
+/* pthreads and sysconf() */
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+
+#include "grey.h"
+#include "grey_kernels.h"
+#include "grey_parallel.h"
+#include "grey_stats.h"
+#include <string.h>
+
+#if defined(GREY_PARALLEL_THREADS)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#if defined(GREY_PARALLEL_AFFINITY)
+#include <dirent.h>
+#include <sched.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#endif
+
+/** Default of grey_parallel_config_t.cutoff. */
+#define GREY_PARALLEL_CUTOFF_DEFAULT (4U * 1024U * 1024U)
+/** Default of grey_parallel_config_t.chunk, fits in most L2 caches. */
+#define GREY_PARALLEL_CHUNK_DEFAULT (64U * 1024U)
+
+static grey_parallel_config_t grey_parallel_config = {
+        .threads = 0,
+        .cutoff = GREY_PARALLEL_CUTOFF_DEFAULT,
+        .chunk = GREY_PARALLEL_CHUNK_DEFAULT,
+};
+
+/** Converts \p amount elements with \p fn, or zeroes them without. */
+static void grey_parallel_convert(const grey_parallel_fn_t fn,
+                                  const void* const in, void* const out,
+                                  const size_t amount, const size_t size)
+{
+    if (fn == NULL)
+    {
+        memset(out, 0, amount * size);
+    }
+    else
+    {
+        fn(in, out, amount);
+    }
+}
+
+#if defined(GREY_PARALLEL_THREADS)
+
+/** Bytes of a cache line, to keep the ranges of two threads apart. */
+#define GREY_PARALLEL_CACHE_LINE 64U
+
+/**
+ * Chunks of one thread: the next one to claim and the end. Alone in its
+ * cache line, as every thief increments it.
+ */
+typedef struct
+{
+    size_t next;
+    size_t end;
+    unsigned char padding[GREY_PARALLEL_CACHE_LINE - 2U * sizeof(size_t)];
+} grey_parallel_range_t;
+
+/** One call split into chunks, a NULL grey_parallel_job_t.fn zeroes. */
+typedef struct
+{
+    grey_parallel_fn_t fn;
+    const unsigned char* in;
+    unsigned char* out;
+    size_t amount;
+    size_t size;
+    size_t chunk;
+    size_t workers;
+    grey_parallel_range_t ranges[GREY_PARALLEL_MAX_THREADS];
+    /** NUMA node of the thread owning each range, -1 if unknown. */
+    int nodes[GREY_PARALLEL_MAX_THREADS];
+} grey_parallel_job_t;
+
+/**
+ * A pool thread, with the last call it has seen when started and the
+ * NUMA node of its CPU, -1 if unknown or not pinned.
+ */
+typedef struct
+{
+    size_t index;
+    unsigned long generation;
+    int node;
+} grey_parallel_worker_t;
+
+/** The pool, only changed while holding grey_pool.call. */
+static struct
+{
+    /** Held for the whole of a parallel call or a reconfiguration. */
+    pthread_mutex_t call;
+    /** Guards the fields below, shared with the pool threads. */
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    unsigned long generation;
+    size_t pending;
+    bool stop;
+    size_t started;
+    pthread_t threads[GREY_PARALLEL_MAX_THREADS];
+    grey_parallel_worker_t workers[GREY_PARALLEL_MAX_THREADS];
+    grey_parallel_job_t job;
+} grey_pool = {
+        .call = PTHREAD_MUTEX_INITIALIZER,
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+        .wake = PTHREAD_COND_INITIALIZER,
+        .done = PTHREAD_COND_INITIALIZER,
+};
+
+/** Converts or zeroes the chunk at \p index of \p job. */
+static void grey_parallel_chunk(const grey_parallel_job_t* const job,
+                                const size_t index)
+{
+    const size_t first = index * job->chunk;
+    const size_t amount = (job->amount - first < job->chunk)
+                          ? job->amount - first : job->chunk;
+    grey_parallel_convert(job->fn,
+                          (job->in == NULL) ? NULL
+                                            : &job->in[first * job->size],
+                          &job->out[first * job->size], amount, job->size);
+}
+
+/**
+ * Converts the chunks of \p worker, then steals from the others: first
+ * the ones on the same NUMA node, then the rest. Unknown nodes count as
+ * the same one.
+ */
+static void grey_parallel_work(grey_parallel_job_t* const job,
+                               const size_t worker)
+{
+    const int node = job->nodes[worker];
+    for (unsigned int pass = 0; pass < 2U; pass++)
+    {
+        for (size_t i = 0; i < job->workers; i++)
+        {
+            const size_t owner = (worker + i) % job->workers;
+            const bool local = node < 0 || job->nodes[owner] < 0
+                               || job->nodes[owner] == node;
+            if (local != (pass == 0U))
+            {
+                continue;
+            }
+            grey_parallel_range_t* const range = &job->ranges[owner];
+            for (;;)
+            {
+                const size_t index = __atomic_fetch_add(&range->next, 1U,
+                                                        __ATOMIC_RELAXED);
+                if (index >= range->end)
+                {
+                    break;
+                }
+                grey_parallel_chunk(job, index);
+            }
+        }
+    }
+}
+
+static void* grey_parallel_thread(void* const argument)
+{
+    const grey_parallel_worker_t* const worker = argument;
+    unsigned long seen = worker->generation;
+    pthread_mutex_lock(&grey_pool.lock);
+    for (;;)
+    {
+        while (grey_pool.generation == seen && !grey_pool.stop)
+        {
+            pthread_cond_wait(&grey_pool.wake, &grey_pool.lock);
+        }
+        if (grey_pool.stop)
+        {
+            break;
+        }
+        seen = grey_pool.generation;
+        pthread_mutex_unlock(&grey_pool.lock);
+        grey_parallel_work(&grey_pool.job, worker->index);
+        pthread_mutex_lock(&grey_pool.lock);
+        if (--grey_pool.pending == 0)
+        {
+            pthread_cond_signal(&grey_pool.done);
+        }
+    }
+    pthread_mutex_unlock(&grey_pool.lock);
+    return NULL;
+}
+
+/** Threads to use, including the calling one. */
+static size_t grey_parallel_threads(void)
+{
+    size_t threads = grey_parallel_config.threads;
+    if (threads == 0)
+    {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (size_t) online : 1U;
+    }
+    return (threads > GREY_PARALLEL_MAX_THREADS)
+           ? GREY_PARALLEL_MAX_THREADS : threads;
+}
+
+#if defined(GREY_PARALLEL_AFFINITY)
+
+/** NUMA node of \p cpu, from its `nodeN` entry in sysfs, -1 if none. */
+static int grey_parallel_cpu_node(const size_t cpu)
+{
+    char path[64];
+    (void) snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu",
+                    cpu);
+    DIR* const dir = opendir(path);
+    if (dir == NULL)
+    {
+        return -1;
+    }
+    int node = -1;
+    for (const struct dirent* entry = readdir(dir);
+         entry != NULL && node < 0; entry = readdir(dir))
+    {
+        unsigned int id;
+        if (sscanf(entry->d_name, "node%u", &id) == 1)
+        {
+            node = (int) id;
+        }
+    }
+    (void) closedir(dir);
+    return node;
+}
+
+/** NUMA node the calling thread runs on now, -1 if unknown. */
+static int grey_parallel_current_node(void)
+{
+    unsigned int cpu;
+    unsigned int node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+    {
+        return -1;
+    }
+    return (int) node;
+}
+
+/**
+ * Pins the pool thread \p index to the CPU of the process at the same
+ * position, wrapping around, leaving the first one to the calling
+ * thread when there are enough.
+ *
+ * @return false if the CPUs of the process are unknown, in which case the
+ *         thread is created unpinned.
+ */
+static bool grey_parallel_pin(pthread_attr_t* const attr, const size_t index,
+                              int* const node)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0
+        || CPU_COUNT(&allowed) == 0)
+    {
+        return false;
+    }
+    size_t position = index % (size_t) CPU_COUNT(&allowed);
+    size_t cpu = 0;
+    for (; cpu < (size_t) CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+            if (position == 0)
+            {
+                break;
+            }
+            position--;
+        }
+    }
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(cpu, &pinned);
+    if (pthread_attr_setaffinity_np(attr, sizeof(pinned), &pinned) != 0)
+    {
+        return false;
+    }
+    *node = grey_parallel_cpu_node(cpu);
+    return true;
+}
+
+#endif
+
+/**
+ * Starts the missing pool threads, pinned to CPUs where supported. If the
+ * system refuses to create some, the calls go on with the ones that
+ * started.
+ */
+static void grey_parallel_start(void)
+{
+    const size_t wanted = grey_parallel_threads() - 1U;
+    while (grey_pool.started < wanted)
+    {
+        const size_t i = grey_pool.started;
+        pthread_attr_t attr;
+        if (pthread_attr_init(&attr) != 0)
+        {
+            break;
+        }
+        /* No call is running: the generation is stable. */
+        grey_pool.workers[i].index = i + 1U;
+        grey_pool.workers[i].generation = grey_pool.generation;
+        grey_pool.workers[i].node = -1;
+#if defined(GREY_PARALLEL_AFFINITY)
+        (void) grey_parallel_pin(&attr, i + 1U, &grey_pool.workers[i].node);
+#endif
+        const int err = pthread_create(&grey_pool.threads[i], &attr,
+                                       grey_parallel_thread,
+                                       &grey_pool.workers[i]);
+        (void) pthread_attr_destroy(&attr);
+        if (err != 0)
+        {
+            break;
+        }
+        grey_pool.started++;
+    }
+}
+
+/** Joins all pool threads. The caller holds grey_pool.call. */
+static void grey_parallel_stop(void)
+{
+    pthread_mutex_lock(&grey_pool.lock);
+    grey_pool.stop = true;
+    pthread_cond_broadcast(&grey_pool.wake);
+    pthread_mutex_unlock(&grey_pool.lock);
+    for (size_t i = 0; i < grey_pool.started; i++)
+    {
+        pthread_join(grey_pool.threads[i], NULL);
+    }
+    grey_pool.started = 0;
+    grey_pool.stop = false;
+}
+
+/**
+ * Falls back to the calling thread alone for arrays below the cutoff,
+ * and when another thread is already using the pool.
+ */
+void grey_parallel_run(const grey_parallel_fn_t fn,
+                       const void* const in, void* const out,
+                       const size_t amount, const size_t size)
+{
+    grey_parallel_job_t* const job = &grey_pool.job;
+    if (amount == 0)
+    {
+        return;
+    }
+    if (pthread_mutex_trylock(&grey_pool.call) != 0)
+    {
+        grey_parallel_convert(fn, in, out, amount, size);
+        return;
+    }
+    job->fn = fn;
+    job->in = in;
+    job->out = out;
+    job->amount = amount;
+    job->size = size;
+    if (amount * size < grey_parallel_config.cutoff
+        || grey_parallel_threads() == 1U)
+    {
+        grey_parallel_convert(fn, in, out, amount, size);
+        pthread_mutex_unlock(&grey_pool.call);
+        return;
+    }
+    job->chunk = grey_parallel_config.chunk / size;
+    job->chunk = (job->chunk == 0) ? 1U : job->chunk;
+    grey_parallel_start();
+    const size_t chunks = (amount + job->chunk - 1U) / job->chunk;
+    job->workers = grey_pool.started + 1U;
+    for (size_t i = 0; i < job->workers; i++)
+    {
+        /* Proportional to the size in bytes, so the ranges of each thread
+         * cover the same memory for buffers of the same size. */
+        job->ranges[i].next = i * chunks / job->workers;
+        job->ranges[i].end = (i + 1U) * chunks / job->workers;
+        job->nodes[i] = (i == 0) ? -1 : grey_pool.workers[i - 1U].node;
+    }
+#if defined(GREY_PARALLEL_AFFINITY)
+    job->nodes[0] = grey_parallel_current_node();
+#endif
+    pthread_mutex_lock(&grey_pool.lock);
+    grey_pool.generation++;
+    grey_pool.pending = grey_pool.started;
+    pthread_cond_broadcast(&grey_pool.wake);
+    pthread_mutex_unlock(&grey_pool.lock);
+
+    grey_parallel_work(job, 0);
+
+    pthread_mutex_lock(&grey_pool.lock);
+    while (grey_pool.pending > 0)
+    {
+        pthread_cond_wait(&grey_pool.done, &grey_pool.lock);
+    }
+    pthread_mutex_unlock(&grey_pool.lock);
+    pthread_mutex_unlock(&grey_pool.call);
+}
+
+grey_err_t grey_parallel_config_set(const grey_parallel_config_t* const config)
+{
+    if (config->chunk == 0 || config->threads > GREY_PARALLEL_MAX_THREADS)
+    {
+        return GREY_ERR_INVALID;
+    }
+    pthread_mutex_lock(&grey_pool.call);
+    grey_parallel_config = *config;
+    if (grey_pool.started + 1U > grey_parallel_threads())
+    {
+        grey_parallel_stop();
+    }
+    pthread_mutex_unlock(&grey_pool.call);
+    return GREY_OK;
+}
+
+void grey_parallel_config_get(grey_parallel_config_t* const config)
+{
+    pthread_mutex_lock(&grey_pool.call);
+    *config = grey_parallel_config;
+    pthread_mutex_unlock(&grey_pool.call);
+}
+
+void grey_parallel_shutdown(void)
+{
+    pthread_mutex_lock(&grey_pool.call);
+    grey_parallel_stop();
+    pthread_mutex_unlock(&grey_pool.call);
+}
+
+#else
+
+void grey_parallel_run(const grey_parallel_fn_t fn,
+                       const void* const in, void* const out,
+                       const size_t amount, const size_t size)
+{
+    grey_parallel_convert(fn, in, out, amount, size);
+}
+
+grey_err_t grey_parallel_config_set(const grey_parallel_config_t* const config)
+{
+    if (config->chunk == 0 || config->threads > GREY_PARALLEL_MAX_THREADS)
+    {
+        return GREY_ERR_INVALID;
+    }
+    if (config->threads > 1U)
+    {
+        return GREY_ERR_UNSUPPORTED;
+    }
+    grey_parallel_config = *config;
+    return GREY_OK;
+}
+
+void grey_parallel_config_get(grey_parallel_config_t* const config)
+{
+    *config = grey_parallel_config;
+}
+
+void grey_parallel_shutdown(void)
+{
+}
+
+#endif
+
+void grey_parallel_first_touch(void* const buffer, const size_t bytes)
+{
+    grey_parallel_run(NULL, NULL, buffer, bytes, 1U);
+}
+
+/**
+ * Defines the parallel conversions of \p bits -wide integers on top of
+ * the bulk kernels in use, which accept the same buffer as input and
+ * output. The runtime counters see each call once, not its chunks.
+ */
+#define GREY_PARALLEL_DEFINE(bits, type) \
+    static void grey_parallel_to##bits(const void* const in, \
+                                       void* const out, \
+                                       const size_t amount) \
+    { \
+        grey_kernels.to##bits(in, out, amount); \
+    } \
+    static void grey_parallel_from##bits(const void* const in, \
+                                         void* const out, \
+                                         const size_t amount) \
+    { \
+        grey_kernels.from##bits(in, out, amount); \
+    } \
+    void grey_to_array_parallel##bits(const type* const values, \
+                                      type* const codes, \
+                                      const size_t amount) \
+    { \
+        GREY_STATS_CONVERT_AS(GREY_STATS_PARALLEL_TO, to, bits, amount, \
+                              grey_parallel_run(grey_parallel_to##bits, \
+                                                values, codes, amount, \
+                                                sizeof(type))); \
+    } \
+    void grey_from_array_parallel##bits(const type* const codes, \
+                                        type* const values, \
+                                        const size_t amount) \
+    { \
+        GREY_STATS_CONVERT_AS(GREY_STATS_PARALLEL_FROM, from, bits, amount, \
+                              grey_parallel_run(grey_parallel_from##bits, \
+                                                codes, values, amount, \
+                                                sizeof(type))); \
+    }
+
+GREY_PARALLEL_DEFINE(8, uint8_t)
+GREY_PARALLEL_DEFINE(16, uint16_t)
+GREY_PARALLEL_DEFINE(32, uint32_t)
+GREY_PARALLEL_DEFINE(64, uint64_t)
+
+void grey_to_array_parallel(const grey_int_t* const values,
+                            grey_code_t* const codes, const size_t amount)
+{
+    GREY_WIDTH_NAME(grey_to_array_parallel, GREY_UINTBITS)(values, codes,
+                                                           amount);
+}
+
+void grey_from_array_parallel(const grey_code_t* const codes,
+                              grey_int_t* const values, const size_t amount)
+{
+    GREY_WIDTH_NAME(grey_from_array_parallel, GREY_UINTBITS)(codes, values,
+                                                             amount);
+}
@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @brief Internal declarations of the thread pool of the parallel
+ * conversions, shared with the other bulk conversions built on it.
+ *
+ * Not part of the public API.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef GREY_PARALLEL_H
+#define GREY_PARALLEL_H
+
+#include "grey.h"
+#include <stddef.h>
+
+/**
+ * Converts \p amount elements from \p in to \p out, which may be the
+ * same buffer.
+ */
+typedef void (* grey_parallel_fn_t)(const void* in, void* out,
+                                    size_t amount);
+
+/**
+ * Converts \p amount elements of \p size bytes with \p fn, NULL to zero
+ * them, split into chunks across the pool as configured with
+ * grey_parallel_config_set().
+ */
+void grey_parallel_run(grey_parallel_fn_t fn, const void* in, void* out,
+                       size_t amount, size_t size);
+
+#endif  /* GREY_PARALLEL_H */
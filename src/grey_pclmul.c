@@ -0,0 +1,66 @@
+/**
+ * @file
+ * @brief Carry-less multiplication (PCLMULQDQ) Grey decoding kernel.
+ *
+ * Decoding a Grey code is a prefix-XOR from the most significant bit
+ * down: bit `i` of the binary value is the XOR of the code bits `i..63`.
+ * The carry-less product of the code by 64 ones has exactly these XORs in
+ * its bits `63..126`, so a single multiplication followed by a 63-bit
+ * right shift of the 128-bit product replaces the whole shift-XOR cascade.
+ * See grey_inline_from() for the scalar version.
+ *
+ * Only the 64-bit width benefits from it: narrower widths have shorter
+ * cascades and keep the SSE2 kernels.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+
+#if defined(GREY_KERNELS_PCLMUL)
+
+#include <wmmintrin.h>
+
+/** Decodes the two 64-bit lanes of \p v at once. */
+static inline __m128i pclmul_from64(const __m128i v)
+{
+    const __m128i ones = _mm_set1_epi64x(-1);
+    /* 128-bit products of each lane, as [low half, high half] */
+    const __m128i product0 = _mm_clmulepi64_si128(v, ones, 0x00);
+    const __m128i product1 = _mm_clmulepi64_si128(v, ones, 0x01);
+    const __m128i high = _mm_unpackhi_epi64(product0, product1);
+    const __m128i low = _mm_unpacklo_epi64(product0, product1);
+    /* (product >> 63) truncated to 64 bits, for each product */
+    return _mm_or_si128(_mm_slli_epi64(high, 1), _mm_srli_epi64(low, 63));
+}
+
+/** Same as in the SSE2 kernels, see GREY_WORDS_FROM_KERNELS_DEFINE(). */
+static inline unsigned int pclmul_words_parities(const __m128i v)
+{
+    return (unsigned int) _mm_movemask_pd(
+            _mm_castsi128_pd(_mm_slli_epi64(v, 63)));
+}
+
+static inline __m128i pclmul_words_flip(const __m128i v,
+                                        const unsigned int mask)
+{
+    return _mm_xor_si128(v, _mm_set_epi64x(-(long long) ((mask >> 1U) & 1U),
+                                           -(long long) (mask & 1U)));
+}
+
+GREY_KERNEL_DEFINE(grey_pclmul_from64, uint64_t, __m128i, 2,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   pclmul_from64, grey_inline_from64)
+GREY_WORDS_FROM_KERNELS_DEFINE(pclmul, __m128i, 2,
+                               _mm_loadu_si128, _mm_storeu_si128,
+                               pclmul_from64, pclmul_words_parities,
+                               pclmul_words_flip)
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int grey_pclmul_unavailable_t;
+
+#endif
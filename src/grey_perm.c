@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief Plain changes Grey code of the permutations: ranking, unranking
+ * and iterator positioning.
+ *
+ * In the order of Steinhaus, Johnson and Trotter, the number of smaller
+ * elements after the element v is a digit of radix v + 1 of a reflected
+ * mixed-radix Grey code, which increases by one each time v swaps towards
+ * the start and decreases each time it swaps towards the end. The element
+ * 0 has no digit, as it never moves by itself.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+
+/** Radices of the digits of \p length elements, the largest one first. */
+static size_t grey_perm_radices(const size_t length, uint32_t* const radices)
+{
+    const size_t digits = (length == 0U) ? 0U : length - 1U;
+    for (size_t i = 0; i < digits; i++)
+    {
+        radices[i] = (uint32_t) (length - i);
+    }
+    return digits;
+}
+
+/**
+ * Writes the permutation whose elements have \p codes smaller elements
+ * after them, inserting them from the smallest: the element v goes before
+ * the \p codes of the smaller ones already placed.
+ */
+static void grey_perm_place(const uint32_t* const codes, const size_t length,
+                            uint8_t* const elements)
+{
+    for (size_t v = 0; v < length; v++)
+    {
+        const size_t after = (v == 0U) ? 0U : codes[length - 1U - v];
+        const size_t position = v - after;
+        for (size_t i = v; i > position; i--)
+        {
+            elements[i] = elements[i - 1U];
+        }
+        elements[position] = (uint8_t) v;
+    }
+}
+
+grey_err_t grey_perm_iter_init(grey_perm_iter_t* const iter,
+                               const size_t length)
+{
+    if (length > GREY_PERM_MAX_LENGTH)
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint32_t radices[GREY_PERM_MAX_LENGTH] = {0};
+    const size_t digits = grey_perm_radices(length, radices);
+    const grey_err_t err = grey_radix_iter_init(&iter->moves, radices, digits);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        iter->elements[i] = (uint8_t) i;
+        iter->positions[i] = (uint8_t) i;
+    }
+    iter->length = (uint8_t) length;
+    iter->swapped = (uint8_t) length;
+    return GREY_OK;
+}
+
+grey_err_t grey_perm_iter_seek(grey_perm_iter_t* const iter,
+                               const uint64_t rank)
+{
+    const grey_err_t err = grey_radix_iter_seek(&iter->moves, rank);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    grey_perm_place(iter->moves.digits, iter->length, iter->elements);
+    for (uint8_t i = 0; i < iter->length; i++)
+    {
+        iter->positions[iter->elements[i]] = i;
+    }
+    iter->swapped = iter->length;
+    return GREY_OK;
+}
+
+grey_err_t grey_perm_rank(const uint8_t* const elements, const size_t length,
+                          uint64_t* const rank)
+{
+    if (length > GREY_PERM_MAX_LENGTH)
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        if (elements[i] >= length || ((seen >> elements[i]) & 1U) != 0U)
+        {
+            return GREY_ERR_INVALID;
+        }
+        seen |= UINT64_C(1) << elements[i];
+    }
+    uint32_t radices[GREY_PERM_MAX_LENGTH] = {0};
+    uint32_t codes[GREY_PERM_MAX_LENGTH] = {0};
+    const size_t digits = grey_perm_radices(length, radices);
+    for (size_t i = 0; i < length; i++)
+    {
+        const uint8_t element = elements[i];
+        if (element == 0U)
+        {
+            continue;
+        }
+        uint32_t after = 0;
+        for (size_t j = i + 1U; j < length; j++)
+        {
+            after += (elements[j] < element) ? 1U : 0U;
+        }
+        codes[length - 1U - element] = after;
+    }
+    return grey_radix_from_u64(radices, codes, digits, rank);
+}
+
+grey_err_t grey_perm_unrank(const uint64_t rank, const size_t length,
+                            uint8_t* const elements)
+{
+    if (length > GREY_PERM_MAX_LENGTH)
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint32_t radices[GREY_PERM_MAX_LENGTH] = {0};
+    uint32_t codes[GREY_PERM_MAX_LENGTH] = {0};
+    const size_t digits = grey_perm_radices(length, radices);
+    const grey_err_t err = grey_radix_to_u64(rank, radices, digits, codes);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    grey_perm_place(codes, length, elements);
+    return GREY_OK;
+}
@@ -0,0 +1,402 @@
+/**
+ * @file
+ * @brief Reflected mixed-radix and k-ary Grey codes.
+ *
+ * A digit of the code is the digit of the number, reflected when the
+ * number made by the digits above it is odd. Its parity is carried from
+ * the most significant digit down: the higher number times the radix
+ * plus the digit, so with an odd radix the parity of the higher number
+ * adds to the one of the digit.
+ *
+ * With a radix 2^s, reflecting a digit is XORing it with 2^s - 1, and
+ * the parity of the number above a digit is the lowest bit of the next
+ * digit alone, so all the digits of an integer convert at once with
+ * shifts and XORs, like the binary code does.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+
+/**
+ * Steps of the prefix XOR over the digits: radix 4, the smallest power of
+ * 2 converted this way as radix 2 goes to grey_to_array64(), uses 5, plus
+ * a spare one.
+ */
+#define GREY_KARY_STEPS 6U
+
+/** Constants of the conversions in a radix 2^s. */
+typedef struct
+{
+    /** The lowest bit of each digit. */
+    uint64_t lows;
+    /** Shift of the prefix XOR of each step, 0 for unused steps. */
+    unsigned int shifts[GREY_KARY_STEPS];
+    /** Bits kept by each step, 0 for the unused ones. */
+    uint64_t keeps[GREY_KARY_STEPS];
+    /** Bits per digit, s. */
+    unsigned int bits;
+} grey_kary_pow2_t;
+
+static bool grey_radix_valid(const uint32_t* const radices,
+                             const uint32_t* const digits,
+                             const size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        if (radices[i] < 2U || (digits != NULL && digits[i] >= radices[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+grey_err_t grey_radix_to(const uint32_t* const radices,
+                         const uint32_t* const digits, uint32_t* const codes,
+                         const size_t length)
+{
+    if (!grey_radix_valid(radices, digits, length))
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint32_t odd = 0;  /* Parity of the number above the digit */
+    for (size_t i = length; i-- > 0U;)
+    {
+        const uint32_t digit = digits[i];
+        codes[i] = odd ? radices[i] - 1U - digit : digit;
+        odd = (digit & 1U) ^ (odd & radices[i] & 1U);
+    }
+    return GREY_OK;
+}
+
+grey_err_t grey_radix_from(const uint32_t* const radices,
+                           const uint32_t* const codes, uint32_t* const digits,
+                           const size_t length)
+{
+    if (!grey_radix_valid(radices, codes, length))
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint32_t odd = 0;
+    for (size_t i = length; i-- > 0U;)
+    {
+        const uint32_t digit = odd ? radices[i] - 1U - codes[i] : codes[i];
+        digits[i] = digit;
+        odd = (digit & 1U) ^ (odd & radices[i] & 1U);
+    }
+    return GREY_OK;
+}
+
+grey_err_t grey_radix_to_u64(uint64_t value, const uint32_t* const radices,
+                             const size_t length, uint32_t* const codes)
+{
+    if (!grey_radix_valid(radices, NULL, length))
+    {
+        return GREY_ERR_INVALID;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        codes[i] = (uint32_t) (value % radices[i]);
+        value /= radices[i];
+    }
+    if (value != 0U)
+    {
+        return GREY_ERR_RANGE;
+    }
+    return grey_radix_to(radices, codes, codes, length);
+}
+
+grey_err_t grey_radix_from_u64(const uint32_t* const radices,
+                               const uint32_t* const codes,
+                               const size_t length, uint64_t* const value)
+{
+    if (!grey_radix_valid(radices, codes, length))
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint64_t number = 0;  /* Made by the digits so far, its parity exact */
+    bool overflow = false;
+    for (size_t i = length; i-- > 0U;)
+    {
+        const uint32_t digit = (number & 1U) ? radices[i] - 1U - codes[i]
+                                             : codes[i];
+        overflow = overflow || number > (UINT64_MAX - digit) / radices[i];
+        number = number * radices[i] + digit;
+    }
+    if (overflow)
+    {
+        return GREY_ERR_RANGE;
+    }
+    *value = number;
+    return GREY_OK;
+}
+
+static inline bool grey_kary_is_pow2(const uint32_t radix)
+{
+    return (radix & (radix - 1U)) == 0U;
+}
+
+static void grey_kary_pow2(const uint32_t radix,
+                           grey_kary_pow2_t* const pow2)
+{
+    pow2->bits = grey_inline_ctz64(radix);
+    pow2->lows = 1U;
+    for (unsigned int shift = pow2->bits; shift < 64U; shift *= 2U)
+    {
+        pow2->lows |= pow2->lows << shift;
+    }
+    unsigned int shift = pow2->bits;
+    for (unsigned int step = 0; step < GREY_KARY_STEPS; step++)
+    {
+        pow2->shifts[step] = (shift < 64U) ? shift : 0U;
+        pow2->keeps[step] = (shift < 64U) ? UINT64_MAX : 0U;
+        shift *= 2U;
+    }
+}
+
+/** The digits with their lowest bit in \p lows, all bits set. */
+static inline uint64_t grey_kary_fill(const uint64_t lows,
+                                      const unsigned int bits)
+{
+    return (lows << bits) - lows;
+}
+
+static inline uint64_t grey_kary_pow2_to(const uint64_t value,
+                                         const grey_kary_pow2_t* const pow2)
+{
+    return value ^ grey_kary_fill((value >> pow2->bits) & pow2->lows,
+                                  pow2->bits);
+}
+
+static inline uint64_t grey_kary_pow2_from(const uint64_t code,
+                                           const grey_kary_pow2_t* const pow2)
+{
+    /* Parity of the number from each digit up: XOR of their lowest bits */
+    uint64_t odd = code & pow2->lows;
+    for (unsigned int step = 0; step < GREY_KARY_STEPS; step++)
+    {
+        odd ^= (odd >> pow2->shifts[step]) & pow2->keeps[step];
+    }
+    return code ^ grey_kary_fill((odd >> pow2->bits) & pow2->lows,
+                                 pow2->bits);
+}
+
+/**
+ * Values and codes below which a radix that is not a power of 2 keeps
+ * the codes in 64 bits: the largest multiple of the largest power of
+ * \p radix that fits, as its top digit is the same in the code.
+ */
+static uint64_t grey_kary_limit(const uint32_t radix)
+{
+    uint64_t power = radix;
+    while (power <= UINT64_MAX / radix)
+    {
+        power *= radix;
+    }
+    return UINT64_MAX / power * power;
+}
+
+static inline uint64_t grey_kary_digits_to(uint64_t value,
+                                           const uint32_t radix)
+{
+    uint64_t code = 0;
+    uint64_t power = 1;
+    while (value != 0U)
+    {
+        const uint64_t higher = value / radix;
+        const uint64_t digit = value - higher * radix;
+        code += ((higher & 1U) ? radix - 1U - digit : digit) * power;
+        power *= radix;  /* Wraps around only after the last digit */
+        value = higher;
+    }
+    return code;
+}
+
+static inline uint64_t grey_kary_digits_from(uint64_t code,
+                                             const uint32_t radix)
+{
+    uint32_t digits[64];
+    size_t length = 0;
+    while (code != 0U)
+    {
+        digits[length++] = (uint32_t) (code % radix);
+        code /= radix;
+    }
+    uint64_t value = 0;
+    while (length-- > 0U)
+    {
+        const uint32_t digit = digits[length];
+        value = value * radix
+                + ((value & 1U) ? radix - 1U - digit : digit);
+    }
+    return value;
+}
+
+grey_err_t grey_kary_to(const uint64_t value, const uint32_t radix,
+                        uint64_t* const code)
+{
+    return grey_kary_to_array(&value, code, 1U, radix);
+}
+
+grey_err_t grey_kary_from(const uint64_t code, const uint32_t radix,
+                          uint64_t* const value)
+{
+    return grey_kary_from_array(&code, value, 1U, radix);
+}
+
+grey_err_t grey_kary_to_array(const uint64_t* const values,
+                              uint64_t* const codes, const size_t amount,
+                              const uint32_t radix)
+{
+    if (radix < 2U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    if (radix == 2U)
+    {
+        if (amount == 1U)
+        {
+            codes[0] = grey_inline_to64(values[0]);
+        }
+        else
+        {
+            grey_to_array64(values, codes, amount);
+        }
+        return GREY_OK;
+    }
+    if (grey_kary_is_pow2(radix))
+    {
+        grey_kary_pow2_t pow2;
+        grey_kary_pow2(radix, &pow2);
+        for (size_t i = 0; i < amount; i++)
+        {
+            codes[i] = grey_kary_pow2_to(values[i], &pow2);
+        }
+        return GREY_OK;
+    }
+    const uint64_t limit = grey_kary_limit(radix);
+    for (size_t i = 0; i < amount; i++)
+    {
+        if (values[i] >= limit)
+        {
+            return GREY_ERR_RANGE;
+        }
+        codes[i] = grey_kary_digits_to(values[i], radix);
+    }
+    return GREY_OK;
+}
+
+grey_err_t grey_kary_from_array(const uint64_t* const codes,
+                                uint64_t* const values, const size_t amount,
+                                const uint32_t radix)
+{
+    if (radix < 2U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    if (radix == 2U)
+    {
+        if (amount == 1U)
+        {
+            values[0] = grey_inline_from64(codes[0]);
+        }
+        else
+        {
+            grey_from_array64(codes, values, amount);
+        }
+        return GREY_OK;
+    }
+    if (grey_kary_is_pow2(radix))
+    {
+        grey_kary_pow2_t pow2;
+        grey_kary_pow2(radix, &pow2);
+        for (size_t i = 0; i < amount; i++)
+        {
+            values[i] = grey_kary_pow2_from(codes[i], &pow2);
+        }
+        return GREY_OK;
+    }
+    const uint64_t limit = grey_kary_limit(radix);
+    for (size_t i = 0; i < amount; i++)
+    {
+        if (codes[i] >= limit)
+        {
+            return GREY_ERR_RANGE;
+        }
+        values[i] = grey_kary_digits_from(codes[i], radix);
+    }
+    return GREY_OK;
+}
+
+grey_err_t grey_radix_iter_init(grey_radix_iter_t* const iter,
+                                const uint32_t* const radices,
+                                const size_t length)
+{
+    if (length > GREY_RADIX_MAX_DIGITS
+        || !grey_radix_valid(radices, NULL, length))
+    {
+        return GREY_ERR_INVALID;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        iter->digits[i] = 0;
+        iter->radices[i] = radices[i];
+        iter->down[i] = false;
+        iter->focus[i] = (uint8_t) i;
+    }
+    iter->focus[length] = (uint8_t) length;
+    iter->length = (uint8_t) length;
+    iter->changed = (uint8_t) length;
+    iter->decreased = false;
+    return GREY_OK;
+}
+
+grey_err_t grey_radix_iter_seek(grey_radix_iter_t* const iter,
+                                const uint64_t value)
+{
+    uint32_t codes[GREY_RADIX_MAX_DIGITS];
+    const uint8_t length = iter->length;
+    const grey_err_t err = grey_radix_to_u64(value, iter->radices, length,
+                                             codes);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    /* A digit sweeps down when the number above it is odd. At the end of
+     * its sweep it waits, already turned around, and the focus pointer of
+     * the lowest digit of each run of waiting ones skips them all. */
+    uint32_t odd = 0;
+    bool waiting_above = false;
+    uint8_t active = length;  /* Lowest digit above not waiting */
+    iter->focus[length] = length;
+    for (uint8_t i = length; i-- > 0U;)
+    {
+        const uint32_t radix = iter->radices[i];
+        const uint32_t code = codes[i];
+        const bool waiting = odd ? code == 0U : code == radix - 1U;
+        iter->digits[i] = code;
+        iter->down[i] = (waiting != (odd != 0U));
+        iter->focus[i] = i;
+        if (waiting_above && !waiting)
+        {
+            iter->focus[i + 1U] = active;
+        }
+        if (!waiting)
+        {
+            active = i;
+        }
+        waiting_above = waiting;
+        const uint32_t digit = odd ? radix - 1U - code : code;
+        odd = (digit & 1U) ^ (odd & radix & 1U);
+    }
+    if (waiting_above)
+    {
+        iter->focus[0] = active;
+    }
+    iter->changed = length;
+    iter->decreased = false;
+    return GREY_OK;
+}
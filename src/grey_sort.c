@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @brief Radix sort of Grey codes by their binary values.
+ *
+ * Sorting Grey codes directly would need grey_cmp() or a decode in every
+ * comparison. Instead the whole array is decoded once into a scratch
+ * buffer, sorted there as plain integers, and encoded back. The codes
+ * array itself is the second buffer of the radix sort, so only one array
+ * of keys is allocated, plus the indices when a payload is permuted too.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Bits of each radix sort digit. */
+#define GREY_SORT_DIGIT_BITS 8U
+#define GREY_SORT_BUCKETS (1U << GREY_SORT_DIGIT_BITS)
+/** Digit of \p key starting at bit \p shift. */
+#define GREY_SORT_DIGIT(key, shift) \
+    ((size_t) ((key) >> (shift)) & (GREY_SORT_BUCKETS - 1U))
+
+/**
+ * Reorders \p payload as `payload[i] = old payload[order[i]]`, through
+ * the \p scratch buffer of the same size.
+ */
+static void grey_sort_permute(void* const payload, const size_t payload_size,
+                              const size_t* const order, const size_t amount,
+                              unsigned char* const scratch)
+{
+    const unsigned char* const original = payload;
+    for (size_t i = 0; i < amount; i++)
+    {
+        memcpy(&scratch[i * payload_size],
+               &original[order[i] * payload_size], payload_size);
+    }
+    memcpy(payload, scratch, amount * payload_size);
+}
+
+/**
+ * Defines the radix sort of \p bits -wide Grey codes.
+ *
+ * All digit histograms are collected in one pass over the decoded keys.
+ * A digit whose histogram has a single non-empty bucket, such as the high
+ * digits of small values, leaves the order unchanged and is skipped.
+ *
+ * Every buffer is allocated before anything is written, so a failed
+ * allocation leaves the arrays untouched.
+ */
+#define GREY_SORT_DEFINE(bits, type) \
+    grey_err_t grey_sort##bits(type* const codes, const size_t amount, \
+                               void* const payload, \
+                               const size_t payload_size) \
+    { \
+        if (amount < 2U) \
+        { \
+            return GREY_OK; \
+        } \
+        const bool permute = (payload != NULL) && (payload_size > 0U); \
+        type* const keys = malloc(amount * sizeof(type)); \
+        size_t* const indices = permute \
+                                ? malloc(2U * amount * sizeof(size_t)) \
+                                : NULL; \
+        unsigned char* const scratch = permute \
+                                       ? malloc(amount * payload_size) \
+                                       : NULL; \
+        if (keys == NULL \
+            || (permute && (indices == NULL || scratch == NULL))) \
+        { \
+            free(keys); \
+            free(indices); \
+            free(scratch); \
+            return GREY_ERR_NOMEM; \
+        } \
+        grey_from_array##bits(codes, keys, amount); \
+        size_t counts[(bits) / GREY_SORT_DIGIT_BITS][GREY_SORT_BUCKETS]; \
+        memset(counts, 0, sizeof(counts)); \
+        for (size_t i = 0; i < amount; i++) \
+        { \
+            for (unsigned int d = 0; d < (bits) / GREY_SORT_DIGIT_BITS; d++) \
+            { \
+                counts[d][GREY_SORT_DIGIT(keys[i], \
+                                          d * GREY_SORT_DIGIT_BITS)]++; \
+            } \
+        } \
+        /* Ping-pong between the keys and the codes array */ \
+        type* source = keys; \
+        type* destination = codes; \
+        size_t* source_indices = indices; \
+        size_t* destination_indices = permute ? &indices[amount] : NULL; \
+        for (size_t i = 0; permute && i < amount; i++) \
+        { \
+            source_indices[i] = i; \
+        } \
+        for (unsigned int d = 0; d < (bits) / GREY_SORT_DIGIT_BITS; d++) \
+        { \
+            const unsigned int shift = d * GREY_SORT_DIGIT_BITS; \
+            size_t* const count = counts[d]; \
+            if (count[GREY_SORT_DIGIT(source[0], shift)] == amount) \
+            { \
+                continue; \
+            } \
+            size_t offset = 0; \
+            for (unsigned int bucket = 0; bucket < GREY_SORT_BUCKETS; \
+                 bucket++) \
+            { \
+                const size_t bucket_size = count[bucket]; \
+                count[bucket] = offset; \
+                offset += bucket_size; \
+            } \
+            for (size_t i = 0; i < amount; i++) \
+            { \
+                const size_t position = \
+                        count[GREY_SORT_DIGIT(source[i], shift)]++; \
+                destination[position] = source[i]; \
+                if (permute) \
+                { \
+                    destination_indices[position] = source_indices[i]; \
+                } \
+            } \
+            type* const swap = source; \
+            source = destination; \
+            destination = swap; \
+            size_t* const swap_indices = source_indices; \
+            source_indices = destination_indices; \
+            destination_indices = swap_indices; \
+        } \
+        if (source == codes) \
+        { \
+            grey_to_array_inplace##bits(codes, amount); \
+        } \
+        else \
+        { \
+            grey_to_array##bits(keys, codes, amount); \
+        } \
+        if (permute) \
+        { \
+            grey_sort_permute(payload, payload_size, source_indices, amount, \
+                              scratch); \
+        } \
+        free(keys); \
+        free(indices); \
+        free(scratch); \
+        return GREY_OK; \
+    }
+
+GREY_SORT_DEFINE(8, uint8_t)
+GREY_SORT_DEFINE(16, uint16_t)
+GREY_SORT_DEFINE(32, uint32_t)
+GREY_SORT_DEFINE(64, uint64_t)
+
+grey_err_t grey_sort(grey_code_t* const codes, const size_t amount,
+                     void* const payload, const size_t payload_size)
+{
+    return GREY_WIDTH_NAME(grey_sort, GREY_UINTBITS)(codes, amount,
+                                                     payload, payload_size);
+}
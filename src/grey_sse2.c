@@ -0,0 +1,246 @@
+/**
+ * @file
+ * @brief SSE2 bulk conversion kernels, 128 bits per iteration.
+ *
+ * SSE2 has no 8-bit shifts, so the 8-bit kernels shift 16-bit lanes and
+ * mask away the bits that leaked in from the neighbouring byte.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+#include "grey_hilbert_kernels.h"
+
+#if defined(GREY_KERNELS_SSE2)
+
+#include <emmintrin.h>
+#include <string.h>
+
+#define GREY_SSE2_SHR8(v, n) \
+    _mm_and_si128(_mm_srli_epi16((v), (n)), \
+                  _mm_set1_epi8((char) (0xFFU >> (n))))
+
+static inline __m128i sse2_to8(const __m128i v)
+{
+    return _mm_xor_si128(v, GREY_SSE2_SHR8(v, 1));
+}
+
+static inline __m128i sse2_from8(__m128i v)
+{
+    v = _mm_xor_si128(v, GREY_SSE2_SHR8(v, 4));
+    v = _mm_xor_si128(v, GREY_SSE2_SHR8(v, 2));
+    v = _mm_xor_si128(v, GREY_SSE2_SHR8(v, 1));
+    return v;
+}
+
+static inline __m128i sse2_to16(const __m128i v)
+{
+    return _mm_xor_si128(v, _mm_srli_epi16(v, 1));
+}
+
+static inline __m128i sse2_from16(__m128i v)
+{
+    v = _mm_xor_si128(v, _mm_srli_epi16(v, 8));
+    v = _mm_xor_si128(v, _mm_srli_epi16(v, 4));
+    v = _mm_xor_si128(v, _mm_srli_epi16(v, 2));
+    v = _mm_xor_si128(v, _mm_srli_epi16(v, 1));
+    return v;
+}
+
+static inline __m128i sse2_to32(const __m128i v)
+{
+    return _mm_xor_si128(v, _mm_srli_epi32(v, 1));
+}
+
+static inline __m128i sse2_from32(__m128i v)
+{
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 16));
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 8));
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 4));
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 2));
+    v = _mm_xor_si128(v, _mm_srli_epi32(v, 1));
+    return v;
+}
+
+static inline __m128i sse2_to64(const __m128i v)
+{
+    return _mm_xor_si128(v, _mm_srli_epi64(v, 1));
+}
+
+static inline __m128i sse2_from64(__m128i v)
+{
+    v = _mm_xor_si128(v, _mm_srli_epi64(v, 32));
+    v = _mm_xor_si128(v, _mm_srli_epi64(v, 16));
+    v = _mm_xor_si128(v, _mm_srli_epi64(v, 8));
+    v = _mm_xor_si128(v, _mm_srli_epi64(v, 4));
+    v = _mm_xor_si128(v, _mm_srli_epi64(v, 2));
+    v = _mm_xor_si128(v, _mm_srli_epi64(v, 1));
+    return v;
+}
+
+/** Encodes two words of a multiword value, see grey_inline_word_to(). */
+static inline __m128i sse2_words_to(const __m128i v, const __m128i above)
+{
+    return _mm_xor_si128(_mm_xor_si128(v, _mm_srli_epi64(v, 1)),
+                         _mm_slli_epi64(above, 63));
+}
+
+/** Lowest bit of each of the two words, as a 2-bit integer. */
+static inline unsigned int sse2_words_parities(const __m128i v)
+{
+    return (unsigned int) _mm_movemask_pd(
+            _mm_castsi128_pd(_mm_slli_epi64(v, 63)));
+}
+
+/** Inverts the words whose bit is set in \p mask. */
+static inline __m128i sse2_words_flip(const __m128i v, const unsigned int mask)
+{
+    return _mm_xor_si128(v, _mm_set_epi64x(-(long long) ((mask >> 1U) & 1U),
+                                           -(long long) (mask & 1U)));
+}
+
+GREY_KERNEL_DEFINE(grey_sse2_to8, uint8_t, __m128i, 16,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_to8, grey_inline_to8)
+GREY_KERNEL_DEFINE(grey_sse2_from8, uint8_t, __m128i, 16,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_from8, grey_inline_from8)
+GREY_KERNEL_DEFINE(grey_sse2_to16, uint16_t, __m128i, 8,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_to16, grey_inline_to16)
+GREY_KERNEL_DEFINE(grey_sse2_from16, uint16_t, __m128i, 8,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_from16, grey_inline_from16)
+GREY_KERNEL_DEFINE(grey_sse2_to32, uint32_t, __m128i, 4,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_to32, grey_inline_to32)
+GREY_KERNEL_DEFINE(grey_sse2_from32, uint32_t, __m128i, 4,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_from32, grey_inline_from32)
+GREY_KERNEL_DEFINE(grey_sse2_to64, uint64_t, __m128i, 2,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_to64, grey_inline_to64)
+GREY_KERNEL_DEFINE(grey_sse2_from64, uint64_t, __m128i, 2,
+                   _mm_loadu_si128, _mm_storeu_si128,
+                   sse2_from64, grey_inline_from64)
+GREY_WORDS_KERNELS_DEFINE(sse2, __m128i, 2,
+                          _mm_loadu_si128, _mm_storeu_si128,
+                          sse2_words_to, sse2_from64,
+                          sse2_words_parities, sse2_words_flip)
+
+GREY_FILL_KERNEL_DEFINE(grey_sse2_fill8, uint8_t, __m128i, 16,
+                        _mm_loadu_si128, _mm_storeu_si128,
+                        _mm_add_epi8, sse2_to8, grey_inline_to8)
+GREY_FILL_KERNEL_DEFINE(grey_sse2_fill16, uint16_t, __m128i, 8,
+                        _mm_loadu_si128, _mm_storeu_si128,
+                        _mm_add_epi16, sse2_to16, grey_inline_to16)
+GREY_FILL_KERNEL_DEFINE(grey_sse2_fill32, uint32_t, __m128i, 4,
+                        _mm_loadu_si128, _mm_storeu_si128,
+                        _mm_add_epi32, sse2_to32, grey_inline_to32)
+GREY_FILL_KERNEL_DEFINE(grey_sse2_fill64, uint64_t, __m128i, 2,
+                        _mm_loadu_si128, _mm_storeu_si128,
+                        _mm_add_epi64, sse2_to64, grey_inline_to64)
+
+/* Portable code, vectorized by the compiler for this instruction set. */
+GREY_HILBERT_KERNELS_DEFINE(sse2, points)
+
+/** Bit counts of the bytes of \p v, adding ever wider bit fields. */
+static inline __m128i sse2_count8(const __m128i v)
+{
+    const __m128i pairs = _mm_sub_epi8(
+            v, _mm_and_si128(_mm_srli_epi16(v, 1), _mm_set1_epi8(0x55)));
+    const __m128i nibbles = _mm_add_epi8(
+            _mm_and_si128(pairs, _mm_set1_epi8(0x33)),
+            _mm_and_si128(_mm_srli_epi16(pairs, 2), _mm_set1_epi8(0x33)));
+    return _mm_and_si128(_mm_add_epi8(nibbles, _mm_srli_epi16(nibbles, 4)),
+                         _mm_set1_epi8(0x0F));
+}
+
+static inline __m128i sse2_count16(const __m128i v)
+{
+    const __m128i bytes = sse2_count8(v);
+    return _mm_and_si128(_mm_add_epi8(bytes, _mm_srli_epi16(bytes, 8)),
+                         _mm_set1_epi16(0xFF));
+}
+
+static inline __m128i sse2_count32(const __m128i v)
+{
+    return _mm_madd_epi16(sse2_count16(v), _mm_set1_epi16(1));
+}
+
+static inline __m128i sse2_count64(const __m128i v)
+{
+    return _mm_sad_epu8(sse2_count8(v), _mm_setzero_si128());
+}
+
+static inline __m128i sse2_broadcast8(const uint8_t query)
+{
+    return _mm_set1_epi8((char) query);
+}
+
+static inline __m128i sse2_broadcast16(const uint16_t query)
+{
+    return _mm_set1_epi16((short) query);
+}
+
+static inline __m128i sse2_broadcast32(const uint32_t query)
+{
+    return _mm_set1_epi32((int) query);
+}
+
+static inline __m128i sse2_broadcast64(const uint64_t query)
+{
+    return _mm_set1_epi64x((long long) query);
+}
+
+static inline void sse2_store_distances8(uint8_t* const out,
+                                         const __m128i counts)
+{
+    _mm_storeu_si128((__m128i*) out, counts);
+}
+
+static inline void sse2_store_distances16(uint8_t* const out,
+                                          const __m128i counts)
+{
+    _mm_storel_epi64((__m128i*) out, _mm_packus_epi16(counts, counts));
+}
+
+static inline void sse2_store_distances32(uint8_t* const out,
+                                          const __m128i counts)
+{
+    const __m128i words = _mm_packs_epi32(counts, counts);
+    const int bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    memcpy(out, &bytes, 4U);
+}
+
+static inline void sse2_store_distances64(uint8_t* const out,
+                                          const __m128i counts)
+{
+    out[0] = (uint8_t) _mm_cvtsi128_si32(counts);
+    out[1] = (uint8_t) _mm_extract_epi16(counts, 4);
+}
+
+GREY_DISTANCES_KERNEL_DEFINE(grey_sse2_distances8, uint8_t, __m128i, 16,
+                             _mm_loadu_si128, sse2_broadcast8, _mm_xor_si128,
+                             sse2_count8, sse2_store_distances8)
+GREY_DISTANCES_KERNEL_DEFINE(grey_sse2_distances16, uint16_t, __m128i, 8,
+                             _mm_loadu_si128, sse2_broadcast16,
+                             _mm_xor_si128, sse2_count16,
+                             sse2_store_distances16)
+GREY_DISTANCES_KERNEL_DEFINE(grey_sse2_distances32, uint32_t, __m128i, 4,
+                             _mm_loadu_si128, sse2_broadcast32,
+                             _mm_xor_si128, sse2_count32,
+                             sse2_store_distances32)
+GREY_DISTANCES_KERNEL_DEFINE(grey_sse2_distances64, uint64_t, __m128i, 2,
+                             _mm_loadu_si128, sse2_broadcast64,
+                             _mm_xor_si128, sse2_count64,
+                             sse2_store_distances64)
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int grey_sse2_unavailable_t;
+
+#endif
@@ -0,0 +1,419 @@
+/**
+ * @file
+ * @brief Runtime counters of the bulk functions, in the `GREY_STATS`
+ * builds.
+ *
+ * Each thread counts its calls in its own block of counters, allocated
+ * at its first call and pushed onto a lock-free list of all the blocks,
+ * which are never freed so the calls of the ended threads keep counting.
+ * Only the owner thread writes a block, with relaxed atomic loads and
+ * stores which compile to plain ones, while grey_stats_snapshot() sums
+ * all the blocks with relaxed loads from any thread.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "grey_stats.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(GREY_STATS)
+
+#if !defined(GREY_HAS_ATOMIC)
+#error "GREY_STATS requires the atomic builtins of GCC or Clang"
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+
+/** Defined when the time stamp counter can be read. */
+#define GREY_STATS_TSC 1
+#endif
+
+/** Counters of one thread. */
+typedef struct grey_stats_block
+{
+    grey_stats_t stats;
+    /** Block of the thread which made its first call just before. */
+    struct grey_stats_block* next;
+} grey_stats_block_t;
+
+/** Last block allocated, the head of the list of all of them. */
+static grey_stats_block_t* grey_stats_blocks = NULL;
+
+/** Counters of this thread, NULL until its first call. */
+static __thread grey_stats_block_t* grey_stats_own = NULL;
+
+/** Calls of this thread since its last sampled one. */
+static __thread uint32_t grey_stats_countdown = 0;
+
+/** Calls per sampled call, 0 when not sampling. */
+static uint32_t grey_stats_period = 0;
+
+/** Totals at the last grey_stats_reset(). */
+static grey_stats_t grey_stats_baseline;
+
+uint64_t grey_stats_begin(void)
+{
+    const uint32_t period = __atomic_load_n(&grey_stats_period,
+                                            __ATOMIC_RELAXED);
+    if (period == 0U || ++grey_stats_countdown < period)
+    {
+        return 0;
+    }
+    grey_stats_countdown = 0;
+#if defined(GREY_STATS_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/** Allocates the block of this thread and adds it to the list. */
+static grey_stats_block_t* grey_stats_attach(void)
+{
+    grey_stats_block_t* const block = calloc(1U, sizeof(*block));
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    block->next = __atomic_load_n(&grey_stats_blocks, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&grey_stats_blocks, &block->next,
+                                        block, true, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+    {
+        /* block->next now holds the new head, try again. */
+    }
+    grey_stats_own = block;
+    return block;
+}
+
+/** Adds \p amount to a counter owned by this thread. */
+static inline void grey_stats_add(uint64_t* const counter,
+                                  const uint64_t amount)
+{
+    __atomic_store_n(counter,
+                     __atomic_load_n(counter, __ATOMIC_RELAXED) + amount,
+                     __ATOMIC_RELAXED);
+}
+
+/** Index of the histogram bucket of a call of \p elements elements. */
+static inline size_t grey_stats_bucket(const size_t elements)
+{
+    if (elements == 0U)
+    {
+        return 0;
+    }
+    return 64U - (size_t) __builtin_clzll((unsigned long long) elements);
+}
+
+void grey_stats_end(const grey_stats_api_t api, const grey_kernel_t kernel,
+                    const size_t elements, const size_t bytes,
+                    const uint64_t start)
+{
+#if defined(GREY_STATS_TSC)
+    const uint64_t cycles = (start != 0U) ? __rdtsc() - start : 0U;
+#else
+    const uint64_t cycles = 0;
+#endif
+    grey_stats_block_t* block = grey_stats_own;
+    if (block == NULL)
+    {
+        block = grey_stats_attach();
+        if (block == NULL)
+        {
+            return;  /* Out of memory: the call is not counted. */
+        }
+    }
+    grey_stats_t* const stats = &block->stats;
+    const size_t group = (size_t) api;
+    const size_t id = ((size_t) kernel < GREY_STATS_KERNELS)
+                      ? (size_t) kernel : 0U;
+    grey_stats_add(&stats->calls[group][id], 1U);
+    grey_stats_add(&stats->elements[group][id], elements);
+    grey_stats_add(&stats->bytes[group][id], bytes);
+    grey_stats_add(&stats->sizes[group][grey_stats_bucket(elements)], 1U);
+    if (start != 0U)
+    {
+        grey_stats_add(&stats->sampled_calls[group], 1U);
+        grey_stats_add(&stats->sampled_elements[group], elements);
+        grey_stats_add(&stats->cycles[group], cycles);
+    }
+}
+
+/** Adds the \p amount counters of \p block to the ones of \p total. */
+static void grey_stats_sum(uint64_t* const total,
+                           const uint64_t* const block,
+                           const size_t amount)
+{
+    for (size_t i = 0; i < amount; i++)
+    {
+        total[i] += __atomic_load_n(&block[i], __ATOMIC_RELAXED);
+    }
+}
+
+/** Sums the counters of all the blocks into \p total. */
+static void grey_stats_total(grey_stats_t* const total)
+{
+    memset(total, 0, sizeof(*total));
+    const grey_stats_block_t* block = __atomic_load_n(&grey_stats_blocks,
+                                                      __ATOMIC_ACQUIRE);
+    for (; block != NULL; block = block->next)
+    {
+        const grey_stats_t* const stats = &block->stats;
+        for (size_t api = 0; api < GREY_STATS_APIS; api++)
+        {
+            grey_stats_sum(total->calls[api], stats->calls[api],
+                           GREY_STATS_KERNELS);
+            grey_stats_sum(total->elements[api], stats->elements[api],
+                           GREY_STATS_KERNELS);
+            grey_stats_sum(total->bytes[api], stats->bytes[api],
+                           GREY_STATS_KERNELS);
+            grey_stats_sum(total->sizes[api], stats->sizes[api],
+                           GREY_STATS_BUCKETS);
+        }
+        grey_stats_sum(total->sampled_calls, stats->sampled_calls,
+                       GREY_STATS_APIS);
+        grey_stats_sum(total->sampled_elements, stats->sampled_elements,
+                       GREY_STATS_APIS);
+        grey_stats_sum(total->cycles, stats->cycles, GREY_STATS_APIS);
+    }
+}
+
+/** Subtracts the \p amount counters of \p baseline from \p total. */
+static void grey_stats_since(uint64_t* const total,
+                             const uint64_t* const baseline,
+                             const size_t amount)
+{
+    for (size_t i = 0; i < amount; i++)
+    {
+        total[i] -= baseline[i];
+    }
+}
+
+grey_err_t grey_stats_snapshot(grey_stats_t* const stats)
+{
+    grey_stats_total(stats);
+    const grey_stats_t* const baseline = &grey_stats_baseline;
+    for (size_t api = 0; api < GREY_STATS_APIS; api++)
+    {
+        grey_stats_since(stats->calls[api], baseline->calls[api],
+                         GREY_STATS_KERNELS);
+        grey_stats_since(stats->elements[api], baseline->elements[api],
+                         GREY_STATS_KERNELS);
+        grey_stats_since(stats->bytes[api], baseline->bytes[api],
+                         GREY_STATS_KERNELS);
+        grey_stats_since(stats->sizes[api], baseline->sizes[api],
+                         GREY_STATS_BUCKETS);
+    }
+    grey_stats_since(stats->sampled_calls, baseline->sampled_calls,
+                     GREY_STATS_APIS);
+    grey_stats_since(stats->sampled_elements, baseline->sampled_elements,
+                     GREY_STATS_APIS);
+    grey_stats_since(stats->cycles, baseline->cycles, GREY_STATS_APIS);
+    return GREY_OK;
+}
+
+grey_err_t grey_stats_reset(void)
+{
+    grey_stats_total(&grey_stats_baseline);
+    return GREY_OK;
+}
+
+grey_err_t grey_stats_sample_cycles(const uint32_t period)
+{
+#if !defined(GREY_STATS_TSC)
+    if (period != 0U)
+    {
+        return GREY_ERR_UNSUPPORTED;
+    }
+#endif
+    __atomic_store_n(&grey_stats_period, period, __ATOMIC_RELAXED);
+    return GREY_OK;
+}
+
+#else
+
+grey_err_t grey_stats_snapshot(grey_stats_t* const stats)
+{
+    (void) stats;
+    return GREY_ERR_UNSUPPORTED;
+}
+
+grey_err_t grey_stats_reset(void)
+{
+    return GREY_ERR_UNSUPPORTED;
+}
+
+grey_err_t grey_stats_sample_cycles(const uint32_t period)
+{
+    (void) period;
+    return GREY_ERR_UNSUPPORTED;
+}
+
+#endif  /* GREY_STATS */
+
+const char* grey_stats_api_name(const grey_stats_api_t api)
+{
+    switch (api)
+    {
+        case GREY_STATS_TO_ARRAY:
+            return "to_array";
+        case GREY_STATS_FROM_ARRAY:
+            return "from_array";
+        case GREY_STATS_FILL_RANGE:
+            return "fill_range";
+        case GREY_STATS_WORDS_TO:
+            return "words_to";
+        case GREY_STATS_WORDS_FROM:
+            return "words_from";
+        case GREY_STATS_HILBERT:
+            return "hilbert";
+        case GREY_STATS_DISTANCES:
+            return "distances";
+        case GREY_STATS_PARALLEL_TO:
+            return "parallel_to";
+        case GREY_STATS_PARALLEL_FROM:
+            return "parallel_from";
+        case GREY_STATS_PACKED_TO:
+            return "packed_to";
+        case GREY_STATS_PACKED_FROM:
+            return "packed_from";
+        default:
+            return "unknown";
+    }
+}
+
+/** JSON written so far by grey_stats_json(). */
+typedef struct
+{
+    char* buffer;
+    size_t size;
+    /** Length of the whole JSON so far, also what did not fit. */
+    size_t length;
+} grey_stats_writer_t;
+
+/** Appends formatted text to \p writer, truncating what does not fit. */
+static void grey_stats_print(grey_stats_writer_t* const writer,
+                             const char* const format, ...)
+{
+    char* end = NULL;
+    size_t room = 0;
+    if (writer->length < writer->size)
+    {
+        end = &writer->buffer[writer->length];
+        room = writer->size - writer->length;
+    }
+    va_list args;
+    va_start(args, format);
+    const int written = vsnprintf(end, room, format, args);
+    va_end(args);
+    if (written > 0)
+    {
+        writer->length += (size_t) written;
+    }
+}
+
+/** Appends a `"name": {"calls": .., "elements": .., "bytes": ..}`. */
+static void grey_stats_print_counters(grey_stats_writer_t* const writer,
+                                      const char* const name,
+                                      const uint64_t calls,
+                                      const uint64_t elements,
+                                      const uint64_t bytes)
+{
+    grey_stats_print(writer, "\"%s\": {\"calls\": %" PRIu64
+                             ", \"elements\": %" PRIu64
+                             ", \"bytes\": %" PRIu64 "}",
+                     name, calls, elements, bytes);
+}
+
+/** Appends the counters of one group, which was called. */
+static void grey_stats_print_api(grey_stats_writer_t* const writer,
+                                 const grey_stats_t* const stats,
+                                 const size_t api)
+{
+    uint64_t calls = 0;
+    uint64_t elements = 0;
+    uint64_t bytes = 0;
+    for (size_t kernel = 0; kernel < GREY_STATS_KERNELS; kernel++)
+    {
+        calls += stats->calls[api][kernel];
+        elements += stats->elements[api][kernel];
+        bytes += stats->bytes[api][kernel];
+    }
+    grey_stats_print(writer, "\"%s\": {\"calls\": %" PRIu64
+                             ", \"elements\": %" PRIu64
+                             ", \"bytes\": %" PRIu64 ", \"kernels\": {",
+                     grey_stats_api_name((grey_stats_api_t) api),
+                     calls, elements, bytes);
+    const char* separator = "";
+    for (size_t kernel = 0; kernel < GREY_STATS_KERNELS; kernel++)
+    {
+        if (stats->calls[api][kernel] != 0U)
+        {
+            grey_stats_print(writer, "%s", separator);
+            grey_stats_print_counters(
+                    writer, grey_kernel_name((grey_kernel_t) kernel),
+                    stats->calls[api][kernel], stats->elements[api][kernel],
+                    stats->bytes[api][kernel]);
+            separator = ", ";
+        }
+    }
+    grey_stats_print(writer, "}, \"sizes\": {");
+    separator = "";
+    for (size_t bucket = 0; bucket < GREY_STATS_BUCKETS; bucket++)
+    {
+        if (stats->sizes[api][bucket] != 0U)
+        {
+            const uint64_t smallest = (bucket == 0U)
+                                      ? 0U : UINT64_C(1) << (bucket - 1U);
+            grey_stats_print(writer, "%s\"%" PRIu64 "\": %" PRIu64,
+                             separator, smallest, stats->sizes[api][bucket]);
+            separator = ", ";
+        }
+    }
+    grey_stats_print(writer, "}");
+    if (stats->sampled_calls[api] != 0U)
+    {
+        grey_stats_print(writer, ", \"cycles\": {\"calls\": %" PRIu64
+                                 ", \"elements\": %" PRIu64
+                                 ", \"cycles\": %" PRIu64 "}",
+                         stats->sampled_calls[api],
+                         stats->sampled_elements[api], stats->cycles[api]);
+    }
+    grey_stats_print(writer, "}");
+}
+
+size_t grey_stats_json(const grey_stats_t* const stats, char* const buffer,
+                       const size_t size)
+{
+    grey_stats_writer_t writer = {buffer, size, 0};
+    if (size != 0U)
+    {
+        buffer[0] = '\0';
+    }
+    grey_stats_print(&writer, "{");
+    const char* separator = "";
+    for (size_t api = 0; api < GREY_STATS_APIS; api++)
+    {
+        bool called = false;
+        for (size_t kernel = 0; kernel < GREY_STATS_KERNELS; kernel++)
+        {
+            called = called || stats->calls[api][kernel] != 0U;
+        }
+        if (called)
+        {
+            grey_stats_print(&writer, "%s", separator);
+            grey_stats_print_api(&writer, stats, api);
+            separator = ", ";
+        }
+    }
+    grey_stats_print(&writer, "}");
+    return writer.length;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @brief Internal recording of the runtime counters of the `GREY_STATS`
+ * builds.
+ *
+ * Not part of the public API. The bulk functions wrap each call to a
+ * kernel in #GREY_STATS_RECORD, which without `GREY_STATS` is just the
+ * call itself, so the other builds compile exactly the same code.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef GREY_STATS_H
+#define GREY_STATS_H
+
+#include "grey.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(GREY_STATS)
+
+/**
+ * Starts timing a call, when it is one of the sampled ones of this thread.
+ *
+ * @return the time stamp counter, 0 if the call is not sampled.
+ */
+uint64_t grey_stats_begin(void);
+
+/**
+ * Counts a call of \p kernel by \p api in the counters of this thread,
+ * with its cycles if \p start is not 0.
+ *
+ * @param[in] api group of the function called
+ * @param[in] kernel kernel which did the work
+ * @param[in] elements elements processed
+ * @param[in] bytes bytes read and written
+ * @param[in] start what grey_stats_begin() returned before the call
+ */
+void grey_stats_end(grey_stats_api_t api, grey_kernel_t kernel,
+                    size_t elements, size_t bytes, uint64_t start);
+
+/**
+ * Runs \p call, a kernel call processing \p elements elements and
+ * moving \p bytes bytes, counting it for \p api and \p kernel.
+ */
+#define GREY_STATS_RECORD(api, kernel, elements, bytes, call) \
+    do \
+    { \
+        const uint64_t grey_stats_start_ = grey_stats_begin(); \
+        call; \
+        grey_stats_end((api), (kernel), (elements), (bytes), \
+                       grey_stats_start_); \
+    } while (0)
+
+#else
+
+#define GREY_STATS_RECORD(api, kernel, elements, bytes, call) call
+
+#endif  /* GREY_STATS */
+
+/** #grey_stats_api_t of the conversions in \p direction, `to` or `from`. */
+#define GREY_STATS_API_to GREY_STATS_TO_ARRAY
+#define GREY_STATS_API_from GREY_STATS_FROM_ARRAY
+/** Whether the conversions in \p direction, `to` or `from`, decode. */
+#define GREY_STATS_DECODE_to false
+#define GREY_STATS_DECODE_from true
+
+/**
+ * #GREY_STATS_RECORD of \p call, a conversion in \p direction, `to` or
+ * `from`, of \p amount \p bits -wide elements, counted for \p api.
+ */
+#define GREY_STATS_CONVERT_AS(api, direction, bits, amount, call) \
+    GREY_STATS_RECORD((api), \
+                      grey_kernel_active_width((bits), \
+                                               GREY_STATS_DECODE_##direction), \
+                      (amount), (amount) * (bits) / 4U, call)
+
+/** #GREY_STATS_CONVERT_AS() for the array group of \p direction. */
+#define GREY_STATS_CONVERT(direction, bits, amount, call) \
+    GREY_STATS_CONVERT_AS(GREY_STATS_API_##direction, direction, bits, \
+                          amount, call)
+
+#endif  /* GREY_STATS_H */
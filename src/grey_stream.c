@@ -0,0 +1,125 @@
+/**
+ * @file
+ * @brief Decoder of a stream of Grey encoder readings, fed through a
+ * single-producer single-consumer ring buffer.
+ *
+ * The producer owns grey_stream_t.head, the consumer grey_stream_t.tail,
+ * each publishing it with release ordering after touching the buffer, so
+ * no slot is read before it is written nor overwritten before it is
+ * decoded. Both counters run freely and wrap around, the buffer index
+ * being their lowest bits.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+
+#if defined(GREY_HAS_ATOMIC)
+
+/** Readings decoded at once with grey_from_array(). */
+#define GREY_STREAM_BATCH 256U
+
+grey_err_t grey_stream_init(grey_stream_t* const stream,
+                            grey_code_t* const buffer,
+                            const size_t capacity)
+{
+    if (buffer == NULL || capacity == 0U
+        || (capacity & (capacity - 1U)) != 0U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    stream->head = 0;
+    stream->overruns = 0;
+    stream->buffer = buffer;
+    stream->mask = capacity - 1U;
+    stream->tail = 0;
+    stream->position = 0;
+    stream->glitches = 0;
+    stream->started = false;
+    return GREY_OK;
+}
+
+/**
+ * Signed difference of two readings modulo 2^#GREY_UINTBITS, the shortest
+ * way from \p from to \p to.
+ */
+static inline int64_t grey_stream_step(const grey_int_t from,
+                                       const grey_int_t to)
+{
+    const grey_int_t forward = (grey_int_t) (to - from);
+    if (forward > GREY_MAX / 2U)
+    {
+        return -(int64_t) (GREY_MAX - forward) - 1;
+    }
+    return (int64_t) forward;
+}
+
+size_t grey_stream_decode(grey_stream_t* const stream,
+                          int64_t* const positions, bool* const glitches,
+                          const size_t max)
+{
+    const size_t head = __atomic_load_n(&stream->head, __ATOMIC_ACQUIRE);
+    const size_t tail = stream->tail;  /* Written only here */
+    const size_t amount = (head - tail < max) ? head - tail : max;
+    grey_int_t values[GREY_STREAM_BATCH];
+    uint64_t position = (uint64_t) stream->position;
+    uint64_t flagged = 0;
+    size_t done = 0;
+    while (done < amount)
+    {
+        /* Up to the end of the buffer, where it wraps around */
+        const size_t index = (tail + done) & stream->mask;
+        size_t length = stream->mask + 1U - index;
+        length = (length < amount - done) ? length : amount - done;
+        length = (length < GREY_STREAM_BATCH) ? length : GREY_STREAM_BATCH;
+        const grey_code_t* const readings = &stream->buffer[index];
+        grey_from_array(readings, values, length);
+        size_t i = 0;
+        if (!stream->started)
+        {
+            position = values[0];
+            stream->started = true;
+            if (positions != NULL)
+            {
+                positions[done] = (int64_t) position;
+            }
+            if (glitches != NULL)
+            {
+                glitches[done] = false;
+            }
+            i = 1U;
+        }
+        for (; i < length; i++)
+        {
+            const grey_int_t last = (grey_int_t) position;
+            const grey_code_t changed = (grey_code_t) (
+                    readings[i] ^ grey_inline_to(last));
+            const bool glitch = (changed & (changed - 1U)) != 0U;
+            position += (uint64_t) grey_stream_step(last, values[i]);
+            flagged += glitch;
+            if (positions != NULL)
+            {
+                positions[done + i] = (int64_t) position;
+            }
+            if (glitches != NULL)
+            {
+                glitches[done + i] = glitch;
+            }
+        }
+        done += length;
+    }
+    stream->position = (int64_t) position;
+    stream->glitches += flagged;
+    /* Only now the producer may overwrite the decoded readings */
+    __atomic_store_n(&stream->tail, tail + amount, __ATOMIC_RELEASE);
+    return amount;
+}
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int grey_stream_unavailable_t;
+
+#endif
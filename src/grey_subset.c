@@ -0,0 +1,255 @@
+/**
+ * @file
+ * @brief Revolving-door Grey code of the k-subsets of an n-set: ranking,
+ * unranking and iterator positioning.
+ *
+ * The subsets of (n k) without the element n - 1 come first, as in
+ * (n-1 k), then the ones with it, as in (n-1 k-1) reversed. Ranking and
+ * unranking walk down from the element n - 1, keeping the binomial
+ * coefficient of the current n and k, which each step updates in O(1).
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+
+/** Lowest element of the current subset able to move, k if none. */
+static uint32_t grey_subset_focus(const grey_subset_iter_t* const iter)
+{
+    uint32_t index = 0;
+    while (index < iter->k && !grey_subset_iter_movable(iter, index))
+    {
+        index++;
+    }
+    return index;
+}
+
+/** Greatest common divisor of \p a and \p b. */
+static uint64_t grey_subset_gcd(uint64_t a, uint64_t b)
+{
+    while (b != 0U)
+    {
+        const uint64_t rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+/**
+ * `x * a / b` for an exact quotient, without overflowing when it fits in
+ * 64 bits: \p b divided by its common factors with \p x divides \p a.
+ *
+ * @return false if the quotient does not fit in 64 bits.
+ */
+static bool grey_subset_mul_div(uint64_t x, const uint64_t a, uint64_t b,
+                                uint64_t* const result)
+{
+    const uint64_t common = grey_subset_gcd(x, b);
+    x /= common;
+    b /= common;
+    const uint64_t factor = a / b;
+    if (factor != 0U && x > UINT64_MAX / factor)
+    {
+        return false;
+    }
+    *result = x * factor;
+    return true;
+}
+
+grey_err_t grey_subset_count(const uint32_t n, const uint32_t k,
+                             uint64_t* const count)
+{
+    if (k > n)
+    {
+        return GREY_ERR_INVALID;
+    }
+    const uint32_t smaller = (k < n - k) ? k : n - k;
+    uint64_t binomial = 1U;
+    /* (n-smaller+i i) from (n-smaller+i-1 i-1) */
+    for (uint32_t i = 1U; i <= smaller; i++)
+    {
+        if (!grey_subset_mul_div(binomial, (uint64_t) (n - smaller) + i, i,
+                                 &binomial))
+        {
+            return GREY_ERR_RANGE;
+        }
+    }
+    *count = binomial;
+    return GREY_OK;
+}
+
+grey_err_t grey_subset_rank(const uint32_t* const elements, const uint32_t n,
+                            uint32_t k, uint64_t* const rank)
+{
+    uint64_t binomial;
+    const grey_err_t err = grey_subset_count(n, k, &binomial);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    for (uint32_t i = 0; i < k; i++)
+    {
+        if (elements[i] >= n || (i > 0U && elements[i] <= elements[i - 1U]))
+        {
+            return GREY_ERR_INVALID;
+        }
+    }
+    /* The rank is offset + rank in the subsets of the remaining elements,
+     * negated once per element found, which reverses their order. The
+     * arithmetic wraps around, but the final rank is in range. */
+    uint64_t offset = 0;
+    bool negated = false;
+    for (uint32_t m = n; k > 0U && k < m; m--)
+    {
+        /* binomial is (m k), without_top is (m-1 k) */
+        uint64_t without_top = 0;
+        (void) grey_subset_mul_div(binomial, m - k, m, &without_top);
+        if (elements[k - 1U] == m - 1U)
+        {
+            const uint64_t last = binomial - 1U;
+            offset = negated ? offset - last : offset + last;
+            negated = !negated;
+            binomial -= without_top;
+            k--;
+        }
+        else
+        {
+            binomial = without_top;
+        }
+    }
+    *rank = offset;
+    return GREY_OK;
+}
+
+grey_err_t grey_subset_unrank(uint64_t rank, const uint32_t n, uint32_t k,
+                              uint32_t* const elements)
+{
+    uint64_t binomial;
+    const grey_err_t err = grey_subset_count(n, k, &binomial);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    if (rank >= binomial)
+    {
+        return GREY_ERR_RANGE;
+    }
+    uint32_t m = n;
+    for (; k > 0U && k < m; m--)
+    {
+        uint64_t without_top = 0;
+        (void) grey_subset_mul_div(binomial, m - k, m, &without_top);
+        if (rank >= without_top)
+        {
+            /* With m - 1: the rest in reverse order */
+            elements[k - 1U] = m - 1U;
+            rank = binomial - 1U - rank;
+            binomial -= without_top;
+            k--;
+        }
+        else
+        {
+            binomial = without_top;
+        }
+    }
+    /* All the remaining elements are in */
+    for (uint32_t i = 0; i < k; i++)
+    {
+        elements[i] = i;
+    }
+    return GREY_OK;
+}
+
+grey_err_t grey_subset_rank_mask(const uint64_t mask, const uint32_t n,
+                                 uint64_t* const rank)
+{
+    if (n > 64U || (n < 64U && (mask >> n) != 0U))
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint32_t elements[64];
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (((mask >> i) & 1U) != 0U)
+        {
+            elements[k++] = i;
+        }
+    }
+    return grey_subset_rank(elements, n, k, rank);
+}
+
+grey_err_t grey_subset_unrank_mask(const uint64_t rank, const uint32_t n,
+                                   const uint32_t k, uint64_t* const mask)
+{
+    if (n > 64U)
+    {
+        return GREY_ERR_INVALID;
+    }
+    uint32_t elements[64];
+    const grey_err_t err = grey_subset_unrank(rank, n, k, elements);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    uint64_t bits = 0;
+    for (uint32_t i = 0; i < k; i++)
+    {
+        bits |= UINT64_C(1) << elements[i];
+    }
+    *mask = bits;
+    return GREY_OK;
+}
+
+grey_err_t grey_subset_iter_init(grey_subset_iter_t* const iter,
+                                 const uint32_t n, const uint32_t k,
+                                 uint32_t* const elements)
+{
+    if (k > n || n == UINT32_MAX || elements == NULL)
+    {
+        return GREY_ERR_INVALID;
+    }
+    for (uint32_t i = 0; i < k; i++)
+    {
+        elements[i] = i;
+    }
+    elements[k] = n;
+    iter->elements = elements;
+    iter->mask = 0;
+    if (n <= 64U)
+    {
+        iter->mask = (k == 64U) ? UINT64_MAX : (UINT64_C(1) << k) - 1U;
+    }
+    iter->n = n;
+    iter->k = k;
+    iter->left = n;
+    iter->joined = n;
+    iter->focus = grey_subset_focus(iter);
+    return GREY_OK;
+}
+
+grey_err_t grey_subset_iter_seek(grey_subset_iter_t* const iter,
+                                 const uint64_t rank)
+{
+    const grey_err_t err = grey_subset_unrank(rank, iter->n, iter->k,
+                                              iter->elements);
+    if (err != GREY_OK)
+    {
+        return err;
+    }
+    iter->mask = 0;
+    if (iter->n <= 64U)
+    {
+        for (uint32_t i = 0; i < iter->k; i++)
+        {
+            iter->mask |= UINT64_C(1) << iter->elements[i];
+        }
+    }
+    iter->left = iter->n;
+    iter->joined = iter->n;
+    iter->focus = grey_subset_focus(iter);
+    return GREY_OK;
+}
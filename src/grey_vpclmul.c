@@ -0,0 +1,74 @@
+/**
+ * @file
+ * @brief AVX-512 VPCLMULQDQ Grey decoding kernel.
+ *
+ * Same prefix-XOR by carry-less multiplication as the PCLMULQDQ kernel,
+ * on 8 lanes of 64 bits per iteration, with the leftovers handled by a
+ * masked load/store as in the other AVX-512 kernels.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+
+#if defined(GREY_KERNELS_VPCLMUL)
+
+#include <immintrin.h>
+
+/** Decodes the eight 64-bit lanes of \p v at once. */
+static inline __m512i vpclmul_from64(const __m512i v)
+{
+    const __m512i ones = _mm512_set1_epi64(-1);
+    /* 128-bit products of each lane, as [low half, high half] */
+    const __m512i product0 = _mm512_clmulepi64_epi128(v, ones, 0x00);
+    const __m512i product1 = _mm512_clmulepi64_epi128(v, ones, 0x01);
+    const __m512i high = _mm512_unpackhi_epi64(product0, product1);
+    const __m512i low = _mm512_unpacklo_epi64(product0, product1);
+    /* (product >> 63) truncated to 64 bits, for each product */
+    return _mm512_or_si512(_mm512_slli_epi64(high, 1),
+                           _mm512_srli_epi64(low, 63));
+}
+
+/** Same as in the AVX-512 kernels, see GREY_WORDS_FROM_KERNELS_DEFINE(). */
+static inline unsigned int vpclmul_words_parities(const __m512i v)
+{
+    return _mm512_test_epi64_mask(v, _mm512_set1_epi64(1));
+}
+
+static inline __m512i vpclmul_words_flip(const __m512i v,
+                                         const unsigned int mask)
+{
+    return _mm512_mask_xor_epi64(v, (__mmask8) mask, v,
+                                 _mm512_set1_epi64(-1));
+}
+
+void grey_vpclmul_from64(const uint64_t* const in, uint64_t* const out,
+                         const size_t amount)
+{
+    size_t i = 0;
+    for (; i + 8U <= amount; i += 8U)
+    {
+        const __m512i v = _mm512_loadu_si512(&in[i]);
+        _mm512_storeu_si512(&out[i], vpclmul_from64(v));
+    }
+    if (i < amount)
+    {
+        const __mmask8 mask = (__mmask8) ((1U << (amount - i)) - 1U);
+        const __m512i v = _mm512_maskz_loadu_epi64(mask, &in[i]);
+        _mm512_mask_storeu_epi64(&out[i], mask, vpclmul_from64(v));
+    }
+}
+
+GREY_WORDS_FROM_KERNELS_DEFINE(vpclmul, __m512i, 8,
+                               _mm512_loadu_si512, _mm512_storeu_si512,
+                               vpclmul_from64, vpclmul_words_parities,
+                               vpclmul_words_flip)
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int grey_vpclmul_unavailable_t;
+
+#endif
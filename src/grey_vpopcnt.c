@@ -0,0 +1,28 @@
+/**
+ * @file
+ * @brief AVX-512 VPOPCNTDQ + BITALG Hamming distance kernels.
+ *
+ * Count the bits of each lane of 8, 16, 32 or 64 bits with a single
+ * instruction, instead of the nibble table lookups of the AVX-512 kernels
+ * they replace on the CPUs that have them.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_kernels.h"
+
+#if defined(GREY_KERNELS_VPOPCNT)
+
+#include <immintrin.h>
+
+GREY_AVX512_DISTANCES_DEFINE(vpopcnt, _mm512_popcnt_epi8, _mm512_popcnt_epi16,
+                             _mm512_popcnt_epi32, _mm512_popcnt_epi64)
+
+#else
+
+/* ISO C forbids an empty translation unit. */
+typedef int grey_vpopcnt_unavailable_t;
+
+#endif
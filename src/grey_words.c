@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @brief Grey codes of any width, stored as arrays of 64-bit words.
+ *
+ * Encoding is word-local apart from one bit shifted in from the more
+ * significant neighbour, so it runs entirely in the multiword kernels.
+ * Decoding is a prefix-XOR across the whole value: each word is decoded on
+ * its own as by the 64-bit bulk kernel, then all of its bits are inverted
+ * when the XOR of every more significant code bit is 1. The multiword
+ * decoders do both in the same pass, see #GREY_WORDS_FROM_KERNELS_DEFINE.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "grey_kernels.h"
+#include "grey_stats.h"
+
+/** Mask of the used bits of the most significant word. */
+static uint64_t grey_words_top_mask(const size_t bits)
+{
+    const unsigned int used = (unsigned int) (bits % 64U);
+    return (used == 0) ? UINT64_MAX : ((UINT64_C(1) << used) - 1U);
+}
+
+void grey_to_words(const uint64_t* const values, uint64_t* const codes,
+                   const size_t bits, const grey_word_order_t order)
+{
+    const size_t amount = GREY_WORDS(bits);
+    if (amount == 0)
+    {
+        return;
+    }
+    const size_t top = (order == GREY_WORDS_BE) ? 0 : amount - 1U;
+    /* The neighbour of the lower words is the top one, but only its lowest
+     * bit, always in use, is read: no masking needed before this. */
+    if (order == GREY_WORDS_BE)
+    {
+        GREY_STATS_RECORD(GREY_STATS_WORDS_TO, grey_kernels.id, amount - 1U,
+                          (amount - 1U) * 16U,
+                          grey_kernels.words_to_be(values, codes,
+                                                   amount - 1U));
+    }
+    else
+    {
+        GREY_STATS_RECORD(GREY_STATS_WORDS_TO, grey_kernels.id, amount - 1U,
+                          (amount - 1U) * 16U,
+                          grey_kernels.words_to_le(values, codes,
+                                                   amount - 1U));
+    }
+    const uint64_t value = values[top] & grey_words_top_mask(bits);
+    codes[top] = grey_inline_to64(value);
+}
+
+void grey_from_words(const uint64_t* const codes, uint64_t* const values,
+                     const size_t bits, const grey_word_order_t order)
+{
+    const size_t amount = GREY_WORDS(bits);
+    if (amount == 0)
+    {
+        return;
+    }
+    const size_t top = (order == GREY_WORDS_BE) ? 0 : amount - 1U;
+    const uint64_t flip = grey_inline_word_from(
+            codes[top] & grey_words_top_mask(bits), &values[top], 0);
+    if (order == GREY_WORDS_BE)
+    {
+        GREY_STATS_RECORD(GREY_STATS_WORDS_FROM, grey_kernels.id,
+                          amount - 1U, (amount - 1U) * 16U,
+                          (void) grey_kernels.words_from_be(
+                                  &codes[1], &values[1], amount - 1U, flip));
+    }
+    else
+    {
+        GREY_STATS_RECORD(GREY_STATS_WORDS_FROM, grey_kernels.id,
+                          amount - 1U, (amount - 1U) * 16U,
+                          (void) grey_kernels.words_from_le(
+                                  codes, values, amount - 1U, flip));
+    }
+}
@@ -0,0 +1,799 @@
+/**
+ * @file
+ * @brief Benchmarks of the Grey codes library: ns/op and GB/s of every
+ * function and bulk kernel, at every width.
+ *
+ * Each benchmark runs in two modes:
+ * - latency: every operation depends on the result of the previous one,
+ *   so they cannot overlap. The bulk functions work in place on a short
+ *   array, repeatedly, so the call overhead is included.
+ * - throughput: the operations are independent and the CPU may overlap
+ *   them. The bulk functions convert a whole array of `--size` elements.
+ *
+ * One operation is one Grey code (or one 64-bit word for the multiword
+ * functions) and GB/s counts the bytes of the Grey codes processed, not
+ * of the text of the binary string functions. Every benchmark is first
+ * run for the warm-up time, which also calibrates the repetitions, then
+ * measured a few times; the fastest run is reported, as the least
+ * disturbed by the rest of the system.
+ *
+ * All widths are part of the same library build, so a single run covers
+ * 8 to 64 bits (and 128 bits where supported) regardless of
+ * #GREY_UINTBITS.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+/* sched_setaffinity() and clock_gettime() */
+#define _GNU_SOURCE
+
+#include "grey.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#if defined(GREY_HAS_ATOMIC) && !defined(GREY_NO_THREADS) \
+    && (defined(__unix__) || defined(__APPLE__))
+#define BENCH_ATOMIC
+#include <pthread.h>
+#endif
+
+/** Distinct inputs cycled through by the single-value benchmarks. */
+#define BENCH_INPUTS 1024U
+/** Elements of the array converted in place by the bulk latency mode. */
+#define BENCH_LATENCY_LEN 64U
+/** Queries of the many-to-many distances, fitting the output buffer. */
+#define BENCH_QUERIES 8U
+/** Radius of the Hamming balls enumerated. */
+#define BENCH_BALL_RADIUS 2U
+/** Measured runs of each benchmark, the fastest one is reported. */
+#define BENCH_RUNS 5U
+
+typedef enum
+{
+    BENCH_TEXT = 0,
+    BENCH_CSV = 1,
+    BENCH_JSON = 2,
+} bench_format_t;
+
+/** Command line options. */
+typedef struct
+{
+    bench_format_t format;
+    int cpu;
+    double warmup_ms;
+    double time_ms;
+    size_t size;
+    const char* filter;
+} bench_options_t;
+
+/** Runs \p reps operations (or arrays), returns a value to keep. */
+typedef uint64_t (* bench_fn_t)(size_t reps);
+
+static bench_options_t options = {
+        .format = BENCH_TEXT,
+        .cpu = -1,
+        .warmup_ms = 100.0,
+        .time_ms = 500.0,
+        .size = 4096U,
+        .filter = NULL,
+};
+static size_t results = 0;
+static volatile uint64_t sink;
+
+/* Inputs, shared by all widths, truncated as needed. */
+static uint64_t inputs[BENCH_INPUTS];
+/* Zero-padded binary strings of the inputs, per width. */
+static char strings8[BENCH_INPUTS][8 + 1];
+static char strings16[BENCH_INPUTS][16 + 1];
+static char strings32[BENCH_INPUTS][32 + 1];
+static char strings64[BENCH_INPUTS][64 + 1];
+/* Bulk buffers of options.size elements, the largest width. */
+static uint64_t* bulk_in;
+static uint64_t* bulk_out;
+static char* bulk_text;
+
+static double now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+static double elapsed_ns(const bench_fn_t fn, const size_t reps)
+{
+    const double start = now_ns();
+    sink += fn(reps);
+    return now_ns() - start;
+}
+
+/**
+ * Runs \p fn for the warm-up time, doubling the repetitions until a run is
+ * long enough to time, then measures it #BENCH_RUNS times.
+ * @return the fastest time of one repetition, in ns.
+ */
+static double bench_time(const bench_fn_t fn)
+{
+    const double run_ns = options.time_ms * 1e6 / BENCH_RUNS;
+    const double warmup_end = now_ns() + options.warmup_ms * 1e6;
+    size_t reps = 1;
+    double elapsed = elapsed_ns(fn, reps);
+    while (elapsed < run_ns || now_ns() < warmup_end)
+    {
+        if (elapsed < run_ns)
+        {
+            reps *= 2U;
+        }
+        elapsed = elapsed_ns(fn, reps);
+    }
+    double fastest = -1.0;
+    for (unsigned int run = 0; run < BENCH_RUNS; run++)
+    {
+        const double time = elapsed_ns(fn, reps) / (double) reps;
+        if (fastest < 0.0 || time < fastest)
+        {
+            fastest = time;
+        }
+    }
+    return fastest;
+}
+
+static void report(const char* const name, const unsigned int bits,
+                   const char* const kernel, const char* const mode,
+                   const double ns_per_op, const double bytes_per_op)
+{
+    const double gb_per_s = (ns_per_op > 0.0) ? bytes_per_op / ns_per_op : 0;
+    switch (options.format)
+    {
+        case BENCH_CSV:
+            printf("%s,%u,%s,%s,%.4f,%.4f\n",
+                   name, bits, kernel, mode, ns_per_op, gb_per_s);
+            break;
+        case BENCH_JSON:
+            printf("%s\n    {\"name\": \"%s\", \"bits\": %u, "
+                   "\"kernel\": \"%s\", \"mode\": \"%s\", "
+                   "\"ns_per_op\": %.4f, \"gb_per_s\": %.4f}",
+                   (results == 0) ? "" : ",",
+                   name, bits, kernel, mode, ns_per_op, gb_per_s);
+            break;
+        case BENCH_TEXT:
+        default:
+            printf("%-16s %4u %-8s %-10s %10.3f ns/op %9.3f GB/s\n",
+                   name, bits, kernel, mode, ns_per_op, gb_per_s);
+            break;
+    }
+    fflush(stdout);
+    results++;
+}
+
+/**
+ * Times \p fn, where one repetition is \p ops operations on \p bits -wide
+ * codes, and reports it unless filtered out.
+ */
+static void bench(const char* const name, const unsigned int bits,
+                  const char* const kernel, const char* const mode,
+                  const bench_fn_t fn, const size_t ops)
+{
+    if (options.filter != NULL && strstr(name, options.filter) == NULL)
+    {
+        return;
+    }
+    const double ns_per_op = bench_time(fn) / (double) ops;
+    report(name, bits, kernel, mode, ns_per_op, (double) bits / 8.0);
+}
+
+/**
+ * Defines the latency and throughput functions of a single-value
+ * operation \p op on \p bits -wide codes, computed by `call(x)` as a
+ * value of \p type.
+ */
+#define BENCH_SCALAR_DEFINE(op, bits, type, call) \
+    static uint64_t bench_##op##bits##_latency(const size_t reps) \
+    { \
+        type x = (type) inputs[0]; \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            x = (type) call(x); \
+        } \
+        return (uint64_t) x; \
+    } \
+    static uint64_t bench_##op##bits##_throughput(const size_t reps) \
+    { \
+        type sum = 0; \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            sum ^= (type) call((type) inputs[i % BENCH_INPUTS]); \
+        } \
+        return (uint64_t) sum; \
+    }
+
+/**
+ * Defines the operations of \p bits -wide codes that need a helper:
+ * grey_binstr(), chained through its length, and grey_parse_binstr(),
+ * chained by parsing the string picked by the previous result.
+ */
+#define BENCH_HELPERS_DEFINE(bits, type) \
+    static type bench_binstr##bits(const type grey) \
+    { \
+        char str[(bits) + 1]; \
+        return (type) (grey + grey_binstr##bits(str, grey)); \
+    } \
+    static type bench_binstr_fixed##bits(const type grey) \
+    { \
+        char str[(bits) + 1]; \
+        grey_binstr_fixed##bits(str, grey); \
+        return (type) (grey + (unsigned char) str[(bits) - 1U]); \
+    } \
+    static type bench_parse##bits(const type index) \
+    { \
+        type grey = 0; \
+        (void) grey_parse_binstr##bits(strings##bits[index % BENCH_INPUTS], \
+                                       (bits), &grey); \
+        return grey; \
+    }
+
+/** Defines all single-value benchmarks of \p bits -wide codes. */
+#define BENCH_WIDTH_DEFINE(bits, type) \
+    BENCH_HELPERS_DEFINE(bits, type) \
+    BENCH_SCALAR_DEFINE(to, bits, type, grey_to##bits) \
+    BENCH_SCALAR_DEFINE(from, bits, type, grey_from##bits) \
+    BENCH_SCALAR_DEFINE(incr, bits, type, grey_incr##bits) \
+    BENCH_SCALAR_DEFINE(binstr, bits, type, bench_binstr##bits) \
+    BENCH_SCALAR_DEFINE(binstr_fixed, bits, type, bench_binstr_fixed##bits) \
+    BENCH_SCALAR_DEFINE(parse_binstr, bits, type, bench_parse##bits) \
+    static void bench_scalar##bits(void) \
+    { \
+        bench("to", (bits), "-", "latency", \
+              bench_to##bits##_latency, 1U); \
+        bench("to", (bits), "-", "throughput", \
+              bench_to##bits##_throughput, 1U); \
+        bench("from", (bits), "-", "latency", \
+              bench_from##bits##_latency, 1U); \
+        bench("from", (bits), "-", "throughput", \
+              bench_from##bits##_throughput, 1U); \
+        bench("incr", (bits), "-", "latency", \
+              bench_incr##bits##_latency, 1U); \
+        bench("incr", (bits), "-", "throughput", \
+              bench_incr##bits##_throughput, 1U); \
+        bench("binstr", (bits), "-", "latency", \
+              bench_binstr##bits##_latency, 1U); \
+        bench("binstr", (bits), "-", "throughput", \
+              bench_binstr##bits##_throughput, 1U); \
+        bench("binstr_fixed", (bits), "-", "latency", \
+              bench_binstr_fixed##bits##_latency, 1U); \
+        bench("binstr_fixed", (bits), "-", "throughput", \
+              bench_binstr_fixed##bits##_throughput, 1U); \
+        bench("parse_binstr", (bits), "-", "latency", \
+              bench_parse_binstr##bits##_latency, 1U); \
+        bench("parse_binstr", (bits), "-", "throughput", \
+              bench_parse_binstr##bits##_throughput, 1U); \
+    }
+
+BENCH_WIDTH_DEFINE(8, uint8_t)
+BENCH_WIDTH_DEFINE(16, uint16_t)
+BENCH_WIDTH_DEFINE(32, uint32_t)
+BENCH_WIDTH_DEFINE(64, uint64_t)
+
+#if defined(GREY_HAS_UINT128)
+BENCH_SCALAR_DEFINE(to, 128, grey_uint128_t, grey_to128)
+BENCH_SCALAR_DEFINE(from, 128, grey_uint128_t, grey_from128)
+
+static void bench_scalar128(void)
+{
+    bench("to", 128, "-", "latency", bench_to128_latency, 1U);
+    bench("to", 128, "-", "throughput", bench_to128_throughput, 1U);
+    bench("from", 128, "-", "latency", bench_from128_latency, 1U);
+    bench("from", 128, "-", "throughput", bench_from128_throughput, 1U);
+}
+#endif
+
+/** Defines the bulk benchmarks of \p bits -wide codes. */
+#define BENCH_BULK_DEFINE(bits, type) \
+    static uint64_t bench_to_array##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            grey_to_array##bits((const type*) bulk_in, (type*) bulk_out, \
+                                options.size); \
+        } \
+        return bulk_out[0]; \
+    } \
+    static uint64_t bench_from_array##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            grey_from_array##bits((const type*) bulk_in, (type*) bulk_out, \
+                                  options.size); \
+        } \
+        return bulk_out[0]; \
+    } \
+    static uint64_t bench_to_inplace##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            grey_to_array_inplace##bits((type*) bulk_out, \
+                                        BENCH_LATENCY_LEN); \
+        } \
+        return bulk_out[0]; \
+    } \
+    static uint64_t bench_from_inplace##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            grey_from_array_inplace##bits((type*) bulk_out, \
+                                          BENCH_LATENCY_LEN); \
+        } \
+        return bulk_out[0]; \
+    } \
+    static uint64_t bench_fill_range##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            grey_fill_range##bits((type) i, options.size, \
+                                  (type*) bulk_out); \
+        } \
+        return bulk_out[0]; \
+    } \
+    static uint64_t bench_binstr_array##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            (void) grey_binstr_array##bits(bulk_text, (const type*) bulk_in, \
+                                           options.size, '\n'); \
+        } \
+        return (uint64_t) bulk_text[0]; \
+    } \
+    static uint64_t bench_distances##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            grey_distances##bits((type) inputs[i % BENCH_INPUTS], \
+                                 (const type*) bulk_in, \
+                                 (uint8_t*) bulk_out, options.size); \
+        } \
+        return bulk_out[0]; \
+    } \
+    static uint64_t bench_distances_many##bits(const size_t reps) \
+    { \
+        for (size_t i = 0; i < reps; i++) \
+        { \
+            grey_distances_many##bits((const type*) inputs, \
+                                      BENCH_QUERIES, (const type*) bulk_in, \
+                                      options.size, (uint8_t*) bulk_out); \
+        } \
+        return bulk_out[0]; \
+    } \
+    static void bench_bulk##bits(const char* const kernel) \
+    { \
+        bench("to_array", (bits), kernel, "latency", \
+              bench_to_inplace##bits, BENCH_LATENCY_LEN); \
+        bench("to_array", (bits), kernel, "throughput", \
+              bench_to_array##bits, options.size); \
+        bench("from_array", (bits), kernel, "latency", \
+              bench_from_inplace##bits, BENCH_LATENCY_LEN); \
+        bench("from_array", (bits), kernel, "throughput", \
+              bench_from_array##bits, options.size); \
+        bench("fill_range", (bits), kernel, "throughput", \
+              bench_fill_range##bits, options.size); \
+        bench("distances", (bits), kernel, "throughput", \
+              bench_distances##bits, options.size); \
+        bench("distances_many", (bits), kernel, "throughput", \
+              bench_distances_many##bits, BENCH_QUERIES * options.size); \
+    }
+
+BENCH_BULK_DEFINE(8, uint8_t)
+BENCH_BULK_DEFINE(16, uint16_t)
+BENCH_BULK_DEFINE(32, uint32_t)
+BENCH_BULK_DEFINE(64, uint64_t)
+
+static uint64_t bench_to_words(const size_t reps)
+{
+    for (size_t i = 0; i < reps; i++)
+    {
+        grey_to_words(bulk_in, bulk_out, options.size * 64U, GREY_WORDS_LE);
+    }
+    return bulk_out[0];
+}
+
+static uint64_t bench_from_words(const size_t reps)
+{
+    for (size_t i = 0; i < reps; i++)
+    {
+        grey_from_words(bulk_in, bulk_out, options.size * 64U,
+                        GREY_WORDS_LE);
+    }
+    return bulk_out[0];
+}
+
+static uint64_t bench_to_words_inplace(const size_t reps)
+{
+    for (size_t i = 0; i < reps; i++)
+    {
+        grey_to_words(bulk_out, bulk_out, BENCH_LATENCY_LEN * 64U,
+                      GREY_WORDS_LE);
+    }
+    return bulk_out[0];
+}
+
+static uint64_t bench_from_words_inplace(const size_t reps)
+{
+    for (size_t i = 0; i < reps; i++)
+    {
+        grey_from_words(bulk_out, bulk_out, BENCH_LATENCY_LEN * 64U,
+                        GREY_WORDS_LE);
+    }
+    return bulk_out[0];
+}
+
+static void bench_words(const char* const kernel)
+{
+    bench("to_words", 64, kernel, "latency", bench_to_words_inplace,
+          BENCH_LATENCY_LEN);
+    bench("to_words", 64, kernel, "throughput", bench_to_words,
+          options.size);
+    bench("from_words", 64, kernel, "latency", bench_from_words_inplace,
+          BENCH_LATENCY_LEN);
+    bench("from_words", 64, kernel, "throughput", bench_from_words,
+          options.size);
+}
+
+/** Points of 2 coordinates, from the input buffer as 32-bit values. */
+static uint64_t bench_hilbert_index2(const size_t reps)
+{
+    const uint32_t* const coords = (const uint32_t*) bulk_in;
+    const size_t amount = options.size / 2U;
+    for (size_t i = 0; i < reps; i++)
+    {
+        (void) grey_hilbert_index2_array(coords, &coords[amount], bulk_out,
+                                         amount, GREY_HILBERT_MAX_BITS2);
+    }
+    return bulk_out[0];
+}
+
+/** Points of 3 coordinates, from the input buffer as 32-bit values. */
+static uint64_t bench_hilbert_index3(const size_t reps)
+{
+    const uint32_t* const coords = (const uint32_t*) bulk_in;
+    const size_t amount = options.size * 2U / 3U;
+    for (size_t i = 0; i < reps; i++)
+    {
+        (void) grey_hilbert_index3_array(coords, &coords[amount],
+                                         &coords[2U * amount], bulk_out,
+                                         amount, GREY_HILBERT_MAX_BITS3);
+    }
+    return bulk_out[0];
+}
+
+static void bench_hilbert(const char* const kernel)
+{
+    bench("hilbert_index2", 32, kernel, "throughput", bench_hilbert_index2,
+          options.size / 2U);
+    bench("hilbert_index3", 21, kernel, "throughput", bench_hilbert_index3,
+          options.size * 2U / 3U);
+}
+
+/** The binary strings do not depend on the bulk kernel. */
+static void bench_text(void)
+{
+    bench("binstr_array", 8, "-", "throughput", bench_binstr_array8,
+          options.size);
+    bench("binstr_array", 16, "-", "throughput", bench_binstr_array16,
+          options.size);
+    bench("binstr_array", 32, "-", "throughput", bench_binstr_array32,
+          options.size);
+    bench("binstr_array", 64, "-", "throughput", bench_binstr_array64,
+          options.size);
+}
+
+#if defined(BENCH_ATOMIC)
+static grey_atomic_padded_t atomic_counter;
+
+static void* bench_atomic_worker(void* const reps)
+{
+    const size_t amount = *(const size_t*) reps;
+    for (size_t i = 0; i < amount; i++)
+    {
+        grey_atomic_incr(&atomic_counter.counter);
+    }
+    return NULL;
+}
+
+/**
+ * Defines the benchmark of \p threads threads, the caller included,
+ * incrementing the same counter \p reps times each.
+ */
+#define BENCH_ATOMIC_DEFINE(threads) \
+    static uint64_t bench_atomic_incr##threads(const size_t reps) \
+    { \
+        pthread_t workers[(threads)]; \
+        size_t amount = reps; \
+        for (size_t i = 1; i < (threads); i++) \
+        { \
+            pthread_create(&workers[i], NULL, bench_atomic_worker, &amount); \
+        } \
+        bench_atomic_worker(&amount); \
+        for (size_t i = 1; i < (threads); i++) \
+        { \
+            pthread_join(workers[i], NULL); \
+        } \
+        return grey_atomic_load(&atomic_counter.counter); \
+    }
+
+BENCH_ATOMIC_DEFINE(1U)
+BENCH_ATOMIC_DEFINE(2U)
+BENCH_ATOMIC_DEFINE(4U)
+BENCH_ATOMIC_DEFINE(8U)
+
+/**
+ * Contention on one atomic counter: ns per increment of all threads
+ * together, so the cost of moving the cache line among the CPUs shows up
+ * as the threads increase. Meaningless with `--cpu`, which pins all of
+ * them to the same CPU.
+ */
+static void bench_atomic(void)
+{
+    bench("atomic_incr", GREY_UINTBITS, "-", "1 thread",
+          bench_atomic_incr1U, 1U);
+    bench("atomic_incr", GREY_UINTBITS, "-", "2 threads",
+          bench_atomic_incr2U, 2U);
+    bench("atomic_incr", GREY_UINTBITS, "-", "4 threads",
+          bench_atomic_incr4U, 4U);
+    bench("atomic_incr", GREY_UINTBITS, "-", "8 threads",
+          bench_atomic_incr8U, 8U);
+}
+#endif
+
+#if defined(GREY_HAS_ATOMIC)
+static grey_stream_t stream;
+static grey_code_t stream_buffer[BENCH_LATENCY_LEN];
+static int64_t stream_positions[BENCH_LATENCY_LEN];
+
+/** Pushes a batch of readings, then decodes it, in the same thread. */
+static uint64_t bench_stream_batch(const size_t reps)
+{
+    for (size_t i = 0; i < reps; i++)
+    {
+        for (size_t j = 0; j < BENCH_LATENCY_LEN; j++)
+        {
+            grey_stream_push(&stream, (grey_code_t) inputs[j]);
+        }
+        grey_stream_decode(&stream, stream_positions, NULL,
+                           BENCH_LATENCY_LEN);
+    }
+    return (uint64_t) stream.position;
+}
+
+static void bench_stream(void)
+{
+    (void) grey_stream_init(&stream, stream_buffer, BENCH_LATENCY_LEN);
+    bench("stream_push_decode", GREY_UINTBITS, "-", "throughput",
+          bench_stream_batch, BENCH_LATENCY_LEN);
+}
+#endif
+
+/** Codes of a whole ball, written BENCH_LATENCY_LEN at a time. */
+static uint64_t bench_ball_fill(const size_t reps)
+{
+    grey_code_t* const codes = (grey_code_t*) bulk_out;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < reps; i++)
+    {
+        const grey_code_t center = (grey_code_t) inputs[i % BENCH_INPUTS];
+        grey_ball_iter_t ball;
+        (void) grey_ball_iter_init(&ball, center, BENCH_BALL_RADIUS);
+        while (grey_ball_iter_fill(&ball, codes, BENCH_LATENCY_LEN)
+               == BENCH_LATENCY_LEN)
+        {
+            sum += codes[0];
+        }
+    }
+    return sum;
+}
+
+static void bench_ball(void)
+{
+    /* 1 + n + n (n - 1) / 2 codes within distance 2 */
+    const size_t codes = 1U + GREY_UINTBITS
+                         + GREY_UINTBITS * (GREY_UINTBITS - 1U) / 2U;
+    bench("ball_fill", GREY_UINTBITS, "-", "throughput", bench_ball_fill,
+          codes);
+}
+
+static void prepare_inputs(void)
+{
+    uint64_t state = 0x853C49E6748FEA9BULL;
+    for (size_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        inputs[i] = state ^ (state >> 29U);
+        grey_binstr_fixed8(strings8[i], (uint8_t) inputs[i]);
+        grey_binstr_fixed16(strings16[i], (uint16_t) inputs[i]);
+        grey_binstr_fixed32(strings32[i], (uint32_t) inputs[i]);
+        grey_binstr_fixed64(strings64[i], inputs[i]);
+    }
+    for (size_t i = 0; i < options.size; i++)
+    {
+        bulk_in[i] = inputs[i % BENCH_INPUTS];
+        bulk_out[i] = 0;
+    }
+}
+
+static void pin_cpu(void)
+{
+    if (options.cpu < 0)
+    {
+        return;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t) options.cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+    {
+        fprintf(stderr, "Cannot pin to CPU %d\n", options.cpu);
+        exit(EXIT_FAILURE);
+    }
+#else
+    fprintf(stderr, "CPU pinning is not supported on this platform\n");
+#endif
+}
+
+static void usage(const char* const program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --format text|csv|json  output format, default text\n"
+            "  --cpu N                 pin the benchmark to CPU N\n"
+            "  --warmup MS             warm-up time per benchmark, "
+            "default 100\n"
+            "  --time MS               measured time per benchmark, "
+            "default 500\n"
+            "  --size N                elements of the bulk arrays, "
+            "default 4096\n"
+            "  --filter NAME           only benchmarks whose name "
+            "contains NAME\n",
+            program);
+}
+
+static void parse_options(const int argc, char** const argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* const option = argv[i];
+        const char* const value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL)
+        {
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+        if (strcmp(option, "--format") == 0)
+        {
+            if (strcmp(value, "csv") == 0)
+            {
+                options.format = BENCH_CSV;
+            }
+            else if (strcmp(value, "json") == 0)
+            {
+                options.format = BENCH_JSON;
+            }
+            else if (strcmp(value, "text") == 0)
+            {
+                options.format = BENCH_TEXT;
+            }
+            else
+            {
+                usage(argv[0]);
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (strcmp(option, "--cpu") == 0)
+        {
+            options.cpu = atoi(value);
+        }
+        else if (strcmp(option, "--warmup") == 0)
+        {
+            options.warmup_ms = atof(value);
+        }
+        else if (strcmp(option, "--time") == 0)
+        {
+            options.time_ms = atof(value);
+        }
+        else if (strcmp(option, "--size") == 0)
+        {
+            options.size = (size_t) strtoull(value, NULL, 10);
+        }
+        else if (strcmp(option, "--filter") == 0)
+        {
+            options.filter = value;
+        }
+        else
+        {
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+        i++;
+    }
+    if (options.size < BENCH_LATENCY_LEN)
+    {
+        options.size = BENCH_LATENCY_LEN;
+    }
+}
+
+int main(const int argc, char** const argv)
+{
+    parse_options(argc, argv);
+    pin_cpu();
+    bulk_in = malloc(options.size * sizeof(uint64_t));
+    bulk_out = malloc(options.size * sizeof(uint64_t));
+    bulk_text = malloc(GREY_BINSTR_ARRAY_SIZE(64U, options.size));
+    if (bulk_in == NULL || bulk_out == NULL || bulk_text == NULL)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    prepare_inputs();
+
+    switch (options.format)
+    {
+        case BENCH_CSV:
+            printf("name,bits,kernel,mode,ns_per_op,gb_per_s\n");
+            break;
+        case BENCH_JSON:
+            printf("{\n  \"version\": \"%s\",\n  \"size\": %zu,\n"
+                   "  \"cpu\": %d,\n  \"results\": [",
+                   GREY_VERSION, options.size, options.cpu);
+            break;
+        case BENCH_TEXT:
+        default:
+            printf("Grey %s benchmarks, bulk arrays of %zu elements\n",
+                   GREY_VERSION, options.size);
+            break;
+    }
+    bench_scalar8();
+    bench_scalar16();
+    bench_scalar32();
+    bench_scalar64();
+#if defined(GREY_HAS_UINT128)
+    bench_scalar128();
+#endif
+    bench_text();
+#if defined(BENCH_ATOMIC)
+    bench_atomic();
+#endif
+#if defined(GREY_HAS_ATOMIC)
+    bench_stream();
+#endif
+    bench_ball();
+    for (int kernel = GREY_KERNEL_SCALAR; kernel <= GREY_KERNEL_LUT;
+         kernel++)
+    {
+        if (grey_kernel_force((grey_kernel_t) kernel) != GREY_OK)
+        {
+            continue;
+        }
+        const char* const name = grey_kernel_name((grey_kernel_t) kernel);
+        bench_bulk8(name);
+        bench_bulk16(name);
+        bench_bulk32(name);
+        bench_bulk64(name);
+        bench_words(name);
+        bench_hilbert(name);
+    }
+    (void) grey_kernel_force(GREY_KERNEL_AUTO);
+    if (options.format == BENCH_JSON)
+    {
+        printf("\n  ]\n}\n");
+    }
+
+    free(bulk_in);
+    free(bulk_out);
+    free(bulk_text);
+    return EXIT_SUCCESS;
+}
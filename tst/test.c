@@ -8,8 +8,29 @@
 
 #include "grey.h"
 #include "atto.h"
+#include "test.h"
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
+
+uint64_t test_next_pseudorandom(uint64_t* const state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state ^ (*state >> 29U);
+}
+
+void test_fill_pseudorandom(void* const data, const size_t size,
+                            uint64_t seed)
+{
+    uint8_t* const bytes = (uint8_t*) data;
+    for (size_t i = 0; i < size; i += sizeof(uint64_t))
+    {
+        const uint64_t random = test_next_pseudorandom(&seed);
+        const size_t rest = size - i;
+        memcpy(&bytes[i], &random,
+               (rest < sizeof(uint64_t)) ? rest : sizeof(uint64_t));
+    }
+}
 
 static void test_max_and_print(void)
 {
@@ -116,6 +137,83 @@ static void test_decrement(void)
             grey_decr(grey_to(GREY_MAX)));
 }
 
+static void test_add(void)
+{
+    atto_eq(grey_to(15), grey_add(grey_to(10), 5));
+    atto_eq(grey_to(5), grey_add(grey_to(10), -5));
+    atto_eq(grey_to(GREY_MAX), grey_add(grey_to(2), -3));
+    atto_eq(grey_to(1), grey_add(grey_to(GREY_MAX), 2));
+    atto_eq(grey_to(103), grey_add(grey_to(103), 0));
+}
+
+static void test_add_overflow(void)
+{
+    grey_code_t result = 0;
+    atto_assert(!grey_add_overflow(grey_to(10), 5, &result));
+    atto_eq(grey_to(15), result);
+    atto_assert(!grey_add_overflow(grey_to(10), -10, &result));
+    atto_eq(0, result);
+    atto_assert(!grey_add_overflow(grey_to(GREY_MAX - 2), 2, &result));
+    atto_eq(grey_to(GREY_MAX), result);
+    atto_assert(grey_add_overflow(grey_to(2), -3, &result));
+    atto_eq(grey_to(GREY_MAX), result);
+    atto_assert(grey_add_overflow(grey_to(GREY_MAX), 2, &result));
+    atto_eq(grey_to(1), result);
+    atto_assert(grey_add_overflow(grey_to(0), INT64_MIN, &result));
+    atto_assert(grey_add_overflow(grey_to(GREY_MAX), INT64_MAX, &result));
+    atto_assert(!grey_add_overflow(grey_to(GREY_MAX), 0, &result));
+    atto_eq(grey_to(GREY_MAX), result);
+}
+
+/** Native grey_incr*() and grey_decr*() against decoding and encoding. */
+static void test_incr_decr_widths(void)
+{
+    for (uint32_t i = 0; i <= UINT8_MAX; i++)
+    {
+        const uint8_t value = (uint8_t) i;
+        atto_eq(grey_to8((uint8_t) (value + 1U)), grey_incr8(grey_to8(value)));
+        atto_eq(grey_to8((uint8_t) (value - 1U)), grey_decr8(grey_to8(value)));
+    }
+    for (uint32_t i = 0; i <= UINT16_MAX; i++)
+    {
+        const uint16_t value = (uint16_t) i;
+        atto_eq(grey_to16((uint16_t) (value + 1U)),
+                grey_incr16(grey_to16(value)));
+        atto_eq(grey_to16((uint16_t) (value - 1U)),
+                grey_decr16(grey_to16(value)));
+    }
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t i = 0; i < 100000U; i++)
+    {
+        const uint64_t random = test_next_pseudorandom(&state);
+        /* Small values and the ones near the maximum, plus random ones */
+        const uint64_t value = (i < 1000U) ? i
+                               : (i < 2000U) ? UINT64_MAX - (i - 1000U)
+                               : random;
+        const uint32_t value32 = (uint32_t) value;
+        atto_eq(grey_to32(value32 + 1U), grey_incr32(grey_to32(value32)));
+        atto_eq(grey_to32(value32 - 1U), grey_decr32(grey_to32(value32)));
+        atto_eq(grey_to64(value + 1U), grey_incr64(grey_to64(value)));
+        atto_eq(grey_to64(value - 1U), grey_decr64(grey_to64(value)));
+#if defined(GREY_HAS_UINT128)
+        const grey_uint128_t value128 = ((grey_uint128_t) value << 64U)
+                                        | (value ^ state);
+        atto_assert(grey_to128(value128 + 1U)
+                    == grey_incr128(grey_to128(value128)));
+        atto_assert(grey_to128(value128 - 1U)
+                    == grey_decr128(grey_to128(value128)));
+#endif
+    }
+    /* Walking the whole 16-bit sequence visits every code exactly once. */
+    uint16_t code = 0;
+    for (uint32_t i = 0; i <= UINT16_MAX; i++)
+    {
+        atto_eq(grey_from16(code), i);
+        code = grey_incr16(code);
+    }
+    atto_eq(0, code);
+}
+
 static void test_binstr(void)
 {
     char str[GREY_UINTBITS + 1];
@@ -146,6 +244,396 @@ static void test_binstr(void)
 
 }
 
+/** Amount of elements for the array tests: covers several whole vectors of
+ * every width plus leftovers. */
+#define ARRAY_LEN 300U
+
+/** Seed of the pseudorandom values of the array tests. */
+#define ARRAY_SEED 0x9E3779B97F4A7C15ULL
+
+static void test_to_array(void)
+{
+    grey_int_t values[ARRAY_LEN];
+    grey_code_t codes[ARRAY_LEN + 1];
+    test_fill_pseudorandom(values, sizeof(values), ARRAY_SEED);
+    grey_to_array(values, codes, 0);
+    grey_to_array(NULL, NULL, 0);
+    for (size_t amount = 0; amount <= ARRAY_LEN; amount += 7U)
+    {
+        codes[amount] = 42U;  // Canary after the last element
+        grey_to_array(values, codes, amount);
+        for (size_t i = 0; i < amount; i++)
+        {
+            atto_eq(grey_to(values[i]), codes[i]);
+        }
+        atto_eq(42U, codes[amount]);
+    }
+}
+
+static void test_from_array(void)
+{
+    grey_code_t codes[ARRAY_LEN];
+    grey_int_t values[ARRAY_LEN + 1];
+    test_fill_pseudorandom(codes, sizeof(codes), ARRAY_SEED);
+    grey_from_array(NULL, NULL, 0);
+    for (size_t amount = 0; amount <= ARRAY_LEN; amount += 7U)
+    {
+        values[amount] = 42U;  // Canary after the last element
+        grey_from_array(codes, values, amount);
+        for (size_t i = 0; i < amount; i++)
+        {
+            atto_eq(grey_from(codes[i]), values[i]);
+        }
+        atto_eq(42U, values[amount]);
+    }
+}
+
+static void test_array_inplace(void)
+{
+    grey_int_t original[ARRAY_LEN];
+    grey_int_t data[ARRAY_LEN];
+    test_fill_pseudorandom(original, sizeof(original), ARRAY_SEED);
+    memcpy(data, original, sizeof(data));
+    grey_to_array_inplace(data, ARRAY_LEN);
+    for (size_t i = 0; i < ARRAY_LEN; i++)
+    {
+        atto_eq(grey_to(original[i]), data[i]);
+    }
+    grey_from_array_inplace(data, ARRAY_LEN);
+    atto_memeq(original, data, sizeof(data));
+}
+
+static void test_kernel_names(void)
+{
+    atto_streq("auto", grey_kernel_name(GREY_KERNEL_AUTO), 10);
+    atto_streq("scalar", grey_kernel_name(GREY_KERNEL_SCALAR), 10);
+    atto_streq("sse2", grey_kernel_name(GREY_KERNEL_SSE2), 10);
+    atto_streq("avx2", grey_kernel_name(GREY_KERNEL_AVX2), 10);
+    atto_streq("avx512", grey_kernel_name(GREY_KERNEL_AVX512), 10);
+    atto_streq("pclmul", grey_kernel_name(GREY_KERNEL_PCLMUL), 10);
+    atto_streq("vpclmul", grey_kernel_name(GREY_KERNEL_VPCLMUL), 10);
+    atto_streq("lut", grey_kernel_name(GREY_KERNEL_LUT), 10);
+    atto_streq("unknown", grey_kernel_name((grey_kernel_t) 100), 10);
+}
+
+static void test_kernel_force(void)
+{
+    atto_eq(GREY_OK, grey_kernel_force(GREY_KERNEL_SCALAR));
+    atto_eq(GREY_KERNEL_SCALAR, grey_kernel_active());
+    atto_eq(GREY_ERR_UNSUPPORTED, grey_kernel_force((grey_kernel_t) 100));
+    atto_eq(GREY_KERNEL_SCALAR, grey_kernel_active());
+    atto_eq(GREY_OK, grey_kernel_force(GREY_KERNEL_AUTO));
+    atto_neq(GREY_KERNEL_AUTO, grey_kernel_active());
+}
+
+static void test_widths(void)
+{
+    atto_eq(0x80U, grey_to8(0xFFU));
+    atto_eq(0xFFU, grey_from8(0x80U));
+    atto_eq(0x8000U, grey_to16(0xFFFFU));
+    atto_eq(0xFFFFU, grey_from16(0x8000U));
+    atto_eq(0x80000000UL, grey_to32(0xFFFFFFFFUL));
+    atto_eq(0xFFFFFFFFUL, grey_from32(0x80000000UL));
+    atto_eq(0x8000000000000000ULL, grey_to64(UINT64_MAX));
+    atto_eq(UINT64_MAX, grey_from64(0x8000000000000000ULL));
+    for (uint32_t i = 0; i <= UINT16_MAX; i++)
+    {
+        const uint16_t value = (uint16_t) i;
+        atto_eq(value, grey_from16(grey_to16(value)));
+        atto_eq(grey_to64(value), grey_to16(value));
+        atto_eq(grey_from64(value), grey_from16(value));
+        atto_eq(grey_to16((uint8_t) value), grey_to8((uint8_t) value));
+    }
+    grey_int_t values[ARRAY_LEN];
+    test_fill_pseudorandom(values, sizeof(values), ARRAY_SEED);
+    for (size_t i = 0; i < ARRAY_LEN; i++)
+    {
+        const uint32_t value = (uint32_t) values[i];
+        atto_eq(value, grey_from32(grey_to32(value)));
+        atto_eq(grey_to64(value), grey_to32(value));
+    }
+}
+
+static void test_widths_128(void)
+{
+#if defined(GREY_HAS_UINT128)
+    const grey_uint128_t top = (grey_uint128_t) 1U << 127U;
+    atto_eq(top, grey_to128(GREY_MAX128));
+    atto_assert(GREY_MAX128 == grey_from128(top));
+    atto_eq(15U, grey_to128(10U));
+    atto_eq(10U, grey_from128(15U));
+    grey_int_t values[ARRAY_LEN];
+    test_fill_pseudorandom(values, sizeof(values), ARRAY_SEED);
+    for (size_t i = 0; i + 1U < ARRAY_LEN; i++)
+    {
+        const grey_uint128_t value =
+                ((grey_uint128_t) values[i] << 64U) | values[i + 1U];
+        atto_assert(value == grey_from128(grey_to128(value)));
+        atto_eq(grey_from64(values[i]), grey_from128(values[i]));
+        /* The lowest bit of the value is the parity of the whole code */
+        atto_eq(__builtin_parityll((unsigned long long) (value >> 64U))
+                ^ __builtin_parityll((unsigned long long) value),
+                (int) (grey_from128(value) & 1U));
+    }
+#endif
+}
+
+static void test_binstr_widths(void)
+{
+    char str[128 + 1];
+    atto_eq(8, grey_binstr8(str, 0xFFU));
+    atto_streq(str, "11111111", 8);
+    atto_eq(3, grey_binstr16(str, 0x5U));
+    atto_streq(str, "101", 16);
+    atto_eq(16, grey_binstr16(str, 0x8001U));
+    atto_streq(str, "1000000000000001", 16);
+    atto_eq(32, grey_binstr32(str, 0x80000000UL));
+    atto_streq(str, "10000000000000000000000000000000", 32);
+    atto_eq(0, grey_binstr64(str, 0U));
+    atto_streq(str, "", 64);
+    atto_eq(64, grey_binstr64(str, UINT64_MAX));
+    atto_streq(
+            str,
+            "1111111111111111111111111111111111111111111111111111111111111111",
+            64);
+#if defined(GREY_HAS_UINT128)
+    atto_eq(4, grey_binstr128(str, 0xEU));
+    atto_streq(str, "1110", 128);
+    atto_eq(66, grey_binstr128(str, ((grey_uint128_t) 2U << 64U) | 1U));
+    atto_streq(
+            str,
+            "10"
+            "0000000000000000000000000000000000000000000000000000000000000001",
+            128);
+#endif
+}
+
+static void test_array_widths(void)
+{
+    uint8_t bytes[ARRAY_LEN];
+    uint8_t bytes_out[ARRAY_LEN];
+    uint16_t words[ARRAY_LEN];
+    uint16_t words_out[ARRAY_LEN];
+    uint32_t dwords[ARRAY_LEN];
+    uint32_t dwords_out[ARRAY_LEN];
+    uint64_t qwords[ARRAY_LEN];
+    uint64_t qwords_out[ARRAY_LEN];
+    grey_int_t values[ARRAY_LEN];
+    test_fill_pseudorandom(values, sizeof(values), ARRAY_SEED);
+    for (size_t i = 0; i < ARRAY_LEN; i++)
+    {
+        bytes[i] = (uint8_t) values[i];
+        words[i] = (uint16_t) values[i];
+        dwords[i] = (uint32_t) values[i];
+        qwords[i] = (uint64_t) values[i];
+    }
+    grey_to_array8(bytes, bytes_out, ARRAY_LEN);
+    grey_to_array16(words, words_out, ARRAY_LEN);
+    grey_to_array32(dwords, dwords_out, ARRAY_LEN);
+    grey_to_array64(qwords, qwords_out, ARRAY_LEN);
+    for (size_t i = 0; i < ARRAY_LEN; i++)
+    {
+        atto_eq(grey_to8(bytes[i]), bytes_out[i]);
+        atto_eq(grey_to16(words[i]), words_out[i]);
+        atto_eq(grey_to32(dwords[i]), dwords_out[i]);
+        atto_eq(grey_to64(qwords[i]), qwords_out[i]);
+    }
+    grey_from_array8(bytes_out, bytes_out, 0);
+    grey_from_array_inplace8(bytes_out, ARRAY_LEN);
+    grey_from_array_inplace16(words_out, ARRAY_LEN);
+    grey_from_array_inplace32(dwords_out, ARRAY_LEN);
+    grey_from_array_inplace64(qwords_out, ARRAY_LEN);
+    atto_memeq(bytes, bytes_out, sizeof(bytes));
+    atto_memeq(words, words_out, sizeof(words));
+    atto_memeq(dwords, dwords_out, sizeof(dwords));
+    atto_memeq(qwords, qwords_out, sizeof(qwords));
+    grey_to_array_inplace16(words, ARRAY_LEN);
+    grey_from_array16(words, words_out, ARRAY_LEN);
+    for (size_t i = 0; i < ARRAY_LEN; i++)
+    {
+        atto_eq(grey_from16(words[i]), words_out[i]);
+    }
+}
+
+static void test_generic(void)
+{
+#if !defined(GREY_NO_GENERIC) && defined(__STDC_VERSION__) \
+    && (__STDC_VERSION__ >= 201112L)
+    const uint8_t byte = 0xFFU;
+    const uint16_t word = 0xFFFFU;
+    const uint32_t dword = 0xFFFFFFFFUL;
+    const unsigned long long qword = 0xFFFFFFFFFFFFFFFFULL;
+    atto_eq(1, sizeof(grey_to(byte)));
+    atto_eq(0x80U, grey_to(byte));
+    atto_eq(0xFFU, grey_from(grey_to(byte)));
+    atto_eq(2, sizeof(grey_to(word)));
+    atto_eq(0x8000U, grey_to(word));
+    atto_eq(4, sizeof(grey_from(dword)));
+    atto_eq(8, sizeof(grey_from(qword)));
+    atto_eq(sizeof(grey_code_t), sizeof(grey_to(1)));
+    atto_eq(15, (grey_to)(10));
+    char str[64 + 1];
+    atto_eq(8, grey_binstr(str, byte));
+    atto_streq(str, "11111111", 64);
+#if defined(GREY_HAS_UINT128)
+    atto_eq(16, sizeof(grey_to(GREY_MAX128)));
+#endif
+#endif
+}
+
+static void test_fill_range(void)
+{
+    grey_code_t codes[ARRAY_LEN + 1];
+    grey_fill_range(0, 0, NULL);
+    grey_fill_range_down(0, 0, NULL);
+    /* Starting anywhere, including right before wrapping around */
+    const grey_int_t starts[] = {
+            0, 1, 7, 100, (grey_int_t) (GREY_MAX - 130U), GREY_MAX
+    };
+    for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); s++)
+    {
+        for (size_t amount = 0; amount <= ARRAY_LEN; amount += 13U)
+        {
+            codes[amount] = 42U;  // Canary after the last element
+            grey_fill_range(starts[s], amount, codes);
+            for (size_t i = 0; i < amount; i++)
+            {
+                atto_eq(grey_to((grey_int_t) (starts[s] + i)), codes[i]);
+            }
+            grey_fill_range_down(starts[s], amount, codes);
+            for (size_t i = 0; i < amount; i++)
+            {
+                atto_eq(grey_to((grey_int_t) (starts[s] - i)), codes[i]);
+            }
+            atto_eq(42U, codes[amount]);
+        }
+    }
+}
+
+static void test_fill_range_widths(void)
+{
+    uint8_t codes8[ARRAY_LEN];
+    uint16_t codes16[ARRAY_LEN];
+    uint32_t codes32[ARRAY_LEN];
+    uint64_t codes64[ARRAY_LEN];
+    grey_fill_range8(200U, ARRAY_LEN, codes8);
+    grey_fill_range16(UINT16_MAX - 100U, ARRAY_LEN, codes16);
+    grey_fill_range32(UINT32_MAX - 100U, ARRAY_LEN, codes32);
+    grey_fill_range64(UINT64_MAX - 100U, ARRAY_LEN, codes64);
+    for (uint32_t i = 0; i < ARRAY_LEN; i++)
+    {
+        atto_eq(grey_to8((uint8_t) (200U + i)), codes8[i]);
+        atto_eq(grey_to16((uint16_t) (UINT16_MAX - 100U + i)), codes16[i]);
+        atto_eq(grey_to32(UINT32_MAX - 100U + i), codes32[i]);
+        atto_eq(grey_to64(UINT64_MAX - 100U + i), codes64[i]);
+    }
+    grey_fill_range_down8(100U, ARRAY_LEN, codes8);
+    grey_fill_range_down16(100U, ARRAY_LEN, codes16);
+    grey_fill_range_down32(100U, ARRAY_LEN, codes32);
+    grey_fill_range_down64(100U, ARRAY_LEN, codes64);
+    for (uint32_t i = 0; i < ARRAY_LEN; i++)
+    {
+        atto_eq(grey_to8((uint8_t) (100U - i)), codes8[i]);
+        atto_eq(grey_to16((uint16_t) (100U - i)), codes16[i]);
+        atto_eq(grey_to32(100U - i), codes32[i]);
+        atto_eq(grey_to64(100U - (uint64_t) i), codes64[i]);
+    }
+}
+
+static void test_iter(void)
+{
+    grey_iter_t iter;
+    grey_iter_init(&iter, 0);
+    atto_eq(0, iter.code);
+    atto_eq(GREY_UINTBITS, iter.flipped);
+    atto_eq(grey_to(1), grey_iter_next(&iter));
+    atto_eq(0, iter.flipped);
+    atto_eq(grey_to(2), grey_iter_next(&iter));
+    atto_eq(1, iter.flipped);
+    atto_eq(grey_to(1), grey_iter_prev(&iter));
+    atto_eq(1, iter.flipped);
+    atto_eq(0, grey_iter_prev(&iter));
+    atto_eq(0, iter.flipped);
+    /* Wrapping around both ways flips the top bit */
+    atto_eq(grey_to(GREY_MAX), grey_iter_prev(&iter));
+    atto_eq(GREY_UINTBITS - 1, iter.flipped);
+    atto_eq(GREY_MAX, iter.value);
+    atto_eq(0, grey_iter_next(&iter));
+    atto_eq(GREY_UINTBITS - 1, iter.flipped);
+
+    const grey_int_t starts[] = {
+            0, (grey_int_t) 12345U, (grey_int_t) (GREY_MAX - 500U)
+    };
+    for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); s++)
+    {
+        grey_iter_init(&iter, starts[s]);
+        for (uint32_t i = 1; i <= 1000U; i++)
+        {
+            const grey_code_t previous = iter.code;
+            atto_eq(grey_to((grey_int_t) (starts[s] + i)),
+                    grey_iter_next(&iter));
+            atto_eq((grey_code_t) (previous ^ iter.code),
+                    (grey_code_t) ((grey_code_t) 1U << iter.flipped));
+        }
+        for (uint32_t i = 1; i <= 1000U; i++)
+        {
+            const grey_code_t previous = iter.code;
+            atto_eq(grey_to((grey_int_t) (starts[s] + 1000U - i)),
+                    grey_iter_prev(&iter));
+            atto_eq((grey_code_t) (previous ^ iter.code),
+                    (grey_code_t) ((grey_code_t) 1U << iter.flipped));
+        }
+    }
+}
+
+/** Runs the bulk conversion tests once with each kernel the CPU supports. */
+static void test_array_all_kernels(void)
+{
+    for (grey_kernel_t kernel = GREY_KERNEL_SCALAR;
+         kernel <= GREY_KERNEL_LUT; kernel++)
+    {
+        if (grey_kernel_force(kernel) == GREY_OK)
+        {
+            printf("Testing kernel: %s\n", grey_kernel_name(kernel));
+            test_to_array();
+            test_from_array();
+            test_array_inplace();
+            test_array_widths();
+            test_words();
+            test_fill_range();
+            test_fill_range_widths();
+        }
+    }
+    atto_eq(GREY_OK, grey_kernel_force(GREY_KERNEL_AUTO));
+}
+
+/** Whatever kernel is the fastest for each conversion, they all agree. */
+static void test_kernel_tune(void)
+{
+    atto_eq(GREY_OK, grey_kernel_tune());
+    atto_neq(GREY_KERNEL_AUTO, grey_kernel_active());
+    const unsigned int widths[] = {8U, 16U, 32U, 64U};
+    for (size_t i = 0; i < sizeof(widths) / sizeof(widths[0]); i++)
+    {
+        for (int decode = 0; decode <= 1; decode++)
+        {
+            const grey_kernel_t kernel =
+                    grey_kernel_active_width(widths[i], decode);
+            atto_neq(GREY_KERNEL_AUTO, kernel);
+            atto_neq(0, strcmp("unknown", grey_kernel_name(kernel)));
+        }
+    }
+    atto_eq(GREY_KERNEL_AUTO, grey_kernel_active_width(128U, false));
+    test_to_array();
+    test_from_array();
+    test_array_inplace();
+    test_array_widths();
+    atto_eq(GREY_OK, grey_kernel_force(GREY_KERNEL_LUT));
+    atto_eq(GREY_KERNEL_LUT, grey_kernel_active_width(32U, true));
+    atto_eq(GREY_OK, grey_kernel_force(GREY_KERNEL_AUTO));
+    atto_eq(grey_kernel_active(), grey_kernel_active_width(8U, false));
+}
+
 int main(void)
 {
     test_max_and_print();
@@ -153,6 +641,33 @@ int main(void)
     test_from_grey();
     test_increment();
     test_decrement();
+    test_add();
+    test_add_overflow();
+    test_incr_decr_widths();
+    test_iter();
+    test_sort();
+    test_binstr_formats();
+    test_parallel();
+    test_text();
+    test_packed();
+    test_fields();
+    test_atomic();
+    test_hilbert();
+    test_stream();
+    test_radix();
+    test_hamming();
+    test_stats();
+    test_subset();
+    test_perm();
     test_binstr();
+    test_header_only();
+    test_widths();
+    test_widths_128();
+    test_binstr_widths();
+    test_generic();
+    test_kernel_names();
+    test_kernel_force();
+    test_array_all_kernels();
+    test_kernel_tune();
     return atto_at_least_one_fail;
 }
@@ -0,0 +1,51 @@
+/**
+ * @file
+ * @brief Test cases defined in other files than test.c, run by its main.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Steps a fast, fixed pseudorandom sequence of the tests: a 64-bit LCG,
+ * with the high bits folded into the weak low ones.
+ *
+ * @param[in,out] state of the sequence, any seed at first.
+ * @return the next number of the sequence.
+ */
+uint64_t test_next_pseudorandom(uint64_t* state);
+
+/**
+ * Fills a buffer with test_next_pseudorandom() from a seed.
+ *
+ * @param[out] data buffer to fill, of any type.
+ * @param[in] size of \p data in bytes.
+ * @param[in] seed first state of the sequence.
+ */
+void test_fill_pseudorandom(void* data, size_t size, uint64_t seed);
+
+void test_header_only(void);
+void test_words(void);
+void test_sort(void);
+void test_binstr_formats(void);
+void test_parallel(void);
+void test_text(void);
+void test_packed(void);
+void test_fields(void);
+void test_atomic(void);
+void test_hilbert(void);
+void test_stream(void);
+void test_radix(void);
+void test_hamming(void);
+void test_stats(void);
+void test_subset(void);
+void test_perm(void);
+
+#endif  /* TEST_H */
@@ -0,0 +1,184 @@
+/**
+ * @file
+ * @brief Tests of the atomic Grey counters, hammered from many threads.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#if !defined(GREY_NO_THREADS) && defined(__GNUC__) \
+    && (defined(__unix__) || defined(__APPLE__))
+#define ATOMIC_THREADS
+/* pthreads */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+#if defined(ATOMIC_THREADS)
+#include <pthread.h>
+#endif
+
+#if defined(GREY_HAS_ATOMIC)
+
+#define ATOMIC_THREADS_AMOUNT 8U
+#define ATOMIC_STEPS 20000U
+
+static void test_atomic_single(void)
+{
+    grey_atomic_t counter;
+    grey_atomic_init(&counter, 0);
+    atto_eq(grey_inline_to(1U), grey_atomic_incr(&counter));
+    atto_eq(grey_inline_to(11U), grey_atomic_add(&counter, 10));
+    atto_eq(grey_inline_to(8U), grey_atomic_add(&counter, -3));
+    atto_eq(grey_inline_to(8U), grey_atomic_load(&counter));
+    grey_code_t expected = grey_inline_to(7U);
+    atto_false(grey_atomic_cas(&counter, &expected, 0));
+    atto_eq(grey_inline_to(8U), expected);
+    atto_assert(grey_atomic_cas(&counter, &expected,
+                                grey_inline_to(GREY_MAX)));
+    atto_eq(0U, grey_atomic_incr(&counter));  // Wraps around
+    grey_atomic_store(&counter, grey_inline_to(42U));
+    atto_eq(grey_inline_to(42U), grey_snapshot(&counter.code));
+
+    atto_eq(GREY_CACHE_LINE, sizeof(grey_atomic_padded_t));
+    static uint8_t region[GREY_ATOMIC_REGION_SIZE(3U) + 1U];
+    grey_atomic_t* const first = grey_atomic_at(&region[1], 0);
+    grey_atomic_t* const last = grey_atomic_at(&region[1], 2U);
+    atto_eq(0U, (uintptr_t) first % GREY_CACHE_LINE);
+    atto_eq(2U * GREY_CACHE_LINE, (uintptr_t) last - (uintptr_t) first);
+    atto_assert((uint8_t*) (last + 1) <= &region[sizeof(region)]);
+}
+
+#if defined(ATOMIC_THREADS)
+
+static grey_atomic_padded_t shared;
+/** Which values of the counter some increment returned. */
+static uint8_t returned[ATOMIC_THREADS_AMOUNT * ATOMIC_STEPS + 1U];
+
+static void* atomic_incrementer(void* const arg)
+{
+    (void) arg;
+    for (uint32_t i = 0; i < ATOMIC_STEPS; i++)
+    {
+        const grey_int_t value = grey_inline_from(
+                grey_atomic_incr(&shared.counter));
+        __atomic_store_n(&returned[value], 1U, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+static void* atomic_adder(void* const arg)
+{
+    const int64_t delta = (arg == NULL) ? 3 : -1;
+    for (uint32_t i = 0; i < ATOMIC_STEPS; i++)
+    {
+        grey_atomic_add(&shared.counter, delta);
+    }
+    return NULL;
+}
+
+static volatile bool writing;
+
+/** Reads the counter stepped by the main thread, which never goes back. */
+static void* atomic_reader(void* const arg)
+{
+    grey_int_t last = 0;
+    bool ordered = true;
+    while (__atomic_load_n(&writing, __ATOMIC_ACQUIRE))
+    {
+        const grey_int_t value = grey_inline_from(grey_snapshot(
+                &shared.counter.code));
+        ordered = ordered && value >= last;
+        last = value;
+    }
+    *(bool*) arg = ordered;
+    return NULL;
+}
+
+/** Every increment returns a different value, none is lost. */
+static void test_atomic_threads(void)
+{
+    if (GREY_MAX < ATOMIC_THREADS_AMOUNT * ATOMIC_STEPS)
+    {
+        return;  // Would wrap around
+    }
+    pthread_t threads[ATOMIC_THREADS_AMOUNT];
+    grey_atomic_init(&shared.counter, 0);
+    memset(returned, 0, sizeof(returned));
+    for (size_t i = 0; i < ATOMIC_THREADS_AMOUNT; i++)
+    {
+        atto_eq(0, pthread_create(&threads[i], NULL, atomic_incrementer,
+                                  NULL));
+    }
+    for (size_t i = 0; i < ATOMIC_THREADS_AMOUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    atto_eq(grey_inline_to((grey_int_t) (ATOMIC_THREADS_AMOUNT
+                                         * ATOMIC_STEPS)),
+            grey_atomic_load(&shared.counter));
+    for (size_t i = 1; i < sizeof(returned); i++)
+    {
+        atto_eq(1U, returned[i]);
+    }
+
+    /* Half add 3, half subtract 1 */
+    grey_atomic_init(&shared.counter, 0);
+    for (size_t i = 0; i < ATOMIC_THREADS_AMOUNT; i++)
+    {
+        atto_eq(0, pthread_create(&threads[i], NULL, atomic_adder,
+                                  (i % 2U) ? &shared : NULL));
+    }
+    for (size_t i = 0; i < ATOMIC_THREADS_AMOUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    atto_eq(grey_inline_to((grey_int_t) (ATOMIC_THREADS_AMOUNT
+                                         * ATOMIC_STEPS)),
+            grey_atomic_load(&shared.counter));
+
+    /* One writer, many snapshots */
+    bool ordered[ATOMIC_THREADS_AMOUNT];
+    grey_atomic_init(&shared.counter, 0);
+    writing = true;
+    for (size_t i = 0; i < ATOMIC_THREADS_AMOUNT; i++)
+    {
+        atto_eq(0, pthread_create(&threads[i], NULL, atomic_reader,
+                                  &ordered[i]));
+    }
+    grey_code_t code = 0;
+    for (uint32_t i = 0; i < ATOMIC_THREADS_AMOUNT * ATOMIC_STEPS; i++)
+    {
+        code = grey_incr(code);
+        grey_atomic_store(&shared.counter, code);
+    }
+    __atomic_store_n(&writing, false, __ATOMIC_RELEASE);
+    for (size_t i = 0; i < ATOMIC_THREADS_AMOUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+        atto_assert(ordered[i]);
+    }
+}
+
+#endif
+
+void test_atomic(void)
+{
+    test_atomic_single();
+#if defined(ATOMIC_THREADS)
+    test_atomic_threads();
+#endif
+}
+
+#else
+
+void test_atomic(void)
+{
+}
+
+#endif
@@ -0,0 +1,227 @@
+/**
+ * @file
+ * @brief Tests of the binary string formatters grey_binstr_fixed() and
+ * grey_binstr_array() and of the parser grey_parse_binstr(), against a
+ * bit-by-bit reference.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+/** Zero-padded, most significant bit first. */
+static void reference_binstr(char* const str, const uint64_t grey,
+                             const unsigned int bits)
+{
+    for (unsigned int i = 0; i < bits; i++)
+    {
+        str[i] = (char) ('0' + ((grey >> (bits - 1U - i)) & 1U));
+    }
+    str[bits] = '\0';
+}
+
+/** Reference without leading zeros, as grey_binstr(). */
+static const char* shortest(const char* const fixed)
+{
+    const size_t zeros = strspn(fixed, "0");
+    return &fixed[zeros];
+}
+
+static void test_binstr_fixed(void)
+{
+    char str[64 + 1];
+    char expected[64 + 1];
+    grey_binstr_fixed8(str, 0x0EU);
+    atto_streq("00001110", str, sizeof(str));
+    grey_binstr_fixed16(str, 0U);
+    atto_streq("0000000000000000", str, sizeof(str));
+    for (uint32_t i = 0; i <= UINT16_MAX; i++)
+    {
+        reference_binstr(expected, i, 16U);
+        grey_binstr_fixed16(str, (uint16_t) i);
+        atto_streq(expected, str, sizeof(str));
+        atto_eq(strlen(shortest(expected)),
+                grey_binstr16(str, (uint16_t) i));
+        atto_streq(shortest(expected), str, sizeof(str));
+        reference_binstr(expected, (uint8_t) i, 8U);
+        grey_binstr_fixed8(str, (uint8_t) i);
+        atto_streq(expected, str, sizeof(str));
+    }
+    uint64_t state = 0x853C49E6748FEA9BULL;
+    for (uint32_t i = 0; i < 10000U; i++)
+    {
+        /* Random lengths, to hit every partial first byte */
+        const uint64_t random = test_next_pseudorandom(&state) >> (i % 64U);
+        reference_binstr(expected, random, 64U);
+        grey_binstr_fixed64(str, random);
+        atto_streq(expected, str, sizeof(str));
+        atto_eq(strlen(shortest(expected)), grey_binstr64(str, random));
+        atto_streq(shortest(expected), str, sizeof(str));
+        reference_binstr(expected, (uint32_t) random, 32U);
+        grey_binstr_fixed32(str, (uint32_t) random);
+        atto_streq(expected, str, sizeof(str));
+        atto_eq(strlen(shortest(expected)),
+                grey_binstr32(str, (uint32_t) random));
+        atto_streq(shortest(expected), str, sizeof(str));
+    }
+#if defined(GREY_HAS_UINT128)
+    char str128[128 + 1];
+    grey_binstr_fixed128(str128, ((grey_uint128_t) 1U << 127U) | 1U);
+    atto_eq('1', str128[0]);
+    atto_eq('1', str128[127]);
+    atto_eq(2, 128U - strspn(str128, "0") - strspn(&str128[1], "0"));
+    atto_eq('\0', str128[128]);
+#endif
+}
+
+static void test_binstr_array(void)
+{
+    char str[GREY_BINSTR_ARRAY_SIZE(16, 3) + 1];
+    const uint8_t codes8[2] = {0x0EU, 0x01U};
+    const uint16_t codes16[3] = {0x8001U, 0U, 0xFFFFU};
+    atto_eq(1, GREY_BINSTR_ARRAY_SIZE(8, 0));
+    atto_eq(18, GREY_BINSTR_ARRAY_SIZE(8, 2));
+    atto_eq(0, grey_binstr_array8(str, codes8, 0, ','));
+    atto_streq("", str, sizeof(str));
+    atto_eq(17, grey_binstr_array8(str, codes8, 2, ','));
+    atto_streq("00001110,00000001", str, sizeof(str));
+    str[GREY_BINSTR_ARRAY_SIZE(16, 3)] = 'X';  // Canary after the end
+    atto_eq(50, grey_binstr_array16(str, codes16, 3, '\n'));
+    atto_streq("1000000000000001\n"
+               "0000000000000000\n"
+               "1111111111111111", str, sizeof(str));
+    atto_eq('X', str[GREY_BINSTR_ARRAY_SIZE(16, 3)]);
+
+    static uint64_t codes64[1000];
+    static char str64[GREY_BINSTR_ARRAY_SIZE(64, 1000)];
+    uint64_t state = 0xDA3E39CB94B95BDBULL;
+    for (size_t i = 0; i < 1000U; i++)
+    {
+        codes64[i] = test_next_pseudorandom(&state);
+    }
+    atto_eq(sizeof(str64) - 1U,
+            grey_binstr_array64(str64, codes64, 1000U, ' '));
+    for (size_t i = 0; i < 1000U; i++)
+    {
+        char expected[64 + 1];
+        reference_binstr(expected, codes64[i], 64U);
+        atto_memeq(expected, &str64[i * 65U], 64U);
+        atto_eq((i == 999U) ? '\0' : ' ', str64[i * 65U + 64U]);
+        uint64_t parsed = 0;
+        atto_eq(GREY_OK,
+                grey_parse_binstr64(&str64[i * 65U], 64U, &parsed));
+        atto_eq(codes64[i], parsed);
+    }
+    grey_code_t codes[2] = {1U, 2U};
+    atto_eq(2U * GREY_UINTBITS + 1U,
+            grey_binstr_array(str64, codes, 2, ';'));
+}
+
+static void test_parse_binstr(void)
+{
+    uint8_t code8 = 42U;
+    atto_eq(GREY_ERR_INVALID, grey_parse_binstr8("", 0, &code8));
+    atto_eq(GREY_ERR_INVALID, grey_parse_binstr8("2", 1, &code8));
+    atto_eq(GREY_ERR_INVALID, grey_parse_binstr8("1 ", 2, &code8));
+    atto_eq(GREY_ERR_INVALID, grey_parse_binstr8("0b1", 3, &code8));
+    atto_eq(GREY_ERR_RANGE, grey_parse_binstr8("100000000", 9, &code8));
+    atto_eq(42U, code8);  // Untouched on failure
+    atto_eq(GREY_OK, grey_parse_binstr8("1110", 4, &code8));
+    atto_eq(0x0EU, code8);
+    atto_eq(GREY_OK, grey_parse_binstr8("11110000", 8, &code8));
+    atto_eq(0xF0U, code8);
+    /* Only the given length is parsed */
+    atto_eq(GREY_OK, grey_parse_binstr8("1110xyz", 4, &code8));
+    atto_eq(0x0EU, code8);
+    atto_eq(GREY_OK,
+            grey_parse_binstr8("0000000000000000000011", 22, &code8));
+    atto_eq(3U, code8);
+
+    /* A bad character in every position of chunks and leftovers */
+    char str[40 + 1];
+    for (size_t length = 1; length <= 40U; length++)
+    {
+        for (size_t bad = 0; bad < length; bad++)
+        {
+            memset(str, '0', length);
+            str[bad] = (bad % 2U) ? '/' : '2';
+            uint64_t code64 = 42U;
+            atto_eq(GREY_ERR_INVALID, grey_parse_binstr64(str, length,
+                                                          &code64));
+            str[bad] = (char) ('1' | 0x80);
+            atto_eq(GREY_ERR_INVALID, grey_parse_binstr64(str, length,
+                                                          &code64));
+            atto_eq(42U, code64);
+            str[bad] = '1';
+            atto_eq((length - bad > 64U) ? GREY_ERR_RANGE : GREY_OK,
+                    grey_parse_binstr64(str, length, &code64));
+            uint16_t code16 = 0;
+            atto_eq((length - bad > 16U) ? GREY_ERR_RANGE : GREY_OK,
+                    grey_parse_binstr16(str, length, &code16));
+        }
+    }
+
+    /* Round trips of every 16-bit code, both representations */
+    char fixed[16 + 1];
+    for (uint32_t i = 0; i <= UINT16_MAX; i++)
+    {
+        uint16_t code16 = 0;
+        grey_binstr_fixed16(fixed, (uint16_t) i);
+        atto_eq(GREY_OK, grey_parse_binstr16(fixed, 16U, &code16));
+        atto_eq(i, code16);
+        const uint8_t len = grey_binstr16(fixed, (uint16_t) i);
+        if (len > 0U)
+        {
+            code16 = 0;
+            atto_eq(GREY_OK, grey_parse_binstr16(fixed, len, &code16));
+            atto_eq(i, code16);
+        }
+    }
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (uint32_t i = 0; i < 10000U; i++)
+    {
+        const uint64_t random = test_next_pseudorandom(&state) >> (i % 64U);
+        char str64[64 + 1];
+        uint64_t code64 = 0;
+        uint32_t code32 = 0;
+        const uint8_t len = grey_binstr64(str64, random);
+        if (len > 0U)
+        {
+            atto_eq(GREY_OK, grey_parse_binstr64(str64, len, &code64));
+            atto_eq(random, code64);
+            atto_eq((len > 32U) ? GREY_ERR_RANGE : GREY_OK,
+                    grey_parse_binstr32(str64, len, &code32));
+        }
+        grey_code_t code = 0;
+        grey_binstr_fixed(str64, (grey_code_t) random);
+        atto_eq(GREY_OK, grey_parse_binstr(str64, GREY_UINTBITS, &code));
+        atto_eq((grey_code_t) random, code);
+    }
+#if defined(GREY_HAS_UINT128)
+    const grey_uint128_t value = ((grey_uint128_t) 0x8000000000000001ULL
+            << 64U) | 0xFEDCBA9876543210ULL;
+    char str128[128 + 1 + 1];
+    grey_uint128_t code128 = 0;
+    grey_binstr_fixed128(str128, value);
+    atto_eq(GREY_OK, grey_parse_binstr128(str128, 128U, &code128));
+    atto_assert(value == code128);
+    atto_eq(127U, grey_binstr128(str128, value >> 1U));
+    atto_eq(GREY_OK, grey_parse_binstr128(str128, 127U, &code128));
+    atto_assert((value >> 1U) == code128);
+    grey_binstr_fixed128(&str128[1], value);
+    str128[0] = '1';
+    atto_eq(GREY_ERR_RANGE, grey_parse_binstr128(str128, 129U, &code128));
+#endif
+}
+
+void test_binstr_formats(void)
+{
+    test_binstr_fixed();
+    test_binstr_array();
+    test_parse_binstr();
+}
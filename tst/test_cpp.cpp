@@ -0,0 +1,176 @@
+/**
+ * @file
+ * @brief Tests of the C++ front-end grey.hpp, in their own runner as the
+ * other tests are C.
+ *
+ * The `constexpr` functions are checked at compile time by the
+ * `static_assert`s, against the C library at runtime.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.hpp"
+#include "atto.h"
+#include <vector>
+
+static_assert(grey::width<std::uint8_t>::value == 8U, "");
+static_assert(grey::width<unsigned long long>::value == 64U, "");
+static_assert(grey::width<std::bitset<100>>::value == 100U, "");
+static_assert(!grey::is_code_type<int>::value, "");
+static_assert(!grey::is_code_type<bool>::value, "");
+static_assert(grey::to<std::uint8_t>(10U) == 15U, "");
+static_assert(grey::to<std::uint8_t>(255U) == 0x80U, "");
+static_assert(grey::from<std::uint8_t>(0x80U) == 255U, "");
+static_assert(grey::from(grey::to(UINT64_C(0x0123456789ABCDEF)))
+              == UINT64_C(0x0123456789ABCDEF), "");
+static_assert(grey::code<std::uint16_t>::of(10U).bits() == 15U, "");
+static_assert(grey::code<std::uint16_t>(15U).value() == 10U, "");
+static_assert(grey::code<std::uint16_t>::of(3U)
+              < grey::code<std::uint16_t>::of(4U), "");
+
+/** Folded into constants, with the first codes reflected. */
+constexpr auto codes8 = grey::table<std::uint8_t, 256U>();
+constexpr auto values8 = grey::inverse_table<std::uint8_t, 256U>();
+static_assert(codes8[255] == 0x80U, "");
+static_assert(values8[0x80] == 255U, "");
+
+/** Checks grey::to() and grey::from() of \p T against the C library. */
+template<typename T>
+static void test_cpp_width(T (* const to)(T), T (* const from)(T))
+{
+    std::uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (std::uint32_t i = 0; i < 1000U; i++)
+    {
+        state ^= state << 13U;
+        state ^= state >> 7U;
+        state ^= state << 17U;
+        const T value = static_cast<T>(state);
+        atto_eq(to(value), grey::to(value));
+        atto_eq(from(value), grey::from(value));
+    }
+}
+
+static void test_cpp_widths(void)
+{
+    test_cpp_width<std::uint8_t>(grey_to8, grey_from8);
+    test_cpp_width<std::uint16_t>(grey_to16, grey_from16);
+    test_cpp_width<std::uint32_t>(grey_to32, grey_from32);
+    test_cpp_width<std::uint64_t>(grey_to64, grey_from64);
+#if defined(GREY_HAS_UINT128)
+    const grey_uint128_t value = (static_cast<grey_uint128_t>(
+                                          UINT64_C(0xFEDCBA9876543210)) << 64U)
+                                 | UINT64_C(0x0123456789ABCDEF);
+    atto_assert(grey_to128(value) == grey::to(value));
+    atto_assert(grey_from128(value) == grey::from(value));
+    atto_assert(value == grey::from(grey::to(value)));
+#endif
+    for (std::uint32_t i = 0; i < 256U; i++)
+    {
+        atto_eq(grey_to8(static_cast<std::uint8_t>(i)), codes8[i]);
+        atto_eq(grey_from8(static_cast<std::uint8_t>(i)), values8[i]);
+    }
+}
+
+static void test_cpp_bitset(void)
+{
+    std::bitset<100> value;
+    value[99] = true;
+    value[70] = true;
+    value[3] = true;
+    const std::bitset<100> code = grey::to(value);
+    atto_assert(code[99] && code[98]);
+    atto_assert(code[70] && code[69]);
+    atto_assert(code[3] && code[2]);
+    atto_eq(6U, code.count());
+    atto_assert(value == grey::from(code));
+}
+
+static void test_cpp_code(void)
+{
+    grey::code<std::uint8_t> code;
+    atto_eq(0U, code.bits());
+    for (std::uint32_t i = 1; i < 256U; i++)
+    {
+        const grey::code<std::uint8_t> previous = code++;
+        atto_eq(grey_to8(static_cast<std::uint8_t>(i)), code.bits());
+        atto_eq(i, code.value());
+        atto_assert(previous < code);
+        atto_assert(previous != code);
+    }
+    ++code;
+    atto_assert(code == grey::code<std::uint8_t>());
+    --code;
+    atto_eq(0x80U, code.bits());
+    atto_assert(code-- == grey::code<std::uint8_t>::of(255U));
+    atto_eq(254U, code.value());
+}
+
+static void test_cpp_sequence(void)
+{
+    const grey::sequence_view<std::uint8_t> sequence(250U, 10U);
+    atto_eq(10U, sequence.size());
+    std::uint32_t value = 250U;
+    for (const std::uint8_t code : sequence)
+    {
+        atto_eq(grey_to8(static_cast<std::uint8_t>(value)), code);
+        value++;
+    }
+    atto_eq(260U, value);
+    atto_assert(grey::sequence_view<std::uint32_t>().begin()
+                == grey::sequence_view<std::uint32_t>().end());
+#if defined(GREY_HAS_RANGES)
+    static_assert(std::ranges::view<grey::sequence_view<std::uint32_t>>);
+    static_assert(
+            std::ranges::forward_range<grey::sequence_view<std::uint32_t>>);
+    std::uint32_t next = 2U;
+    for (const std::uint32_t code : grey::sequence_view<std::uint32_t>(0, 8)
+                                    | std::views::drop(2)
+                                    | std::views::take(3))
+    {
+        atto_eq(grey_to32(next), code);
+        next++;
+    }
+    atto_eq(5U, next);
+#endif
+}
+
+static void test_cpp_span(void)
+{
+#if defined(GREY_HAS_SPAN)
+    std::vector<std::uint32_t> values(1000U);
+    std::vector<std::uint32_t> codes(1001U, 42U);
+    for (std::uint32_t i = 0; i < values.size(); i++)
+    {
+        values[i] = i * 7919U;
+    }
+    atto_eq(1000U, grey::to(values, codes));
+    atto_eq(42U, codes[1000]);
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        atto_eq(grey_to32(values[i]), codes[i]);
+    }
+    std::vector<std::uint32_t> decoded(10U);
+    atto_eq(10U, grey::from(codes, decoded));
+    atto_eq(values[9], decoded[9]);
+    grey::from(codes);
+    atto_eq(values[999], codes[999]);
+    grey::to(codes);
+    atto_eq(grey_to32(values[999]), codes[999]);
+    std::uint8_t filled[4];
+    grey::fill(std::uint8_t{254U}, filled);
+    atto_eq(grey_to8(254U), filled[0]);
+    atto_eq(grey_to8(1U), filled[3]);
+#endif
+}
+
+int main(void)
+{
+    test_cpp_widths();
+    test_cpp_bitset();
+    test_cpp_code();
+    test_cpp_sequence();
+    test_cpp_span();
+    return atto_at_least_one_fail;
+}
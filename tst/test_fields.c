@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief Tests of the conversions of packed N-bit Grey codes, against a
+ * bit-by-bit reference.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+/** Enough fields to cross every word of the period of the masks, twice. */
+#define FIELDS_AMOUNT 150U
+#define FIELDS_BYTES (64U * FIELDS_AMOUNT / 8U)
+
+static bool get_bit(const uint8_t* const stream, const size_t position,
+                    const grey_field_order_t order)
+{
+    const unsigned int shift = (order == GREY_FIELDS_MSB_FIRST)
+                               ? 7U - position % 8U : position % 8U;
+    return (stream[position / 8U] >> shift) & 1U;
+}
+
+static void set_bit(uint8_t* const stream, const size_t position,
+                    const bool bit, const grey_field_order_t order)
+{
+    const unsigned int shift = (order == GREY_FIELDS_MSB_FIRST)
+                               ? 7U - position % 8U : position % 8U;
+    stream[position / 8U] = (uint8_t) ((stream[position / 8U]
+                                        & ~(1U << shift))
+                                       | ((unsigned int) bit << shift));
+}
+
+/** Field \p index of the stream, one bit at a time. */
+static uint64_t get_field(const uint8_t* const stream, const size_t index,
+                          const unsigned int bits,
+                          const grey_field_order_t order)
+{
+    uint64_t field = 0;
+    for (unsigned int i = 0; i < bits; i++)
+    {
+        const bool bit = get_bit(stream, index * bits + i, order);
+        if (order == GREY_FIELDS_MSB_FIRST)
+        {
+            field = (field << 1U) | bit;
+        }
+        else
+        {
+            field |= (uint64_t) bit << i;
+        }
+    }
+    return field;
+}
+
+static void set_field(uint8_t* const stream, const size_t index,
+                      const uint64_t field, const unsigned int bits,
+                      const grey_field_order_t order)
+{
+    for (unsigned int i = 0; i < bits; i++)
+    {
+        const unsigned int shift = (order == GREY_FIELDS_MSB_FIRST)
+                                   ? bits - 1U - i : i;
+        set_bit(stream, index * bits + i, (field >> shift) & 1U, order);
+    }
+}
+
+static void test_fields_bits(void)
+{
+    atto_eq(0x7U, grey_to_bits(0xF5U, 3U));
+    atto_eq(0x6U, grey_from_bits(0xF5U, 3U));
+    atto_eq(grey_to64(UINT64_MAX), grey_to_bits(UINT64_MAX, 64U));
+    atto_eq(grey_from64(UINT64_MAX), grey_from_bits(UINT64_MAX, 64U));
+    /* The neighbouring bits of a 12-bit field in a 16-bit register */
+    for (uint32_t value = 0; value < 4096U; value++)
+    {
+        const uint64_t code = grey_to_bits(value | 0xA000U, 12U);
+        atto_eq(grey_to16((uint16_t) value), code);
+        atto_eq(value, grey_from_bits(code | 0x5000U, 12U));
+    }
+}
+
+static void test_fields_invalid(void)
+{
+    uint8_t stream[8] = {0};
+    uint64_t values[1] = {0};
+    atto_eq(GREY_ERR_INVALID,
+            grey_fields_to(stream, stream, 0, 1U, GREY_FIELDS_MSB_FIRST));
+    atto_eq(GREY_ERR_INVALID,
+            grey_fields_from(stream, stream, 65U, 1U, GREY_FIELDS_MSB_FIRST));
+    atto_eq(GREY_ERR_INVALID,
+            grey_fields_unpack_from(stream, values, 12U, 1U,
+                                    (grey_field_order_t) 2));
+    atto_eq(GREY_ERR_INVALID,
+            grey_fields_pack_to(values, stream, 0, 1U,
+                                GREY_FIELDS_LSB_FIRST));
+    atto_eq(GREY_OK,
+            grey_fields_to(NULL, NULL, 12U, 0, GREY_FIELDS_LSB_FIRST));
+    atto_eq(GREY_OK,
+            grey_fields_pack_to(NULL, NULL, 12U, 0, GREY_FIELDS_MSB_FIRST));
+    atto_eq(3U, GREY_FIELDS_BYTES(12U, 2U));
+    atto_eq(2U, GREY_FIELDS_BYTES(5U, 3U));
+}
+
+/** Every width, order and amount of fields, up to a few words. */
+static void test_fields_widths(void)
+{
+    static uint8_t input[FIELDS_BYTES];
+    static uint8_t expected[FIELDS_BYTES + 1U];
+    static uint8_t output[FIELDS_BYTES + 1U];
+    static uint64_t values[FIELDS_AMOUNT];
+    static uint64_t codes[FIELDS_AMOUNT];
+    test_fill_pseudorandom(input, FIELDS_BYTES, 0x9E3779B97F4A7C15ULL);
+    for (unsigned int bits = 1U; bits <= 64U; bits++)
+    {
+        for (unsigned int o = 0; o < 2U; o++)
+        {
+            const grey_field_order_t order = (grey_field_order_t) o;
+            for (size_t amount = 0; amount <= FIELDS_AMOUNT;
+                 amount += 1U + amount / 8U)
+            {
+                const size_t bytes = GREY_FIELDS_BYTES(bits, amount);
+                /* The bits after the last field stay as they were */
+                memcpy(expected, input, bytes + 1U);
+                for (size_t i = 0; i < amount; i++)
+                {
+                    set_field(expected, i,
+                              grey_to64(get_field(input, i, bits, order)),
+                              bits, order);
+                }
+                memcpy(output, input, bytes + 1U);
+                atto_eq(GREY_OK, grey_fields_to(input, output, bits, amount,
+                                                order));
+                atto_memeq(expected, output, bytes + 1U);
+                atto_eq(GREY_OK, grey_fields_from(output, output, bits,
+                                                  amount, order));
+                atto_memeq(input, output, bytes + 1U);
+
+                for (size_t i = 0; i < amount; i++)
+                {
+                    set_field(expected, i,
+                              grey_from_bits(get_field(input, i, bits, order),
+                                             bits),
+                              bits, order);
+                }
+                memcpy(output, input, bytes + 1U);
+                atto_eq(GREY_OK, grey_fields_from(output, output, bits,
+                                                  amount, order));
+                atto_memeq(expected, output, bytes + 1U);
+
+                /* Unpacked, with garbage above the width when packing */
+                atto_eq(GREY_OK, grey_fields_unpack_from(input, values, bits,
+                                                         amount, order));
+                for (size_t i = 0; i < amount; i++)
+                {
+                    atto_eq(get_field(expected, i, bits, order), values[i]);
+                    codes[i] = values[i] | (bits < 64U ? ~0ULL << bits : 0U);
+                }
+                memcpy(output, expected, bytes + 1U);
+                atto_eq(GREY_OK, grey_fields_pack_to(codes, output, bits,
+                                                     amount, order));
+                atto_memeq(input, output, bytes);
+                atto_eq(expected[bytes], output[bytes]);
+            }
+        }
+    }
+}
+
+void test_fields(void)
+{
+    test_fields_bits();
+    test_fields_invalid();
+    test_fields_widths();
+}
@@ -0,0 +1,218 @@
+/**
+ * @file
+ * @brief Tests of the Hamming distances and of the Hamming ball iterator.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+/** Longer than a tile of grey_distances_many() of any width. */
+#define HAMMING_CODES 17000U
+#define HAMMING_QUERIES 3U
+
+static uint64_t codes[HAMMING_CODES];
+static uint8_t distances[HAMMING_QUERIES * HAMMING_CODES];
+
+static void test_distance_single(void)
+{
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    atto_eq(0U, grey_inline_popcount64(0U));
+    atto_eq(64U, grey_inline_popcount64(UINT64_MAX));
+    atto_eq(GREY_UINTBITS, grey_distance(0U, GREY_MAX));
+    for (uint32_t i = 0; i < 1000U; i++)
+    {
+        const grey_int_t value = (grey_int_t) test_next_pseudorandom(&state);
+        const grey_code_t code = grey_inline_to(value);
+        atto_eq(0U, grey_distance(code, code));
+        atto_eq(1U, grey_distance(code,
+                                  grey_inline_to((grey_int_t) (value + 1U))));
+        uint_fast8_t bits = 0;
+        for (uint64_t x = code; x != 0U; x &= x - 1U)
+        {
+            bits++;
+        }
+        atto_eq(bits, grey_distance(code, 0U));
+    }
+}
+
+/**
+ * Checks the distances of one width against grey_inline_popcount64(), on
+ * all lengths up to a few vectors, then many-to-many on several tiles.
+ */
+#define TEST_DISTANCES_WIDTH_DEFINE(bits, type) \
+    static void test_distances##bits(uint64_t state) \
+    { \
+        type* const typed = (type*) codes; \
+        for (size_t i = 0; i < HAMMING_CODES; i++) \
+        { \
+            typed[i] = (type) test_next_pseudorandom(&state); \
+        } \
+        typed[0] = 0; \
+        typed[1] = (type) ~(type) 0; \
+        const type query = (type) test_next_pseudorandom(&state); \
+        for (size_t amount = 0; amount <= 300U; amount++) \
+        { \
+            memset(distances, 0xFF, amount + 1U); \
+            grey_distances##bits(query, typed, distances, amount); \
+            for (size_t i = 0; i < amount; i++) \
+            { \
+                atto_eq(grey_inline_popcount64( \
+                                (uint64_t) (typed[i] ^ query)), \
+                        distances[i]); \
+            } \
+            atto_eq(0xFFU, distances[amount]); \
+        } \
+        const type* const queries = &typed[HAMMING_CODES - HAMMING_QUERIES]; \
+        grey_distances_many##bits(queries, HAMMING_QUERIES, typed, \
+                                  HAMMING_CODES, distances); \
+        for (size_t q = 0; q < HAMMING_QUERIES; q++) \
+        { \
+            for (size_t i = 0; i < HAMMING_CODES; i++) \
+            { \
+                atto_eq(grey_inline_popcount64( \
+                                (uint64_t) (typed[i] ^ queries[q])), \
+                        distances[q * HAMMING_CODES + i]); \
+            } \
+        } \
+    }
+
+TEST_DISTANCES_WIDTH_DEFINE(8, uint8_t)
+TEST_DISTANCES_WIDTH_DEFINE(16, uint16_t)
+TEST_DISTANCES_WIDTH_DEFINE(32, uint32_t)
+TEST_DISTANCES_WIDTH_DEFINE(64, uint64_t)
+
+/** The generic functions run the kernels of #GREY_UINTBITS. */
+static void test_distances_generic(void)
+{
+    grey_code_t* const typed = (grey_code_t*) codes;
+    uint8_t expected[HAMMING_QUERIES * 100U];
+    grey_distances_many(typed, HAMMING_QUERIES, typed, 100U, distances);
+    for (size_t q = 0; q < HAMMING_QUERIES; q++)
+    {
+        grey_distances(typed[q], typed, &expected[q * 100U], 100U);
+        for (size_t i = 0; i < 100U; i++)
+        {
+            atto_eq(grey_distance(typed[q], typed[i]), expected[q * 100U + i]);
+        }
+    }
+    atto_memeq(expected, distances, sizeof(expected));
+}
+
+static void test_distances_kernels(void)
+{
+    for (grey_kernel_t kernel = GREY_KERNEL_SCALAR;
+         kernel <= GREY_KERNEL_LUT; kernel++)
+    {
+        if (grey_kernel_force(kernel) != GREY_OK)
+        {
+            continue;
+        }
+        test_distances8(0x9E3779B97F4A7C15ULL + kernel);
+        test_distances16(0xBF58476D1CE4E5B9ULL + kernel);
+        test_distances32(0x94D049BB133111EBULL + kernel);
+        test_distances64(0xD6E8FEB86659FD93ULL + kernel);
+        test_distances_generic();
+    }
+    atto_eq(GREY_OK, grey_kernel_force(GREY_KERNEL_AUTO));
+}
+
+/** Number of codes at distance up to \p radius. */
+static uint64_t ball_size(const unsigned int radius)
+{
+    uint64_t size = 0;
+    uint64_t binomial = 1;  // C(GREY_UINTBITS, distance)
+    for (unsigned int distance = 0; distance <= radius; distance++)
+    {
+        size += binomial;
+        binomial = binomial * (GREY_UINTBITS - distance) / (distance + 1U);
+    }
+    return size;
+}
+
+/** The codes come once each, by increasing distance. */
+static void test_ball(const grey_code_t center, const unsigned int radius)
+{
+    static grey_code_t seen[4000];
+    grey_ball_iter_t iter;
+    atto_eq(GREY_OK, grey_ball_iter_init(&iter, center, radius));
+    size_t amount = 0;
+    grey_code_t code;
+    uint_fast8_t last = 0;
+    while (grey_ball_iter_next(&iter, &code))
+    {
+        atto_lt(amount, 4000U);
+        const uint_fast8_t distance = grey_distance(center, code);
+        atto_assert(distance <= radius);
+        atto_assert(distance >= last);
+        last = distance;
+        for (size_t i = 0; i < amount; i++)
+        {
+            atto_neq(seen[i], code);
+        }
+        seen[amount++] = code;
+    }
+    atto_eq(ball_size(radius), amount);
+    atto_eq(center, seen[0]);
+    atto_false(grey_ball_iter_next(&iter, &code));
+
+    /* Filling in parts gives the same codes */
+    grey_code_t filled[4000];
+    atto_eq(GREY_OK, grey_ball_iter_init(&iter, center, radius));
+    size_t done = 0;
+    size_t written;
+    do
+    {
+        written = grey_ball_iter_fill(&iter, &filled[done], 7U);
+        done += written;
+    } while (written == 7U);
+    atto_eq(amount, done);
+    atto_memeq(seen, filled, amount * sizeof(grey_code_t));
+}
+
+/** The whole space, which is small only for 8 bits. */
+static void test_ball_whole(void)
+{
+    grey_ball_iter_t iter;
+    grey_code_t code;
+    atto_eq(GREY_ERR_INVALID,
+            grey_ball_iter_init(&iter, 0U, GREY_UINTBITS + 1U));
+    atto_eq(GREY_OK, grey_ball_iter_init(&iter, 0U, GREY_UINTBITS));
+    if (GREY_UINTBITS == 8U)
+    {
+        bool seen[256] = {false};
+        for (uint32_t i = 0; i < 256U; i++)
+        {
+            atto_assert(grey_ball_iter_next(&iter, &code));
+            atto_false(seen[code & 0xFFU]);
+            seen[code & 0xFFU] = true;
+        }
+        atto_false(grey_ball_iter_next(&iter, &code));
+    }
+    else
+    {
+        /* The center, then the lowest bit flipped */
+        atto_assert(grey_ball_iter_next(&iter, &code));
+        atto_eq(0U, code);
+        atto_assert(grey_ball_iter_next(&iter, &code));
+        atto_eq(1U, code);
+    }
+}
+
+void test_hamming(void)
+{
+    test_distance_single();
+    test_distances_kernels();
+    test_ball(0U, 0U);
+    test_ball(grey_inline_to(123U), 1U);
+    test_ball(GREY_MAX, 2U);
+#if (GREY_UINTBITS <= 16)
+    test_ball(grey_inline_to(42U), 3U);
+#endif
+    test_ball_whole();
+}
@@ -0,0 +1,31 @@
+/**
+ * @file
+ * @brief Tests of the #GREY_HEADER_ONLY mode, compiled with it enabled.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#define GREY_HEADER_ONLY
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+
+void test_header_only(void)
+{
+    atto_eq(15, grey_to(10));
+    atto_eq(0x80, grey_to(255));
+    atto_eq(10, grey_from(15));
+    atto_eq(255, grey_from(0x80));
+    atto_eq(GREY_MAX, grey_from(grey_to(GREY_MAX)));
+    for (uint32_t i = 0; i < 1000U; i++)
+    {
+        const grey_int_t value = (grey_int_t) i;
+        atto_eq(value, grey_from(grey_to(value)));
+        atto_eq(grey_to((grey_int_t) (value + 1U)), grey_incr(grey_to(value)));
+    }
+    atto_eq(0, grey_incr(grey_to(GREY_MAX)));
+    atto_eq(grey_to(GREY_MAX), grey_decr(0));
+    atto_eq(grey_to(10), grey_add(grey_to(15), -5));
+}
@@ -0,0 +1,257 @@
+/**
+ * @file
+ * @brief Tests of the Hilbert curve indices: every point of small curves
+ * exactly once with unit steps, and all variants agreeing on large ones.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define HILBERT_RANDOM 5000U
+#define HILBERT_DIMS 5U
+
+/** Whether the points differ by 1 in exactly one coordinate. */
+static bool unit_step(const uint32_t* const a, const uint32_t* const b,
+                      const size_t dims)
+{
+    uint32_t distance = 0;
+    for (size_t i = 0; i < dims; i++)
+    {
+        distance += (a[i] > b[i]) ? a[i] - b[i] : b[i] - a[i];
+    }
+    return distance == 1U;
+}
+
+static void test_hilbert_known(void)
+{
+    /* The 4x4 curve, starting at the origin and ending at (3, 0) */
+    static const uint32_t expected[16][2] = {
+            {0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 2}, {0, 3}, {1, 3}, {1, 2},
+            {2, 2}, {2, 3}, {3, 3}, {3, 2}, {3, 1}, {2, 1}, {2, 0}, {3, 0},
+    };
+    for (uint32_t i = 0; i < 16U; i++)
+    {
+        uint32_t x;
+        uint32_t y;
+        grey_hilbert_coords2(i, 2U, &x, &y);
+        atto_eq(expected[i][0], x);
+        atto_eq(expected[i][1], y);
+        atto_eq(i, grey_hilbert_index2(expected[i][0], expected[i][1], 2U));
+    }
+    /* The bits above the width are ignored */
+    atto_eq(grey_hilbert_index2(3U, 1U, 2U),
+            grey_hilbert_index2(0xFFU, 0x11U, 2U));
+    atto_eq(grey_hilbert_index3(1U, 0, 1U, 1U),
+            grey_hilbert_index3(0xFFU, 0x10U, 0xFFFFFFFFU, 1U));
+    atto_eq(0U, grey_hilbert_index2(0, 0, GREY_HILBERT_MAX_BITS2));
+    atto_eq(0U, grey_hilbert_index3(UINT32_MAX, UINT32_MAX, UINT32_MAX,
+                                    GREY_HILBERT_MAX_BITS3) >> 63U);
+}
+
+static void test_hilbert_invalid(void)
+{
+    uint32_t coords[2] = {0};
+    uint64_t index[1] = {0};
+    atto_eq(GREY_ERR_INVALID, grey_hilbert_index(coords, 0, 4U, index));
+    atto_eq(GREY_ERR_INVALID, grey_hilbert_index(coords, 2U, 0, index));
+    atto_eq(GREY_ERR_INVALID, grey_hilbert_coords(index, 2U, 33U, coords));
+    atto_eq(GREY_ERR_INVALID,
+            grey_hilbert_index2_array(coords, coords, index, 1U, 33U));
+    atto_eq(GREY_ERR_INVALID,
+            grey_hilbert_coords3_array(index, coords, coords, coords, 1U,
+                                       22U));
+    atto_eq(GREY_OK, grey_hilbert_index3_array(NULL, NULL, NULL, NULL, 0,
+                                               GREY_HILBERT_MAX_BITS3));
+}
+
+/**
+ * Walks the whole curve of \p dims dimensions and \p bits bits, checking
+ * that it visits each point once, one unit step at a time, and that the
+ * other variants agree.
+ */
+static void test_hilbert_walk(const size_t dims, const unsigned int bits)
+{
+    const size_t points = (size_t) 1U << (dims * bits);
+    bool* const visited = calloc(points, sizeof(bool));
+    atto_assert(visited != NULL);
+    uint32_t previous[HILBERT_DIMS] = {0};
+    uint32_t coords[HILBERT_DIMS];
+    for (uint64_t i = 0; i < points; i++)
+    {
+        uint64_t index = i;
+        atto_eq(GREY_OK, grey_hilbert_coords(&index, dims, bits, coords));
+        size_t point = 0;
+        for (size_t d = 0; d < dims; d++)
+        {
+            atto_lt(coords[d], 1U << bits);
+            point = (point << bits) | coords[d];
+        }
+        atto_false(visited[point]);
+        visited[point] = true;
+        atto_assert(i == 0 ? point == 0 : unit_step(previous, coords, dims));
+        index = 42U;
+        atto_eq(GREY_OK, grey_hilbert_index(coords, dims, bits, &index));
+        atto_eq(i, index);
+        uint32_t x;
+        uint32_t y;
+        uint32_t z;
+        if (dims == 2U)
+        {
+            atto_eq(i, grey_hilbert_index2(coords[0], coords[1], bits));
+            grey_hilbert_coords2(i, bits, &x, &y);
+            atto_eq(coords[0], x);
+            atto_eq(coords[1], y);
+        }
+        else if (dims == 3U)
+        {
+            atto_eq(i, grey_hilbert_index3(coords[0], coords[1], coords[2],
+                                           bits));
+            grey_hilbert_coords3(i, bits, &x, &y, &z);
+            atto_eq(coords[0], x);
+            atto_eq(coords[1], y);
+            atto_eq(coords[2], z);
+        }
+        memcpy(previous, coords, sizeof(previous));
+    }
+    /* Ends at the highest value of the first coordinate */
+    atto_eq((1U << bits) - 1U, previous[0]);
+    for (size_t d = 1; d < dims; d++)
+    {
+        atto_eq(0U, previous[d]);
+    }
+    free(visited);
+}
+
+/** Random points of all widths, the arrays in uneven lengths. */
+static void test_hilbert_random(void)
+{
+    static uint32_t x[HILBERT_RANDOM];
+    static uint32_t y[HILBERT_RANDOM];
+    static uint32_t z[HILBERT_RANDOM];
+    static uint32_t decoded[3][HILBERT_RANDOM];
+    static uint64_t indices[HILBERT_RANDOM + 1U];
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < HILBERT_RANDOM; i++)
+    {
+        const uint64_t random = test_next_pseudorandom(&state);
+        x[i] = (uint32_t) random;
+        y[i] = (uint32_t) (random >> 32U);
+        z[i] = (uint32_t) test_next_pseudorandom(&state);
+    }
+    for (unsigned int bits = 1U; bits <= GREY_HILBERT_MAX_BITS2; bits++)
+    {
+        const size_t amount = HILBERT_RANDOM - bits;
+        const uint32_t mask = UINT32_MAX >> (32U - bits);
+        indices[amount] = 42U;
+        atto_eq(GREY_OK, grey_hilbert_index2_array(x, y, indices, amount,
+                                                   bits));
+        atto_eq(42U, indices[amount]);
+        atto_eq(GREY_OK, grey_hilbert_coords2_array(
+                indices, decoded[0], decoded[1], amount, bits));
+        for (size_t i = 0; i < amount; i++)
+        {
+            const uint32_t coords[2] = {x[i], y[i]};
+            uint64_t index;
+            atto_eq(GREY_OK, grey_hilbert_index(coords, 2U, bits, &index));
+            atto_eq(index, indices[i]);
+            atto_eq(index, grey_hilbert_index2(x[i], y[i], bits));
+            atto_eq(x[i] & mask, decoded[0][i]);
+            atto_eq(y[i] & mask, decoded[1][i]);
+        }
+        if (bits > GREY_HILBERT_MAX_BITS3)
+        {
+            continue;
+        }
+        atto_eq(GREY_OK, grey_hilbert_index3_array(x, y, z, indices, amount,
+                                                   bits));
+        atto_eq(GREY_OK, grey_hilbert_coords3_array(
+                indices, decoded[0], decoded[1], decoded[2], amount, bits));
+        for (size_t i = 0; i < amount; i++)
+        {
+            const uint32_t coords[3] = {x[i], y[i], z[i]};
+            uint64_t index;
+            atto_eq(GREY_OK, grey_hilbert_index(coords, 3U, bits, &index));
+            atto_eq(index, indices[i]);
+            atto_eq(index, grey_hilbert_index3(x[i], y[i], z[i], bits));
+            uint32_t point[3];
+            grey_hilbert_coords3(index, bits, &point[0], &point[1],
+                                 &point[2]);
+            atto_eq(x[i] & mask, decoded[0][i]);
+            atto_eq(y[i] & mask, decoded[1][i]);
+            atto_eq(z[i] & mask, decoded[2][i]);
+            atto_eq(x[i] & mask, point[0]);
+            atto_eq(y[i] & mask, point[1]);
+            atto_eq(z[i] & mask, point[2]);
+        }
+    }
+}
+
+/** Indices wider than 64 bits, on the heap beyond 64 dimensions. */
+static void test_hilbert_wide(void)
+{
+    static uint32_t coords[100];
+    static uint32_t decoded[100];
+    static uint64_t index[GREY_WORDS(100U * 32U) + 1U];
+    uint64_t state = 0xDA3E39CB94B95BDBULL;
+    for (size_t dims = 1; dims <= 100U; dims += 33U)
+    {
+        for (unsigned int bits = 1U; bits <= 32U; bits += 7U)
+        {
+            for (size_t i = 0; i < dims; i++)
+            {
+                coords[i] = (uint32_t) test_next_pseudorandom(&state)
+                            & (UINT32_MAX >> (32U - bits));
+            }
+            index[GREY_WORDS(dims * bits)] = 42U;
+            atto_eq(GREY_OK, grey_hilbert_index(coords, dims, bits, index));
+            atto_eq(42U, index[GREY_WORDS(dims * bits)]);
+            if ((dims * bits) % 64U != 0U)
+            {
+                atto_eq(0U, index[GREY_WORDS(dims * bits) - 1U]
+                            >> ((dims * bits) % 64U));
+            }
+            atto_eq(GREY_OK, grey_hilbert_coords(index, dims, bits,
+                                                 decoded));
+            atto_memeq(coords, decoded, dims * sizeof(uint32_t));
+        }
+    }
+    /* In 1-D the curve is the line itself */
+    coords[0] = 12345U;
+    atto_eq(GREY_OK, grey_hilbert_index(coords, 1U, 14U, index));
+    atto_eq(12345U, index[0]);
+}
+
+void test_hilbert(void)
+{
+    test_hilbert_known();
+    test_hilbert_invalid();
+    for (unsigned int bits = 1U; bits <= 6U; bits++)
+    {
+        test_hilbert_walk(1U, bits);
+        test_hilbert_walk(2U, bits);
+    }
+    for (unsigned int bits = 1U; bits <= 4U; bits++)
+    {
+        test_hilbert_walk(3U, bits);
+    }
+    test_hilbert_walk(4U, 3U);
+    test_hilbert_walk(HILBERT_DIMS, 2U);
+    /* The arrays have a kernel for each instruction set */
+    for (grey_kernel_t kernel = GREY_KERNEL_SCALAR;
+         kernel <= GREY_KERNEL_LUT; kernel++)
+    {
+        if (grey_kernel_force(kernel) == GREY_OK)
+        {
+            test_hilbert_random();
+        }
+    }
+    atto_eq(GREY_OK, grey_kernel_force(GREY_KERNEL_AUTO));
+    test_hilbert_wide();
+}
@@ -0,0 +1,206 @@
+/**
+ * @file
+ * @brief Tests of the conversions of packed integers of any byte order,
+ * in buffers and in files, against a byte-by-byte reference.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <stdio.h>
+#include <string.h>
+
+/** Crosses a few blocks of swapped integers, plus a partial one. */
+#define PACKED_BYTES (3U * 4096U + 8U * 13U)
+#define PACKED_INPUT "test_grey_packed_input.bin"
+#define PACKED_OUTPUT "test_grey_packed_output.bin"
+
+static bool host_is_big(void)
+{
+    const uint16_t one = 1U;
+    return *(const uint8_t*) &one == 0U;
+}
+
+static bool order_is_big(const grey_byte_order_t order)
+{
+    return (order == GREY_ORDER_NATIVE) ? host_is_big()
+                                        : order == GREY_ORDER_BIG;
+}
+
+/** Reads the integer of \p size bytes at \p bytes in the given order. */
+static uint64_t load(const uint8_t* const bytes, const size_t size,
+                     const bool big)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        value = (value << 8U) | bytes[big ? i : size - 1U - i];
+    }
+    return value;
+}
+
+static void store(uint8_t* const bytes, uint64_t value, const size_t size,
+                  const bool big)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        bytes[big ? size - 1U - i : i] = (uint8_t) value;
+        value >>= 8U;
+    }
+}
+
+/** The conversion of \p input as grey_packed_convert() should do it. */
+static void reference(const uint8_t* const input, uint8_t* const output,
+                      const size_t bytes,
+                      const grey_packed_config_t* const config)
+{
+    const size_t size = config->bits / 8U;
+    for (size_t i = 0; i < bytes; i += size)
+    {
+        const uint64_t value = load(&input[i], size,
+                                    order_is_big(config->input_order));
+        store(&output[i], config->decode ? grey_from64(value)
+                                         : grey_to64(value),
+              size, order_is_big(config->output_order));
+    }
+}
+
+static void test_packed_invalid(void)
+{
+    uint64_t buffer[2] = {0};
+    grey_packed_config_t config = {
+            .bits = 12U,
+            .decode = false,
+            .input_order = GREY_ORDER_NATIVE,
+            .output_order = GREY_ORDER_NATIVE,
+    };
+    atto_eq(GREY_ERR_INVALID,
+            grey_packed_convert(buffer, buffer, sizeof(buffer), &config));
+    config.bits = 32U;
+    atto_eq(GREY_ERR_INVALID, grey_packed_convert(buffer, buffer, 6U,
+                                                  &config));
+    config.output_order = (grey_byte_order_t) 3;
+    atto_eq(GREY_ERR_INVALID,
+            grey_packed_convert(buffer, buffer, sizeof(buffer), &config));
+    atto_eq(0U, buffer[0]);
+}
+
+/** Every width, direction and pair of byte orders, both in place and not. */
+static void test_packed_buffers(void)
+{
+    static uint64_t input[PACKED_BYTES / 8U];
+    static uint64_t output[PACKED_BYTES / 8U + 1U];
+    static uint8_t expected[PACKED_BYTES];
+    test_fill_pseudorandom(input, PACKED_BYTES, 0x2545F4914F6CDD1DULL);
+    for (unsigned int bits = 8U; bits <= 64U; bits *= 2U)
+    {
+        for (unsigned int combination = 0; combination < 18U; combination++)
+        {
+            const grey_packed_config_t config = {
+                    .bits = bits,
+                    .decode = combination % 2U,
+                    .input_order = (grey_byte_order_t) (combination / 6U),
+                    .output_order = (grey_byte_order_t) (combination / 2U
+                                                         % 3U),
+            };
+            reference((const uint8_t*) input, expected, PACKED_BYTES,
+                      &config);
+            output[PACKED_BYTES / 8U] = 42U;  // Canary after the end
+            atto_eq(GREY_OK, grey_packed_convert(input, output,
+                                                 PACKED_BYTES, &config));
+            atto_memeq(expected, output, PACKED_BYTES);
+            memcpy(output, input, PACKED_BYTES);
+            atto_eq(GREY_OK, grey_packed_convert(output, output,
+                                                 PACKED_BYTES, &config));
+            atto_memeq(expected, output, PACKED_BYTES);
+            atto_eq(42U, output[PACKED_BYTES / 8U]);
+        }
+    }
+}
+
+static void test_packed_files(void)
+{
+    static uint8_t input[PACKED_BYTES];
+    static uint8_t expected[PACKED_BYTES];
+    static uint8_t output[PACKED_BYTES];
+    const grey_packed_config_t config = {
+            .bits = 32U,
+            .decode = true,
+            .input_order = GREY_ORDER_BIG,
+            .output_order = GREY_ORDER_LITTLE,
+    };
+    atto_eq(GREY_ERR_IO, grey_packed_convert_file(
+            "test_grey_packed_missing.bin", NULL, &config));
+    test_fill_pseudorandom(input, PACKED_BYTES, 0x2545F4914F6CDD1DULL);
+    FILE* file = fopen(PACKED_INPUT, "wb");
+    atto_assert(file != NULL);
+    atto_eq(PACKED_BYTES, fwrite(input, 1, PACKED_BYTES, file));
+    fclose(file);
+    const grey_err_t err = grey_packed_convert_file(PACKED_INPUT,
+                                                    PACKED_OUTPUT, &config);
+    if (err == GREY_ERR_UNSUPPORTED)
+    {
+        remove(PACKED_INPUT);
+        return;
+    }
+    atto_eq(GREY_OK, err);
+    reference(input, expected, PACKED_BYTES, &config);
+    file = fopen(PACKED_OUTPUT, "rb");
+    atto_assert(file != NULL);
+    atto_eq(PACKED_BYTES, fread(output, 1, PACKED_BYTES + 1U, file));
+    fclose(file);
+    atto_memeq(expected, output, PACKED_BYTES);
+
+    /* In place, also when the output is the same file */
+    atto_eq(GREY_OK, grey_packed_convert_file(PACKED_INPUT, NULL, &config));
+    atto_eq(GREY_OK, grey_packed_convert_file(PACKED_OUTPUT, PACKED_OUTPUT,
+                                              &config));
+    reference(expected, output, PACKED_BYTES, &config);
+    file = fopen(PACKED_OUTPUT, "rb");
+    atto_assert(file != NULL);
+    atto_eq(PACKED_BYTES, fread(expected, 1, PACKED_BYTES + 1U, file));
+    fclose(file);
+    atto_memeq(output, expected, PACKED_BYTES);
+    file = fopen(PACKED_INPUT, "rb");
+    atto_assert(file != NULL);
+    atto_eq(PACKED_BYTES, fread(output, 1, PACKED_BYTES, file));
+    fclose(file);
+    reference(input, expected, PACKED_BYTES, &config);
+    atto_memeq(expected, output, PACKED_BYTES);
+
+    /* A size not multiple of the width leaves the output untouched */
+    file = fopen(PACKED_INPUT, "ab");
+    atto_assert(file != NULL);
+    atto_eq(1U, fwrite(input, 1, 1, file));
+    fclose(file);
+    atto_eq(GREY_ERR_INVALID, grey_packed_convert_file(
+            PACKED_INPUT, PACKED_OUTPUT, &config));
+    remove(PACKED_INPUT);
+    remove(PACKED_OUTPUT);
+}
+
+void test_packed(void)
+{
+    grey_parallel_config_t defaults;
+    grey_parallel_config_get(&defaults);
+    test_packed_invalid();
+    test_packed_buffers();
+    test_packed_files();
+#if !defined(GREY_NO_THREADS)
+    /* Again across threads, in chunks not multiple of the blocks */
+    const grey_parallel_config_t config = {
+            .threads = 3U,
+            .cutoff = 0,
+            .chunk = 1000U,
+    };
+    atto_eq(GREY_OK, grey_parallel_config_set(&config));
+    test_packed_buffers();
+    test_packed_files();
+    grey_parallel_shutdown();
+    atto_eq(GREY_OK, grey_parallel_config_set(&defaults));
+#endif
+}
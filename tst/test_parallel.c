@@ -0,0 +1,123 @@
+/**
+ * @file
+ * @brief Tests of the multi-threaded bulk conversions, against the
+ * single-threaded ones.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+#define PARALLEL_LEN 100003U
+
+static void test_parallel_config(void)
+{
+    grey_parallel_config_t config;
+    grey_parallel_config_get(&config);
+    atto_eq(0, config.threads);
+    atto_eq(4U * 1024U * 1024U, config.cutoff);
+    atto_eq(64U * 1024U, config.chunk);
+    grey_parallel_config_t wrong = config;
+    wrong.chunk = 0;
+    atto_eq(GREY_ERR_INVALID, grey_parallel_config_set(&wrong));
+    wrong.chunk = 1;
+    wrong.threads = GREY_PARALLEL_MAX_THREADS + 1U;
+    atto_eq(GREY_ERR_INVALID, grey_parallel_config_set(&wrong));
+    grey_parallel_config_t unchanged;
+    grey_parallel_config_get(&unchanged);
+    atto_memeq(&config, &unchanged, sizeof(config));
+}
+
+/**
+ * Compares every width against the single-threaded conversions, with
+ * \p threads threads and chunks of \p chunk bytes, on arrays from below
+ * one chunk to many uneven ones.
+ */
+static void test_parallel_threads(const size_t threads, const size_t chunk)
+{
+    static uint64_t input[PARALLEL_LEN];
+    static uint64_t expected[PARALLEL_LEN];
+    static uint64_t output[PARALLEL_LEN + 1U];
+    const grey_parallel_config_t config = {
+            .threads = threads,
+            .cutoff = 0,
+            .chunk = chunk,
+    };
+#if defined(GREY_NO_THREADS)
+    if (threads > 1U)
+    {
+        atto_eq(GREY_ERR_UNSUPPORTED, grey_parallel_config_set(&config));
+        return;
+    }
+#endif
+    atto_eq(GREY_OK, grey_parallel_config_set(&config));
+    test_fill_pseudorandom(input, PARALLEL_LEN * sizeof(uint64_t),
+                           0x2545F4914F6CDD1DULL);
+    for (size_t amount = 0; amount <= PARALLEL_LEN;
+         amount = amount * 7U + 1U)
+    {
+        const size_t bytes = amount * sizeof(uint64_t);
+        output[amount] = 42U;  // Canary after the last element
+        grey_to_array_parallel64(input, output, amount);
+        grey_to_array64(input, expected, amount);
+        atto_memeq(expected, output, bytes);
+        grey_from_array_parallel64(input, output, amount);
+        grey_from_array64(input, expected, amount);
+        atto_memeq(expected, output, bytes);
+        /* In place */
+        grey_to_array_parallel64(output, output, amount);
+        atto_memeq(input, output, bytes);
+        atto_eq(42U, output[amount]);
+
+        grey_to_array_parallel32((const uint32_t*) input,
+                                 (uint32_t*) output, amount);
+        grey_to_array32((const uint32_t*) input, (uint32_t*) expected,
+                        amount);
+        atto_memeq(expected, output, amount * sizeof(uint32_t));
+        grey_from_array_parallel16((const uint16_t*) input,
+                                   (uint16_t*) output, amount);
+        grey_from_array16((const uint16_t*) input, (uint16_t*) expected,
+                          amount);
+        atto_memeq(expected, output, amount * sizeof(uint16_t));
+        grey_from_array_parallel8((const uint8_t*) input,
+                                  (uint8_t*) output, amount);
+        grey_from_array8((const uint8_t*) input, (uint8_t*) expected,
+                         amount);
+        atto_memeq(expected, output, amount);
+        grey_from_array_parallel((const grey_code_t*) input,
+                                 (grey_int_t*) output, amount);
+        grey_from_array((const grey_code_t*) input, (grey_int_t*) expected,
+                        amount);
+        atto_memeq(expected, output, amount * sizeof(grey_code_t));
+
+        memset(output, 0xFF, bytes);
+        grey_parallel_first_touch(output, bytes);
+        memset(expected, 0, bytes);
+        atto_memeq(expected, output, bytes);
+        atto_eq(42U, output[amount]);
+    }
+}
+
+void test_parallel(void)
+{
+    grey_parallel_config_t defaults;
+    grey_parallel_config_get(&defaults);
+    test_parallel_config();
+    test_parallel_threads(1, 64);
+    test_parallel_threads(2, 1);
+    test_parallel_threads(3, 64);
+    test_parallel_threads(4, 4096);
+    test_parallel_threads(7, 1000);
+    /* Fewer threads than before restart the pool */
+    test_parallel_threads(2, 64);
+    grey_parallel_shutdown();
+    /* Started again by the next call */
+    test_parallel_threads(3, 512);
+    grey_parallel_shutdown();
+    atto_eq(GREY_OK, grey_parallel_config_set(&defaults));
+}
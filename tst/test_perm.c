@@ -0,0 +1,247 @@
+/**
+ * @file
+ * @brief Tests of the plain changes Grey code of the permutations and of
+ * the positioning of the mixed-radix iterator it steps with.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+/** Largest permutations that are all enumerated. */
+#define PERM_MAX_LENGTH 8U
+
+/**
+ * Steps through all the codes of some radices, checking that a seek to
+ * each one leaves the same iterator as the steps did.
+ */
+static void test_perm_radix_seek_all(const uint32_t* const radices,
+                                     const size_t length)
+{
+    grey_radix_iter_t iter;
+    grey_radix_iter_t seek;
+    atto_eq(GREY_OK, grey_radix_iter_init(&iter, radices, length));
+    atto_eq(GREY_OK, grey_radix_iter_init(&seek, radices, length));
+    uint64_t value = 0;
+    do
+    {
+        atto_eq(GREY_OK, grey_radix_iter_seek(&seek, value));
+        atto_memeq(iter.digits, seek.digits, length * sizeof(uint32_t));
+        atto_memeq(iter.down, seek.down, length * sizeof(bool));
+        atto_memeq(iter.focus, seek.focus, length + 1U);
+        atto_eq(length, seek.changed);
+        value++;
+    } while (grey_radix_iter_next(&iter));
+    atto_eq(GREY_ERR_RANGE, grey_radix_iter_seek(&seek, value));
+    atto_memeq(iter.digits, seek.digits, length * sizeof(uint32_t));
+    atto_false(grey_radix_iter_next(&seek));
+}
+
+static void test_perm_radix_seek(void)
+{
+    const uint32_t binary[] = {2U, 2U, 2U, 2U, 2U};
+    const uint32_t mixed[] = {3U, 2U, 4U, 5U, 2U, 3U};
+    const uint32_t odd[] = {3U, 5U, 3U, 7U};
+    const uint32_t even[] = {4U, 2U, 6U, 4U};
+    test_perm_radix_seek_all(binary, 0U);
+    test_perm_radix_seek_all(binary, 5U);
+    test_perm_radix_seek_all(mixed, 6U);
+    test_perm_radix_seek_all(odd, 4U);
+    test_perm_radix_seek_all(even, 4U);
+}
+
+static void test_perm_invalid(void)
+{
+    grey_perm_iter_t iter;
+    uint8_t elements[4] = {1U, 0U, 1U, 3U};
+    uint64_t rank;
+    atto_eq(GREY_ERR_INVALID, grey_perm_iter_init(&iter, 65U));
+    atto_eq(GREY_ERR_INVALID, grey_perm_rank(elements, 4U, &rank));
+    elements[2] = 4U;
+    atto_eq(GREY_ERR_INVALID, grey_perm_rank(elements, 4U, &rank));
+    atto_eq(GREY_ERR_INVALID, grey_perm_rank(elements, 65U, &rank));
+    atto_eq(GREY_ERR_RANGE, grey_perm_unrank(24U, 4U, elements));
+    atto_eq(GREY_ERR_INVALID, grey_perm_unrank(0U, 65U, elements));
+    atto_eq(GREY_OK, grey_perm_iter_init(&iter, 4U));
+    atto_eq(GREY_ERR_RANGE, grey_perm_iter_seek(&iter, 24U));
+    atto_eq(4U, iter.swapped);
+}
+
+/** Factorial of \p length, to 20. */
+static uint64_t perm_count(const size_t length)
+{
+    uint64_t count = 1U;
+    for (size_t i = 2U; i <= length; i++)
+    {
+        count *= i;
+    }
+    return count;
+}
+
+/** Index of a permutation of up to 8 elements, 3 bits each. */
+static uint32_t perm_key(const uint8_t* const elements, const size_t length)
+{
+    uint32_t key = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        key |= (uint32_t) elements[i] << (3U * i);
+    }
+    return key;
+}
+
+/**
+ * Enumerates all the permutations of some elements, each differing from
+ * the previous one by two adjacent elements swapped, and ranked in order,
+ * and continues from each of them after a seek.
+ */
+static void test_perm_all(const size_t length)
+{
+    static bool seen[1U << (3U * PERM_MAX_LENGTH)];
+    uint8_t previous[PERM_MAX_LENGTH];
+    uint8_t unranked[PERM_MAX_LENGTH];
+    grey_perm_iter_t iter;
+    grey_perm_iter_t seek;
+    memset(seen, 0, sizeof(seen));
+    atto_eq(GREY_OK, grey_perm_iter_init(&iter, length));
+    atto_eq(GREY_OK, grey_perm_iter_init(&seek, length));
+    atto_eq(length, iter.swapped);
+    uint64_t index = 0;
+    do
+    {
+        const uint32_t key = perm_key(iter.elements, length);
+        atto_false(seen[key]);
+        seen[key] = true;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            atto_eq(i, iter.positions[iter.elements[i]]);
+        }
+        uint64_t rank = 0;
+        atto_eq(GREY_OK, grey_perm_rank(iter.elements, length, &rank));
+        atto_eq(index, rank);
+        atto_eq(GREY_OK, grey_perm_unrank(index, length, unranked));
+        atto_memeq(iter.elements, unranked, length);
+        /* A seek to the previous permutation steps to the same one */
+        if (index > 0U)
+        {
+            atto_eq(GREY_OK, grey_perm_iter_seek(&seek, index - 1U));
+            atto_eq(length, seek.swapped);
+            atto_assert(grey_perm_iter_next(&seek));
+            atto_memeq(iter.elements, seek.elements, length);
+            atto_memeq(iter.positions, seek.positions, length);
+            atto_eq(iter.swapped, seek.swapped);
+        }
+        index++;
+        memcpy(previous, iter.elements, length);
+        if (!grey_perm_iter_next(&iter))
+        {
+            break;
+        }
+        /* Only the swapped adjacent elements changed */
+        atto_lt(iter.swapped + 1U, length);
+        const uint8_t at = iter.swapped;
+        atto_eq(previous[at], iter.elements[at + 1U]);
+        atto_eq(previous[at + 1U], iter.elements[at]);
+        previous[at] = iter.elements[at];
+        previous[at + 1U] = iter.elements[at + 1U];
+        atto_memeq(previous, iter.elements, length);
+    } while (true);
+    atto_eq(perm_count(length), index);
+    /* The last permutation stays, with 0 and 1 swapped from the first */
+    atto_false(grey_perm_iter_next(&iter));
+    atto_memeq(previous, iter.elements, length);
+    if (length >= 2U)
+    {
+        atto_eq(1U, iter.elements[0]);
+        atto_eq(0U, iter.elements[1]);
+    }
+}
+
+static void test_perm_all_small(void)
+{
+    for (size_t length = 0; length <= PERM_MAX_LENGTH; length++)
+    {
+        test_perm_all(length);
+    }
+}
+
+/** Plain changes of 3 elements, the largest one sweeping first. */
+static void test_perm_order(void)
+{
+    const uint8_t expected[6][3] = {
+            {0U, 1U, 2U}, {0U, 2U, 1U}, {2U, 0U, 1U},
+            {2U, 1U, 0U}, {1U, 2U, 0U}, {1U, 0U, 2U},
+    };
+    grey_perm_iter_t iter;
+    atto_eq(GREY_OK, grey_perm_iter_init(&iter, 3U));
+    for (size_t i = 0; i < 6U; i++)
+    {
+        atto_memeq(expected[i], iter.elements, 3U);
+        atto_eq(i < 5U, grey_perm_iter_next(&iter));
+    }
+}
+
+/** Permutations too many to enumerate, up to the 64-bit ranks. */
+static void test_perm_large(void)
+{
+    uint8_t unranked[GREY_PERM_MAX_LENGTH];
+    grey_perm_iter_t iter;
+    const size_t lengths[] = {12U, 20U};
+    for (size_t l = 0; l < 2U; l++)
+    {
+        const size_t length = lengths[l];
+        const uint64_t count = perm_count(length);
+        atto_eq(GREY_OK, grey_perm_iter_init(&iter, length));
+        /* Around the middle and the end */
+        const uint64_t starts[] = {count / 2U - 50U, count - 100U};
+        for (size_t s = 0; s < 2U; s++)
+        {
+            atto_eq(GREY_OK, grey_perm_iter_seek(&iter, starts[s]));
+            for (uint64_t rank = starts[s] + 1U; rank < count; rank++)
+            {
+                atto_assert(grey_perm_iter_next(&iter));
+                atto_eq(GREY_OK, grey_perm_unrank(rank, length, unranked));
+                atto_memeq(unranked, iter.elements, length);
+                uint64_t ranked = 0;
+                atto_eq(GREY_OK, grey_perm_rank(iter.elements, length,
+                                                &ranked));
+                atto_eq(rank, ranked);
+                if (rank == starts[s] + 200U)
+                {
+                    break;
+                }
+            }
+        }
+        atto_false(grey_perm_iter_next(&iter));
+    }
+    /* 21! does not fit in 64 bits: 1 0 2 ... 20, the last permutation,
+     * is beyond the first 20! too */
+    uint64_t rank = 0;
+    atto_eq(GREY_OK, grey_perm_iter_init(&iter, 21U));
+    atto_assert(grey_perm_iter_next(&iter));
+    atto_eq(GREY_OK, grey_perm_rank(iter.elements, 21U, &rank));
+    atto_eq(1U, rank);
+    for (size_t i = 0; i < 21U; i++)
+    {
+        unranked[i] = (uint8_t) ((i < 2U) ? 1U - i : i);
+    }
+    atto_eq(GREY_ERR_RANGE, grey_perm_rank(unranked, 21U, &rank));
+    atto_eq(GREY_OK, grey_perm_iter_init(&iter, 64U));
+    atto_eq(63U, iter.elements[63]);
+    atto_assert(grey_perm_iter_next(&iter));
+    atto_eq(62U, iter.swapped);
+    atto_eq(63U, iter.elements[62]);
+}
+
+void test_perm(void)
+{
+    test_perm_radix_seek();
+    test_perm_invalid();
+    test_perm_order();
+    test_perm_all_small();
+    test_perm_large();
+}
@@ -0,0 +1,236 @@
+/**
+ * @file
+ * @brief Tests of the mixed-radix and k-ary Grey codes.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+
+#define RADIX_RANDOM 2000U
+
+static void test_radix_invalid(void)
+{
+    const uint32_t radices[] = {3U, 1U};
+    const uint32_t digits[] = {2U, 0U};
+    uint32_t codes[2];
+    uint64_t value;
+    atto_eq(GREY_ERR_INVALID, grey_radix_to(radices, digits, codes, 2U));
+    atto_eq(GREY_OK, grey_radix_to(radices, digits, codes, 1U));
+    atto_eq(GREY_ERR_INVALID, grey_radix_from(radices, digits, codes, 2U));
+    const uint32_t threes[] = {3U, 3U};
+    const uint32_t too_large[] = {3U, 0U};
+    atto_eq(GREY_ERR_INVALID, grey_radix_to(threes, too_large, codes, 2U));
+    atto_eq(GREY_ERR_RANGE, grey_radix_to_u64(9U, threes, 2U, codes));
+    atto_eq(GREY_ERR_INVALID, grey_radix_to_u64(0U, radices, 2U, codes));
+    atto_eq(GREY_ERR_INVALID, grey_radix_from_u64(threes, too_large, 2U,
+                                                  &value));
+    uint32_t twos[65];
+    uint32_t top[65] = {0};
+    for (size_t i = 0; i < 65U; i++)
+    {
+        twos[i] = 2U;
+    }
+    top[64] = 1U;
+    atto_eq(GREY_ERR_RANGE, grey_radix_from_u64(twos, top, 65U, &value));
+    atto_eq(GREY_OK, grey_radix_from_u64(twos, top, 64U, &value));
+    atto_eq(0U, value);
+    atto_eq(GREY_ERR_INVALID, grey_kary_to(1U, 1U, &value));
+    atto_eq(GREY_ERR_INVALID, grey_kary_from(1U, 0U, &value));
+    grey_radix_iter_t iter;
+    atto_eq(GREY_ERR_INVALID, grey_radix_iter_init(&iter, twos, 65U));
+    atto_eq(GREY_ERR_INVALID, grey_radix_iter_init(&iter, radices, 2U));
+}
+
+/** Counting up changes one digit by 1, as the iterator does. */
+static void test_radix_sequence(const uint32_t* const radices,
+                                const size_t length)
+{
+    uint64_t total = 1;
+    for (size_t i = 0; i < length; i++)
+    {
+        total *= radices[i];
+    }
+    grey_radix_iter_t iter;
+    atto_eq(GREY_OK, grey_radix_iter_init(&iter, radices, length));
+    atto_eq(length, iter.changed);
+    uint32_t previous[8] = {0};
+    for (uint64_t value = 0; value < total; value++)
+    {
+        uint32_t codes[8];
+        uint32_t digits[8];
+        uint64_t back;
+        atto_eq(GREY_OK, grey_radix_to_u64(value, radices, length, codes));
+        atto_eq(GREY_OK, grey_radix_from(radices, codes, digits, length));
+        atto_eq(GREY_OK, grey_radix_from_u64(radices, codes, length, &back));
+        atto_eq(value, back);
+        uint64_t number = 0;
+        for (size_t i = length; i-- > 0U;)
+        {
+            number = number * radices[i] + digits[i];
+        }
+        atto_eq(value, number);
+        if (value > 0U)
+        {
+            atto_assert(grey_radix_iter_next(&iter));
+            size_t changes = 0;
+            for (size_t i = 0; i < length; i++)
+            {
+                if (codes[i] != previous[i])
+                {
+                    changes++;
+                    atto_eq(i, iter.changed);
+                    atto_eq(iter.decreased ? previous[i] - 1U
+                                           : previous[i] + 1U, codes[i]);
+                }
+            }
+            atto_eq(1U, changes);
+        }
+        atto_memeq(codes, iter.digits, length * sizeof(uint32_t));
+        for (size_t i = 0; i < length; i++)
+        {
+            previous[i] = codes[i];
+        }
+    }
+    atto_false(grey_radix_iter_next(&iter));
+    atto_false(grey_radix_iter_next(&iter));
+    atto_memeq(previous, iter.digits, length * sizeof(uint32_t));
+}
+
+/** With all radices 2 it is the binary code. */
+static void test_radix_binary(void)
+{
+    uint32_t twos[16];
+    uint32_t bits[16];
+    for (size_t i = 0; i < 16U; i++)
+    {
+        twos[i] = 2U;
+    }
+    for (uint32_t value = 0; value < 1000U; value++)
+    {
+        atto_eq(GREY_OK, grey_radix_to_u64(value, twos, 16U, bits));
+        const uint32_t code = grey_inline_to32(value);
+        for (size_t i = 0; i < 16U; i++)
+        {
+            atto_eq((code >> i) & 1U, bits[i]);
+        }
+    }
+}
+
+/** The k-ary codes are the mixed-radix ones with equal radices. */
+static void test_kary(const uint32_t radix, uint64_t state)
+{
+    uint32_t radices[64];
+    uint32_t codes[64];
+    size_t length = 0;
+    for (uint64_t power = 1; length < 64U; length++)
+    {
+        radices[length] = radix;
+        if (power > UINT64_MAX / radix)
+        {
+            length++;  // Partial top digit
+            break;
+        }
+        power *= radix;
+    }
+    for (uint32_t i = 0; i < RADIX_RANDOM; i++)
+    {
+        uint64_t value = test_next_pseudorandom(&state);
+        value = (i < RADIX_RANDOM / 2U) ? value % 1000000U : value;
+        uint64_t code;
+        const grey_err_t err = grey_kary_to(value, radix, &code);
+        if (err == GREY_ERR_RANGE)
+        {
+            atto_assert(radix & (radix - 1U));  // Never for powers of 2
+            continue;
+        }
+        atto_eq(GREY_OK, err);
+        atto_eq(GREY_OK, grey_radix_to_u64(value, radices, length, codes));
+        uint64_t expected = 0;
+        for (size_t digit = length; digit-- > 0U;)
+        {
+            expected = expected * radix + codes[digit];
+        }
+        atto_eq(expected, code);
+        uint64_t back;
+        atto_eq(GREY_OK, grey_kary_from(code, radix, &back));
+        atto_eq(value, back);
+    }
+}
+
+static void test_kary_limits(void)
+{
+    uint64_t code;
+    /* 3^40 * 1, as 3^40 * 2 > 2^64 */
+    const uint64_t limit3 = 12157665459056928801ULL;
+    atto_eq(GREY_ERR_RANGE, grey_kary_to(limit3, 3U, &code));
+    atto_eq(GREY_OK, grey_kary_to(limit3 - 1U, 3U, &code));
+    atto_lt(code, limit3);
+    atto_eq(GREY_ERR_RANGE, grey_kary_from(limit3, 3U, &code));
+    atto_eq(GREY_OK, grey_kary_to(UINT64_MAX, 8U, &code));
+    atto_eq(GREY_OK, grey_kary_from(code, 8U, &code));
+    atto_eq(UINT64_MAX, code);
+    /* Base 10: 0..9 then 19..10 */
+    atto_eq(GREY_OK, grey_kary_to(10U, 10U, &code));
+    atto_eq(19U, code);
+    atto_eq(GREY_OK, grey_kary_to(199U, 10U, &code));
+    atto_eq(100U, code);
+}
+
+static void test_kary_array(void)
+{
+    static uint64_t values[RADIX_RANDOM];
+    static uint64_t codes[RADIX_RANDOM];
+    static uint64_t expected[RADIX_RANDOM];
+    uint64_t state = 0x853C49E6748FEA9BULL;
+    for (size_t i = 0; i < RADIX_RANDOM; i++)
+    {
+        values[i] = test_next_pseudorandom(&state) >> 2U;
+    }
+    const uint32_t radices[] = {2U, 3U, 4U, 10U, 16U, 1U << 31U};
+    for (size_t r = 0; r < sizeof(radices) / sizeof(radices[0]); r++)
+    {
+        for (size_t i = 0; i < RADIX_RANDOM; i++)
+        {
+            atto_eq(GREY_OK, grey_kary_to(values[i], radices[r],
+                                          &expected[i]));
+        }
+        atto_eq(GREY_OK, grey_kary_to_array(values, codes, RADIX_RANDOM,
+                                            radices[r]));
+        atto_memeq(expected, codes, sizeof(codes));
+        atto_eq(GREY_OK, grey_kary_from_array(codes, codes, RADIX_RANDOM,
+                                              radices[r]));
+        atto_memeq(values, codes, sizeof(codes));
+    }
+    codes[0] = 1U;
+    codes[1] = UINT64_MAX;
+    atto_eq(GREY_ERR_RANGE, grey_kary_to_array(codes, codes, 2U, 3U));
+    atto_eq(1U, codes[0]);
+}
+
+void test_radix(void)
+{
+    test_radix_invalid();
+    const uint32_t mixed[] = {3U, 2U, 4U, 5U};
+    test_radix_sequence(mixed, 4U);
+    const uint32_t odd[] = {3U, 3U, 5U, 3U};
+    test_radix_sequence(odd, 4U);
+    const uint32_t dials[] = {10U, 10U, 10U};
+    test_radix_sequence(dials, 3U);
+    const uint32_t single[] = {7U};
+    test_radix_sequence(single, 1U);
+    test_radix_sequence(single, 0U);
+    test_radix_binary();
+    for (uint32_t radix = 2U; radix <= 17U; radix++)
+    {
+        test_kary(radix, 0x9E3779B97F4A7C15ULL + radix);
+    }
+    test_kary(1U << 31U, 42U);
+    test_kary(UINT32_MAX, 43U);
+    test_kary_limits();
+    test_kary_array();
+}
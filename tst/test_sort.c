@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief Tests of the decode-free comparison grey_cmp() and of the radix
+ * sort grey_sort(), against the decoded values.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <stdlib.h>
+
+#define SORT_LEN 5000U
+
+static int sign(const int x)
+{
+    return (x > 0) - (x < 0);
+}
+
+static int cmp_values(const uint64_t a, const uint64_t b)
+{
+    return (a > b) - (a < b);
+}
+
+static void test_cmp(void)
+{
+    atto_eq(0, grey_cmp8(0, 0));
+    atto_eq(-1, grey_cmp8(grey_to8(1), grey_to8(2)));
+    atto_eq(1, grey_cmp8(grey_to8(255), grey_to8(254)));
+    /* Every pair of 8-bit codes */
+    for (uint32_t a = 0; a <= UINT8_MAX; a++)
+    {
+        for (uint32_t b = 0; b <= UINT8_MAX; b++)
+        {
+            atto_eq(cmp_values(grey_from8((uint8_t) a),
+                               grey_from8((uint8_t) b)),
+                    sign(grey_cmp8((uint8_t) a, (uint8_t) b)));
+        }
+    }
+    uint64_t state = 0x853C49E6748FEA9BULL;
+    for (uint32_t i = 0; i < 100000U; i++)
+    {
+        const uint64_t a = test_next_pseudorandom(&state);
+        /* Sharing a random amount of the top bits, to hit every position */
+        const uint64_t b = (a & ~(UINT64_MAX >> (i % 64U)))
+                           | (test_next_pseudorandom(&state) >> (i % 64U));
+        atto_eq(cmp_values(grey_from16((uint16_t) a),
+                           grey_from16((uint16_t) b)),
+                sign(grey_cmp16((uint16_t) a, (uint16_t) b)));
+        atto_eq(cmp_values(grey_from32((uint32_t) a),
+                           grey_from32((uint32_t) b)),
+                sign(grey_cmp32((uint32_t) a, (uint32_t) b)));
+        atto_eq(cmp_values(grey_from64(a), grey_from64(b)),
+                sign(grey_cmp64(a, b)));
+        atto_eq(cmp_values(grey_from(grey_to((grey_int_t) a)),
+                           grey_from(grey_to((grey_int_t) b))),
+                sign(grey_cmp(grey_to((grey_int_t) a),
+                              grey_to((grey_int_t) b))));
+#if defined(GREY_HAS_UINT128)
+        const grey_uint128_t a128 = ((grey_uint128_t) a << 64U) | b;
+        const grey_uint128_t b128 = ((grey_uint128_t) a << 64U) | a;
+        const grey_uint128_t a_value = grey_from128(a128);
+        const grey_uint128_t b_value = grey_from128(b128);
+        atto_eq((a_value > b_value) - (a_value < b_value),
+                sign(grey_cmp128(a128, b128)));
+        atto_eq(-sign(grey_cmp128(a128, b128)),
+                sign(grey_cmp128(b128, a128)));
+#endif
+    }
+}
+
+/** Sorted by value and, for equal values, in the original order. */
+static void check_sorted(const grey_code_t* const codes,
+                         const size_t* const positions, const size_t amount,
+                         const grey_code_t* const original)
+{
+    for (size_t i = 0; i < amount; i++)
+    {
+        atto_eq(original[positions[i]], codes[i]);
+        if (i > 0)
+        {
+            atto_assert(grey_from(codes[i - 1U]) <= grey_from(codes[i]));
+            if (codes[i - 1U] == codes[i])
+            {
+                atto_assert(positions[i - 1U] < positions[i]);
+            }
+        }
+    }
+}
+
+static void test_sort_codes(void)
+{
+    static grey_code_t original[SORT_LEN];
+    static grey_code_t codes[SORT_LEN];
+    static size_t positions[SORT_LEN];
+    uint64_t state = 0xDA3E39CB94B95BDBULL;
+    atto_eq(GREY_OK, grey_sort(NULL, 0, NULL, 0));
+    for (size_t amount = 1; amount <= SORT_LEN; amount = amount * 3U + 1U)
+    {
+        for (size_t i = 0; i < amount; i++)
+        {
+            /* Few distinct values in half the arrays, to check stability */
+            const uint64_t random = test_next_pseudorandom(&state);
+            original[i] = (grey_code_t) ((amount % 2U) ? random : random % 7U);
+            codes[i] = original[i];
+            positions[i] = i;
+        }
+        atto_eq(GREY_OK, grey_sort(codes, amount, positions, sizeof(size_t)));
+        check_sorted(codes, positions, amount, original);
+        /* Without payload */
+        for (size_t i = 0; i < amount; i++)
+        {
+            codes[i] = original[i];
+        }
+        atto_eq(GREY_OK, grey_sort(codes, amount, NULL, 0));
+        for (size_t i = 1; i < amount; i++)
+        {
+            atto_assert(grey_cmp(codes[i - 1U], codes[i]) <= 0);
+        }
+    }
+}
+
+static void test_sort_widths(void)
+{
+    static uint8_t codes8[SORT_LEN];
+    static uint16_t codes16[SORT_LEN];
+    static uint32_t codes32[SORT_LEN];
+    static uint64_t codes64[SORT_LEN];
+    static uint32_t payload[SORT_LEN];
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (size_t i = 0; i < SORT_LEN; i++)
+    {
+        const uint64_t random = test_next_pseudorandom(&state);
+        codes8[i] = (uint8_t) random;
+        codes16[i] = (uint16_t) random;
+        codes32[i] = (uint32_t) random;
+        codes64[i] = random;
+        payload[i] = (uint32_t) random;
+    }
+    atto_eq(GREY_OK, grey_sort8(codes8, SORT_LEN, NULL, 0));
+    atto_eq(GREY_OK, grey_sort16(codes16, SORT_LEN, NULL, 0));
+    atto_eq(GREY_OK, grey_sort32(codes32, SORT_LEN, payload,
+                                 sizeof(uint32_t)));
+    atto_eq(GREY_OK, grey_sort64(codes64, SORT_LEN, NULL, 0));
+    for (size_t i = 1; i < SORT_LEN; i++)
+    {
+        atto_assert(grey_cmp8(codes8[i - 1U], codes8[i]) <= 0);
+        atto_assert(grey_cmp16(codes16[i - 1U], codes16[i]) <= 0);
+        atto_assert(grey_cmp32(codes32[i - 1U], codes32[i]) <= 0);
+        atto_assert(grey_cmp64(codes64[i - 1U], codes64[i]) <= 0);
+    }
+    /* The 32-bit payload was equal to the code it belongs to */
+    for (size_t i = 0; i < SORT_LEN; i++)
+    {
+        atto_eq(codes32[i], payload[i]);
+    }
+}
+
+void test_sort(void)
+{
+    test_cmp();
+    test_sort_codes();
+    test_sort_widths();
+}
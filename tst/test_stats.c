@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @brief Tests of the runtime counters of the `GREY_STATS` builds, and of
+ * their absence in the other ones.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+#define STATS_LEN 1000U
+
+static grey_stats_t stats;
+static char json[4096];
+
+static void test_stats_names(void)
+{
+    atto_streq("to_array", grey_stats_api_name(GREY_STATS_TO_ARRAY), 20);
+    atto_streq("distances", grey_stats_api_name(GREY_STATS_DISTANCES), 20);
+    atto_streq("packed_from", grey_stats_api_name(GREY_STATS_PACKED_FROM),
+               20);
+    atto_streq("unknown",
+               grey_stats_api_name((grey_stats_api_t) GREY_STATS_APIS), 20);
+}
+
+static void test_stats_json_empty(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    atto_eq(2U, grey_stats_json(&stats, json, sizeof(json)));
+    atto_streq("{}", json, sizeof(json));
+    atto_eq(2U, grey_stats_json(&stats, NULL, 0));
+    /* Truncated, but still null-terminated */
+    atto_eq(2U, grey_stats_json(&stats, json, 2U));
+    atto_streq("{", json, sizeof(json));
+}
+
+static void test_stats_json(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    stats.calls[GREY_STATS_FROM_ARRAY][GREY_KERNEL_SCALAR] = 2U;
+    stats.elements[GREY_STATS_FROM_ARRAY][GREY_KERNEL_SCALAR] = 7U;
+    stats.bytes[GREY_STATS_FROM_ARRAY][GREY_KERNEL_SCALAR] = 56U;
+    stats.sizes[GREY_STATS_FROM_ARRAY][0] = 1U;
+    stats.sizes[GREY_STATS_FROM_ARRAY][3] = 1U;
+    stats.sampled_calls[GREY_STATS_FROM_ARRAY] = 1U;
+    stats.sampled_elements[GREY_STATS_FROM_ARRAY] = 7U;
+    stats.cycles[GREY_STATS_FROM_ARRAY] = 300U;
+    const char* const expected =
+            "{\"from_array\": {\"calls\": 2, \"elements\": 7, \"bytes\": 56, "
+            "\"kernels\": {\"scalar\": {\"calls\": 2, \"elements\": 7, "
+            "\"bytes\": 56}}, \"sizes\": {\"0\": 1, \"4\": 1}, "
+            "\"cycles\": {\"calls\": 1, \"elements\": 7, \"cycles\": 300}}}";
+    const size_t length = strlen(expected);
+    atto_eq(length, grey_stats_json(&stats, json, sizeof(json)));
+    atto_streq(expected, json, sizeof(json));
+    atto_eq(length, grey_stats_json(&stats, json, 10U));
+    atto_eq(9U, strlen(json));
+}
+
+#if defined(GREY_STATS)
+
+/** Sum of the counters of one group over all kernels. */
+static uint64_t stats_total(const uint64_t counters[GREY_STATS_KERNELS])
+{
+    uint64_t total = 0;
+    for (size_t kernel = 0; kernel < GREY_STATS_KERNELS; kernel++)
+    {
+        total += counters[kernel];
+    }
+    return total;
+}
+
+static void test_stats_counters(void)
+{
+    static uint32_t values[STATS_LEN];
+    static uint8_t distances[STATS_LEN];
+    atto_eq(GREY_OK, grey_stats_reset());
+    atto_eq(GREY_OK, grey_stats_snapshot(&stats));
+    atto_eq(0U, stats_total(stats.calls[GREY_STATS_TO_ARRAY]));
+    grey_to_array32(values, values, STATS_LEN);
+    grey_to_array_inplace32(values, 3U);
+    grey_from_array32(values, values, 0);
+    grey_fill_range32(5U, 10U, values);
+    grey_distances32(1U, values, distances, 10U);
+    grey_distances_many32(values, 2U, values, 10U, distances);
+    atto_eq(GREY_OK, grey_stats_snapshot(&stats));
+    const grey_kernel_t to = grey_kernel_active_width(32U, false);
+    atto_eq(2U, stats.calls[GREY_STATS_TO_ARRAY][to]);
+    atto_eq(2U, stats_total(stats.calls[GREY_STATS_TO_ARRAY]));
+    atto_eq(STATS_LEN + 3U, stats.elements[GREY_STATS_TO_ARRAY][to]);
+    atto_eq((STATS_LEN + 3U) * 8U, stats.bytes[GREY_STATS_TO_ARRAY][to]);
+    atto_eq(1U, stats.sizes[GREY_STATS_TO_ARRAY][2]);
+    atto_eq(1U, stats.sizes[GREY_STATS_TO_ARRAY][10]);
+    atto_eq(1U, stats_total(stats.calls[GREY_STATS_FROM_ARRAY]));
+    atto_eq(0U, stats_total(stats.elements[GREY_STATS_FROM_ARRAY]));
+    atto_eq(1U, stats.sizes[GREY_STATS_FROM_ARRAY][0]);
+    atto_eq(10U, stats_total(stats.elements[GREY_STATS_FILL_RANGE]));
+    atto_eq(2U, stats_total(stats.calls[GREY_STATS_DISTANCES]));
+    atto_eq(30U, stats_total(stats.elements[GREY_STATS_DISTANCES]));
+    atto_eq(0U, stats_total(stats.calls[GREY_STATS_HILBERT]));
+    atto_eq(0U, stats.sampled_calls[GREY_STATS_TO_ARRAY]);
+    /* Restarting from 0 */
+    atto_eq(GREY_OK, grey_stats_reset());
+    atto_eq(GREY_OK, grey_stats_snapshot(&stats));
+    atto_eq(0U, stats_total(stats.calls[GREY_STATS_TO_ARRAY]));
+    atto_eq(2U, grey_stats_json(&stats, json, sizeof(json)));
+}
+
+static void test_stats_cycles(void)
+{
+    static uint64_t values[STATS_LEN];
+    if (grey_stats_sample_cycles(2U) == GREY_ERR_UNSUPPORTED)
+    {
+        return;  /* No time stamp counter */
+    }
+    atto_eq(GREY_OK, grey_stats_reset());
+    for (uint32_t i = 0; i < 10U; i++)
+    {
+        grey_from_array64(values, values, STATS_LEN);
+    }
+    atto_eq(GREY_OK, grey_stats_sample_cycles(0));
+    grey_from_array64(values, values, STATS_LEN);
+    atto_eq(GREY_OK, grey_stats_snapshot(&stats));
+    atto_eq(11U, stats_total(stats.calls[GREY_STATS_FROM_ARRAY]));
+    atto_eq(5U, stats.sampled_calls[GREY_STATS_FROM_ARRAY]);
+    atto_eq(5U * STATS_LEN, stats.sampled_elements[GREY_STATS_FROM_ARRAY]);
+    atto_neq(0U, stats.cycles[GREY_STATS_FROM_ARRAY]);
+    const size_t length = grey_stats_json(&stats, json, sizeof(json));
+    atto_lt(length, sizeof(json));
+    atto_neq(NULL, strstr(json, "\"cycles\": {\"calls\": 5, "));
+}
+
+/**
+ * A call split across the threads of the pool counts once, with all its
+ * elements, in its own group.
+ */
+static void test_stats_threads(void)
+{
+    static uint64_t values[STATS_LEN];
+    const grey_packed_config_t packed = {
+            .bits = 64U,
+            .decode = true,
+            .input_order = GREY_ORDER_NATIVE,
+            .output_order = GREY_ORDER_NATIVE,
+    };
+    grey_parallel_config_t defaults;
+    grey_parallel_config_get(&defaults);
+    const grey_parallel_config_t config = {
+            .threads = 4,
+            .cutoff = 0,
+            .chunk = 64,
+    };
+#if defined(GREY_NO_THREADS)
+    atto_eq(GREY_ERR_UNSUPPORTED, grey_parallel_config_set(&config));
+    return;
+#else
+    atto_eq(GREY_OK, grey_parallel_config_set(&config));
+    atto_eq(GREY_OK, grey_stats_reset());
+    grey_to_array_parallel64(values, values, STATS_LEN);
+    atto_eq(GREY_OK, grey_packed_convert(values, values, sizeof(values),
+                                         &packed));
+    atto_eq(GREY_OK, grey_stats_snapshot(&stats));
+    const grey_kernel_t to = grey_kernel_active_width(64U, false);
+    atto_eq(1U, stats.calls[GREY_STATS_PARALLEL_TO][to]);
+    atto_eq(1U, stats_total(stats.calls[GREY_STATS_PARALLEL_TO]));
+    atto_eq(STATS_LEN, stats.elements[GREY_STATS_PARALLEL_TO][to]);
+    atto_eq(STATS_LEN * 16U, stats.bytes[GREY_STATS_PARALLEL_TO][to]);
+    atto_eq(1U, stats.sizes[GREY_STATS_PARALLEL_TO][10]);
+    atto_eq(1U, stats_total(stats.calls[GREY_STATS_PACKED_FROM]));
+    atto_eq(STATS_LEN, stats_total(stats.elements[GREY_STATS_PACKED_FROM]));
+    atto_eq(0U, stats_total(stats.calls[GREY_STATS_PACKED_TO]));
+    /* The chunks are not counted as plain array conversions */
+    atto_eq(0U, stats_total(stats.calls[GREY_STATS_TO_ARRAY]));
+    atto_eq(0U, stats_total(stats.calls[GREY_STATS_FROM_ARRAY]));
+    grey_parallel_shutdown();
+    atto_eq(GREY_OK, grey_parallel_config_set(&defaults));
+#endif
+}
+
+#endif  /* GREY_STATS */
+
+void test_stats(void)
+{
+    test_stats_names();
+    test_stats_json_empty();
+    test_stats_json();
+#if defined(GREY_STATS)
+    test_stats_counters();
+    test_stats_cycles();
+    test_stats_threads();
+#else
+    atto_eq(GREY_ERR_UNSUPPORTED, grey_stats_snapshot(&stats));
+    atto_eq(GREY_ERR_UNSUPPORTED, grey_stats_reset());
+    atto_eq(GREY_ERR_UNSUPPORTED, grey_stats_sample_cycles(1U));
+#endif
+}
@@ -0,0 +1,193 @@
+/**
+ * @file
+ * @brief Tests of the stream decoder of encoder readings.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#if !defined(GREY_NO_THREADS) && defined(__GNUC__) \
+    && (defined(__unix__) || defined(__APPLE__))
+#define STREAM_THREADS
+/* pthreads */
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+
+#if defined(STREAM_THREADS)
+#include <pthread.h>
+#endif
+
+#if defined(GREY_HAS_ATOMIC)
+
+#define STREAM_CAPACITY 8U
+#define STREAM_STEPS 100000U
+
+static void test_stream_invalid(void)
+{
+    grey_stream_t stream;
+    grey_code_t buffer[STREAM_CAPACITY];
+    atto_eq(GREY_ERR_INVALID, grey_stream_init(&stream, NULL, 8U));
+    atto_eq(GREY_ERR_INVALID, grey_stream_init(&stream, buffer, 0U));
+    atto_eq(GREY_ERR_INVALID, grey_stream_init(&stream, buffer, 6U));
+    atto_eq(GREY_OK, grey_stream_init(&stream, buffer, 1U));
+    atto_eq(0U, grey_stream_decode(&stream, NULL, NULL, 10U));
+    atto_false(stream.started);
+    atto_eq(0U, (uintptr_t) &stream.tail % GREY_CACHE_LINE);
+}
+
+/** Position \p offset steps from #GREY_MAX, wrapping around at 64 bits. */
+static int64_t stream_from_max(const int64_t offset)
+{
+    return (int64_t) ((uint64_t) GREY_MAX + (uint64_t) offset);
+}
+
+/** Steps back and forth across the wraparound, then glitches. */
+static void test_stream_turns(void)
+{
+    grey_stream_t stream;
+    grey_code_t buffer[STREAM_CAPACITY];
+    int64_t positions[STREAM_CAPACITY];
+    bool glitches[STREAM_CAPACITY];
+    atto_eq(GREY_OK, grey_stream_init(&stream, buffer, STREAM_CAPACITY));
+    const grey_int_t readings[] = {
+            (grey_int_t) (GREY_MAX - 1U), GREY_MAX, 0U, 1U, 0U, GREY_MAX,
+            (grey_int_t) (GREY_MAX - 1U),
+    };
+    for (size_t i = 0; i < sizeof(readings) / sizeof(readings[0]); i++)
+    {
+        atto_assert(grey_stream_push(&stream, grey_inline_to(readings[i])));
+    }
+    atto_eq(7U, grey_stream_decode(&stream, positions, glitches, 10U));
+    const int64_t expected[] = {
+            stream_from_max(-1), stream_from_max(0), stream_from_max(1),
+            stream_from_max(2), stream_from_max(1), stream_from_max(0),
+            stream_from_max(-1),
+    };
+    atto_memeq(expected, positions, sizeof(expected));
+    for (size_t i = 0; i < 7U; i++)
+    {
+        atto_false(glitches[i]);
+    }
+    atto_eq(stream_from_max(-1), stream.position);
+    atto_eq(0U, stream.glitches);
+
+    /* Skips flipping 2 bits of the Grey code: MAX - 1 -> 2 -> 4 */
+    atto_assert(grey_stream_push(&stream, grey_inline_to(2U)));
+    atto_assert(grey_stream_push(&stream, grey_inline_to(4U)));
+    atto_assert(grey_stream_push(&stream, grey_inline_to(5U)));
+    atto_eq(3U, grey_stream_decode(&stream, positions, glitches, 10U));
+    atto_eq(stream_from_max(3), positions[0]);  // Forward, the shortest way
+    atto_assert(glitches[0]);
+    atto_eq(stream_from_max(5), positions[1]);
+    atto_assert(glitches[1]);
+    atto_eq(stream_from_max(6), positions[2]);
+    atto_false(glitches[2]);
+    atto_eq(2U, stream.glitches);
+}
+
+/** Full buffer, decoding in parts across the end of the buffer. */
+static void test_stream_ring(void)
+{
+    grey_stream_t stream;
+    grey_code_t buffer[STREAM_CAPACITY];
+    int64_t positions[STREAM_CAPACITY];
+    atto_eq(GREY_OK, grey_stream_init(&stream, buffer, STREAM_CAPACITY));
+    grey_code_t code = 0;
+    for (size_t i = 0; i < STREAM_CAPACITY; i++)
+    {
+        atto_assert(grey_stream_push(&stream, code));
+        code = grey_incr(code);
+    }
+    atto_false(grey_stream_push(&stream, code));
+    atto_false(grey_stream_push(&stream, code));
+    atto_eq(2U, grey_stream_overruns(&stream));
+    int64_t expected = 0;
+    for (size_t round = 0; round < 10U; round++)
+    {
+        /* Leaves 3 readings in the buffer each time */
+        const size_t amount = grey_stream_decode(&stream, positions, NULL,
+                                                 STREAM_CAPACITY - 3U);
+        atto_eq(STREAM_CAPACITY - 3U, amount);
+        for (size_t i = 0; i < amount; i++)
+        {
+            atto_eq(expected, positions[i]);
+            expected++;
+        }
+        for (size_t i = 0; i < amount; i++)
+        {
+            atto_assert(grey_stream_push(&stream, code));
+            code = grey_incr(code);
+        }
+        atto_false(grey_stream_push(&stream, code));
+    }
+    atto_eq(STREAM_CAPACITY, grey_stream_decode(&stream, NULL, NULL, 100U));
+    atto_eq(expected + STREAM_CAPACITY - 1, stream.position);
+    atto_eq(0U, stream.glitches);
+    atto_eq(12U, grey_stream_overruns(&stream));
+}
+
+#if defined(STREAM_THREADS)
+
+static grey_stream_t shared;
+
+static void* stream_producer(void* const arg)
+{
+    (void) arg;
+    grey_code_t code = 0;
+    for (uint32_t i = 0; i < STREAM_STEPS; i++)
+    {
+        while (!grey_stream_push(&shared, code))
+        {
+        }
+        code = grey_incr(code);
+    }
+    return NULL;
+}
+
+/** Every reading arrives in order, as the producer spins when full. */
+static void test_stream_threads(void)
+{
+    static grey_code_t buffer[64];
+    int64_t positions[48];
+    atto_eq(GREY_OK, grey_stream_init(&shared, buffer, 64U));
+    pthread_t producer;
+    atto_eq(0, pthread_create(&producer, NULL, stream_producer, NULL));
+    int64_t expected = 0;
+    while (expected < (int64_t) STREAM_STEPS)
+    {
+        const size_t amount = grey_stream_decode(&shared, positions, NULL,
+                                                 48U);
+        for (size_t i = 0; i < amount; i++)
+        {
+            atto_eq(expected, positions[i]);
+            expected++;
+        }
+    }
+    pthread_join(producer, NULL);
+    atto_eq(0U, shared.glitches);
+}
+
+#endif
+
+void test_stream(void)
+{
+    test_stream_invalid();
+    test_stream_turns();
+    test_stream_ring();
+#if defined(STREAM_THREADS)
+    test_stream_threads();
+#endif
+}
+
+#else
+
+void test_stream(void)
+{
+}
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file
+ * @brief Tests of the revolving-door Grey code of the k-subsets.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+/** Largest set whose subsets are all enumerated. */
+#define SUBSET_MAX_N 12U
+
+static void test_subset_count(void)
+{
+    uint64_t count = 0;
+    atto_eq(GREY_OK, grey_subset_count(0U, 0U, &count));
+    atto_eq(1U, count);
+    atto_eq(GREY_OK, grey_subset_count(10U, 3U, &count));
+    atto_eq(120U, count);
+    atto_eq(GREY_OK, grey_subset_count(64U, 32U, &count));
+    atto_eq(UINT64_C(1832624140942590534), count);
+    atto_eq(GREY_OK, grey_subset_count(67U, 33U, &count));
+    atto_eq(UINT64_C(14226520737620288370), count);
+    atto_eq(GREY_OK, grey_subset_count(100000U, 2U, &count));
+    atto_eq(UINT64_C(4999950000), count);
+    atto_eq(GREY_ERR_RANGE, grey_subset_count(68U, 34U, &count));
+    atto_eq(GREY_ERR_INVALID, grey_subset_count(3U, 4U, &count));
+}
+
+static void test_subset_invalid(void)
+{
+    grey_subset_iter_t iter;
+    uint32_t elements[4] = {1U, 1U, 2U, 0U};
+    uint64_t rank;
+    uint64_t mask;
+    atto_eq(GREY_ERR_INVALID, grey_subset_iter_init(&iter, 2U, 3U, elements));
+    atto_eq(GREY_ERR_INVALID, grey_subset_iter_init(&iter, 5U, 3U, NULL));
+    atto_eq(GREY_ERR_INVALID, grey_subset_rank(elements, 5U, 2U, &rank));
+    elements[1] = 5U;
+    atto_eq(GREY_ERR_INVALID, grey_subset_rank(elements, 5U, 2U, &rank));
+    atto_eq(GREY_ERR_INVALID, grey_subset_rank_mask(0x20U, 5U, &rank));
+    atto_eq(GREY_ERR_INVALID, grey_subset_rank_mask(0x1U, 65U, &rank));
+    atto_eq(GREY_ERR_RANGE, grey_subset_unrank(10U, 5U, 2U, elements));
+    atto_eq(GREY_ERR_RANGE, grey_subset_unrank_mask(10U, 5U, 3U, &mask));
+    atto_eq(GREY_ERR_RANGE, grey_subset_unrank(0U, 200U, 100U, elements));
+    atto_eq(GREY_OK, grey_subset_iter_init(&iter, 5U, 3U, elements));
+    atto_eq(GREY_ERR_RANGE, grey_subset_iter_seek(&iter, 10U));
+}
+
+/** Bitmask of the \p k elements of \p elements. */
+static uint64_t subset_mask(const uint32_t* const elements, const uint32_t k)
+{
+    uint64_t mask = 0;
+    for (uint32_t i = 0; i < k; i++)
+    {
+        mask |= UINT64_C(1) << elements[i];
+    }
+    return mask;
+}
+
+/** Lowest element of the subset of \p iter able to move, k if none. */
+static uint32_t subset_focus(const grey_subset_iter_t* const iter)
+{
+    for (uint32_t i = 0; i < iter->k; i++)
+    {
+        if (grey_subset_iter_movable(iter, i))
+        {
+            return i;
+        }
+    }
+    return iter->k;
+}
+
+/**
+ * Enumerates all the k-subsets of an n-set, each differing from the
+ * previous one by the element leaving and the one joining, and ranked in
+ * order, and continues from each of them after a seek.
+ */
+static void test_subset_all(const uint32_t n, const uint32_t k)
+{
+    static bool seen[1U << SUBSET_MAX_N];
+    uint32_t elements[SUBSET_MAX_N + 1U];
+    uint32_t unranked[SUBSET_MAX_N + 1U];
+    uint32_t seek_elements[SUBSET_MAX_N + 1U];
+    grey_subset_iter_t iter;
+    grey_subset_iter_t seek;
+    uint64_t count = 0;
+    atto_eq(GREY_OK, grey_subset_count(n, k, &count));
+    memset(seen, 0, sizeof(seen));
+    atto_eq(GREY_OK, grey_subset_iter_init(&iter, n, k, elements));
+    atto_eq(GREY_OK, grey_subset_iter_init(&seek, n, k, seek_elements));
+    atto_eq(n, iter.left);
+    uint64_t index = 0;
+    do
+    {
+        const uint64_t mask = subset_mask(elements, k);
+        atto_eq(mask, iter.mask);
+        atto_false(seen[mask]);
+        seen[mask] = true;
+        atto_eq(n, elements[k]);
+        atto_eq(subset_focus(&iter), iter.focus);
+        for (uint32_t i = 1; i < k; i++)
+        {
+            atto_lt(elements[i - 1U], elements[i]);
+        }
+        uint64_t rank = 0;
+        atto_eq(GREY_OK, grey_subset_rank(elements, n, k, &rank));
+        atto_eq(index, rank);
+        atto_eq(GREY_OK, grey_subset_rank_mask(mask, n, &rank));
+        atto_eq(index, rank);
+        atto_eq(GREY_OK, grey_subset_unrank(index, n, k, unranked));
+        atto_memeq(elements, unranked, k * sizeof(uint32_t));
+        uint64_t unranked_mask = 0;
+        atto_eq(GREY_OK, grey_subset_unrank_mask(index, n, k,
+                                                 &unranked_mask));
+        atto_eq(mask, unranked_mask);
+        /* A seek to the previous subset steps to the same one */
+        if (index > 0U)
+        {
+            atto_eq(GREY_OK, grey_subset_iter_seek(&seek, index - 1U));
+            atto_eq(n, seek.left);
+            atto_assert(grey_subset_iter_next(&seek));
+            atto_eq(mask, seek.mask);
+            atto_eq(iter.left, seek.left);
+            atto_eq(iter.joined, seek.joined);
+            atto_eq(iter.focus, seek.focus);
+        }
+        index++;
+        if (!grey_subset_iter_next(&iter))
+        {
+            break;
+        }
+        /* One element left, another joined */
+        atto_neq(iter.left, iter.joined);
+        atto_neq(0U, mask & (UINT64_C(1) << iter.left));
+        atto_eq(0U, mask & (UINT64_C(1) << iter.joined));
+        atto_eq(mask ^ (UINT64_C(1) << iter.left)
+                ^ (UINT64_C(1) << iter.joined), iter.mask);
+    } while (true);
+    atto_eq(count, index);
+    /* The last subset stays */
+    const uint64_t last = iter.mask;
+    atto_false(grey_subset_iter_next(&iter));
+    atto_eq(last, iter.mask);
+}
+
+static void test_subset_all_small(void)
+{
+    for (uint32_t n = 0; n <= SUBSET_MAX_N; n++)
+    {
+        for (uint32_t k = 0; k <= n; k++)
+        {
+            test_subset_all(n, k);
+        }
+    }
+}
+
+/** Sets larger than 64 elements, as arrays only. */
+static void test_subset_large(void)
+{
+    const uint32_t n = 1000U;
+    const uint32_t k = 5U;
+    uint32_t elements[6];
+    uint32_t unranked[5];
+    grey_subset_iter_t iter;
+    atto_eq(GREY_OK, grey_subset_iter_init(&iter, n, k, elements));
+    uint64_t count = 0;
+    atto_eq(GREY_OK, grey_subset_count(n, k, &count));
+    /* Around the middle and the end */
+    const uint64_t starts[] = {count / 2U, count - 100U};
+    for (size_t s = 0; s < 2U; s++)
+    {
+        atto_eq(GREY_OK, grey_subset_iter_seek(&iter, starts[s]));
+        atto_eq(0U, iter.mask);
+        for (uint64_t rank = starts[s] + 1U; rank < count; rank++)
+        {
+            atto_assert(grey_subset_iter_next(&iter));
+            atto_eq(subset_focus(&iter), iter.focus);
+            atto_eq(GREY_OK, grey_subset_unrank(rank, n, k, unranked));
+            atto_memeq(unranked, elements, sizeof(unranked));
+            uint64_t ranked = 0;
+            atto_eq(GREY_OK, grey_subset_rank(elements, n, k, &ranked));
+            atto_eq(rank, ranked);
+            if (rank == starts[s] + 200U)
+            {
+                break;
+            }
+        }
+    }
+    atto_false(grey_subset_iter_next(&iter));
+    /* 64-element sets use the whole mask */
+    static uint32_t all[65];
+    atto_eq(GREY_OK, grey_subset_iter_init(&iter, 64U, 64U, all));
+    atto_eq(UINT64_MAX, iter.mask);
+}
+
+void test_subset(void)
+{
+    test_subset_count();
+    test_subset_invalid();
+    test_subset_all_small();
+    test_subset_large();
+}
@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @brief Tests of the text conversion of the `grey` command line tool,
+ * against the printf() family.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey_text.h"
+#include "atto.h"
+#include "test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static grey_err_t parse(const char* const str,
+                        const grey_text_format_t format, uint64_t* value)
+{
+    return grey_text_parse(str, strlen(str), format, UINT64_MAX, value);
+}
+
+static void test_text_parse(void)
+{
+    uint64_t value = 42U;
+    atto_eq(GREY_ERR_INVALID, parse("", GREY_TEXT_DEC, &value));
+    atto_eq(GREY_ERR_INVALID, parse("-1", GREY_TEXT_DEC, &value));
+    atto_eq(GREY_ERR_INVALID, parse(" 1", GREY_TEXT_DEC, &value));
+    atto_eq(GREY_ERR_INVALID, parse("12345678a", GREY_TEXT_DEC, &value));
+    atto_eq(GREY_ERR_RANGE,
+            parse("18446744073709551616", GREY_TEXT_DEC, &value));
+    atto_eq(GREY_ERR_RANGE,
+            parse("99999999999999999999", GREY_TEXT_DEC, &value));
+    atto_eq(GREY_ERR_INVALID, parse("0x", GREY_TEXT_HEX, &value));
+    atto_eq(GREY_ERR_INVALID, parse("0xg", GREY_TEXT_HEX, &value));
+    atto_eq(GREY_ERR_RANGE,
+            parse("10000000000000000", GREY_TEXT_HEX, &value));
+    atto_eq(GREY_ERR_INVALID, parse("2", GREY_TEXT_BIN, &value));
+    atto_eq(42U, value);  // Untouched on failure
+    atto_eq(GREY_OK, parse("18446744073709551615", GREY_TEXT_DEC, &value));
+    atto_eq(UINT64_MAX, value);
+    atto_eq(GREY_OK,
+            parse("0000000000000000000000000042", GREY_TEXT_DEC, &value));
+    atto_eq(42U, value);
+    atto_eq(GREY_OK, parse("0xFfFfFfFfFfFfFfFf", GREY_TEXT_HEX, &value));
+    atto_eq(UINT64_MAX, value);
+    atto_eq(GREY_OK, parse("0X2a", GREY_TEXT_HEX, &value));
+    atto_eq(42U, value);
+    atto_eq(GREY_OK, parse("101010", GREY_TEXT_BIN, &value));
+    atto_eq(42U, value);
+    atto_eq(GREY_ERR_RANGE, grey_text_parse("256", 3, GREY_TEXT_DEC,
+                                            UINT8_MAX, &value));
+    atto_eq(GREY_OK, grey_text_parse("255", 3, GREY_TEXT_DEC,
+                                     UINT8_MAX, &value));
+    atto_eq(255U, value);
+
+    /* Every byte, in every position of chunks and leftovers */
+    char str[20 + 1];
+    for (unsigned int c = 0; c <= UINT8_MAX; c++)
+    {
+        const bool digit = c >= '0' && c <= '9';
+        const bool hex = digit || (c >= 'a' && c <= 'f')
+                         || (c >= 'A' && c <= 'F');
+        for (size_t length = 1; length <= 16U; length++)
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                memset(str, '1', length);
+                str[i] = (char) c;
+                atto_eq(digit ? GREY_OK : GREY_ERR_INVALID,
+                        grey_text_parse(str, length, GREY_TEXT_DEC,
+                                        UINT64_MAX, &value));
+                atto_eq(hex ? GREY_OK : GREY_ERR_INVALID,
+                        grey_text_parse(str, length, GREY_TEXT_HEX,
+                                        UINT64_MAX, &value));
+            }
+        }
+    }
+}
+
+static void test_text_format(void)
+{
+    char str[GREY_TEXT_MAX_LEN];
+    char expected[GREY_TEXT_MAX_LEN + 1U];
+    atto_eq(1U, grey_text_format(str, 0U, GREY_TEXT_DEC, 0));
+    atto_eq('0', str[0]);
+    atto_eq(1U, grey_text_format(str, 0U, GREY_TEXT_HEX, 0));
+    atto_eq('0', str[0]);
+    atto_eq(1U, grey_text_format(str, 0U, GREY_TEXT_BIN, 0));
+    atto_eq('0', str[0]);
+    atto_eq(8U, grey_text_format(str, 5U, GREY_TEXT_BIN, 8U));
+    atto_memeq("00000101", str, 8U);
+    atto_eq(4U, grey_text_format(str, 0xABU, GREY_TEXT_HEX, 16U));
+    atto_memeq("00ab", str, 4U);
+    uint64_t state = 0x853C49E6748FEA9BULL;
+    for (uint32_t i = 0; i < 100000U; i++)
+    {
+        /* Random lengths, to hit every amount of digits */
+        const uint64_t random = test_next_pseudorandom(&state) >> (i % 64U);
+        uint64_t parsed = 0;
+        size_t length = grey_text_format(str, random, GREY_TEXT_DEC, 0);
+        atto_eq((size_t) snprintf(expected, sizeof(expected),
+                                  "%" PRIu64, random), length);
+        atto_memeq(expected, str, length);
+        atto_eq(GREY_OK, grey_text_parse(str, length, GREY_TEXT_DEC,
+                                         UINT64_MAX, &parsed));
+        atto_eq(random, parsed);
+        length = grey_text_format(str, random, GREY_TEXT_HEX, 0);
+        atto_eq((size_t) snprintf(expected, sizeof(expected),
+                                  "%" PRIx64, random), length);
+        atto_memeq(expected, str, length);
+        atto_eq(GREY_OK, grey_text_parse(str, length, GREY_TEXT_HEX,
+                                         UINT64_MAX, &parsed));
+        atto_eq(random, parsed);
+        length = grey_text_format(str, (uint32_t) random, GREY_TEXT_HEX, 32);
+        atto_eq(8U, length);
+        snprintf(expected, sizeof(expected), "%08" PRIx32,
+                 (uint32_t) random);
+        atto_memeq(expected, str, length);
+        length = grey_text_format(str, random, GREY_TEXT_BIN, 64U);
+        grey_binstr_fixed64(expected, random);
+        atto_eq(64U, length);
+        atto_memeq(expected, str, length);
+        length = grey_text_format(str, random, GREY_TEXT_BIN, 0);
+        atto_eq(GREY_OK, grey_text_parse(str, length, GREY_TEXT_BIN,
+                                         UINT64_MAX, &parsed));
+        atto_eq(random, parsed);
+    }
+}
+
+static void test_text_convert(void)
+{
+    grey_text_config_t config = {
+            .input = GREY_TEXT_DEC,
+            .output = GREY_TEXT_BIN,
+            .direction = GREY_TEXT_ENCODE,
+            .bits = 64U,
+            .pad = false,
+    };
+    grey_text_block_t block;
+    memset(&block, 0, sizeof(block));
+    /* CRLF and a last line without newline */
+    block.in = "5\n255\r\n0";
+    block.in_len = strlen(block.in);
+    atto_eq(GREY_OK, grey_text_convert(&block, &config));
+    atto_eq(3U, block.lines);
+    atto_eq(15U, block.out_len);
+    atto_memeq("111\n10000000\n0\n", block.out, block.out_len);
+
+    config.input = GREY_TEXT_HEX;
+    config.output = GREY_TEXT_DEC;
+    config.direction = GREY_TEXT_DECODE;
+    config.bits = 8U;
+    block.in = "0x7\nff\n100\n1\n";
+    block.in_len = strlen(block.in);
+    atto_eq(GREY_ERR_RANGE, grey_text_convert(&block, &config));
+    atto_eq(2U, block.lines);
+    atto_eq(GREY_ERR_RANGE, block.error);
+    atto_memeq("5\n170\n", block.out, block.out_len);
+    block.in = "1\n\n";
+    block.in_len = strlen(block.in);
+    atto_eq(GREY_ERR_INVALID, grey_text_convert(&block, &config));
+    atto_eq(1U, block.lines);
+
+    /* Many batches, against one conversion per line */
+    config.input = GREY_TEXT_DEC;
+    config.output = GREY_TEXT_HEX;
+    config.direction = GREY_TEXT_ENCODE;
+    config.bits = 32U;
+    config.pad = true;
+    const size_t lines = 3000U;
+    char* const in = malloc(lines * 11U + 1U);
+    char* const expected = malloc(lines * 9U + 1U);
+    atto_assert(in != NULL && expected != NULL);
+    size_t in_len = 0;
+    uint64_t state = 0xDA3E39CB94B95BDBULL;
+    for (size_t i = 0; i < lines; i++)
+    {
+        const uint32_t value = (uint32_t) test_next_pseudorandom(&state);
+        in_len += (size_t) sprintf(&in[in_len], "%" PRIu32 "\n", value);
+        sprintf(&expected[9U * i], "%08" PRIx32 "\n", grey_to32(value));
+    }
+    block.in = in;
+    block.in_len = in_len;
+    atto_eq(GREY_OK, grey_text_convert(&block, &config));
+    atto_eq(lines, block.lines);
+    atto_eq(lines * 9U, block.out_len);
+    atto_memeq(expected, block.out, block.out_len);
+    free(in);
+    free(expected);
+    free(block.out);
+}
+
+void test_text(void)
+{
+    test_text_parse();
+    test_text_format();
+    test_text_convert();
+}
@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief Tests of the multiword Grey codes, grey_to_words() and
+ * grey_from_words(), against a bit-by-bit reference.
+ *
+ * @copyright Copyright © 2020, Matjaž Guštin <dev@matjaz.it>
+ * <https://matjaz.it>. All rights reserved.
+ * @license BSD 3-clause license.
+ */
+
+#include "grey.h"
+#include "atto.h"
+#include "test.h"
+#include <string.h>
+
+#define WORDS_MAX_BITS 40001U
+#define WORDS_MAX GREY_WORDS(WORDS_MAX_BITS)
+
+static uint64_t bit_of(const uint64_t* const words, const size_t i)
+{
+    return (words[i / 64U] >> (i % 64U)) & 1U;
+}
+
+/** Grey code bit i is value bit i XOR value bit i+1, little-endian words. */
+static void reference_to_words(const uint64_t* const values,
+                               uint64_t* const codes, const size_t bits)
+{
+    memset(codes, 0, GREY_WORDS(bits) * sizeof(uint64_t));
+    for (size_t i = 0; i < bits; i++)
+    {
+        const uint64_t above = (i + 1U < bits) ? bit_of(values, i + 1U) : 0;
+        codes[i / 64U] |= (bit_of(values, i) ^ above) << (i % 64U);
+    }
+}
+
+/** Value bit i is the XOR of the code bits from i up, little-endian words. */
+static void reference_from_words(const uint64_t* const codes,
+                                 uint64_t* const values, const size_t bits)
+{
+    memset(values, 0, GREY_WORDS(bits) * sizeof(uint64_t));
+    uint64_t parity = 0;
+    for (size_t i = bits; i > 0; i--)
+    {
+        parity ^= bit_of(codes, i - 1U);
+        values[(i - 1U) / 64U] |= parity << ((i - 1U) % 64U);
+    }
+}
+
+static void reverse_words(uint64_t* const words, const size_t amount)
+{
+    for (size_t i = 0; i < amount / 2U; i++)
+    {
+        const uint64_t tmp = words[i];
+        words[i] = words[amount - 1U - i];
+        words[amount - 1U - i] = tmp;
+    }
+}
+
+static void test_words_bits(const size_t bits)
+{
+    static uint64_t input[WORDS_MAX];
+    static uint64_t masked[WORDS_MAX];
+    static uint64_t expected[WORDS_MAX];
+    static uint64_t output[WORDS_MAX + 1U];
+    const size_t amount = GREY_WORDS(bits);
+
+    /* The unused top bits of the input are garbage on purpose. */
+    test_fill_pseudorandom(input, amount * sizeof(uint64_t),
+                           0x2545F4914F6CDD1DULL);
+    memcpy(masked, input, amount * sizeof(uint64_t));
+    if (bits % 64U != 0)
+    {
+        masked[amount - 1U] &= (UINT64_C(1) << (bits % 64U)) - 1U;
+    }
+
+    /* Little-endian word order. */
+    reference_to_words(input, expected, bits);
+    output[amount] = 42U;  // Canary after the last word
+    grey_to_words(input, output, bits, GREY_WORDS_LE);
+    atto_memeq(expected, output, amount * sizeof(uint64_t));
+    atto_eq(42U, output[amount]);
+    reference_from_words(input, expected, bits);
+    grey_from_words(input, output, bits, GREY_WORDS_LE);
+    atto_memeq(expected, output, amount * sizeof(uint64_t));
+    atto_eq(42U, output[amount]);
+    grey_to_words(output, output, bits, GREY_WORDS_LE);
+    atto_memeq(masked, output, amount * sizeof(uint64_t));
+    grey_from_words(output, output, bits, GREY_WORDS_LE);
+    atto_memeq(expected, output, amount * sizeof(uint64_t));
+
+    /* Big-endian word order: same words, reversed. */
+    reference_to_words(input, expected, bits);
+    reverse_words(expected, amount);
+    memcpy(output, input, amount * sizeof(uint64_t));
+    reverse_words(output, amount);
+    grey_to_words(output, output, bits, GREY_WORDS_BE);
+    atto_memeq(expected, output, amount * sizeof(uint64_t));
+    reference_from_words(input, expected, bits);
+    reverse_words(expected, amount);
+    memcpy(output, input, amount * sizeof(uint64_t));
+    reverse_words(output, amount);
+    grey_from_words(output, output, bits, GREY_WORDS_BE);
+    atto_memeq(expected, output, amount * sizeof(uint64_t));
+    grey_to_words(output, output, bits, GREY_WORDS_BE);
+    reverse_words(output, amount);
+    atto_memeq(masked, output, amount * sizeof(uint64_t));
+}
+
+void test_words(void)
+{
+    grey_to_words(NULL, NULL, 0, GREY_WORDS_LE);
+    grey_from_words(NULL, NULL, 0, GREY_WORDS_BE);
+    atto_eq(0, GREY_WORDS(0));
+    atto_eq(1, GREY_WORDS(64));
+    atto_eq(2, GREY_WORDS(65));
+
+    /* A single word is a plain 64-bit Grey code. */
+    uint64_t word = UINT64_MAX;
+    grey_to_words(&word, &word, 64, GREY_WORDS_LE);
+    atto_eq(grey_to64(UINT64_MAX), word);
+    grey_from_words(&word, &word, 64, GREY_WORDS_BE);
+    atto_eq(UINT64_MAX, word);
+#if defined(GREY_HAS_UINT128)
+    const grey_uint128_t value = ((grey_uint128_t) 0x8000000000000001ULL
+            << 64U) | 0xFEDCBA9876543210ULL;
+    uint64_t words[2] = {(uint64_t) value, (uint64_t) (value >> 64U)};
+    grey_to_words(words, words, 128, GREY_WORDS_LE);
+    atto_eq((uint64_t) grey_to128(value), words[0]);
+    atto_eq((uint64_t) (grey_to128(value) >> 64U), words[1]);
+    grey_from_words(words, words, 128, GREY_WORDS_LE);
+    atto_eq((uint64_t) value, words[0]);
+    atto_eq((uint64_t) (value >> 64U), words[1]);
+#endif
+
+    for (size_t bits = 1; bits <= 300U; bits++)
+    {
+        test_words_bits(bits);
+    }
+    test_words_bits(1024);
+    test_words_bits(4096);
+    test_words_bits(4097);
+    /* More than one decoding block. */
+    test_words_bits(WORDS_MAX_BITS);
+}